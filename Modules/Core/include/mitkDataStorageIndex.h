@@ -0,0 +1,123 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDataStorageIndex_h
+#define mitkDataStorageIndex_h
+
+#include <MitkCoreExports.h>
+#include <mitkBaseProperty.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace mitk
+{
+  class DataNode;
+  class NodePredicateBase;
+
+  /**
+   * \brief Secondary indices of the nodes of a data storage that answer frequent queries without
+   * evaluating a predicate for every node.
+   *
+   * Nodes are indexed by the class name and the UID of their data and by the values
+   * (BaseProperty::GetValueAsString()) of selected renderer-independent properties. The "name"
+   * property is always indexed.
+   *
+   * GetCandidates() plans a predicate: NodePredicateDataType, NodePredicateDataUID and
+   * NodePredicateProperty (with value and without renderer) of indexed keys are answered by the
+   * indices, NodePredicateAnd by the intersection of its indexed child predicates and NodePredicateOr
+   * by the union of its children, if all of them are indexed. The candidates are a superset of the
+   * matching nodes, so callers still have to check the predicate for each candidate.
+   *
+   * Nodes whose own property list does not contain an indexed property are always candidates for
+   * queries of that property, since NodePredicateProperty falls back on the properties of the data.
+   * Changes of a node (e.g. its data or property list) and of its indexed property objects mark the
+   * node as outdated. Outdated nodes are re-indexed by the next call of Update(). UID changes of data
+   * that is already part of a node are not tracked.
+   *
+   * The index is not thread-safe except for the tracking of outdated nodes. It has to be guarded by
+   * the mutex of the owning data storage: GetCandidates() and GetIndexedPropertyKeys() may be called
+   * by concurrent readers, all other methods require exclusive access.
+   *
+   * \ingroup DataStorage
+   */
+  class MITKCORE_EXPORT DataStorageIndex
+  {
+  public:
+    typedef std::set<const DataNode *> NodeSetType;
+
+    DataStorageIndex();
+    ~DataStorageIndex();
+
+    DataStorageIndex(const DataStorageIndex &) = delete;
+    DataStorageIndex &operator=(const DataStorageIndex &) = delete;
+
+    void AddNode(const DataNode *node);
+    void RemoveNode(const DataNode *node);
+
+    /** \brief Adds a property key whose values are indexed for all nodes. */
+    void AddIndexedPropertyKey(const std::string &propertyKey);
+    std::set<std::string> GetIndexedPropertyKeys() const;
+
+    /** \brief Marks a node as outdated. Can be called from any thread. */
+    void MarkOutdated(const DataNode *node);
+
+    /** \brief Checks if any node has been marked as outdated since the last Update(). Can be called from any thread. */
+    bool HasOutdatedNodes() const;
+
+    /** \brief Re-indexes all outdated nodes. */
+    void Update();
+
+    /**
+     * \brief Collects the nodes that may match \a predicate.
+     *
+     * \return false if \a predicate cannot be answered by the indices. \a candidates is undefined then.
+     */
+    bool GetCandidates(const NodePredicateBase *predicate, NodeSetType &candidates) const;
+
+  private:
+    struct IndexedProperty
+    {
+      BaseProperty::Pointer Property;
+      std::string Value;
+      unsigned long ObserverTag;
+    };
+
+    struct Entry
+    {
+      bool HasData = false;
+      std::string DataType;
+      std::string DataUID;
+      std::map<std::string, IndexedProperty> Properties;
+      unsigned long NodeObserverTag = 0;
+    };
+
+    void IndexNode(const DataNode *node, Entry &entry);
+    void IndexProperty(const DataNode *node, const std::string &propertyKey, Entry &entry);
+    void UnindexNode(const DataNode *node, Entry &entry);
+
+    std::map<const DataNode *, Entry> m_Entries;
+    std::set<std::string> m_IndexedPropertyKeys;
+
+    std::map<std::string, NodeSetType> m_NodesByDataType;
+    std::map<std::string, NodeSetType> m_NodesByDataUID;
+    std::map<std::string, std::map<std::string, NodeSetType>> m_NodesByPropertyValue;
+    std::map<std::string, NodeSetType> m_NodesWithoutProperty;
+
+    NodeSetType m_OutdatedNodes;
+    mutable std::mutex m_OutdatedNodesMutex;
+  };
+}
+
+#endif
@@ -111,6 +111,13 @@ namespace mitk
       this->m_ZMax = zMax;
     }
 
+    /** \brief Limit the number of pixels of the slice (0 means no limit).
+    * If the slice would consist of more pixels, it is resampled with a coarser in-plane spacing.
+    * This is used to provide fast previews of large slices.
+    */
+    void SetMaximumNumberOfOutputPixels(unsigned long maximum) { this->m_MaximumNumberOfOutputPixels = maximum; }
+    unsigned long GetMaximumNumberOfOutputPixels() const { return this->m_MaximumNumberOfOutputPixels; }
+
     /** \brief Get the bounding box of the slice [xMin, xMax, yMin, yMax, zMin, zMax]
     * The method uses the input of the filter to calculate the bounds.
     * It is recommended to use
@@ -195,6 +202,8 @@ namespace mitk
 
     unsigned int m_Component;
 
+    unsigned long m_MaximumNumberOfOutputPixels;
+
   private:
     BaseGeometry::ConstPointer m_ResliceTransform;
     /* Axis vectors of the relevant geometry. Set in GenerateOutputInformation() and also used in GenerateData().*/
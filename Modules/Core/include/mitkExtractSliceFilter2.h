@@ -27,15 +27,18 @@ namespace mitk
    * If a pixel of the 2-d output image isn't located within the bounds of the
    * 3-d input image, it is set to the lowest possible pixel value.
    *
-   * Cubic interpolation is considerably slow on the first update for a newly
-   * set input image. Subsequent filter updates with cubic interpolation are
-   * faster by several orders of magnitude as long as the input image was
-   * neither changed nor modified.
+   * The slice is sampled by mitk::ResliceEngine, which distributes the output
+   * rows across multiple threads (see itk::ProcessObject::SetNumberOfThreads).
    *
-   * This filter is completely based on ITK compared to the VTK-based
-   * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
-   * an mitk::Image with valid geometry. Generally it is not as fast as
-   * mitk::ExtractSliceFilter, though.
+   * Cubic interpolation of images with single component pixels uses a second
+   * order B-spline (itk::BSplineInterpolateImageFunction) instead, which is
+   * considerably slow on the first update for a newly set input image.
+   * Subsequent updates are much faster as long as the input image was neither
+   * changed nor modified. Images with multiple components are interpolated with
+   * the Catmull-Rom kernel of mitk::ResliceEngine.
+   *
+   * Compared to the VTK-based mitk::ExtractSliceFilter, this filter is easy to
+   * use and produces an mitk::Image with valid geometry.
    */
   class MITKCORE_EXPORT ExtractSliceFilter2 final : public ImageToImageFilter
   {
@@ -67,8 +70,6 @@ namespace mitk
     ~ExtractSliceFilter2() override;
 
     void AllocateOutputs() override;
-    // void BeforeThreadedGenerateData() override;
-    // void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
     void GenerateData() override;
     void VerifyInputInformation() override;
 
@@ -17,7 +17,9 @@ found in the LICENSE file.
 #include "mitkImageAccessorBase.h"
 #include "mitkImageDataItem.h"
 #include "mitkImageDescriptor.h"
+#include "mitkImagePyramid.h"
 #include "mitkImageVtkAccessor.h"
+#include "mitkImageVolumeLoader.h"
 #include "mitkLevelWindow.h"
 #include "mitkPlaneGeometry.h"
 #include "mitkSlicedData.h"
@@ -80,6 +82,7 @@ namespace mitk
     friend class ImageVtkWriteAccessor;
     friend class ImageReadAccessor;
     friend class ImageWriteAccessor;
+    friend class ImageVolumeLoader;
 
   public:
     mitkClassMacro(Image, SlicedData);
@@ -651,6 +654,39 @@ namespace mitk
       new \a ImageStatisticsHolder object.
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
+
+    /**
+      \brief Sets the store that allocates the memory of channels, volumes and slices of this image.
+
+      Only memory allocated after this call is affected, so the store should be set before the
+      image data is accessed for the first time. Memory imported via SetImportVolume() etc. is never
+      placed in the store. If no store is set (default), image memory is allocated on the heap.
+      \sa MappedFileImageDataBackingStore
+      */
+    void SetBackingStore(ImageDataBackingStore *store);
+    ImageDataBackingStore *GetBackingStore() const;
+
+    /**
+      \brief Sets a loader that supplies the content of volumes not before they are accessed.
+
+      Volumes that are pending in the loader are reported as set. They are loaded by the first
+      call of GetSliceData(), GetVolumeData() or GetChannelData() that needs them. Re-initializing
+      the image removes the loader.
+      \sa ImageVolumeLoader
+      */
+    void SetVolumeLoader(ImageVolumeLoader *loader);
+    ImageVolumeLoader *GetVolumeLoader() const;
+
+    /**
+      \brief Sets a multi-resolution pyramid that provides down-sampled versions of this image.
+
+      The pyramid is optional. If set, consumers like ImageVtkMapper2D select a coarser level of
+      it for zoomed-out views. The levels are rebuilt automatically after the image has been modified.
+      \sa ImagePyramid
+      */
+    void SetPyramid(ImagePyramid *pyramid);
+    ImagePyramid *GetPyramid() const;
+
   protected:
     mitkCloneMacro(Self);
 
@@ -710,7 +746,13 @@ namespace mitk
     friend class ImageStatisticsHolder;
     StatisticsHolderPointer m_ImageStatistics;
 
+    ImageDataBackingStore::Pointer m_BackingStore;
+    ImageVolumeLoader::Pointer m_VolumeLoader;
+    ImagePyramid::Pointer m_Pyramid;
+
   private:
+    void LoadPendingVolume(int t, int n) const;
+
     ImageDataItemPointer GetSliceData_unlocked(
       int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const;
     ImageDataItemPointer GetVolumeData_unlocked(int t,
@@ -0,0 +1,151 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageDataBackingStore_h
+#define mitkImageDataBackingStore_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace mitk
+{
+  /**
+   * \brief Provides the memory that backs the pixel buffers of ImageDataItem.
+   *
+   * By default mitk::Image allocates its channels and volumes on the heap. A backing
+   * store can be assigned to an image (see Image::SetBackingStore()) to place the
+   * buffers somewhere else. Image notifies the store via Touch() whenever a volume
+   * is requested by GetVolumeData(), or a slice of an existing volume by GetSliceData()
+   * (the whole volume is reported then), so a store is able to keep track of the time
+   * steps of the image that are actually in use.
+   *
+   * \ingroup Data
+   */
+  class MITKCORE_EXPORT ImageDataBackingStore : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImageDataBackingStore, itk::Object);
+
+    /**
+     * \brief Allocates a buffer of \c size bytes.
+     * \throw itk::MemoryAllocationError if the buffer could not be allocated.
+     */
+    virtual unsigned char *Allocate(size_t size) = 0;
+
+    /** \brief Releases a buffer previously returned by Allocate(). */
+    virtual void Release(unsigned char *data, size_t size) = 0;
+
+    /**
+     * \brief Notifies the store that the range [data, data + size) is about to be accessed.
+     *
+     * The range has to lie within a buffer allocated by this store. The default
+     * implementation does nothing.
+     */
+    virtual void Touch(const unsigned char *data, size_t size) const;
+
+  protected:
+    ImageDataBackingStore();
+    ~ImageDataBackingStore() override;
+  };
+
+  /**
+   * \brief Backing store that places image buffers in memory-mapped scratch files.
+   *
+   * Every buffer is mapped from its own scratch file that is removed again when the
+   * buffer is released. Since the operating system pages in mapped memory on first
+   * access only, volumes or time steps that are never touched do not occupy RAM.
+   *
+   * The store additionally maintains a residency budget: ranges passed to Touch() are
+   * kept in a least-recently-used list, and as soon as the sum of their sizes exceeds
+   * the budget, the least recently used ranges are flushed to their scratch file and
+   * dropped from physical memory. Their content is transparently paged in again on the
+   * next access. A budget of 0 disables eviction.
+   *
+   * Buffers smaller than the minimum mapped size are allocated on the heap.
+   *
+   * \ingroup Data
+   */
+  class MITKCORE_EXPORT MappedFileImageDataBackingStore : public ImageDataBackingStore
+  {
+  public:
+    mitkClassMacro(MappedFileImageDataBackingStore, ImageDataBackingStore);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Directory for the scratch files. Defaults to IOUtil::GetTempPath(). */
+    itkSetStringMacro(ScratchDirectory);
+    itkGetStringMacro(ScratchDirectory);
+
+    /** \brief Maximum number of touched bytes kept resident (0 = unlimited). */
+    void SetResidencyBudget(size_t budget);
+    size_t GetResidencyBudget() const;
+
+    /** \brief Buffers smaller than this number of bytes are allocated on the heap. */
+    itkSetMacro(MinimumMappedSize, size_t);
+    itkGetConstMacro(MinimumMappedSize, size_t);
+
+    /** \brief Sum of the sizes of all touched ranges that are currently considered resident. */
+    size_t GetResidentSize() const;
+
+    /** \brief Sum of the sizes of all buffers currently mapped from scratch files. */
+    size_t GetMappedSize() const;
+
+    unsigned char *Allocate(size_t size) override;
+    void Release(unsigned char *data, size_t size) override;
+    void Touch(const unsigned char *data, size_t size) const override;
+
+  protected:
+    MappedFileImageDataBackingStore();
+    ~MappedFileImageDataBackingStore() override;
+
+  private:
+    struct Mapping
+    {
+      size_t Size;
+#ifdef _WIN32
+      void *FileHandle;
+      void *MappingHandle;
+#else
+      int FileDescriptor;
+#endif
+    };
+
+    typedef std::pair<const unsigned char *, size_t> RangeType;
+    typedef std::list<RangeType> RangeListType;
+
+    void UnmapBuffer(unsigned char *data, const Mapping &mapping);
+    void ForgetRanges(const unsigned char *begin, const unsigned char *end) const;
+    void EvictLeastRecentlyUsed() const;
+    void Evict(const RangeType &range) const;
+
+    std::string m_ScratchDirectory;
+    size_t m_ResidencyBudget;
+    size_t m_MinimumMappedSize;
+
+    std::map<unsigned char *, Mapping> m_Mappings;
+    size_t m_MappedSize;
+
+    mutable RangeListType m_ResidentRanges;
+    mutable std::map<RangeType, RangeListType::iterator> m_ResidentRangeLookup;
+    mutable size_t m_ResidentSize;
+
+    mutable std::mutex m_Mutex;
+  };
+} // namespace mitk
+
+#endif
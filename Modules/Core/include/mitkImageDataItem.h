@@ -18,6 +18,7 @@ found in the LICENSE file.
 //#include <mitkIpPic.h>
 //#include "mitkPixelType.h"
 #include "mitkImageDescriptor.h"
+#include "mitkImageDataBackingStore.h"
 //#include "mitkImageVtkAccessor.h"
 
 class vtkImageData;
@@ -77,14 +78,25 @@ namespace mitk
 
     ~ImageDataItem() override;
 
-    ImageDataItem(const mitk::ImageDescriptor::Pointer desc, int timestep, void *data, bool manageMemory);
+    /**
+     * If @a data is nullptr, the memory is allocated by @a backingStore or, if no store is given, on the heap.
+     */
+    ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
+                  int timestep,
+                  void *data,
+                  bool manageMemory,
+                  ImageDataBackingStore *backingStore = nullptr);
 
+    /**
+     * If @a data is nullptr, the memory is allocated by @a backingStore or, if no store is given, on the heap.
+     */
     ImageDataItem(const mitk::PixelType &type,
                   int timestep,
                   unsigned int dimension,
                   unsigned int *dimensions,
                   void *data,
-                  bool manageMemory);
+                  bool manageMemory,
+                  ImageDataBackingStore *backingStore = nullptr);
 
     ImageDataItem(const ImageDataItem &other);
 
@@ -148,6 +160,10 @@ namespace mitk
 
   private:
     void ComputeItemSize(const unsigned int *dimensions, unsigned int dimension);
+    void AllocateData(ImageDataBackingStore *backingStore);
+
+    /** Store that allocated m_Data, or nullptr if m_Data lives on the heap. */
+    ImageDataBackingStore::Pointer m_BackingStore;
 
     ImageDataItem::ConstPointer m_Parent;
 
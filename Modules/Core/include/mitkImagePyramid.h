@@ -0,0 +1,134 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImagePyramid_h
+#define mitkImagePyramid_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+#include <mitkNumericTypes.h>
+
+#include <itkObject.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /**
+   * \brief Multi-resolution pyramid of an image for zoomed-out views and previews.
+   *
+   * Level 0 is the image itself. Each further level is derived from its predecessor by
+   * averaging blocks of 2 voxels along each axis whose spacing is not considerably larger
+   * than the smallest spacing of the predecessor, so that anisotropic images become more
+   * isotropic first. Levels are added until the largest dimension does not exceed
+   * GetMinimumLevelSize() or the maximum number of levels is reached. The geometry of each
+   * level covers the same physical region as the image.
+   *
+   * A pyramid is assigned to an image by Image::SetPyramid(). Levels are built by Update()
+   * or by StartBackgroundUpdate() on a worker thread. They belong to a version of the image,
+   * identified by its modification time, and become unavailable as soon as the image is
+   * modified. Consumers like ImageVtkMapper2D select a level by SelectLevel(), which
+   * triggers a background update if the pyramid is outdated and falls back to level 0
+   * until the coarser levels are available.
+   *
+   * Only the first channel of an image is considered. All scalar component types with an
+   * arbitrary number of components are supported.
+   *
+   * \ingroup Data
+   */
+  class MITKCORE_EXPORT ImagePyramid : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImagePyramid, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Maximum number of levels, including the image itself (default: 5). */
+    void SetMaximumNumberOfLevels(unsigned int maximumNumberOfLevels);
+    unsigned int GetMaximumNumberOfLevels() const;
+
+    /** \brief Levels are not down-sampled below this number of voxels along their largest dimension (default: 64). */
+    void SetMinimumLevelSize(unsigned int minimumLevelSize);
+    unsigned int GetMinimumLevelSize() const;
+
+    /** \brief Returns whether all levels have been built for the current version of \a image. */
+    bool IsUpToDate(const Image *image) const;
+
+    /** \brief Returns the number of levels that are available for the current version of \a image, including level 0. */
+    unsigned int GetNumberOfAvailableLevels(const Image *image) const;
+
+    /**
+     * \brief Returns level \a level of \a image without blocking.
+     *
+     * Returns \a image itself for level 0 and nullptr if the level is not available for the
+     * current version of \a image.
+     */
+    itk::SmartPointer<Image> GetLevel(const Image *image, unsigned int level) const;
+
+    /**
+     * \brief Returns the coarsest available level whose voxels are not larger than \a mmPerPixel.
+     *
+     * The smallest spacing of a level is compared. If the pyramid is outdated, a background
+     * update is started and 0 is returned.
+     */
+    unsigned int SelectLevel(const Image *image, ScalarType mmPerPixel);
+
+    /**
+     * \brief Returns the finest available level whose volumes consist of at most \a maximumNumberOfVoxels voxels.
+     *
+     * If no level is small enough, the coarsest available level is returned. If the pyramid
+     * is outdated, a background update is started and 0 is returned.
+     */
+    unsigned int SelectLevelByNumberOfVoxels(const Image *image, size_t maximumNumberOfVoxels);
+
+    /** \brief Builds all levels of the current version of \a image. Blocks until they are available. */
+    void Update(const Image *image);
+
+    /**
+     * \brief Builds all levels of the current version of \a image on a worker thread, if not already running.
+     *
+     * The worker keeps a reference to \a image until it has finished.
+     */
+    void StartBackgroundUpdate(const Image *image);
+
+    /** \brief Stops the worker thread. Levels that have been built so far remain available. */
+    void StopBackgroundUpdate();
+
+  protected:
+    ImagePyramid();
+    ~ImagePyramid() override;
+
+  private:
+    bool IsUpToDate_unlocked(const Image *image) const;
+    void UpdateLevels(const Image *image);
+    void RunBackgroundUpdate(itk::SmartPointer<const Image> image);
+
+    std::vector<itk::SmartPointer<Image>> m_Levels;
+    itk::ModifiedTimeType m_ImageMTime;
+    bool m_Complete;
+    unsigned int m_MaximumNumberOfLevels;
+    unsigned int m_MinimumLevelSize;
+
+    bool m_BackgroundUpdateRunning;
+    std::atomic<bool> m_StopRequested;
+
+    mutable std::mutex m_LevelsMutex;
+    std::mutex m_UpdateMutex;
+    std::thread m_BackgroundThread;
+  };
+} // namespace mitk
+
+#endif
@@ -0,0 +1,116 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageSliceCache_h
+#define mitkImageSliceCache_h
+
+#include <MitkCoreExports.h>
+#include <mitkTimeGeometry.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <list>
+#include <map>
+
+namespace mitk
+{
+  class Image;
+  class PlaneGeometry;
+
+  /**
+   * \brief Bounded least-recently-used cache of resliced image slices.
+   *
+   * Used by ImageVtkMapper2D to avoid reslicing an image again when a slice that
+   * has been shown recently is requested again, e.g., when scrolling back and forth
+   * or when several render windows show the same plane. Since a mapper is shared
+   * by all render windows displaying its data node, so is its cache.
+   *
+   * Slices are identified by the plane (its index-to-world transform and bounds),
+   * the reference geometry of the plane, the time step, the reslice settings and the
+   * modification time of the image and its geometry. Entries of an image are dropped
+   * as soon as a slice of a newer version of the image is inserted.
+   */
+  class MITKCORE_EXPORT ImageSliceCache
+  {
+  public:
+    struct KeyType
+    {
+      const Image *ImagePointer = nullptr;
+      itk::ModifiedTimeType ImageMTime = 0;
+      itk::ModifiedTimeType ImageGeometryMTime = 0;
+      const BaseGeometry *ReferenceGeometry = nullptr;
+      itk::ModifiedTimeType ReferenceGeometryMTime = 0;
+      std::array<double, 12> PlaneTransform;
+      std::array<double, 6> PlaneBounds;
+      TimeStepType TimeStep = 0;
+      int InterpolationMode = 0;
+      int ThickSlicesMode = 0;
+      int ThickSlicesNum = 0;
+      bool InPlaneResampleExtentByGeometry = false;
+
+      bool operator<(const KeyType &other) const;
+    };
+
+    struct EntryType
+    {
+      vtkSmartPointer<vtkImageData> Slice;
+      std::array<ScalarType, 2> Spacing;
+    };
+
+    ImageSliceCache();
+
+    static KeyType CreateKey(const Image *image,
+                             const PlaneGeometry *planeGeometry,
+                             TimeStepType timeStep,
+                             int interpolationMode,
+                             int thickSlicesMode,
+                             int thickSlicesNum,
+                             bool inPlaneResampleExtentByGeometry);
+
+    /** \brief Returns the cached slice for \a key or nullptr. A hit marks the entry as most recently used. */
+    const EntryType *Find(const KeyType &key);
+
+    /**
+     * \brief Stores a deep copy of \a slice under \a key and returns the cached entry.
+     *
+     * Least recently used entries are evicted until the cache fits into its maximum size again.
+     */
+    const EntryType *Insert(const KeyType &key, vtkImageData *slice, const ScalarType *spacing);
+
+    void Clear();
+
+    /** \brief Maximum number of bytes of slice data kept in the cache. 0 disables caching. */
+    void SetMaximumSize(size_t size);
+    size_t GetMaximumSize() const;
+
+    /** \brief Number of bytes of slice data currently kept in the cache. */
+    size_t GetSize() const;
+
+    size_t GetNumberOfEntries() const;
+
+  private:
+    typedef std::list<KeyType> KeyListType;
+    typedef std::map<KeyType, std::pair<EntryType, KeyListType::iterator>> EntryMapType;
+
+    void Remove(EntryMapType::iterator iter);
+    void Shrink();
+
+    EntryMapType m_Entries;
+    KeyListType m_RecentlyUsed;
+    size_t m_Size;
+    size_t m_MaximumSize;
+  };
+} // namespace mitk
+
+#endif
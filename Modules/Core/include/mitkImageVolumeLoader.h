@@ -0,0 +1,109 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageVolumeLoader_h
+#define mitkImageVolumeLoader_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkObject.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /**
+   * \brief Supplies the volumes of an image on demand.
+   *
+   * Readers that are able to decode single time steps of an image can initialize the
+   * image with its geometry only and assign a volume loader to it (see
+   * Image::SetVolumeLoader()). The image then reports all volumes as set, but their
+   * content is decoded by ReadVolume() not before GetSliceData(), GetVolumeData() or
+   * GetChannelData() actually request them.
+   *
+   * In addition, StartBackgroundLoading() decodes the remaining volumes on a worker
+   * thread. Volumes requested by the application are given preference: they are
+   * decoded immediately by the requesting thread, and the worker continues with the
+   * time steps following the last requested one.
+   *
+   * \ingroup Data
+   */
+  class MITKCORE_EXPORT ImageVolumeLoader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImageVolumeLoader, itk::Object);
+
+    /** \brief Marks all volumes of an image with the given number of time steps and channels as pending. */
+    void InitializePendingVolumes(unsigned int timeSteps, unsigned int channels);
+
+    /** \brief Returns whether volume \a t of channel \a n still has to be loaded. */
+    bool IsVolumePending(int t, int n) const;
+
+    /** \brief Returns whether any volume still has to be loaded. */
+    bool HasPendingVolumes() const;
+
+    /**
+     * \brief Loads volume \a t of channel \a n into \a image, if it is still pending.
+     *
+     * Blocks until the volume is available. If another thread is already loading the
+     * volume, this method waits for it to finish.
+     */
+    void LoadVolume(const Image *image, int t, int n);
+
+    /** \brief Starts loading all pending volumes of \a image on a worker thread. */
+    void StartBackgroundLoading(const Image *image);
+
+    /** \brief Stops the worker thread. Volumes that are still pending are loaded on demand later. */
+    void StopBackgroundLoading();
+
+  protected:
+    ImageVolumeLoader();
+    ~ImageVolumeLoader() override;
+
+    /**
+     * \brief Decodes volume \a t of channel \a n into \a buffer.
+     *
+     * \a buffer is large enough to hold a single volume. Calls are serialized, so
+     * implementations do not need to be thread-safe.
+     */
+    virtual void ReadVolume(int t, int n, void *buffer) = 0;
+
+  private:
+    enum class VolumeState
+    {
+      Pending,
+      Loading,
+      Loaded
+    };
+
+    void RunBackgroundLoading(const Image *image);
+
+    std::vector<VolumeState> m_VolumeStates;
+    unsigned int m_TimeSteps;
+    unsigned int m_PendingVolumes;
+    unsigned int m_NextBackgroundTimeStep;
+    bool m_StopRequested;
+
+    mutable std::mutex m_StateMutex;
+    std::condition_variable m_StateChanged;
+    std::mutex m_ReadMutex;
+    std::thread m_BackgroundThread;
+  };
+} // namespace mitk
+
+#endif
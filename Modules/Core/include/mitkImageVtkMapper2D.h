@@ -19,6 +19,7 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkImageSliceCache.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -130,6 +131,14 @@ namespace mitk
      * data. */
     void Update(mitk::BaseRenderer *renderer) override;
 
+    /** \brief Level of detail rendering is used for large slices if the property "level of detail" is true.
+     *
+     * As long as RenderingManager::GetNextLOD() is 0, i.e., during interaction, these slices are
+     * resliced at a reduced resolution. They are refined to full resolution as soon as the
+     * RenderingManager requests the next level of detail.
+     */
+    bool IsLODEnabled(mitk::BaseRenderer *renderer) const override;
+
     //### methods of MITK-VTK rendering pipeline
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
     //### end of methods of MITK-VTK rendering pipeline
@@ -193,6 +202,12 @@ namespace mitk
 
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
+      /** \brief Spacing of the displayed slice, m_mmPerPixel points here. */
+      mitk::ScalarType m_SliceSpacing[2];
+      /** \brief Whether the current slice has been resliced at a reduced resolution. */
+      bool m_ReducedResolution;
+      /** \brief Level of the multi-resolution pyramid of the image the current slice has been resliced from. */
+      unsigned int m_PyramidLevel;
 
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
@@ -218,6 +233,9 @@ namespace mitk
     /** \brief The LocalStorageHandler holds all (three) LocalStorages for the three 2D render windows. */
     mitk::LocalStorageHandler<LocalStorage> m_LSH;
 
+    /** \brief Recently resliced slices, shared by all render windows showing this mapper's data node. */
+    ImageSliceCache m_SliceCache;
+
     /** \brief Get the LocalStorage corresponding to the current renderer. */
     LocalStorage* GetLocalStorage(mitk::BaseRenderer* renderer);
 
@@ -272,6 +290,10 @@ namespace mitk
       * to keep the correct order for the final VTK rendering.*/
     float CalculateLayerDepth(mitk::BaseRenderer *renderer);
 
+    /** \brief Returns the coarsest available level of the multi-resolution pyramid of the image
+      * that still resolves the display pixels of the renderer, or 0 if the image has no pyramid.*/
+    unsigned int SelectPyramidLevel(mitk::BaseRenderer *renderer) const;
+
     /** \brief This method applies (or modifies) the lookuptable for all types of images.
      * \warning To use the lookup table, the property 'Lookup Table' must be set and a 'Image Rendering.Mode'
      * which uses the lookup table must be set.
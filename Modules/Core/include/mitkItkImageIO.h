@@ -54,6 +54,9 @@ namespace mitk
     // Fills the m_DefaultMetaDataKeys vector with default values
     virtual void InitializeDefaultMetaDataKeys();
 
+    // Offers on-demand loading of 4D time steps if the ImageIO supports streamed reading
+    void InitializeDefaultReaderOptions();
+
     // -------------- AbstractFileReader -------------
     std::vector<itk::SmartPointer<BaseData>> DoRead() override;
 
@@ -100,6 +100,24 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes.
+    //## If the value is 0 that means that there is no limit.
+    std::size_t GetUndoMemoryLimit() const override;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history in bytes.
+    //## If the limit is exceeded, the oldest undo items will
+    //## be dropped from the bottom of the undo stack. The most
+    //## recent item is always kept, even if it exceeds the limit.
+    //## The 0 value means that there is no limit.
+    //## @param limit the maximum number of bytes of the items on the stack
+    void SetUndoMemoryLimit(std::size_t limit) override;
+
+    //##Documentation
+    //## @brief Returns the memory of all items on the undo stack in bytes
+    std::size_t GetUndoMemorySize() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +146,10 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Drops the oldest items of the undo stack until the undo limit
+    //## and the undo memory limit are met
+    void EnforceUndoLimits();
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -137,6 +159,8 @@ namespace mitk
 
     std::size_t m_UndoLimit;
 
+    std::size_t m_UndoMemoryLimit;
+
   };
 
 #pragma GCC visibility push(default)
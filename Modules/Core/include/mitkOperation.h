@@ -18,6 +18,8 @@ found in the LICENSE file.
 
 #include <mitkCommon.h>
 
+#include <cstddef>
+
 namespace mitk
 {
   typedef int OperationType;
@@ -39,6 +41,13 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Approximate number of bytes of memory held by the operation beyond the object itself.
+    //##
+    //## Used by undo models to limit the memory of the undo history. Operations that store large
+    //## data (e.g. image slices) should override it. The default is 0.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
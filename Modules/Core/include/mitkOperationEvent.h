@@ -74,6 +74,10 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the approximate number of bytes of memory held by this item (see Operation::GetMemorySize()).
+    virtual std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -170,6 +174,9 @@ namespace mitk
     //## and false if it already has been deleted
     virtual bool IsValid();
 
+    //## @brief Returns the sum of the memory sizes of the operation and the undo operation
+    std::size_t GetMemorySize() const override;
+
   protected:
     void OnObjectDeleted();
 
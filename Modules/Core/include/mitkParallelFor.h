@@ -0,0 +1,51 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelFor_h
+#define mitkParallelFor_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace mitk
+{
+  /** \brief Number of threads used by ParallelFor() for the given number of items.
+   *
+   * This is the global default number of threads of itk::MultiThreader, limited to
+   * the number of items, and at least 1.
+   */
+  MITKCORE_EXPORT unsigned int GetParallelForNumberOfThreads(std::size_t numberOfItems);
+
+  /** \brief Calls \a function for the items 0 to \a numberOfItems - 1 on the threads of an itk::MultiThreader.
+   *
+   * The threads fetch the next item from a shared counter, so items of varying cost are
+   * balanced dynamically. The second argument of \a function is the index of the calling
+   * thread, which is less than GetParallelForNumberOfThreads(numberOfItems). It can be used
+   * to select per-thread buffers. With a single thread, \a function is called on the calling
+   * thread.
+   *
+   * If \a function throws, the other threads stop after their current item and the first
+   * exception is rethrown once all threads have finished.
+   */
+  MITKCORE_EXPORT void ParallelFor(std::size_t numberOfItems,
+                                   const std::function<void(std::size_t item, unsigned int thread)> &function);
+
+  /** \brief Calls \a function for the items 0 to \a numberOfItems - 1 on the threads of an itk::MultiThreader.
+   *
+   * \sa ParallelFor(std::size_t, const std::function<void(std::size_t, unsigned int)>&)
+   */
+  MITKCORE_EXPORT void ParallelFor(std::size_t numberOfItems, const std::function<void(std::size_t item)> &function);
+}
+
+#endif
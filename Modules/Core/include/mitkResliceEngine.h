@@ -0,0 +1,85 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkResliceEngine_h
+#define mitkResliceEngine_h
+
+#include <MitkCoreExports.h>
+#include <mitkPixelType.h>
+#include <mitkTimeGeometry.h>
+
+namespace mitk
+{
+  class Image;
+  class PlaneGeometry;
+
+  /** \brief Samples an arbitrarily oriented plane from a volume of an image.
+   *
+   * The output rows are distributed across the threads of an itk::MultiThreader.
+   * For each row, the range of pixels within the input volume is determined in
+   * advance, so that the sampling loops run without bounds checks or virtual calls
+   * and can be vectorized by the compiler. Pixels outside of the input volume are
+   * set to the background value.
+   *
+   * Images of all scalar component types with an arbitrary number of components
+   * are supported. Components are interpolated independently.
+   *
+   * The output geometry has to be an image geometry, i.e., its origin is the center
+   * of the first output pixel. The output buffer is expected to hold
+   * GetExtent(0) * GetExtent(1) pixels of the input pixel type.
+   */
+  class MITKCORE_EXPORT ResliceEngine
+  {
+  public:
+    enum Interpolator
+    {
+      NearestNeighbor,
+      Linear,
+      /** Cubic convolution (Catmull-Rom), as used by vtkImageReslice. */
+      Cubic
+    };
+
+    ResliceEngine();
+
+    Interpolator GetInterpolator() const;
+    void SetInterpolator(Interpolator interpolator);
+
+    /** \brief Value of output pixels outside of the input volume. It is clamped to the range of the pixel type.
+     *
+     * Defaults to the lowest possible pixel value.
+     */
+    double GetBackgroundValue() const;
+    void SetBackgroundValue(double backgroundValue);
+
+    /** \brief Number of threads used for reslicing. 0 (default) means the global default of ITK. */
+    unsigned int GetNumberOfThreads() const;
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+
+    static bool IsPixelTypeSupported(const PixelType &pixelType);
+
+    /** \brief Samples \a outputGeometry from volume \a timeStep of \a image into \a outputBuffer.
+     *
+     * \throw mitk::Exception if the pixel type of \a image is not supported.
+     */
+    void Reslice(const Image *image,
+                 TimeStepType timeStep,
+                 const PlaneGeometry *outputGeometry,
+                 void *outputBuffer) const;
+
+  private:
+    Interpolator m_Interpolator;
+    double m_BackgroundValue;
+    unsigned int m_NumberOfThreads;
+  };
+}
+
+#endif
@@ -15,8 +15,11 @@ found in the LICENSE file.
 
 #include "itkVectorContainer.h"
 #include "mitkDataStorage.h"
+#include "mitkDataStorageIndex.h"
 #include "mitkMessage.h"
 #include <map>
+#include <set>
+#include <shared_mutex>
 
 namespace mitk
 {
@@ -86,10 +89,33 @@ namespace mitk
     //##Documentation
     //## @brief returns a set of all data objects that are stored in the data storage
     //##
+    //## The returned set is an immutable snapshot that is shared by all callers until the next
+    //## Add() or Remove(). It is never modified, so it can be iterated without holding any lock
+    //## while other threads add or remove nodes.
     SetOfObjects::ConstPointer GetAll() const override;
 
-    /*ITK Mutex */
-    mutable itk::SimpleFastMutexLock m_Mutex;
+    //##Documentation
+    //## @brief returns a set of data objects that meet the given condition(s)
+    //##
+    //## Conditions on the data type, the data UID and the values of indexed properties
+    //## (see AddIndexedPropertyKey()) as well as conjunctions and disjunctions of them are
+    //## answered by a DataStorageIndex. Only the candidate nodes of the index are checked
+    //## against the condition. All other conditions are checked for all nodes.
+    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const override;
+
+    //##Documentation
+    //## @brief Indexes the values of the property with the given key for GetSubset() queries.
+    //##
+    //## The "name" property is always indexed.
+    void AddIndexedPropertyKey(const std::string &propertyKey);
+    std::set<std::string> GetIndexedPropertyKeys() const;
+
+    //##Documentation
+    //## @brief Guards the relations, the snapshot and the index.
+    //##
+    //## Queries share the lock, so concurrent readers (e.g. background workers) do not serialize
+    //## against each other. Add(), Remove() and AddIndexedPropertyKey() lock it exclusively.
+    mutable std::shared_timed_mutex m_Mutex;
 
   protected:
     //##Documentation
@@ -114,6 +140,10 @@ namespace mitk
     //## @brief deletes all references to a node in a given relation (used in Remove() and TreeListener)
     void RemoveFromRelation(const mitk::DataNode *node, AdjacencyList &relation);
 
+    //##Documentation
+    //## @brief Replaces m_Snapshot by a new set of all nodes. m_Mutex has to be locked exclusively.
+    void UpdateSnapshot();
+
     //##Documentation
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
@@ -124,6 +154,15 @@ namespace mitk
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+    //##Documentation
+    //## @brief Secondary indices of the nodes for GetSubset(), guarded by m_Mutex
+    //##
+    //## Declared after the adjacency lists, so it is destroyed first and removes its observers from the nodes
+    //## and their properties while the adjacency lists still keep the nodes alive.
+    mutable DataStorageIndex m_Index;
+    //##Documentation
+    //## @brief Copy-on-write set of all nodes returned by GetAll(), replaced by Add() and Remove()
+    SetOfObjects::ConstPointer m_Snapshot;
   };
 } // namespace mitk
 #endif /* MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_ */
@@ -71,6 +71,20 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     virtual void SetUndoLimit(std::size_t limit) = 0;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes.
+    //## If the value is 0 that means that there is no limit.
+    virtual std::size_t GetUndoMemoryLimit() const = 0;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history in bytes.
+    //## If the memory of the items on the undo stack (see UndoStackItem::GetMemorySize())
+    //## exceeds the limit, the oldest undo items will be dropped from the bottom of the
+    //## undo stack. The most recent item is always kept.
+    //## The 0 value means that there is no limit.
+    //## @param limit the maximum number of bytes of the items on the stack
+    virtual void SetUndoMemoryLimit(std::size_t limit) = 0;
+
     //##Documentation
     //## @brief returns the ObjectEventId of the
     //## top Element in the OperationHistory of the selected
@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include <vtkImageExtractComponents.h>
 #include <vtkLinearTransform.h>
 
+#include <cmath>
+
 mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(0), m_XMax(0), m_YMin(0), m_YMax(0)
 {
   if (reslicer == nullptr)
@@ -45,6 +47,7 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   m_VtkOutputRequested = false;
   m_BackgroundLevel = -32768.0;
   m_Component = 0;
+  m_MaximumNumberOfOutputPixels = 0;
 }
 
 mitk::ExtractSliceFilter::~ExtractSliceFilter()
@@ -139,6 +142,14 @@ void mitk::ExtractSliceFilter::GenerateOutputInformation()
   right.Normalize();
   bottom.Normalize();
 
+  // resample with a coarser spacing if the slice would consist of too many pixels
+  if (0 != m_MaximumNumberOfOutputPixels && extent[0] * extent[1] > m_MaximumNumberOfOutputPixels)
+  {
+    const double factor = std::sqrt(extent[0] * extent[1] / m_MaximumNumberOfOutputPixels);
+    extent[0] /= factor;
+    extent[1] /= factor;
+  }
+
   m_OutPutSpacing[0] = widthInMM / extent[0];
   m_OutPutSpacing[1] = heightInMM / extent[1];
 
@@ -14,11 +14,13 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkResliceEngine.h>
 
 #include <itkBSplineInterpolateImageFunction.h>
-#include <itkLinearInterpolateImageFunction.h>
-#include <itkNearestNeighborInterpolateImageFunction.h>
+#include <itkMultiThreader.h>
 
+#include <algorithm>
+#include <functional>
 #include <limits>
 
 struct mitk::ExtractSliceFilter2::Impl
@@ -28,11 +30,15 @@ struct mitk::ExtractSliceFilter2::Impl
 
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
-  itk::Object::Pointer InterpolateImageFunction;
+
+  // the B-spline coefficients of the input are computed on the first cubic update only
+  itk::Object::Pointer BSplineInterpolateImageFunction;
+  itk::ModifiedTimeType BSplineInterpolateImageFunctionTime;
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    BSplineInterpolateImageFunctionTime(0)
 {
 }
 
@@ -42,43 +48,63 @@ mitk::ExtractSliceFilter2::Impl::~Impl()
 
 namespace
 {
-  template <class TInputImage>
-  void CreateInterpolateImageFunction(const TInputImage* inputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object::Pointer& result)
+  mitk::ResliceEngine::Interpolator ToResliceEngineInterpolator(mitk::ExtractSliceFilter2::Interpolator interpolator)
   {
-    typename itk::InterpolateImageFunction<TInputImage>::Pointer interpolateImageFunction;
-
     switch (interpolator)
     {
       case mitk::ExtractSliceFilter2::NearestNeighbor:
-        interpolateImageFunction = itk::NearestNeighborInterpolateImageFunction<TInputImage>::New().GetPointer();
-        break;
+        return mitk::ResliceEngine::NearestNeighbor;
 
       case mitk::ExtractSliceFilter2::Linear:
-        interpolateImageFunction = itk::LinearInterpolateImageFunction<TInputImage>::New().GetPointer();
-        break;
+        return mitk::ResliceEngine::Linear;
 
       case mitk::ExtractSliceFilter2::Cubic:
-      {
-        auto bSplineInterpolateImageFunction = itk::BSplineInterpolateImageFunction<TInputImage>::New();
-        bSplineInterpolateImageFunction->SetSplineOrder(2);
-        interpolateImageFunction = bSplineInterpolateImageFunction.GetPointer();
-        break;
-      }
+        return mitk::ResliceEngine::Cubic;
 
       default:
         mitkThrow() << "Interplator is unknown.";
     }
+  }
 
-    interpolateImageFunction->SetInputImage(inputImage);
+  /** Cubic interpolation of single component images keeps the second order B-spline of ITK that this filter has
+      always used, since switching the kernel would change the slices of existing users. */
+  bool UseBSpline(const mitk::Image* inputImage, mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    return mitk::ExtractSliceFilter2::Cubic == interpolator && 1 == inputImage->GetPixelType().GetNumberOfComponents();
+  }
+
+  template <class TInputImage>
+  void CreateBSplineInterpolateImageFunction(const TInputImage* inputImage, itk::Object::Pointer& result)
+  {
+    auto bSplineInterpolateImageFunction = itk::BSplineInterpolateImageFunction<TInputImage>::New();
+    bSplineInterpolateImageFunction->SetSplineOrder(2);
+    bSplineInterpolateImageFunction->SetInputImage(inputImage);
 
-    result = interpolateImageFunction.GetPointer();
+    result = bSplineInterpolateImageFunction.GetPointer();
+  }
+
+  struct RowThreaderData
+  {
+    std::size_t NumberOfRows;
+    const std::function<void(std::size_t)>* RowFunction;
+  };
+
+  ITK_THREAD_RETURN_TYPE RowThreaderCallback(void* arg)
+  {
+    auto* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+    auto* data = static_cast<RowThreaderData*>(info->UserData);
+
+    for (std::size_t y = info->ThreadID; y < data->NumberOfRows; y += info->NumberOfThreads)
+      (*data->RowFunction)(y);
+
+    return ITK_THREAD_RETURN_VALUE;
   }
 
   template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  void GenerateDataWithBSpline(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, itk::Object* interpolateImageFunction, unsigned int numberOfThreads)
   {
     typedef itk::Image<TPixel, VImageDimension> TInputImage;
-    typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
+    typedef itk::BSplineInterpolateImageFunction<TInputImage> TInterpolateImageFunction;
 
     auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
     auto interpolator = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
@@ -94,42 +120,38 @@ namespace
     auto spacingAlongXDirection = xDirection * spacing[0];
     auto spacingAlongYDirection = yDirection * spacing[1];
 
-    const std::size_t pixelSize = outputImage->GetPixelType().GetSize();
     const std::size_t width = outputGeometry->GetExtent(0);
-    const std::size_t xBegin = outputRegion.GetIndex(0);
-    const std::size_t yBegin = outputRegion.GetIndex(1);
-    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
-    const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
+    const std::size_t height = outputGeometry->GetExtent(1);
 
     mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
-    auto data = static_cast<char*>(writeAccess.GetData());
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
 
     const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
-    TPixel pixel;
 
-    itk::ContinuousIndex<mitk::ScalarType, 3> index;
-    mitk::Point3D yPoint;
-    mitk::Point3D point;
+    // the evaluation at a continuous index of itk::BSplineInterpolateImageFunction is thread-safe
+    const std::function<void(std::size_t)> rowFunction = [&](std::size_t y) {
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
+      mitk::Point3D point;
+      const mitk::Point3D yPoint = origin + spacingAlongYDirection * y;
 
-    for (std::size_t y = yBegin; y < yEnd; ++y)
-    {
-      yPoint = origin + spacingAlongYDirection * y;
-
-      for (std::size_t x = xBegin; x < xEnd; ++x)
+      for (std::size_t x = 0; x < width; ++x)
       {
         point = yPoint + spacingAlongXDirection * x;
 
-        if (inputImage->TransformPhysicalPointToContinuousIndex(point, index))
-        {
-          pixel = interpolator->EvaluateAtContinuousIndex(index);
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&pixel), pixelSize);
-        }
-        else
-        {
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&backgroundPixel), pixelSize);
-        }
+        data[width * y + x] = inputImage->TransformPhysicalPointToContinuousIndex(point, index)
+          ? static_cast<TPixel>(interpolator->EvaluateAtContinuousIndex(index))
+          : backgroundPixel;
       }
-    }
+    };
+
+    RowThreaderData threaderData;
+    threaderData.NumberOfRows = height;
+    threaderData.RowFunction = &rowFunction;
+
+    auto threader = itk::MultiThreader::New();
+    threader->SetNumberOfThreads(std::max(1u, std::min(numberOfThreads, static_cast<unsigned int>(height))));
+    threader->SetSingleMethod(RowThreaderCallback, &threaderData);
+    threader->SingleMethodExecute();
   }
 
   void VerifyInputImage(const mitk::Image* inputImage)
@@ -152,6 +174,9 @@ namespace
 
     if (!geometry->GetImageGeometry())
       mitkThrow() << "Geometry of input image is not an image geometry.";
+
+    if (!mitk::ResliceEngine::IsPixelTypeSupported(inputImage->GetPixelType()))
+      mitkThrow() << "Pixel type " << inputImage->GetPixelType().GetTypeAsString() << " is not supported.";
   }
 
   void VerifyOutputGeometry(const mitk::PlaneGeometry* outputGeometry)
@@ -196,34 +221,31 @@ void mitk::ExtractSliceFilter2::AllocateOutputs()
   }
 }
 
-/*void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
+void mitk::ExtractSliceFilter2::GenerateData()
 {
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
+  this->AllocateOutputs();
 
+  auto outputImage = this->GetOutput();
   const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
-}
 
-void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
-{
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegionForThread, m_Impl->InterpolateImageFunction);
-}*/
+  if (UseBSpline(inputImage, this->GetInterpolator()))
+  {
+    if (m_Impl->BSplineInterpolateImageFunction.IsNull() || m_Impl->BSplineInterpolateImageFunctionTime < inputImage->GetMTime())
+    {
+      AccessFixedDimensionByItk_1(inputImage, CreateBSplineInterpolateImageFunction, 3, m_Impl->BSplineInterpolateImageFunction);
+      m_Impl->BSplineInterpolateImageFunctionTime = inputImage->GetMTime();
+    }
 
-void mitk::ExtractSliceFilter2::GenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
+    AccessFixedDimensionByItk_3(inputImage, GenerateDataWithBSpline, 3, outputImage, m_Impl->BSplineInterpolateImageFunction.GetPointer(), this->GetNumberOfThreads());
     return;
+  }
 
-  const auto* inputImage = this->GetInput();
-
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
-
-  this->AllocateOutputs();
-  auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
+  ResliceEngine engine;
+  engine.SetInterpolator(ToResliceEngineInterpolator(this->GetInterpolator()));
+  engine.SetNumberOfThreads(this->GetNumberOfThreads());
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+  ImageWriteAccessor writeAccess(outputImage, nullptr, ImageAccessorBase::IgnoreLock);
+  engine.Reslice(inputImage, 0, outputImage->GetSlicedGeometry()->GetPlaneGeometry(0), writeAccess.GetData());
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
@@ -232,7 +254,7 @@ void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
     return;
 
   Superclass::SetInput(image);
-  m_Impl->InterpolateImageFunction = nullptr;
+  m_Impl->BSplineInterpolateImageFunction = nullptr;
 }
 
 void mitk::ExtractSliceFilter2::SetInput(unsigned int index, const InputImageType* image)
@@ -267,7 +289,6 @@ void mitk::ExtractSliceFilter2::SetInterpolator(Interpolator interpolator)
   if (m_Impl->Interpolator != interpolator)
   {
     m_Impl->Interpolator = interpolator;
-    m_Impl->InterpolateImageFunction = nullptr;
     this->Modified();
   }
 }
@@ -0,0 +1,94 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkParallelFor.h>
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace
+{
+  struct ParallelForData
+  {
+    std::size_t NumberOfItems;
+    std::atomic<std::size_t> NextItem;
+    const std::function<void(std::size_t, unsigned int)> *Function;
+    std::mutex ExceptionMutex;
+    std::exception_ptr Exception;
+  };
+
+  void ProcessNextItems(ParallelForData &data, unsigned int thread)
+  {
+    try
+    {
+      for (auto i = data.NextItem++; i < data.NumberOfItems; i = data.NextItem++)
+        (*data.Function)(i, thread);
+    }
+    catch (...)
+    {
+      // let the other threads stop after their current item
+      data.NextItem = data.NumberOfItems;
+
+      std::lock_guard<std::mutex> lock(data.ExceptionMutex);
+      if (nullptr == data.Exception)
+        data.Exception = std::current_exception();
+    }
+  }
+
+  ITK_THREAD_RETURN_TYPE ParallelForThreaderCallback(void *arg)
+  {
+    auto *info = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    ProcessNextItems(*static_cast<ParallelForData *>(info->UserData), info->ThreadID);
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+}
+
+unsigned int mitk::GetParallelForNumberOfThreads(std::size_t numberOfItems)
+{
+  return static_cast<unsigned int>(std::max<std::size_t>(
+    1, std::min<std::size_t>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), numberOfItems)));
+}
+
+void mitk::ParallelFor(std::size_t numberOfItems, const std::function<void(std::size_t, unsigned int)> &function)
+{
+  ParallelForData data;
+  data.NumberOfItems = numberOfItems;
+  data.NextItem = 0;
+  data.Function = &function;
+
+  const auto numberOfThreads = GetParallelForNumberOfThreads(numberOfItems);
+
+  if (numberOfThreads <= 1)
+  {
+    ProcessNextItems(data, 0);
+  }
+  else
+  {
+    auto threader = itk::MultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(ParallelForThreaderCallback, &data);
+    threader->SingleMethodExecute();
+  }
+
+  if (nullptr != data.Exception)
+    std::rethrow_exception(data.Exception);
+}
+
+void mitk::ParallelFor(std::size_t numberOfItems, const std::function<void(std::size_t)> &function)
+{
+  ParallelFor(numberOfItems, [&function](std::size_t item, unsigned int) { function(item); });
+}
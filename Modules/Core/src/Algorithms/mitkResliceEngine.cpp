@@ -0,0 +1,479 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkResliceEngine.h>
+#include <mitkExceptionMacro.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkImageIOBase.h>
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+  struct ResliceParameters
+  {
+    const void *Input;
+    void *Output;
+    std::size_t Dimensions[3];
+    std::size_t NumberOfComponents;
+    std::size_t Width;
+    std::size_t Height;
+    double Origin[3];
+    double XStep[3];
+    double YStep[3];
+    double BackgroundValue;
+    mitk::ResliceEngine::Interpolator Interpolator;
+  };
+
+  template <typename T>
+  inline typename std::enable_if<std::is_integral<T>::value, T>::type ConvertValue(double value)
+  {
+    if (value <= static_cast<double>(std::numeric_limits<T>::lowest()))
+      return std::numeric_limits<T>::lowest();
+
+    if (value >= static_cast<double>(std::numeric_limits<T>::max()))
+      return std::numeric_limits<T>::max();
+
+    // truncated like the implicit conversion of the interpolate image functions of ITK, to keep existing slices
+    return static_cast<T>(value);
+  }
+
+  template <typename T>
+  inline typename std::enable_if<std::is_floating_point<T>::value, T>::type ConvertValue(double value)
+  {
+    return static_cast<T>(std::max(std::min(value, static_cast<double>(std::numeric_limits<T>::max())),
+                                   static_cast<double>(std::numeric_limits<T>::lowest())));
+  }
+
+  /** Continuous indices within [-0.5, dimension - 0.5) are inside, like in ITK. */
+  inline bool IsInside(const ResliceParameters &p, const double *rowOrigin, std::size_t x)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const double index = rowOrigin[i] + x * p.XStep[i];
+      if (!(index >= -0.5 && index < p.Dimensions[i] - 0.5))
+        return false;
+    }
+
+    return true;
+  }
+
+  /** Determines the range [xBegin, xEnd) of pixels of a row that are inside of the input volume. */
+  void GetInsideRange(const ResliceParameters &p, const double *rowOrigin, std::size_t &xBegin, std::size_t &xEnd)
+  {
+    double lower = 0.0;
+    double upper = static_cast<double>(p.Width);
+
+    for (int i = 0; i < 3 && lower < upper; ++i)
+    {
+      const double low = -0.5 - rowOrigin[i];
+      const double high = p.Dimensions[i] - 0.5 - rowOrigin[i];
+      const double step = p.XStep[i];
+
+      if (step > 0.0)
+      {
+        lower = std::max(lower, low / step);
+        upper = std::min(upper, high / step);
+      }
+      else if (step < 0.0)
+      {
+        lower = std::max(lower, high / step);
+        upper = std::min(upper, low / step);
+      }
+      else if (low > 0.0 || high <= 0.0)
+      {
+        upper = lower;
+      }
+    }
+
+    if (!(lower < upper))
+    {
+      xBegin = xEnd = 0;
+      return;
+    }
+
+    xBegin = static_cast<std::size_t>(std::ceil(lower));
+    xEnd = std::min(p.Width, static_cast<std::size_t>(std::ceil(upper)));
+
+    // The estimate may be off by one due to rounding, so verify it with the exact
+    // predicate. Since the row is a line, all pixels between inside pixels are inside.
+    while (xBegin < xEnd && !IsInside(p, rowOrigin, xBegin))
+      ++xBegin;
+
+    while (xEnd > xBegin && !IsInside(p, rowOrigin, xEnd - 1))
+      --xEnd;
+
+    if (xBegin == xEnd)
+    {
+      xBegin = xEnd = 0;
+      return;
+    }
+
+    while (xBegin > 0 && IsInside(p, rowOrigin, xBegin - 1))
+      --xBegin;
+
+    while (xEnd < p.Width && IsInside(p, rowOrigin, xEnd))
+      ++xEnd;
+  }
+
+  template <typename T>
+  void SampleNearestNeighbor(
+    const ResliceParameters &p, const double *rowOrigin, std::size_t xBegin, std::size_t xEnd, T *output)
+  {
+    const auto *input = static_cast<const T *>(p.Input);
+    const std::size_t components = p.NumberOfComponents;
+    const std::size_t strideY = p.Dimensions[0];
+    const std::size_t strideZ = p.Dimensions[0] * p.Dimensions[1];
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+    {
+      // indices are within [-0.5, dimension - 0.5), so truncation rounds half up
+      const auto ix = static_cast<std::size_t>(rowOrigin[0] + x * p.XStep[0] + 0.5);
+      const auto iy = static_cast<std::size_t>(rowOrigin[1] + x * p.XStep[1] + 0.5);
+      const auto iz = static_cast<std::size_t>(rowOrigin[2] + x * p.XStep[2] + 0.5);
+
+      const T *source = input + (iz * strideZ + iy * strideY + ix) * components;
+      T *target = output + x * components;
+
+      for (std::size_t c = 0; c < components; ++c)
+        target[c] = source[c];
+    }
+  }
+
+  template <typename T>
+  void SampleLinear(
+    const ResliceParameters &p, const double *rowOrigin, std::size_t xBegin, std::size_t xEnd, T *output)
+  {
+    const auto *input = static_cast<const T *>(p.Input);
+    const std::size_t components = p.NumberOfComponents;
+
+    // Samples between the outermost voxel centers and the volume border repeat the border voxels
+    double maxIndex[3];
+    std::size_t maxBase[3];
+    std::size_t offset[3];
+    const std::size_t stride[3] = {components, components * p.Dimensions[0], components * p.Dimensions[0] * p.Dimensions[1]};
+
+    for (int i = 0; i < 3; ++i)
+    {
+      maxIndex[i] = static_cast<double>(p.Dimensions[i] - 1);
+      maxBase[i] = p.Dimensions[i] > 1 ? p.Dimensions[i] - 2 : 0;
+      offset[i] = p.Dimensions[i] > 1 ? stride[i] : 0;
+    }
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+    {
+      std::size_t base = 0;
+      double w[3];
+
+      for (int i = 0; i < 3; ++i)
+      {
+        const double index = std::min(std::max(rowOrigin[i] + x * p.XStep[i], 0.0), maxIndex[i]);
+        const std::size_t b = std::min(static_cast<std::size_t>(index), maxBase[i]);
+        w[i] = index - b;
+        base += b * stride[i];
+      }
+
+      const T *source = input + base;
+      T *target = output + x * components;
+
+      for (std::size_t c = 0; c < components; ++c)
+      {
+        const T *s = source + c;
+        const double v00 = s[0] + w[0] * (static_cast<double>(s[offset[0]]) - s[0]);
+        const double v10 = s[offset[1]] + w[0] * (static_cast<double>(s[offset[1] + offset[0]]) - s[offset[1]]);
+        const double v01 = s[offset[2]] + w[0] * (static_cast<double>(s[offset[2] + offset[0]]) - s[offset[2]]);
+        const double v11 = s[offset[2] + offset[1]] +
+                           w[0] * (static_cast<double>(s[offset[2] + offset[1] + offset[0]]) - s[offset[2] + offset[1]]);
+        const double v0 = v00 + w[1] * (v10 - v00);
+        const double v1 = v01 + w[1] * (v11 - v01);
+
+        target[c] = ConvertValue<T>(v0 + w[2] * (v1 - v0));
+      }
+    }
+  }
+
+  /** Weights of the Catmull-Rom spline at the offsets -1, 0, 1 and 2. */
+  inline void GetCubicWeights(double f, double *w)
+  {
+    w[0] = ((-0.5 * f + 1.0) * f - 0.5) * f;
+    w[1] = (1.5 * f - 2.5) * f * f + 1.0;
+    w[2] = ((-1.5 * f + 2.0) * f + 0.5) * f;
+    w[3] = (0.5 * f - 0.5) * f * f;
+  }
+
+  template <typename T>
+  void SampleCubic(
+    const ResliceParameters &p, const double *rowOrigin, std::size_t xBegin, std::size_t xEnd, T *output)
+  {
+    const auto *input = static_cast<const T *>(p.Input);
+    const std::size_t components = p.NumberOfComponents;
+    const std::size_t stride[3] = {components, components * p.Dimensions[0], components * p.Dimensions[0] * p.Dimensions[1]};
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+    {
+      std::size_t offsets[3][4];
+      double weights[3][4];
+
+      for (int i = 0; i < 3; ++i)
+      {
+        const auto last = static_cast<long>(p.Dimensions[i]) - 1;
+        const double index = std::min(std::max(rowOrigin[i] + x * p.XStep[i], 0.0), static_cast<double>(last));
+        const auto base = static_cast<long>(index);
+
+        GetCubicWeights(index - base, weights[i]);
+
+        // taps outside of the volume repeat the border voxels
+        for (long j = 0; j < 4; ++j)
+          offsets[i][j] = static_cast<std::size_t>(std::min(std::max(base + j - 1, 0L), last)) * stride[i];
+      }
+
+      T *target = output + x * components;
+
+      for (std::size_t c = 0; c < components; ++c)
+      {
+        const T *source = input + c;
+        double value = 0.0;
+
+        for (int k = 0; k < 4; ++k)
+        {
+          double plane = 0.0;
+
+          for (int j = 0; j < 4; ++j)
+          {
+            const T *row = source + offsets[2][k] + offsets[1][j];
+            plane += weights[1][j] * (weights[0][0] * row[offsets[0][0]] + weights[0][1] * row[offsets[0][1]] +
+                                      weights[0][2] * row[offsets[0][2]] + weights[0][3] * row[offsets[0][3]]);
+          }
+
+          value += weights[2][k] * plane;
+        }
+
+        target[c] = ConvertValue<T>(value);
+      }
+    }
+  }
+
+  template <typename T>
+  void ResliceRows(const ResliceParameters &p, std::size_t yBegin, std::size_t yEnd)
+  {
+    const T background = ConvertValue<T>(p.BackgroundValue);
+    const std::size_t rowSize = p.Width * p.NumberOfComponents;
+
+    for (std::size_t y = yBegin; y < yEnd; ++y)
+    {
+      double rowOrigin[3];
+      for (int i = 0; i < 3; ++i)
+        rowOrigin[i] = p.Origin[i] + y * p.YStep[i];
+
+      std::size_t xBegin;
+      std::size_t xEnd;
+      GetInsideRange(p, rowOrigin, xBegin, xEnd);
+
+      T *output = static_cast<T *>(p.Output) + y * rowSize;
+      std::fill(output, output + xBegin * p.NumberOfComponents, background);
+      std::fill(output + xEnd * p.NumberOfComponents, output + rowSize, background);
+
+      switch (p.Interpolator)
+      {
+        case mitk::ResliceEngine::Linear:
+          SampleLinear(p, rowOrigin, xBegin, xEnd, output);
+          break;
+
+        case mitk::ResliceEngine::Cubic:
+          SampleCubic(p, rowOrigin, xBegin, xEnd, output);
+          break;
+
+        default:
+          SampleNearestNeighbor(p, rowOrigin, xBegin, xEnd, output);
+          break;
+      }
+    }
+  }
+
+  typedef void (*ResliceRowsFunction)(const ResliceParameters &, std::size_t, std::size_t);
+
+  ResliceRowsFunction GetResliceRowsFunction(int componentType)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        return &ResliceRows<unsigned char>;
+      case itk::ImageIOBase::CHAR:
+        return &ResliceRows<char>;
+      case itk::ImageIOBase::USHORT:
+        return &ResliceRows<unsigned short>;
+      case itk::ImageIOBase::SHORT:
+        return &ResliceRows<short>;
+      case itk::ImageIOBase::UINT:
+        return &ResliceRows<unsigned int>;
+      case itk::ImageIOBase::INT:
+        return &ResliceRows<int>;
+      case itk::ImageIOBase::ULONG:
+        return &ResliceRows<unsigned long>;
+      case itk::ImageIOBase::LONG:
+        return &ResliceRows<long>;
+      case itk::ImageIOBase::FLOAT:
+        return &ResliceRows<float>;
+      case itk::ImageIOBase::DOUBLE:
+        return &ResliceRows<double>;
+      default:
+        return nullptr;
+    }
+  }
+
+  struct ThreadData
+  {
+    const ResliceParameters *Parameters;
+    ResliceRowsFunction Function;
+  };
+
+  ITK_THREAD_RETURN_TYPE ResliceThreaderCallback(void *arg)
+  {
+    auto *info = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    const auto *data = static_cast<const ThreadData *>(info->UserData);
+    const std::size_t height = data->Parameters->Height;
+
+    const std::size_t yBegin = height * info->ThreadID / info->NumberOfThreads;
+    const std::size_t yEnd = height * (info->ThreadID + 1) / info->NumberOfThreads;
+
+    if (yBegin < yEnd)
+      data->Function(*data->Parameters, yBegin, yEnd);
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+}
+
+mitk::ResliceEngine::ResliceEngine()
+  : m_Interpolator(NearestNeighbor),
+    m_BackgroundValue(std::numeric_limits<double>::lowest()),
+    m_NumberOfThreads(0)
+{
+}
+
+mitk::ResliceEngine::Interpolator mitk::ResliceEngine::GetInterpolator() const
+{
+  return m_Interpolator;
+}
+
+void mitk::ResliceEngine::SetInterpolator(Interpolator interpolator)
+{
+  m_Interpolator = interpolator;
+}
+
+double mitk::ResliceEngine::GetBackgroundValue() const
+{
+  return m_BackgroundValue;
+}
+
+void mitk::ResliceEngine::SetBackgroundValue(double backgroundValue)
+{
+  m_BackgroundValue = backgroundValue;
+}
+
+unsigned int mitk::ResliceEngine::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+void mitk::ResliceEngine::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+bool mitk::ResliceEngine::IsPixelTypeSupported(const PixelType &pixelType)
+{
+  return nullptr != GetResliceRowsFunction(pixelType.GetComponentType());
+}
+
+void mitk::ResliceEngine::Reslice(const Image *image,
+                                  TimeStepType timeStep,
+                                  const PlaneGeometry *outputGeometry,
+                                  void *outputBuffer) const
+{
+  if (nullptr == image || nullptr == outputGeometry || nullptr == outputBuffer)
+    mitkThrow() << "Input image, output geometry and output buffer must be set.";
+
+  const auto pixelType = image->GetPixelType();
+  auto function = GetResliceRowsFunction(pixelType.GetComponentType());
+
+  if (nullptr == function)
+    mitkThrow() << "Pixel type " << pixelType.GetTypeAsString() << " is not supported.";
+
+  ResliceParameters p;
+  p.Output = outputBuffer;
+  p.NumberOfComponents = pixelType.GetNumberOfComponents();
+  p.Width = static_cast<std::size_t>(outputGeometry->GetExtent(0));
+  p.Height = static_cast<std::size_t>(outputGeometry->GetExtent(1));
+  p.BackgroundValue = m_BackgroundValue;
+  p.Interpolator = m_Interpolator;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    p.Dimensions[i] = image->GetDimension() > i ? image->GetDimension(i) : 1;
+
+  // Transform the output plane into the continuous index space of the input
+  // volume once, so that sampling does not involve any further transformations.
+  auto inputGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+
+  if (inputGeometry.IsNull())
+    mitkThrow() << "Input image has no geometry for time step " << timeStep << ".";
+
+  const auto spacing = outputGeometry->GetSpacing();
+  auto xDirection = outputGeometry->GetAxisVector(0);
+  auto yDirection = outputGeometry->GetAxisVector(1);
+
+  xDirection.Normalize();
+  yDirection.Normalize();
+
+  Point3D origin;
+  Vector3D xStep;
+  Vector3D yStep;
+
+  inputGeometry->WorldToIndex(outputGeometry->GetOrigin(), origin);
+  inputGeometry->WorldToIndex(xDirection * spacing[0], xStep);
+  inputGeometry->WorldToIndex(yDirection * spacing[1], yStep);
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    p.Origin[i] = origin[i];
+    p.XStep[i] = xStep[i];
+    p.YStep[i] = yStep[i];
+  }
+
+  ImageReadAccessor readAccess(image, image->GetVolumeData(timeStep));
+  p.Input = readAccess.GetData();
+
+  ThreadData data;
+  data.Parameters = &p;
+  data.Function = function;
+
+  unsigned int numberOfThreads =
+    0 != m_NumberOfThreads ? m_NumberOfThreads : itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, p.Height)));
+
+  if (1 == numberOfThreads)
+  {
+    function(p, 0, p.Height);
+    return;
+  }
+
+  auto threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(ResliceThreaderCallback, &data);
+  threader->SingleMethodExecute();
+}
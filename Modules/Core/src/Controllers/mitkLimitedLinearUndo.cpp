@@ -14,7 +14,7 @@ found in the LICENSE file.
 #include <mitkRenderingManager.h>
 
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_UndoMemoryLimit(0)
 {
   // nothing to do
 }
@@ -49,13 +49,8 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     InvokeEvent(RedoEmptyEvent());
   }
 
-  if (0 != m_UndoLimit && m_UndoList.size() == m_UndoLimit)
-  {
-    auto item = m_UndoList.front();
-    m_UndoList.pop_front();
-    delete item;
-  }
   m_UndoList.push_back(operationEvent);
+  this->EnforceUndoLimits();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -182,11 +177,55 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
-    {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
-    }
     m_UndoLimit = undoLimit;
+    this->EnforceUndoLimits();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetUndoMemoryLimit() const
+{
+  return m_UndoMemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetUndoMemoryLimit(std::size_t undoMemoryLimit)
+{
+  if (undoMemoryLimit != m_UndoMemoryLimit)
+  {
+    m_UndoMemoryLimit = undoMemoryLimit;
+    this->EnforceUndoLimits();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetUndoMemorySize() const
+{
+  std::size_t memorySize = 0;
+
+  for (const auto item : m_UndoList)
+    memorySize += item->GetMemorySize();
+
+  return memorySize;
+}
+
+void mitk::LimitedLinearUndo::EnforceUndoLimits()
+{
+  while (0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit)
+  {
+    auto item = m_UndoList.front();
+    m_UndoList.pop_front();
+    delete item;
+  }
+
+  if (0 == m_UndoMemoryLimit)
+    return;
+
+  std::size_t memorySize = this->GetUndoMemorySize();
+
+  while (memorySize > m_UndoMemoryLimit && m_UndoList.size() > 1)
+  {
+    auto item = m_UndoList.front();
+    memorySize -= item->GetMemorySize();
+    m_UndoList.pop_front();
+    delete item;
   }
 }
 
@@ -72,6 +72,11 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return 0;
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -79,6 +84,19 @@ mitk::Operation *mitk::OperationEvent::GetOperation()
   return m_Operation;
 }
 
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t memorySize = 0;
+
+  if (nullptr != m_Operation)
+    memorySize += m_Operation->GetMemorySize();
+
+  if (nullptr != m_UndoOperation)
+    memorySize += m_UndoOperation->GetMemorySize();
+
+  return memorySize;
+}
+
 mitk::OperationEvent::OperationEvent(OperationActor *destination,
                                      Operation *operation,
                                      Operation *undoOperation,
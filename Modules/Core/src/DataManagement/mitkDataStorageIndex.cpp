@@ -0,0 +1,348 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDataStorageIndex.h"
+
+#include "mitkBaseData.h"
+#include "mitkDataNode.h"
+#include "mitkNodePredicateAnd.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateDataUID.h"
+#include "mitkNodePredicateOr.h"
+#include "mitkNodePredicateProperty.h"
+
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+  /** Marks a node as outdated in the index whenever the observed object (the node itself or one of its indexed
+   * properties) is modified. */
+  class MarkOutdatedCommand : public itk::Command
+  {
+  public:
+    mitkClassMacroItkParent(MarkOutdatedCommand, itk::Command);
+
+    static Pointer New(mitk::DataStorageIndex *index, const mitk::DataNode *node)
+    {
+      Pointer command = new MarkOutdatedCommand(index, node);
+      command->UnRegister();
+      return command;
+    }
+
+    void Execute(itk::Object *, const itk::EventObject &) override { m_Index->MarkOutdated(m_Node); }
+    void Execute(const itk::Object *, const itk::EventObject &) override { m_Index->MarkOutdated(m_Node); }
+
+  private:
+    MarkOutdatedCommand(mitk::DataStorageIndex *index, const mitk::DataNode *node) : m_Index(index), m_Node(node) {}
+
+    mitk::DataStorageIndex *m_Index;
+    const mitk::DataNode *m_Node;
+  };
+
+  void Insert(std::map<std::string, mitk::DataStorageIndex::NodeSetType> &index,
+              const std::string &key,
+              const mitk::DataNode *node)
+  {
+    index[key].insert(node);
+  }
+
+  void Erase(std::map<std::string, mitk::DataStorageIndex::NodeSetType> &index,
+             const std::string &key,
+             const mitk::DataNode *node)
+  {
+    auto finding = index.find(key);
+
+    if (finding != index.end())
+    {
+      finding->second.erase(node);
+
+      if (finding->second.empty())
+        index.erase(finding);
+    }
+  }
+}
+
+mitk::DataStorageIndex::DataStorageIndex()
+{
+  m_IndexedPropertyKeys.insert("name");
+}
+
+mitk::DataStorageIndex::~DataStorageIndex()
+{
+  // the nodes may outlive the data storage, so none of the commands that refer to this index must remain
+  for (auto &entry : m_Entries)
+  {
+    this->UnindexNode(entry.first, entry.second);
+    const_cast<DataNode *>(entry.first)->RemoveObserver(entry.second.NodeObserverTag);
+  }
+}
+
+void mitk::DataStorageIndex::AddNode(const DataNode *node)
+{
+  if (nullptr == node || m_Entries.find(node) != m_Entries.end())
+    return;
+
+  auto &entry = m_Entries[node];
+  entry.NodeObserverTag =
+    const_cast<DataNode *>(node)->AddObserver(itk::ModifiedEvent(), MarkOutdatedCommand::New(this, node));
+
+  this->IndexNode(node, entry);
+}
+
+void mitk::DataStorageIndex::RemoveNode(const DataNode *node)
+{
+  auto finding = m_Entries.find(node);
+
+  if (finding == m_Entries.end())
+    return;
+
+  this->UnindexNode(node, finding->second);
+  const_cast<DataNode *>(node)->RemoveObserver(finding->second.NodeObserverTag);
+  m_Entries.erase(finding);
+
+  std::lock_guard<std::mutex> lock(m_OutdatedNodesMutex);
+  m_OutdatedNodes.erase(node);
+}
+
+void mitk::DataStorageIndex::AddIndexedPropertyKey(const std::string &propertyKey)
+{
+  if (!m_IndexedPropertyKeys.insert(propertyKey).second)
+    return;
+
+  for (auto &entry : m_Entries)
+    this->IndexProperty(entry.first, propertyKey, entry.second);
+}
+
+std::set<std::string> mitk::DataStorageIndex::GetIndexedPropertyKeys() const
+{
+  return m_IndexedPropertyKeys;
+}
+
+void mitk::DataStorageIndex::MarkOutdated(const DataNode *node)
+{
+  std::lock_guard<std::mutex> lock(m_OutdatedNodesMutex);
+  m_OutdatedNodes.insert(node);
+}
+
+bool mitk::DataStorageIndex::HasOutdatedNodes() const
+{
+  std::lock_guard<std::mutex> lock(m_OutdatedNodesMutex);
+  return !m_OutdatedNodes.empty();
+}
+
+void mitk::DataStorageIndex::Update()
+{
+  NodeSetType outdatedNodes;
+
+  {
+    std::lock_guard<std::mutex> lock(m_OutdatedNodesMutex);
+    outdatedNodes.swap(m_OutdatedNodes);
+  }
+
+  for (auto node : outdatedNodes)
+  {
+    auto finding = m_Entries.find(node);
+
+    if (finding != m_Entries.end())
+    {
+      this->UnindexNode(node, finding->second);
+      this->IndexNode(node, finding->second);
+    }
+  }
+}
+
+bool mitk::DataStorageIndex::GetCandidates(const NodePredicateBase *predicate, NodeSetType &candidates) const
+{
+  candidates.clear();
+
+  if (nullptr == predicate)
+    return false;
+
+  if (auto dataTypePredicate = dynamic_cast<const NodePredicateDataType *>(predicate))
+  {
+    auto finding = m_NodesByDataType.find(dataTypePredicate->GetValidDataType());
+
+    if (finding != m_NodesByDataType.end())
+      candidates = finding->second;
+
+    return true;
+  }
+
+  if (auto uidPredicate = dynamic_cast<const NodePredicateDataUID *>(predicate))
+  {
+    auto finding = m_NodesByDataUID.find(uidPredicate->GetUID());
+
+    if (finding != m_NodesByDataUID.end())
+      candidates = finding->second;
+
+    return true;
+  }
+
+  if (auto propertyPredicate = dynamic_cast<const NodePredicateProperty *>(predicate))
+  {
+    const auto &propertyKey = propertyPredicate->GetValidPropertyName();
+
+    if (nullptr != propertyPredicate->GetRenderer() || nullptr == propertyPredicate->GetValidProperty() ||
+        m_IndexedPropertyKeys.find(propertyKey) == m_IndexedPropertyKeys.end())
+      return false;
+
+    auto values = m_NodesByPropertyValue.find(propertyKey);
+
+    if (values != m_NodesByPropertyValue.end())
+    {
+      auto finding = values->second.find(propertyPredicate->GetValidProperty()->GetValueAsString());
+
+      if (finding != values->second.end())
+        candidates = finding->second;
+    }
+
+    auto withoutProperty = m_NodesWithoutProperty.find(propertyKey);
+
+    if (withoutProperty != m_NodesWithoutProperty.end())
+      candidates.insert(withoutProperty->second.begin(), withoutProperty->second.end());
+
+    return true;
+  }
+
+  if (auto andPredicate = dynamic_cast<const NodePredicateAnd *>(predicate))
+  {
+    bool planned = false;
+    NodeSetType childCandidates;
+
+    for (const auto &childPredicate : andPredicate->GetPredicates())
+    {
+      if (!this->GetCandidates(childPredicate, childCandidates))
+        continue;
+
+      if (planned)
+      {
+        NodeSetType intersection;
+        std::set_intersection(candidates.begin(),
+                              candidates.end(),
+                              childCandidates.begin(),
+                              childCandidates.end(),
+                              std::inserter(intersection, intersection.end()));
+        candidates.swap(intersection);
+      }
+      else
+      {
+        candidates.swap(childCandidates);
+        planned = true;
+      }
+
+      if (candidates.empty())
+        break;
+    }
+
+    return planned;
+  }
+
+  if (auto orPredicate = dynamic_cast<const NodePredicateOr *>(predicate))
+  {
+    const auto childPredicates = orPredicate->GetPredicates();
+
+    if (childPredicates.empty())
+      return false;
+
+    NodeSetType childCandidates;
+
+    for (const auto &childPredicate : childPredicates)
+    {
+      if (!this->GetCandidates(childPredicate, childCandidates))
+      {
+        candidates.clear();
+        return false;
+      }
+
+      candidates.insert(childCandidates.begin(), childCandidates.end());
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+void mitk::DataStorageIndex::IndexNode(const DataNode *node, Entry &entry)
+{
+  const auto data = node->GetData();
+  entry.HasData = nullptr != data;
+
+  if (entry.HasData)
+  {
+    entry.DataType = data->GetNameOfClass();
+    entry.DataUID = data->GetUID();
+
+    Insert(m_NodesByDataType, entry.DataType, node);
+    Insert(m_NodesByDataUID, entry.DataUID, node);
+  }
+
+  for (const auto &propertyKey : m_IndexedPropertyKeys)
+    this->IndexProperty(node, propertyKey, entry);
+}
+
+void mitk::DataStorageIndex::IndexProperty(const DataNode *node, const std::string &propertyKey, Entry &entry)
+{
+  // Only the node's own renderer-independent property list is indexed. Nodes without the property are
+  // candidates for every value, because NodePredicateProperty falls back on the properties of the data.
+  auto property = node->GetPropertyList()->GetProperty(propertyKey);
+
+  if (nullptr == property)
+  {
+    m_NodesWithoutProperty[propertyKey].insert(node);
+    return;
+  }
+
+  IndexedProperty indexedProperty;
+  indexedProperty.Property = property;
+  indexedProperty.Value = property->GetValueAsString();
+  indexedProperty.ObserverTag = property->AddObserver(itk::ModifiedEvent(), MarkOutdatedCommand::New(this, node));
+
+  m_NodesByPropertyValue[propertyKey][indexedProperty.Value].insert(node);
+  entry.Properties[propertyKey] = indexedProperty;
+}
+
+void mitk::DataStorageIndex::UnindexNode(const DataNode *node, Entry &entry)
+{
+  if (entry.HasData)
+  {
+    Erase(m_NodesByDataType, entry.DataType, node);
+    Erase(m_NodesByDataUID, entry.DataUID, node);
+  }
+
+  entry.HasData = false;
+  entry.DataType.clear();
+  entry.DataUID.clear();
+
+  for (const auto &propertyKey : m_IndexedPropertyKeys)
+    Erase(m_NodesWithoutProperty, propertyKey, node);
+
+  for (auto &indexedProperty : entry.Properties)
+  {
+    indexedProperty.second.Property->RemoveObserver(indexedProperty.second.ObserverTag);
+
+    auto values = m_NodesByPropertyValue.find(indexedProperty.first);
+
+    if (values != m_NodesByPropertyValue.end())
+    {
+      Erase(values->second, indexedProperty.second.Value, node);
+
+      if (values->second.empty())
+        m_NodesByPropertyValue.erase(values);
+    }
+  }
+
+  entry.Properties.clear();
+}
@@ -56,7 +56,8 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_BackingStore(other.m_BackingStore)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -89,6 +90,12 @@ mitk::Image::Image(const Image &other)
 
 mitk::Image::~Image()
 {
+  if (m_VolumeLoader.IsNotNull())
+    m_VolumeLoader->StopBackgroundLoading();
+
+  if (m_Pyramid.IsNotNull())
+    m_Pyramid->StopBackgroundUpdate();
+
   this->Clear();
 
   m_ReferenceCount = 3;
@@ -243,8 +250,20 @@ const vtkImageData *mitk::Image::GetVtkImageData(int t, int n) const
 mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
+  this->LoadPendingVolume(t, n);
+
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
+  ImageDataItemPointer sl = GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
+
+  // a slice is a view into its volume, so the backing store keeps track of the whole time step
+  if (sl.IsNotNull() && m_BackingStore.IsNotNull())
+  {
+    const ImageDataItemPointer &vol = m_Volumes[GetVolumeIndex(t, n)];
+    if (vol.IsNotNull())
+      m_BackingStore->Touch(vol->m_Data, vol->m_Size);
+  }
+
+  return sl;
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData_unlocked(
@@ -328,8 +347,16 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData(int t,
                                                              void *data,
                                                              ImportMemoryManagementType importMemoryManagement) const
 {
+  this->LoadPendingVolume(t, n);
+
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetVolumeData_unlocked(t, n, data, importMemoryManagement);
+  ImageDataItemPointer vol = GetVolumeData_unlocked(t, n, data, importMemoryManagement);
+
+  // let the backing store know which time step is in use, so that it may page out others
+  if (vol.IsNotNull() && m_BackingStore.IsNotNull())
+    m_BackingStore->Touch(vol->m_Data, vol->m_Size);
+
+  return vol;
 }
 mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
   int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
@@ -391,7 +418,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
       // ok, let's combine the slices!
       if (vol.GetPointer() == nullptr)
       {
-        vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
+        vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true, m_BackingStore);
       }
       vol->SetComplete(true);
       size_t size = m_OffsetTable[2] * (ptypeSize);
@@ -458,6 +485,12 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData(int n,
                                                               void *data,
                                                               ImportMemoryManagementType importMemoryManagement) const
 {
+  if (m_VolumeLoader.IsNotNull() && IsValidChannel(n))
+  {
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+      this->LoadPendingVolume(t, n);
+  }
+
   MutexHolder lock(m_ImageDataArraysLock);
   return GetChannelData_unlocked(n, data, importMemoryManagement);
 }
@@ -494,7 +527,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
       ch = m_Channels[n];
       // ok, let's combine the volumes!
       if (ch.GetPointer() == nullptr)
-        ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
+        ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true, m_BackingStore);
       ch->SetComplete(true);
       size_t size = m_OffsetTable[m_Dimension - 1] * (ptypeSize);
       unsigned int t;
@@ -571,6 +604,10 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
 
 bool mitk::Image::IsSliceSet(int s, int t, int n) const
 {
+  // pending volumes are regarded as set, they are loaded on first access
+  if (IsValidSlice(s, t, n) && m_VolumeLoader.IsNotNull() && m_VolumeLoader->IsVolumePending(t, n))
+    return true;
+
   MutexHolder lock(m_ImageDataArraysLock);
   return IsSliceSet_unlocked(s, t, n);
 }
@@ -601,6 +638,10 @@ bool mitk::Image::IsSliceSet_unlocked(int s, int t, int n) const
 
 bool mitk::Image::IsVolumeSet(int t, int n) const
 {
+  // pending volumes are regarded as set, they are loaded on first access
+  if (IsValidVolume(t, n) && m_VolumeLoader.IsNotNull() && m_VolumeLoader->IsVolumePending(t, n))
+    return true;
+
   MutexHolder lock(m_ImageDataArraysLock);
   return IsVolumeSet_unlocked(t, n);
 }
@@ -635,6 +676,19 @@ bool mitk::Image::IsVolumeSet_unlocked(int t, int n) const
 
 bool mitk::Image::IsChannelSet(int n) const
 {
+  if (IsValidChannel(n) == false)
+    return false;
+
+  if (m_VolumeLoader.IsNotNull())
+  {
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      if (!this->IsVolumeSet(t, n))
+        return false;
+    }
+    return true;
+  }
+
   MutexHolder lock(m_ImageDataArraysLock);
   return IsChannelSet_unlocked(n);
 }
@@ -840,6 +894,17 @@ void mitk::Image::Initialize(const mitk::PixelType &type,
                              const unsigned int *dimensions,
                              unsigned int channels)
 {
+  // volumes of a previous initialization must not be loaded into the new ones
+  if (m_VolumeLoader.IsNotNull())
+  {
+    m_VolumeLoader->StopBackgroundLoading();
+    m_VolumeLoader = nullptr;
+  }
+
+  // the pyramid must not read from the volumes while they are released
+  if (m_Pyramid.IsNotNull())
+    m_Pyramid->StopBackgroundUpdate();
+
   Clear();
 
   m_Dimension = dimension;
@@ -1166,6 +1231,61 @@ int mitk::Image::GetVolumeIndex(int t, int n) const
   return ((size_t)t) + ((size_t)n) * m_Dimensions[3]; //??
 }
 
+void mitk::Image::SetBackingStore(ImageDataBackingStore *store)
+{
+  MutexHolder lock(m_ImageDataArraysLock);
+  if (m_BackingStore == store)
+    return;
+
+  m_BackingStore = store;
+  this->Modified();
+}
+
+mitk::ImageDataBackingStore *mitk::Image::GetBackingStore() const
+{
+  return m_BackingStore;
+}
+
+void mitk::Image::SetVolumeLoader(ImageVolumeLoader *loader)
+{
+  if (m_VolumeLoader == loader)
+    return;
+
+  if (m_VolumeLoader.IsNotNull())
+    m_VolumeLoader->StopBackgroundLoading();
+
+  m_VolumeLoader = loader;
+  this->Modified();
+}
+
+mitk::ImageVolumeLoader *mitk::Image::GetVolumeLoader() const
+{
+  return m_VolumeLoader;
+}
+
+void mitk::Image::SetPyramid(ImagePyramid *pyramid)
+{
+  if (m_Pyramid == pyramid)
+    return;
+
+  if (m_Pyramid.IsNotNull())
+    m_Pyramid->StopBackgroundUpdate();
+
+  m_Pyramid = pyramid;
+  this->Modified();
+}
+
+mitk::ImagePyramid *mitk::Image::GetPyramid() const
+{
+  return m_Pyramid;
+}
+
+void mitk::Image::LoadPendingVolume(int t, int n) const
+{
+  if (m_VolumeLoader.IsNotNull() && IsValidVolume(t, n) && m_VolumeLoader->IsVolumePending(t, n))
+    m_VolumeLoader->LoadVolume(this, t, n);
+}
+
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateSliceData(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
@@ -1266,13 +1386,14 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData_unlocked(
   // allocate new volume
   if (importMemoryManagement == CopyMemory)
   {
-    vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
+    vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true, m_BackingStore);
     if (data != nullptr)
       std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
   }
   else
   {
-    vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, data, importMemoryManagement == ManageMemory);
+    vol = new ImageDataItem(
+      chPixelType, t, 3, m_Dimensions, data, importMemoryManagement == ManageMemory, m_BackingStore);
   }
   m_Volumes[pos] = vol;
   return vol;
@@ -1294,13 +1415,14 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateChannelData_unlocked(
   {
     const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
-    ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
+    ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true, m_BackingStore);
     if (data != nullptr)
       std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
   }
   else
   {
-    ch = new ImageDataItem(this->m_ImageDescriptor, -1, data, importMemoryManagement == ManageMemory);
+    ch = new ImageDataItem(
+      this->m_ImageDescriptor, -1, data, importMemoryManagement == ManageMemory, m_BackingStore);
   }
   m_Channels[n] = ch;
   return ch;
@@ -0,0 +1,296 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageDataBackingStore.h"
+
+#include "mitkIOUtil.h"
+#include "mitkLogMacros.h"
+#include "mitkMemoryUtilities.h"
+
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  size_t GetPageSize()
+  {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwAllocationGranularity);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+  }
+}
+
+mitk::ImageDataBackingStore::ImageDataBackingStore()
+{
+}
+
+mitk::ImageDataBackingStore::~ImageDataBackingStore()
+{
+}
+
+void mitk::ImageDataBackingStore::Touch(const unsigned char *, size_t) const
+{
+}
+
+mitk::MappedFileImageDataBackingStore::MappedFileImageDataBackingStore()
+  : m_ScratchDirectory(IOUtil::GetTempPath()),
+    m_ResidencyBudget(0),
+    m_MinimumMappedSize(GetPageSize()),
+    m_MappedSize(0),
+    m_ResidentSize(0)
+{
+}
+
+mitk::MappedFileImageDataBackingStore::~MappedFileImageDataBackingStore()
+{
+  // Buffers are released by their ImageDataItems, which hold a reference to the store.
+  // Anything left at this point has been leaked by its owner; unmap it anyway to get
+  // rid of the scratch files.
+  for (const auto &mapping : m_Mappings)
+  {
+    this->UnmapBuffer(mapping.first, mapping.second);
+  }
+}
+
+void mitk::MappedFileImageDataBackingStore::SetResidencyBudget(size_t budget)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_ResidencyBudget == budget)
+    return;
+
+  m_ResidencyBudget = budget;
+  this->EvictLeastRecentlyUsed();
+  this->Modified();
+}
+
+size_t mitk::MappedFileImageDataBackingStore::GetResidencyBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_ResidencyBudget;
+}
+
+size_t mitk::MappedFileImageDataBackingStore::GetResidentSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_ResidentSize;
+}
+
+size_t mitk::MappedFileImageDataBackingStore::GetMappedSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MappedSize;
+}
+
+unsigned char *mitk::MappedFileImageDataBackingStore::Allocate(size_t size)
+{
+  if (size < m_MinimumMappedSize)
+    return MemoryUtilities::AllocateElements<unsigned char>(size);
+
+  const std::string fileName = IOUtil::CreateTemporaryFile("mitk-image-XXXXXX.raw", m_ScratchDirectory);
+
+  Mapping mapping;
+  mapping.Size = size;
+  unsigned char *data = nullptr;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName.c_str(),
+                            GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    DeleteFileA(fileName.c_str());
+    throw itk::MemoryAllocationError(__FILE__, __LINE__, "Failed to open scratch file.", ITK_LOCATION);
+  }
+
+  const auto size64 = static_cast<unsigned long long>(size);
+  HANDLE fileMapping = CreateFileMappingA(
+    file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+  if (fileMapping != nullptr)
+    data = static_cast<unsigned char *>(MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+
+  if (data == nullptr)
+  {
+    if (fileMapping != nullptr)
+      CloseHandle(fileMapping);
+    CloseHandle(file);
+    throw itk::MemoryAllocationError(__FILE__, __LINE__, "Failed to map scratch file.", ITK_LOCATION);
+  }
+
+  mapping.FileHandle = file;
+  mapping.MappingHandle = fileMapping;
+#else
+  int fd = open(fileName.c_str(), O_RDWR);
+
+  // The file is only needed as long as it is mapped, so unlink it right away. This
+  // guarantees that no scratch files are left behind if the application crashes.
+  unlink(fileName.c_str());
+
+  if (fd < 0)
+    throw itk::MemoryAllocationError(__FILE__, __LINE__, "Failed to open scratch file.", ITK_LOCATION);
+
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address != MAP_FAILED)
+      data = static_cast<unsigned char *>(address);
+  }
+
+  if (data == nullptr)
+  {
+    close(fd);
+    throw itk::MemoryAllocationError(__FILE__, __LINE__, "Failed to map scratch file.", ITK_LOCATION);
+  }
+
+  mapping.FileDescriptor = fd;
+#endif
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Mappings[data] = mapping;
+  m_MappedSize += size;
+
+  return data;
+}
+
+void mitk::MappedFileImageDataBackingStore::Release(unsigned char *data, size_t size)
+{
+  if (data == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto iter = m_Mappings.find(data);
+  if (iter == m_Mappings.end())
+  {
+    MemoryUtilities::DeleteElements(data);
+    return;
+  }
+
+  this->ForgetRanges(data, data + size);
+  m_MappedSize -= iter->second.Size;
+  this->UnmapBuffer(data, iter->second);
+  m_Mappings.erase(iter);
+}
+
+void mitk::MappedFileImageDataBackingStore::Touch(const unsigned char *data, size_t size) const
+{
+  if (data == nullptr || size == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  // Only mapped buffers take part in residency management
+  auto iter = m_Mappings.upper_bound(const_cast<unsigned char *>(data));
+  if (iter == m_Mappings.begin())
+    return;
+  --iter;
+  if (data + size > iter->first + iter->second.Size)
+    return;
+
+  const RangeType range(data, size);
+  auto lookupIter = m_ResidentRangeLookup.find(range);
+  if (lookupIter != m_ResidentRangeLookup.end())
+  {
+    m_ResidentRanges.splice(m_ResidentRanges.begin(), m_ResidentRanges, lookupIter->second);
+    return;
+  }
+
+  m_ResidentRanges.push_front(range);
+  m_ResidentRangeLookup[range] = m_ResidentRanges.begin();
+  m_ResidentSize += size;
+
+  this->EvictLeastRecentlyUsed();
+}
+
+void mitk::MappedFileImageDataBackingStore::UnmapBuffer(unsigned char *data, const Mapping &mapping)
+{
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+  CloseHandle(mapping.MappingHandle);
+  CloseHandle(mapping.FileHandle);
+#else
+  munmap(data, mapping.Size);
+  close(mapping.FileDescriptor);
+#endif
+}
+
+void mitk::MappedFileImageDataBackingStore::ForgetRanges(const unsigned char *begin, const unsigned char *end) const
+{
+  auto lookupIter = m_ResidentRangeLookup.lower_bound(RangeType(begin, 0));
+  while (lookupIter != m_ResidentRangeLookup.end() && lookupIter->first.first < end)
+  {
+    m_ResidentSize -= lookupIter->first.second;
+    m_ResidentRanges.erase(lookupIter->second);
+    lookupIter = m_ResidentRangeLookup.erase(lookupIter);
+  }
+}
+
+void mitk::MappedFileImageDataBackingStore::EvictLeastRecentlyUsed() const
+{
+  if (m_ResidencyBudget == 0)
+    return;
+
+  // The most recently touched range is never evicted, even if it exceeds the budget on its own
+  while (m_ResidentSize > m_ResidencyBudget && m_ResidentRanges.size() > 1)
+  {
+    const RangeType range = m_ResidentRanges.back();
+    m_ResidentRanges.pop_back();
+    m_ResidentRangeLookup.erase(range);
+    m_ResidentSize -= range.second;
+
+    this->Evict(range);
+  }
+}
+
+void mitk::MappedFileImageDataBackingStore::Evict(const RangeType &range) const
+{
+  // Only whole pages can be dropped. Pages partially shared with neighboring ranges stay resident.
+  static const size_t pageSize = GetPageSize();
+
+  auto begin = reinterpret_cast<std::uintptr_t>(range.first);
+  auto end = begin + range.second;
+  begin = (begin + pageSize - 1) / pageSize * pageSize;
+  end = end / pageSize * pageSize;
+
+  if (end <= begin)
+    return;
+
+  auto *address = reinterpret_cast<void *>(begin);
+  const size_t length = end - begin;
+
+#ifdef _WIN32
+  // Unlocking pages that are not locked removes them from the working set of the process.
+  FlushViewOfFile(address, length);
+  VirtualUnlock(address, length);
+#else
+  // Pages of a shared file mapping are written back to the scratch file and re-read on the next access.
+  if (msync(address, length, MS_ASYNC) != 0 || madvise(address, length, MADV_DONTNEED) != 0)
+  {
+    MITK_WARN << "Could not evict " << length << " bytes of image data from physical memory.";
+  }
+#endif
+}
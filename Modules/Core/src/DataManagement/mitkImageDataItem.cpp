@@ -90,7 +90,12 @@ mitk::ImageDataItem::~ImageDataItem()
   if (m_Parent.IsNull())
   {
     if (m_ManageMemory)
-      delete[] m_Data;
+    {
+      if (m_BackingStore.IsNotNull())
+        m_BackingStore->Release(m_Data, m_Size);
+      else
+        delete[] m_Data;
+    }
   }
   delete m_PixelType;
 }
@@ -98,7 +103,8 @@ mitk::ImageDataItem::~ImageDataItem()
 mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
                                    int timestep,
                                    void *data,
-                                   bool manageMemory)
+                                   bool manageMemory,
+                                   ImageDataBackingStore *backingStore)
   : m_Data(static_cast<unsigned char *>(data)),
     m_PixelType(new mitk::PixelType(desc->GetChannelDescriptor(0).GetPixelType())),
     m_ManageMemory(manageMemory),
@@ -122,8 +128,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
 
   if (m_Data == nullptr)
   {
-    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
-    m_ManageMemory = true;
+    this->AllocateData(backingStore);
   }
 
   m_ReferenceCount = 0;
@@ -134,7 +139,8 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
                                    unsigned int dimension,
                                    unsigned int *dimensions,
                                    void *data,
-                                   bool manageMemory)
+                                   bool manageMemory,
+                                   ImageDataBackingStore *backingStore)
   : m_Data(static_cast<unsigned char *>(data)),
     m_PixelType(new mitk::PixelType(type)),
     m_ManageMemory(manageMemory),
@@ -157,8 +163,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
 
   if (m_Data == nullptr)
   {
-    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
-    m_ManageMemory = true;
+    this->AllocateData(backingStore);
   }
 
   m_ReferenceCount = 0;
@@ -175,6 +180,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_Offset(other.m_Offset),
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
+    m_BackingStore(other.m_BackingStore),
     m_Parent(other.m_Parent),
     m_Dimension(other.m_Dimension),
     m_Timestep(other.m_Timestep)
@@ -200,6 +206,20 @@ void mitk::ImageDataItem::ComputeItemSize(const unsigned int *dimensions, unsign
   }
 }
 
+void mitk::ImageDataItem::AllocateData(ImageDataBackingStore *backingStore)
+{
+  if (backingStore != nullptr)
+  {
+    m_Data = backingStore->Allocate(m_Size);
+    m_BackingStore = backingStore;
+  }
+  else
+  {
+    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
+  }
+  m_ManageMemory = true;
+}
+
 void mitk::ImageDataItem::ConstructVtkImageData(ImageConstPointer iP) const
 {
   vtkImageData *inData = vtkImageData::New();
@@ -0,0 +1,514 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImagePyramid.h"
+
+#include "mitkExceptionMacro.h"
+#include "mitkImage.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkLogMacros.h"
+#include "mitkPlaneGeometry.h"
+#include "mitkSlicedGeometry3D.h"
+
+#include <itkImageIOBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  template <typename T>
+  inline typename std::enable_if<std::is_integral<T>::value, T>::type RoundToPixel(double value)
+  {
+    return static_cast<T>(std::floor(value + 0.5));
+  }
+
+  template <typename T>
+  inline typename std::enable_if<std::is_floating_point<T>::value, T>::type RoundToPixel(double value)
+  {
+    return static_cast<T>(value);
+  }
+
+  /** Averages blocks of factors[0] x factors[1] x factors[2] voxels. Blocks at the upper borders may be smaller. */
+  template <typename T>
+  void DownsampleVolume(const void *inputBuffer,
+                        const std::size_t *inputDimensions,
+                        const unsigned int *factors,
+                        std::size_t numberOfComponents,
+                        void *outputBuffer,
+                        const std::size_t *outputDimensions)
+  {
+    const auto *input = static_cast<const T *>(inputBuffer);
+    auto *output = static_cast<T *>(outputBuffer);
+    std::vector<double> sums(numberOfComponents);
+
+    for (std::size_t z = 0; z < outputDimensions[2]; ++z)
+    {
+      const std::size_t zBegin = z * factors[2];
+      const std::size_t zEnd = std::min(zBegin + factors[2], inputDimensions[2]);
+
+      for (std::size_t y = 0; y < outputDimensions[1]; ++y)
+      {
+        const std::size_t yBegin = y * factors[1];
+        const std::size_t yEnd = std::min(yBegin + factors[1], inputDimensions[1]);
+
+        for (std::size_t x = 0; x < outputDimensions[0]; ++x)
+        {
+          const std::size_t xBegin = x * factors[0];
+          const std::size_t xEnd = std::min(xBegin + factors[0], inputDimensions[0]);
+
+          std::fill(sums.begin(), sums.end(), 0.0);
+
+          for (std::size_t zz = zBegin; zz < zEnd; ++zz)
+          {
+            for (std::size_t yy = yBegin; yy < yEnd; ++yy)
+            {
+              const T *voxel = input + ((zz * inputDimensions[1] + yy) * inputDimensions[0] + xBegin) * numberOfComponents;
+
+              for (std::size_t xx = xBegin; xx < xEnd; ++xx)
+              {
+                for (std::size_t c = 0; c < numberOfComponents; ++c)
+                  sums[c] += static_cast<double>(*voxel++);
+              }
+            }
+          }
+
+          const double count = static_cast<double>((zEnd - zBegin) * (yEnd - yBegin) * (xEnd - xBegin));
+
+          for (std::size_t c = 0; c < numberOfComponents; ++c)
+            *output++ = RoundToPixel<T>(sums[c] / count);
+        }
+      }
+    }
+  }
+
+  typedef void (*DownsampleFunction)(
+    const void *, const std::size_t *, const unsigned int *, std::size_t, void *, const std::size_t *);
+
+  DownsampleFunction GetDownsampleFunction(int componentType)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        return &DownsampleVolume<unsigned char>;
+      case itk::ImageIOBase::CHAR:
+        return &DownsampleVolume<char>;
+      case itk::ImageIOBase::USHORT:
+        return &DownsampleVolume<unsigned short>;
+      case itk::ImageIOBase::SHORT:
+        return &DownsampleVolume<short>;
+      case itk::ImageIOBase::UINT:
+        return &DownsampleVolume<unsigned int>;
+      case itk::ImageIOBase::INT:
+        return &DownsampleVolume<int>;
+      case itk::ImageIOBase::ULONG:
+        return &DownsampleVolume<unsigned long>;
+      case itk::ImageIOBase::LONG:
+        return &DownsampleVolume<long>;
+      case itk::ImageIOBase::FLOAT:
+        return &DownsampleVolume<float>;
+      case itk::ImageIOBase::DOUBLE:
+        return &DownsampleVolume<double>;
+      default:
+        return nullptr;
+    }
+  }
+
+  void GetVolumeDimensions(const mitk::Image *image, std::size_t *dimensions)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+      dimensions[i] = image->GetDimension() > i ? image->GetDimension(i) : 1;
+  }
+
+  /** Smallest spacing along the axes that consist of more than one voxel. */
+  mitk::ScalarType GetSmallestSpacing(const mitk::Image *image)
+  {
+    std::size_t dimensions[3];
+    GetVolumeDimensions(image, dimensions);
+    const auto spacing = image->GetGeometry()->GetSpacing();
+
+    auto smallestSpacing = std::numeric_limits<mitk::ScalarType>::max();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (dimensions[i] > 1)
+        smallestSpacing = std::min(smallestSpacing, spacing[i]);
+    }
+
+    return smallestSpacing;
+  }
+
+  /** Determines the down-sampling factors of the level following \a image. Returns false if there is none. */
+  bool ComputeFactors(const mitk::Image *image, unsigned int minimumLevelSize, unsigned int *factors)
+  {
+    std::size_t dimensions[3];
+    GetVolumeDimensions(image, dimensions);
+
+    if (*std::max_element(dimensions, dimensions + 3) <= minimumLevelSize)
+      return false;
+
+    // axes with a considerably larger spacing are not down-sampled before the others caught up
+    const auto smallestSpacing = GetSmallestSpacing(image);
+    const auto spacing = image->GetGeometry()->GetSpacing();
+
+    for (unsigned int i = 0; i < 3; ++i)
+      factors[i] = dimensions[i] > 1 && spacing[i] < 1.5 * smallestSpacing ? 2 : 1;
+
+    return true;
+  }
+
+  /** Geometry of a level that covers the same physical region as \a previousGeometry with a coarser spacing. */
+  mitk::SlicedGeometry3D::Pointer CreateLevelGeometry(const mitk::BaseGeometry *previousGeometry,
+                                                      const unsigned int *factors,
+                                                      const std::size_t *outputDimensions)
+  {
+    // the center of the first voxel of the level is the center of the first block of the previous level
+    mitk::Point3D firstBlockCenter;
+    for (unsigned int i = 0; i < 3; ++i)
+      firstBlockCenter[i] = 0.5 * (factors[i] - 1);
+
+    mitk::Point3D origin;
+    previousGeometry->IndexToWorld(firstBlockCenter, origin);
+
+    auto spacing = previousGeometry->GetSpacing();
+    auto matrix = previousGeometry->GetIndexToWorldTransform()->GetMatrix();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      spacing[i] *= factors[i];
+      for (unsigned int j = 0; j < 3; ++j)
+        matrix[j][i] *= factors[i];
+    }
+
+    // same procedure as in Image::InitializeByItk()
+    auto planeGeometry = mitk::PlaneGeometry::New();
+    planeGeometry->InitializeStandardPlane(outputDimensions[0], outputDimensions[1]);
+    planeGeometry->SetOrigin(origin);
+    planeGeometry->GetIndexToWorldTransform()->SetMatrix(matrix);
+
+    auto slicedGeometry = mitk::SlicedGeometry3D::New();
+    slicedGeometry->InitializeEvenlySpaced(planeGeometry, static_cast<unsigned int>(outputDimensions[2]));
+    slicedGeometry->SetSpacing(spacing);
+    slicedGeometry->ImageGeometryOn();
+
+    return slicedGeometry;
+  }
+
+  /** Returns nullptr if \a stopRequested is set while the level is created. */
+  mitk::Image::Pointer CreateLevel(const mitk::Image *previous,
+                                   const unsigned int *factors,
+                                   const std::atomic<bool> &stopRequested)
+  {
+    const auto pixelType = previous->GetPixelType();
+    auto downsample = GetDownsampleFunction(pixelType.GetComponentType());
+
+    if (nullptr == downsample)
+      mitkThrow() << "Pixel type " << pixelType.GetTypeAsString() << " is not supported.";
+
+    std::size_t inputDimensions[3];
+    std::size_t outputDimensions[3];
+    GetVolumeDimensions(previous, inputDimensions);
+
+    for (unsigned int i = 0; i < 3; ++i)
+      outputDimensions[i] = (inputDimensions[i] + factors[i] - 1) / factors[i];
+
+    auto timeGeometry = previous->GetTimeGeometry()->Clone();
+    const auto timeSteps = timeGeometry->CountTimeSteps();
+
+    for (mitk::TimeStepType t = 0; t < timeSteps; ++t)
+      timeGeometry->SetTimeStepGeometry(CreateLevelGeometry(timeGeometry->GetGeometryForTimeStep(t), factors, outputDimensions), t);
+
+    unsigned int dimensions[4];
+    for (unsigned int i = 0; i < 3; ++i)
+      dimensions[i] = static_cast<unsigned int>(outputDimensions[i]);
+    dimensions[3] = static_cast<unsigned int>(timeSteps);
+
+    auto level = mitk::Image::New();
+    level->Initialize(pixelType, previous->GetDimension(), dimensions);
+    level->SetTimeGeometry(timeGeometry);
+
+    for (mitk::TimeStepType t = 0; t < timeSteps; ++t)
+    {
+      if (stopRequested)
+        return nullptr;
+
+      mitk::ImageReadAccessor readAccess(previous, previous->GetVolumeData(t));
+      mitk::ImageWriteAccessor writeAccess(level, level->GetVolumeData(t));
+
+      downsample(readAccess.GetData(),
+                 inputDimensions,
+                 factors,
+                 pixelType.GetNumberOfComponents(),
+                 writeAccess.GetData(),
+                 outputDimensions);
+    }
+
+    return level;
+  }
+}
+
+mitk::ImagePyramid::ImagePyramid()
+  : m_ImageMTime(0),
+    m_Complete(false),
+    m_MaximumNumberOfLevels(5),
+    m_MinimumLevelSize(64),
+    m_BackgroundUpdateRunning(false),
+    m_StopRequested(false)
+{
+}
+
+mitk::ImagePyramid::~ImagePyramid()
+{
+  this->StopBackgroundUpdate();
+}
+
+void mitk::ImagePyramid::SetMaximumNumberOfLevels(unsigned int maximumNumberOfLevels)
+{
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_MaximumNumberOfLevels == maximumNumberOfLevels)
+    return;
+
+  m_MaximumNumberOfLevels = std::max(1u, maximumNumberOfLevels);
+
+  // the levels are rebuilt by the next update
+  m_Levels.clear();
+  m_ImageMTime = 0;
+  m_Complete = false;
+  this->Modified();
+}
+
+unsigned int mitk::ImagePyramid::GetMaximumNumberOfLevels() const
+{
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  return m_MaximumNumberOfLevels;
+}
+
+void mitk::ImagePyramid::SetMinimumLevelSize(unsigned int minimumLevelSize)
+{
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_MinimumLevelSize == minimumLevelSize)
+    return;
+
+  m_MinimumLevelSize = std::max(1u, minimumLevelSize);
+
+  // the levels are rebuilt by the next update
+  m_Levels.clear();
+  m_ImageMTime = 0;
+  m_Complete = false;
+  this->Modified();
+}
+
+unsigned int mitk::ImagePyramid::GetMinimumLevelSize() const
+{
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  return m_MinimumLevelSize;
+}
+
+bool mitk::ImagePyramid::IsUpToDate(const Image *image) const
+{
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  return this->IsUpToDate_unlocked(image);
+}
+
+bool mitk::ImagePyramid::IsUpToDate_unlocked(const Image *image) const
+{
+  return nullptr != image && m_Complete && m_ImageMTime == image->GetMTime();
+}
+
+unsigned int mitk::ImagePyramid::GetNumberOfAvailableLevels(const Image *image) const
+{
+  if (nullptr == image)
+    return 0;
+
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_ImageMTime != image->GetMTime())
+    return 1;
+
+  return static_cast<unsigned int>(m_Levels.size()) + 1;
+}
+
+mitk::Image::Pointer mitk::ImagePyramid::GetLevel(const Image *image, unsigned int level) const
+{
+  if (nullptr == image)
+    return nullptr;
+
+  if (0 == level)
+    return const_cast<Image *>(image);
+
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_ImageMTime != image->GetMTime() || level > m_Levels.size())
+    return nullptr;
+
+  return m_Levels[level - 1];
+}
+
+unsigned int mitk::ImagePyramid::SelectLevel(const Image *image, ScalarType mmPerPixel)
+{
+  if (nullptr == image || !image->IsInitialized())
+    return 0;
+
+  if (!this->IsUpToDate(image))
+    this->StartBackgroundUpdate(image);
+
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_ImageMTime != image->GetMTime())
+    return 0;
+
+  unsigned int selectedLevel = 0;
+  for (std::size_t i = 0; i < m_Levels.size() && GetSmallestSpacing(m_Levels[i]) <= mmPerPixel; ++i)
+    selectedLevel = static_cast<unsigned int>(i) + 1;
+
+  return selectedLevel;
+}
+
+unsigned int mitk::ImagePyramid::SelectLevelByNumberOfVoxels(const Image *image, size_t maximumNumberOfVoxels)
+{
+  if (nullptr == image || !image->IsInitialized())
+    return 0;
+
+  if (!this->IsUpToDate(image))
+    this->StartBackgroundUpdate(image);
+
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_ImageMTime != image->GetMTime())
+    return 0;
+
+  std::size_t dimensions[3];
+  GetVolumeDimensions(image, dimensions);
+
+  unsigned int selectedLevel = 0;
+  for (std::size_t i = 0; i < m_Levels.size() && dimensions[0] * dimensions[1] * dimensions[2] > maximumNumberOfVoxels; ++i)
+  {
+    GetVolumeDimensions(m_Levels[i], dimensions);
+    selectedLevel = static_cast<unsigned int>(i) + 1;
+  }
+
+  return selectedLevel;
+}
+
+void mitk::ImagePyramid::Update(const Image *image)
+{
+  this->UpdateLevels(image);
+}
+
+void mitk::ImagePyramid::StartBackgroundUpdate(const Image *image)
+{
+  if (nullptr == image || !image->IsInitialized())
+    return;
+
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  if (m_BackgroundUpdateRunning || this->IsUpToDate_unlocked(image))
+    return;
+
+  // a previous worker has finished already
+  if (m_BackgroundThread.joinable())
+    m_BackgroundThread.join();
+
+  m_StopRequested = false;
+  m_BackgroundUpdateRunning = true;
+  m_BackgroundThread = std::thread(&ImagePyramid::RunBackgroundUpdate, this, Image::ConstPointer(image));
+}
+
+void mitk::ImagePyramid::StopBackgroundUpdate()
+{
+  m_StopRequested = true;
+
+  if (m_BackgroundThread.joinable())
+  {
+    // the worker destroys this pyramid if it releases the last reference to its image
+    if (std::this_thread::get_id() == m_BackgroundThread.get_id())
+      m_BackgroundThread.detach();
+    else
+      m_BackgroundThread.join();
+  }
+
+  m_StopRequested = false;
+}
+
+void mitk::ImagePyramid::RunBackgroundUpdate(Image::ConstPointer image)
+{
+  try
+  {
+    this->UpdateLevels(image);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Could not build the multi-resolution pyramid: " << e.what();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_LevelsMutex);
+    m_BackgroundUpdateRunning = false;
+  }
+
+  // releasing the image may destroy it together with this pyramid, so no member must be accessed afterwards
+  image = nullptr;
+}
+
+void mitk::ImagePyramid::UpdateLevels(const Image *image)
+{
+  if (nullptr == image || !image->IsInitialized())
+    return;
+
+  std::lock_guard<std::mutex> updateLock(m_UpdateMutex);
+
+  // levels are built for the version of the image at this point in time
+  const auto imageMTime = image->GetMTime();
+
+  // the levels may be discarded by a concurrent SetMaximumNumberOfLevels() while the next one is built
+  Image::ConstPointer previous = image;
+  std::size_t numberOfLevels = 1;
+  unsigned int maximumNumberOfLevels;
+  unsigned int minimumLevelSize;
+
+  {
+    std::lock_guard<std::mutex> lock(m_LevelsMutex);
+    if (m_ImageMTime != imageMTime)
+    {
+      m_Levels.clear();
+      m_ImageMTime = imageMTime;
+      m_Complete = false;
+    }
+
+    if (m_Complete)
+      return;
+
+    // continue with the levels built by an interrupted update
+    if (!m_Levels.empty())
+      previous = m_Levels.back();
+
+    numberOfLevels += m_Levels.size();
+    maximumNumberOfLevels = m_MaximumNumberOfLevels;
+    minimumLevelSize = m_MinimumLevelSize;
+  }
+
+  unsigned int factors[3];
+
+  while (numberOfLevels < maximumNumberOfLevels && ComputeFactors(previous, minimumLevelSize, factors))
+  {
+    auto level = CreateLevel(previous, factors, m_StopRequested);
+
+    if (level.IsNull())
+      return;
+
+    std::lock_guard<std::mutex> lock(m_LevelsMutex);
+    m_Levels.push_back(level);
+    previous = level;
+    ++numberOfLevels;
+  }
+
+  std::lock_guard<std::mutex> lock(m_LevelsMutex);
+  m_Complete = true;
+}
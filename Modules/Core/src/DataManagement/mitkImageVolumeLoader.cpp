@@ -0,0 +1,181 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageVolumeLoader.h"
+
+#include "mitkImage.h"
+#include "mitkLogMacros.h"
+#include "mitkMemoryUtilities.h"
+
+mitk::ImageVolumeLoader::ImageVolumeLoader()
+  : m_TimeSteps(0), m_PendingVolumes(0), m_NextBackgroundTimeStep(0), m_StopRequested(false)
+{
+}
+
+mitk::ImageVolumeLoader::~ImageVolumeLoader()
+{
+  this->StopBackgroundLoading();
+}
+
+void mitk::ImageVolumeLoader::InitializePendingVolumes(unsigned int timeSteps, unsigned int channels)
+{
+  std::lock_guard<std::mutex> lock(m_StateMutex);
+  m_TimeSteps = timeSteps;
+  m_VolumeStates.assign(static_cast<size_t>(timeSteps) * channels, VolumeState::Pending);
+  m_PendingVolumes = static_cast<unsigned int>(m_VolumeStates.size());
+  m_NextBackgroundTimeStep = 0;
+}
+
+bool mitk::ImageVolumeLoader::IsVolumePending(int t, int n) const
+{
+  std::lock_guard<std::mutex> lock(m_StateMutex);
+  const size_t index = static_cast<size_t>(n) * m_TimeSteps + t;
+  return t >= 0 && n >= 0 && index < m_VolumeStates.size() && m_VolumeStates[index] != VolumeState::Loaded;
+}
+
+bool mitk::ImageVolumeLoader::HasPendingVolumes() const
+{
+  std::lock_guard<std::mutex> lock(m_StateMutex);
+  return m_PendingVolumes > 0;
+}
+
+void mitk::ImageVolumeLoader::LoadVolume(const Image *image, int t, int n)
+{
+  const size_t index = static_cast<size_t>(n) * m_TimeSteps + t;
+
+  {
+    std::unique_lock<std::mutex> lock(m_StateMutex);
+    if (t < 0 || n < 0 || index >= m_VolumeStates.size())
+      return;
+
+    m_StateChanged.wait(lock, [this, index] { return m_VolumeStates[index] != VolumeState::Loading; });
+
+    if (m_VolumeStates[index] == VolumeState::Loaded)
+      return;
+
+    m_VolumeStates[index] = VolumeState::Loading;
+
+    // the worker continues behind the most recently requested time step
+    m_NextBackgroundTimeStep = static_cast<unsigned int>(t + 1) % m_TimeSteps;
+  }
+
+  size_t volumeSize = image->GetPixelType(n).GetSize();
+  for (unsigned int i = 0; i < 3; ++i)
+    volumeSize *= image->GetDimension(i);
+
+  auto *buffer = MemoryUtilities::AllocateElements<unsigned char>(volumeSize, true);
+  bool loaded = false;
+
+  if (buffer != nullptr)
+  {
+    try
+    {
+      {
+        std::lock_guard<std::mutex> readLock(m_ReadMutex);
+        this->ReadVolume(t, n, buffer);
+      }
+
+      // the image takes over the buffer
+      auto volume = image->AllocateVolumeData(t, n, buffer, Image::ManageMemory);
+      buffer = nullptr;
+      volume->SetComplete(true);
+      loaded = true;
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "Could not load volume " << t << " of channel " << n << ": " << e.what();
+    }
+  }
+  else
+  {
+    MITK_ERROR << "Could not allocate memory for volume " << t << " of channel " << n;
+  }
+
+  MemoryUtilities::DeleteElements(buffer);
+
+  {
+    std::lock_guard<std::mutex> lock(m_StateMutex);
+    if (loaded)
+    {
+      m_VolumeStates[index] = VolumeState::Loaded;
+      --m_PendingVolumes;
+    }
+    else
+    {
+      m_VolumeStates[index] = VolumeState::Pending;
+    }
+  }
+  m_StateChanged.notify_all();
+}
+
+void mitk::ImageVolumeLoader::StartBackgroundLoading(const Image *image)
+{
+  this->StopBackgroundLoading();
+
+  std::lock_guard<std::mutex> lock(m_StateMutex);
+  m_StopRequested = false;
+  if (m_PendingVolumes > 0)
+    m_BackgroundThread = std::thread(&ImageVolumeLoader::RunBackgroundLoading, this, image);
+}
+
+void mitk::ImageVolumeLoader::StopBackgroundLoading()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_StateMutex);
+    m_StopRequested = true;
+  }
+
+  if (m_BackgroundThread.joinable())
+    m_BackgroundThread.join();
+}
+
+void mitk::ImageVolumeLoader::RunBackgroundLoading(const Image *image)
+{
+  while (true)
+  {
+    int t = -1;
+    int n = -1;
+
+    {
+      std::lock_guard<std::mutex> lock(m_StateMutex);
+      if (m_StopRequested || m_PendingVolumes == 0)
+        return;
+
+      const size_t channels = m_VolumeStates.size() / m_TimeSteps;
+      for (unsigned int i = 0; i < m_TimeSteps && t < 0; ++i)
+      {
+        const unsigned int timeStep = (m_NextBackgroundTimeStep + i) % m_TimeSteps;
+        for (size_t channel = 0; channel < channels; ++channel)
+        {
+          if (m_VolumeStates[channel * m_TimeSteps + timeStep] == VolumeState::Pending)
+          {
+            t = static_cast<int>(timeStep);
+            n = static_cast<int>(channel);
+            break;
+          }
+        }
+      }
+
+      // remaining volumes are currently being loaded by other threads
+      if (t < 0)
+        return;
+    }
+
+    this->LoadVolume(image, t, n);
+
+    if (this->IsVolumePending(t, n))
+    {
+      // loading failed, the volume will be retried on demand
+      return;
+    }
+  }
+}
@@ -12,15 +12,15 @@ found in the LICENSE file.
 
 #include "mitkStandaloneDataStorage.h"
 
-#include "itkMutexLockHolder.h"
-#include "itkSimpleFastMutexLock.h"
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
 #include "mitkNodePredicateBase.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 
-mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
+#include <mutex>
+
+mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage(), m_Snapshot(SetOfObjects::New())
 {
 }
 
@@ -40,7 +40,7 @@ bool mitk::StandaloneDataStorage::IsInitialized() const
 void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStorage::SetOfObjects *parents)
 {
   {
-    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+    std::unique_lock<std::shared_timed_mutex> locked(m_Mutex);
     if (!IsInitialized())
       throw std::logic_error("DataStorage not initialized");
     /* check if node is in its own list of sources */
@@ -64,6 +64,9 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
     mitk::DataStorage::SetOfObjects::ConstPointer children = childrenPointer.GetPointer();
     m_DerivedNodes.insert(std::make_pair(node, children));
 
+    m_Index.AddNode(node);
+    this->UpdateSnapshot();
+
     /* create entry in derivations adjacency list for each parent of the new node */
     for (SetOfObjects::ConstIterator it = sp->Begin(); it != sp->End(); it++)
     {
@@ -108,16 +111,18 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
   /* Notify observers of imminent node removal */
   EmitRemoveNodeEvent(node);
   {
-    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+    std::unique_lock<std::shared_timed_mutex> locked(m_Mutex);
+    m_Index.RemoveNode(node);
     /* remove node from both relation adjacency lists */
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
+    this->UpdateSnapshot();
   }
 }
 
 bool mitk::StandaloneDataStorage::Exists(const mitk::DataNode *node) const
 {
-  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  std::shared_lock<std::shared_timed_mutex> locked(m_Mutex);
   return (m_SourceNodes.find(node) != m_SourceNodes.end());
 }
 
@@ -145,11 +150,17 @@ void mitk::StandaloneDataStorage::RemoveFromRelation(const mitk::DataNode *node,
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetAll() const
 {
-  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  std::shared_lock<std::shared_timed_mutex> locked(m_Mutex);
   if (!IsInitialized())
     throw std::logic_error("DataStorage not initialized");
 
+  return m_Snapshot;
+}
+
+void mitk::StandaloneDataStorage::UpdateSnapshot()
+{
   mitk::DataStorage::SetOfObjects::Pointer resultset = mitk::DataStorage::SetOfObjects::New();
+  resultset->reserve(m_SourceNodes.size());
   /* Fill resultset with all objects that are managed by the StandaloneDataStorage object */
   unsigned int index = 0;
   for (auto it = m_SourceNodes.cbegin(); it != m_SourceNodes.cend(); ++it)
@@ -158,7 +169,61 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetAl
     else
       resultset->InsertElement(index++, const_cast<mitk::DataNode *>(it->first.GetPointer()));
 
-  return SetOfObjects::ConstPointer(resultset);
+  /* never modify the old snapshot, readers may still iterate it */
+  m_Snapshot = resultset.GetPointer();
+}
+
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubset(
+  const NodePredicateBase *condition) const
+{
+  if (condition == nullptr)
+    return this->GetAll();
+
+  /* re-indexing modified nodes is the only part of a query that needs exclusive access */
+  if (m_Index.HasOutdatedNodes())
+  {
+    std::unique_lock<std::shared_timed_mutex> locked(m_Mutex);
+    m_Index.Update();
+  }
+
+  mitk::DataStorage::SetOfObjects::Pointer candidates = mitk::DataStorage::SetOfObjects::New();
+  bool indexed = false;
+
+  {
+    std::shared_lock<std::shared_timed_mutex> locked(m_Mutex);
+    if (!IsInitialized())
+      throw std::logic_error("DataStorage not initialized");
+
+    DataStorageIndex::NodeSetType indexedCandidates;
+    indexed = m_Index.GetCandidates(condition, indexedCandidates);
+
+    /* nodes modified since the update above may be missing from the candidates, so check all nodes then */
+    if (indexed && m_Index.HasOutdatedNodes())
+      indexed = false;
+
+    /* the index is ordered by node address like m_SourceNodes, so the result order matches GetAll() */
+    unsigned int index = 0;
+    for (auto node : indexedCandidates)
+      candidates->InsertElement(index++, const_cast<mitk::DataNode *>(node));
+  }
+
+  /* the predicates are checked without holding m_Mutex, so they may access the data storage themselves */
+  if (!indexed)
+    return Superclass::GetSubset(condition);
+
+  return this->FilterSetOfObjects(candidates.GetPointer(), condition);
+}
+
+void mitk::StandaloneDataStorage::AddIndexedPropertyKey(const std::string &propertyKey)
+{
+  std::unique_lock<std::shared_timed_mutex> locked(m_Mutex);
+  m_Index.AddIndexedPropertyKey(propertyKey);
+}
+
+std::set<std::string> mitk::StandaloneDataStorage::GetIndexedPropertyKeys() const
+{
+  std::shared_lock<std::shared_timed_mutex> locked(m_Mutex);
+  return m_Index.GetIndexedPropertyKeys();
 }
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRelations(
@@ -240,14 +305,14 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRe
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSources(
   const mitk::DataNode *node, const NodePredicateBase *condition, bool onlyDirectSources) const
 {
-  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  std::shared_lock<std::shared_timed_mutex> locked(m_Mutex);
   return this->GetRelations(node, m_SourceNodes, condition, onlyDirectSources);
 }
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetDerivations(
   const mitk::DataNode *node, const NodePredicateBase *condition, bool onlyDirectDerivations) const
 {
-  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  std::shared_lock<std::shared_timed_mutex> locked(m_Mutex);
   return this->GetRelations(node, m_DerivedNodes, condition, onlyDirectDerivations);
 }
 
@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include <mitkIPropertyPersistence.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
+#include <mitkImageVolumeLoader.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkUIDManipulator.h>
 
@@ -37,6 +38,40 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TYPE = "org_mitk_timegeometry_type";
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
+  const char *const OPTION_NAME_LOAD_TIME_STEPS_ON_DEMAND = "Load time steps on demand";
+
+  namespace
+  {
+    /** Decodes single time steps of a 4D image file via a dedicated ImageIO instance. */
+    class ItkImageIOVolumeLoader : public ImageVolumeLoader
+    {
+    public:
+      mitkClassMacro(ItkImageIOVolumeLoader, ImageVolumeLoader);
+      itkFactorylessNewMacro(Self);
+
+      /** The ImageIO has to be exclusively owned by the loader and ready for reading. */
+      void SetImageIO(itk::ImageIOBase *imageIO) { m_ImageIO = imageIO; }
+
+    protected:
+      void ReadVolume(int t, int, void *buffer) override
+      {
+        itk::ImageIORegion ioRegion(4);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          ioRegion.SetIndex(i, 0);
+          ioRegion.SetSize(i, m_ImageIO->GetDimensions(i));
+        }
+        ioRegion.SetIndex(3, t);
+        ioRegion.SetSize(3, 1);
+
+        m_ImageIO->SetIORegion(ioRegion);
+        m_ImageIO->Read(buffer);
+      }
+
+    private:
+      itk::ImageIOBase::Pointer m_ImageIO;
+    };
+  }
 
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
@@ -122,6 +157,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
 
@@ -207,6 +243,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     if (rank)
     {
@@ -336,13 +373,45 @@ namespace mitk
     ioRegion.SetSize(ioSize);
     ioRegion.SetIndex(ioStart);
 
-    MITK_INFO << "ioRegion: " << ioRegion << std::endl;
-    m_ImageIO->SetIORegion(ioRegion);
-    void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
-    m_ImageIO->Read(buffer);
+    // Time steps of 4D images are decoded on first access if requested and supported by the
+    // ImageIO. The data is read by a separate ImageIO instance because this one is shared by
+    // all reads of this reader.
+    ItkImageIOVolumeLoader::Pointer volumeLoader;
+    const us::Any loadOnDemand = this->GetReaderOption(OPTION_NAME_LOAD_TIME_STEPS_ON_DEMAND);
+    if (ndim == MAXDIM && dimensions[3] > 1 && this->AbstractFileReader::GetInputStream() == nullptr &&
+        !loadOnDemand.Empty() && us::any_cast<bool>(loadOnDemand))
+    {
+      itk::ImageIOBase::Pointer volumeIO = dynamic_cast<itk::ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer());
+      if (volumeIO.IsNotNull())
+      {
+        volumeIO->SetFileName(path);
+        volumeIO->SetUseStreamedReading(true);
+        volumeIO->ReadImageInformation();
+        if (volumeIO->CanStreamRead())
+        {
+          volumeLoader = ItkImageIOVolumeLoader::New();
+          volumeLoader->SetImageIO(volumeIO);
+        }
+      }
+
+      if (volumeLoader.IsNull())
+      {
+        MITK_INFO << m_ImageIO->GetNameOfClass() << " cannot read single time steps, loading all time steps at once.";
+      }
+    }
 
     image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    void *buffer = nullptr;
+    if (volumeLoader.IsNull())
+    {
+      MITK_INFO << "ioRegion: " << ioRegion << std::endl;
+      m_ImageIO->SetIORegion(ioRegion);
+      buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
+      m_ImageIO->Read(buffer);
+
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
 
@@ -523,12 +592,38 @@ namespace mitk
       }
     }
 
-    MITK_INFO << "...finished!";
+    if (volumeLoader.IsNotNull())
+    {
+      volumeLoader->InitializePendingVolumes(image->GetDimension(3), 1);
+      image->SetVolumeLoader(volumeLoader);
+      volumeLoader->StartBackgroundLoading(image);
+      MITK_INFO << "...finished! Time steps are loaded in the background.";
+    }
+    else
+    {
+      MITK_INFO << "...finished!";
+    }
 
     result.push_back(image.GetPointer());
     return result;
   }
 
+  void ItkImageIO::InitializeDefaultReaderOptions()
+  {
+    // On-demand loading relies on reading parts of a file, so only offer it if the ImageIO supports that at all
+    itk::ImageIOBase::Pointer imageIO = dynamic_cast<itk::ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer());
+    if (imageIO.IsNull())
+      return;
+
+    imageIO->SetUseStreamedReading(true);
+    if (!imageIO->CanStreamRead())
+      return;
+
+    Options defaultOptions;
+    defaultOptions[OPTION_NAME_LOAD_TIME_STEPS_ON_DEMAND] = false;
+    this->SetDefaultReaderOptions(defaultOptions);
+  }
+
   AbstractFileIO::ConfidenceLevel ItkImageIO::GetReaderConfidenceLevel() const
   {
     return m_ImageIO->CanReadFile(GetLocalFileName().c_str()) ? IFileReader::Supported : IFileReader::Unsupported;
@@ -0,0 +1,186 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageSliceCache.h"
+
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+bool mitk::ImageSliceCache::KeyType::operator<(const KeyType &other) const
+{
+  return std::tie(ImagePointer,
+                  ImageMTime,
+                  ImageGeometryMTime,
+                  ReferenceGeometry,
+                  ReferenceGeometryMTime,
+                  TimeStep,
+                  InterpolationMode,
+                  ThickSlicesMode,
+                  ThickSlicesNum,
+                  InPlaneResampleExtentByGeometry,
+                  PlaneTransform,
+                  PlaneBounds) < std::tie(other.ImagePointer,
+                                          other.ImageMTime,
+                                          other.ImageGeometryMTime,
+                                          other.ReferenceGeometry,
+                                          other.ReferenceGeometryMTime,
+                                          other.TimeStep,
+                                          other.InterpolationMode,
+                                          other.ThickSlicesMode,
+                                          other.ThickSlicesNum,
+                                          other.InPlaneResampleExtentByGeometry,
+                                          other.PlaneTransform,
+                                          other.PlaneBounds);
+}
+
+mitk::ImageSliceCache::ImageSliceCache() : m_Size(0), m_MaximumSize(64 * 1024 * 1024)
+{
+}
+
+mitk::ImageSliceCache::KeyType mitk::ImageSliceCache::CreateKey(const Image *image,
+                                                                const PlaneGeometry *planeGeometry,
+                                                                TimeStepType timeStep,
+                                                                int interpolationMode,
+                                                                int thickSlicesMode,
+                                                                int thickSlicesNum,
+                                                                bool inPlaneResampleExtentByGeometry)
+{
+  KeyType key;
+  key.ImagePointer = image;
+  key.ImageMTime = image->GetMTime();
+  key.ImageGeometryMTime = image->GetTimeGeometry()->GetGeometryForTimeStep(timeStep)->GetMTime();
+  key.ReferenceGeometry = planeGeometry->GetReferenceGeometry();
+  key.ReferenceGeometryMTime = nullptr != key.ReferenceGeometry ? key.ReferenceGeometry->GetMTime() : 0;
+  key.TimeStep = timeStep;
+  key.InterpolationMode = interpolationMode;
+  key.ThickSlicesMode = thickSlicesMode;
+  key.ThickSlicesNum = thickSlicesNum;
+  key.InPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+
+  const auto *transform = planeGeometry->GetIndexToWorldTransform();
+  const auto &matrix = transform->GetMatrix();
+  const auto &offset = transform->GetOffset();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+      key.PlaneTransform[i * 3 + j] = matrix[i][j];
+    key.PlaneTransform[9 + i] = offset[i];
+  }
+
+  const auto &bounds = planeGeometry->GetBounds();
+  std::copy(bounds.Begin(), bounds.End(), key.PlaneBounds.begin());
+
+  return key;
+}
+
+const mitk::ImageSliceCache::EntryType *mitk::ImageSliceCache::Find(const KeyType &key)
+{
+  auto iter = m_Entries.find(key);
+  if (iter == m_Entries.end())
+    return nullptr;
+
+  m_RecentlyUsed.splice(m_RecentlyUsed.begin(), m_RecentlyUsed, iter->second.second);
+  return &iter->second.first;
+}
+
+const mitk::ImageSliceCache::EntryType *mitk::ImageSliceCache::Insert(const KeyType &key,
+                                                                      vtkImageData *slice,
+                                                                      const ScalarType *spacing)
+{
+  if (nullptr == slice || 0 == m_MaximumSize)
+    return nullptr;
+
+  // Slices of outdated versions of the image will never be requested again
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+  {
+    if (iter->first.ImagePointer == key.ImagePointer &&
+        (iter->first.ImageMTime != key.ImageMTime || iter->first.ImageGeometryMTime != key.ImageGeometryMTime))
+    {
+      auto next = std::next(iter);
+      this->Remove(iter);
+      iter = next;
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+
+  auto existing = m_Entries.find(key);
+  if (existing != m_Entries.end())
+    this->Remove(existing);
+
+  EntryType entry;
+  entry.Slice = vtkSmartPointer<vtkImageData>::New();
+  entry.Slice->DeepCopy(slice);
+  entry.Spacing[0] = spacing[0];
+  entry.Spacing[1] = spacing[1];
+
+  m_RecentlyUsed.push_front(key);
+  auto inserted = m_Entries.emplace(key, std::make_pair(entry, m_RecentlyUsed.begin())).first;
+  m_Size += static_cast<size_t>(entry.Slice->GetActualMemorySize()) * 1024;
+
+  this->Shrink();
+
+  // A single slice larger than the cache is kept until the next insertion
+  return &inserted->second.first;
+}
+
+void mitk::ImageSliceCache::Clear()
+{
+  m_Entries.clear();
+  m_RecentlyUsed.clear();
+  m_Size = 0;
+}
+
+void mitk::ImageSliceCache::SetMaximumSize(size_t size)
+{
+  m_MaximumSize = size;
+  if (0 == m_MaximumSize)
+    this->Clear();
+  else
+    this->Shrink();
+}
+
+size_t mitk::ImageSliceCache::GetMaximumSize() const
+{
+  return m_MaximumSize;
+}
+
+size_t mitk::ImageSliceCache::GetSize() const
+{
+  return m_Size;
+}
+
+size_t mitk::ImageSliceCache::GetNumberOfEntries() const
+{
+  return m_Entries.size();
+}
+
+void mitk::ImageSliceCache::Remove(EntryMapType::iterator iter)
+{
+  m_Size -= static_cast<size_t>(iter->second.first.Slice->GetActualMemorySize()) * 1024;
+  m_RecentlyUsed.erase(iter->second.second);
+  m_Entries.erase(iter);
+}
+
+void mitk::ImageSliceCache::Shrink()
+{
+  while (m_Size > m_MaximumSize && m_Entries.size() > 1)
+  {
+    this->Remove(m_Entries.find(m_RecentlyUsed.back()));
+  }
+}
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
@@ -55,8 +56,13 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <algorithm>
+
 namespace
 {
+  /** Maximum number of pixels of slices resliced at a reduced resolution during interaction. */
+  const unsigned long ReducedResolutionNumberOfPixels = 512 * 512;
+
   bool IsBinaryImage(mitk::Image* image)
   {
     if (nullptr != image && image->IsInitialized())
@@ -188,14 +194,27 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     return;
   }
 
+  // zoomed-out views are resliced from a coarser level of the multi-resolution pyramid, if there is one
+  Image::Pointer resliceInput = image;
+  localStorage->m_PyramidLevel = this->SelectPyramidLevel(renderer);
+  if (0 != localStorage->m_PyramidLevel)
+  {
+    resliceInput = image->GetPyramid()->GetLevel(image, localStorage->m_PyramidLevel);
+    if (resliceInput.IsNull())
+    {
+      resliceInput = image;
+      localStorage->m_PyramidLevel = 0;
+    }
+  }
+
   // set main input for ExtractSliceFilter
-  localStorage->m_Reslicer->SetInput(image);
+  localStorage->m_Reslicer->SetInput(resliceInput);
   localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
   localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
 
   // set the transformation of the image to adapt reslice axis
   localStorage->m_Reslicer->SetResliceTransformByGeometry(
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+    resliceInput->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
 
   // is the geometry of the slice based on the input image or the worldgeometry?
   bool inPlaneResampleExtentByGeometry = false;
@@ -204,6 +223,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  auto interpolation = ExtractSliceFilter::RESLICE_NEAREST;
   if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
@@ -218,20 +238,17 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     switch (interpolationMode)
     {
       case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        interpolation = ExtractSliceFilter::RESLICE_NEAREST;
         break;
       case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        interpolation = ExtractSliceFilter::RESLICE_LINEAR;
         break;
       case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        interpolation = ExtractSliceFilter::RESLICE_CUBIC;
         break;
     }
   }
-  else
-  {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-  }
+  localStorage->m_Reslicer->SetInterpolationMode(interpolation);
 
   // set the vtk output property to true, makes sure that no unneeded mitk image convertion
   // is done.
@@ -267,7 +284,37 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
-  if (thickSlicesMode > 0)
+  // During interaction, large slices are resliced at a reduced resolution first. The RenderingManager
+  // requests the next level of detail once the interaction has settled.
+  auto *renderingManager = RenderingManager::GetInstance();
+  const bool reducedResolution = !renderingManager->GetLODIncreaseBlocked() &&
+                                 0 < renderer->GetNumberOfVisibleLODEnabledMappers() &&
+                                 this->IsLODEnabled(renderer) && 0 == renderingManager->GetNextLOD(renderer);
+  localStorage->m_Reslicer->SetMaximumNumberOfOutputPixels(reducedResolution ? ReducedResolutionNumberOfPixels : 0);
+
+  // Slices on curved planes depend on more than the plane geometry and are not cached
+  const bool useSliceCache =
+    nullptr != planeGeometry && nullptr == dynamic_cast<const AbstractTransformGeometry *>(worldGeometry);
+  ImageSliceCache::KeyType sliceCacheKey;
+  const ImageSliceCache::EntryType *cachedSlice = nullptr;
+  if (useSliceCache)
+  {
+    sliceCacheKey = ImageSliceCache::CreateKey(resliceInput,
+                                               planeGeometry,
+                                               this->GetTimestep(),
+                                               interpolation,
+                                               thickSlicesMode,
+                                               thickSlicesNum,
+                                               inPlaneResampleExtentByGeometry);
+    cachedSlice = m_SliceCache.Find(sliceCacheKey);
+  }
+
+  if (nullptr != cachedSlice)
+  {
+    // the slice has been resliced before, by this or another render window
+    localStorage->m_ReslicedImage = cachedSlice->Slice;
+  }
+  else if (thickSlicesMode > 0)
   {
     double dataZSpacing = 1.0;
 
@@ -288,7 +335,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     }
     normal.Normalize();
 
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep())->WorldToIndex(normal, normInIndex);
+    resliceInput->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep())->WorldToIndex(normal, normInIndex);
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
@@ -323,6 +370,18 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
   }
 
+  // full resolution slices from the cache are preferred to reduced resolution slices
+  localStorage->m_ReducedResolution = reducedResolution && nullptr == cachedSlice;
+
+  if (useSliceCache && nullptr == cachedSlice && !localStorage->m_ReducedResolution)
+  {
+    // keep a copy of the slice, the output of the reslicer is overwritten by the next update
+    cachedSlice = m_SliceCache.Insert(
+      sliceCacheKey, localStorage->m_ReslicedImage, localStorage->m_Reslicer->GetOutputSpacing());
+    if (nullptr != cachedSlice)
+      localStorage->m_ReslicedImage = cachedSlice->Slice;
+  }
+
   // Bounds information for reslicing (only reuqired if reference geometry
   // is present)
   // this used for generating a vtkPLaneSource with the right size
@@ -334,7 +393,17 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
 
   // get the spacing of the slice
-  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  if (nullptr != cachedSlice)
+  {
+    std::copy(cachedSlice->Spacing.begin(), cachedSlice->Spacing.end(), localStorage->m_SliceSpacing);
+  }
+  else
+  {
+    std::copy(localStorage->m_Reslicer->GetOutputSpacing(),
+              localStorage->m_Reslicer->GetOutputSpacing() + 2,
+              localStorage->m_SliceSpacing);
+  }
+  localStorage->m_mmPerPixel = localStorage->m_SliceSpacing;
 
   // calculate minimum bounding rect of IMAGE in texture
   {
@@ -711,7 +780,9 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()))
+      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()) ||
+      (localStorage->m_ReducedResolution && 0 != RenderingManager::GetInstance()->GetNextLOD(renderer)) ||
+      (localStorage->m_PyramidLevel != this->SelectPyramidLevel(renderer)))
   {
     this->GenerateDataForRenderer(renderer);
   }
@@ -721,6 +792,33 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   localStorage->m_LastUpdateTime.Modified();
 }
 
+unsigned int mitk::ImageVtkMapper2D::SelectPyramidLevel(mitk::BaseRenderer *renderer) const
+{
+  const auto *image = dynamic_cast<const Image *>(this->GetDataNode()->GetData());
+  if (nullptr == image || nullptr == image->GetPyramid())
+    return 0;
+
+  return image->GetPyramid()->SelectLevel(image, renderer->GetScaleFactorMMPerDisplayUnit());
+}
+
+bool mitk::ImageVtkMapper2D::IsLODEnabled(mitk::BaseRenderer *renderer) const
+{
+  bool levelOfDetail = false;
+  if (!this->GetDataNode()->GetBoolProperty("level of detail", levelOfDetail, renderer) || !levelOfDetail)
+    return false;
+
+  const auto *image = dynamic_cast<const Image *>(this->GetDataNode()->GetData());
+  if (nullptr == image || !image->IsInitialized())
+    return false;
+
+  // small slices are resliced fast enough at full resolution
+  const unsigned long dimensions[3] = {
+    image->GetDimension(0), image->GetDimension(1), image->GetDimension() > 2 ? image->GetDimension(2) : 1};
+  const auto largestSlice = std::max({dimensions[0] * dimensions[1], dimensions[0] * dimensions[2], dimensions[1] * dimensions[2]});
+
+  return largestSlice > ReducedResolutionNumberOfPixels;
+}
+
 void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer, bool overwrite)
 {
   mitk::Image::Pointer image = dynamic_cast<mitk::Image *>(node->GetData());
@@ -738,6 +836,7 @@ void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::Ba
     node->AddProperty("reslice interpolation", mitk::VtkResliceInterpolationProperty::New());
   node->AddProperty("texture interpolation", mitk::BoolProperty::New(false));
   node->AddProperty("in plane resample extent by geometry", mitk::BoolProperty::New(false));
+  node->AddProperty("level of detail", mitk::BoolProperty::New(true));
   node->AddProperty("bounding box", mitk::BoolProperty::New(false));
 
   mitk::RenderingModeProperty::Pointer renderingModeProperty = mitk::RenderingModeProperty::New();
@@ -1123,6 +1222,11 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
+  m_ReducedResolution = false;
+  m_PyramidLevel = 0;
+  m_SliceSpacing[0] = 1.0;
+  m_SliceSpacing[1] = 1.0;
+  m_mmPerPixel = m_SliceSpacing;
 
   // the following actions are always the same and thus can be performed
   // in the constructor for each image (i.e. the image-corresponding local storage)
@@ -37,6 +37,11 @@ set(MODULE_TESTS
   mitkGeometryDataToSurfaceFilterTest.cpp
   mitkImageCastTest.cpp
   mitkImageDataItemTest.cpp
+  mitkImageDataBackingStoreTest.cpp
+  mitkImageVolumeLoaderTest.cpp
+  mitkImageSliceCacheTest.cpp
+  mitkImagePyramidTest.cpp
+  mitkStandaloneDataStorageIndexTest.cpp
   mitkImageGeneratorTest.cpp
   mitkIOUtilTest.cpp
   mitkBaseDataTest.cpp
@@ -84,6 +89,8 @@ set(MODULE_TESTS
   mitkClippedSurfaceBoundsCalculatorTest.cpp
   mitkExceptionTest.cpp
   mitkExtractSliceFilterTest.cpp
+  mitkResliceEngineTest.cpp
+  mitkParallelForTest.cpp
   mitkLogTest.cpp
   mitkImageDimensionConverterTest.cpp
   mitkLoggingAdapterTest.cpp
@@ -428,6 +428,37 @@ public:
     PixelvalueBasedTestByPlane(imageInMitk, mitk::PlaneGeometry::Axial);
   }
 
+  static void MaximumNumberOfOutputPixelsTest()
+  {
+    mitk::Image::Pointer image = mitk::Image::New();
+    unsigned int dimensions[3] = {32, 32, 32};
+    image->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(image->GetGeometry(), mitk::PlaneGeometry::Axial, 16);
+
+    mitk::ExtractSliceFilter::Pointer slicer = mitk::ExtractSliceFilter::New();
+    slicer->SetInput(image);
+    slicer->SetWorldGeometry(plane);
+    slicer->SetMaximumNumberOfOutputPixels(16 * 16);
+    slicer->Update();
+
+    mitk::Image::Pointer slice = slicer->GetOutput();
+    MITK_TEST_CONDITION(slice->GetDimension(0) == 16 && slice->GetDimension(1) == 16,
+                        "Testing reduced number of slice pixels");
+    MITK_TEST_CONDITION(mitk::Equal(slicer->GetOutputSpacing()[0], 2.0) &&
+                          mitk::Equal(slicer->GetOutputSpacing()[1], 2.0),
+                        "Testing coarser spacing of the reduced slice");
+
+    slicer->SetMaximumNumberOfOutputPixels(0);
+    slicer->Modified();
+    slicer->Update();
+
+    slice = slicer->GetOutput();
+    MITK_TEST_CONDITION(slice->GetDimension(0) == 32 && slice->GetDimension(1) == 32,
+                        "Testing full number of slice pixels without limit");
+  }
+
   static void PixelvalueBasedTestByPlane(mitk::Image *imageInMitk, mitk::PlaneGeometry::PlaneOrientation orientation)
   {
     typedef itk::Image<unsigned short, 3> ImageType;
@@ -826,6 +857,9 @@ int mitkExtractSliceFilterTest(int /*argc*/, char * /*argv*/ [])
   // pixelvalue based testing
   mitkExtractSliceFilterTestClass::PixelvalueBasedTest();
 
+  // limited number of output pixels
+  mitkExtractSliceFilterTestClass::MaximumNumberOfOutputPixelsTest();
+
   // initialize sphere test volume
   mitkExtractSliceFilterTestClass::InitializeTestVolume();
 
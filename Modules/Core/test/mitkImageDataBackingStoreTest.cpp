@@ -0,0 +1,166 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageDataBackingStore.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkPixelType.h>
+
+#include <array>
+
+namespace
+{
+  const unsigned int Size = 64;
+  const unsigned int TimeSteps = 6;
+  const size_t VolumeSize = Size * Size * Size * sizeof(short);
+
+  itk::Index<3> MakeIndex(unsigned int t)
+  {
+    itk::Index<3> index;
+    index[0] = t;
+    index[1] = t + 1;
+    index[2] = t + 2;
+    return index;
+  }
+}
+
+class mitkImageDataBackingStoreTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageDataBackingStoreTestSuite);
+  MITK_TEST(Allocate_LargeBuffer_IsMapped);
+  MITK_TEST(Allocate_SmallBuffer_IsNotMapped);
+  MITK_TEST(Image_WithMappedStore_KeepsContentOfEvictedTimeSteps);
+  MITK_TEST(Touch_ExceedingBudget_EvictsLeastRecentlyUsed);
+  MITK_TEST(GetSliceData_OfExistingVolume_TouchesVolume);
+  MITK_TEST(Image_Destroyed_ReleasesMappedMemory);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::MappedFileImageDataBackingStore::Pointer m_Store;
+
+  mitk::Image::Pointer CreateImage()
+  {
+    auto image = mitk::Image::New();
+    std::array<unsigned int, 4> dimensions = {{Size, Size, Size, TimeSteps}};
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions.data());
+    image->SetBackingStore(m_Store);
+    return image;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Store = mitk::MappedFileImageDataBackingStore::New();
+  }
+
+  void tearDown() override { m_Store = nullptr; }
+
+  void Allocate_LargeBuffer_IsMapped()
+  {
+    auto *data = m_Store->Allocate(VolumeSize);
+    CPPUNIT_ASSERT(data != nullptr);
+    CPPUNIT_ASSERT_EQUAL(VolumeSize, m_Store->GetMappedSize());
+
+    data[0] = 1;
+    data[VolumeSize - 1] = 2;
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(1), data[0]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(2), data[VolumeSize - 1]);
+
+    m_Store->Release(data, VolumeSize);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), m_Store->GetMappedSize());
+  }
+
+  void Allocate_SmallBuffer_IsNotMapped()
+  {
+    m_Store->SetMinimumMappedSize(1024);
+    auto *data = m_Store->Allocate(16);
+    CPPUNIT_ASSERT(data != nullptr);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), m_Store->GetMappedSize());
+    m_Store->Release(data, 16);
+  }
+
+  void Image_WithMappedStore_KeepsContentOfEvictedTimeSteps()
+  {
+    m_Store->SetResidencyBudget(2 * VolumeSize);
+    auto image = this->CreateImage();
+
+    for (unsigned int t = 0; t < TimeSteps; ++t)
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> writeAccess(image, image->GetVolumeData(t));
+      writeAccess.SetPixelByIndex(MakeIndex(t), static_cast<short>(100 + t));
+    }
+
+    CPPUNIT_ASSERT(m_Store->GetMappedSize() > 0);
+    CPPUNIT_ASSERT(m_Store->GetResidentSize() <= 2 * VolumeSize);
+
+    for (unsigned int t = 0; t < TimeSteps; ++t)
+    {
+      mitk::ImagePixelReadAccessor<short, 3> readAccess(image, image->GetVolumeData(t));
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(100 + t), readAccess.GetPixelByIndex(MakeIndex(t)));
+    }
+  }
+
+  void Touch_ExceedingBudget_EvictsLeastRecentlyUsed()
+  {
+    m_Store->SetResidencyBudget(VolumeSize);
+    auto image = this->CreateImage();
+
+    image->GetVolumeData(0);
+    CPPUNIT_ASSERT_EQUAL(VolumeSize, m_Store->GetResidentSize());
+
+    image->GetVolumeData(1);
+    CPPUNIT_ASSERT_EQUAL(VolumeSize, m_Store->GetResidentSize());
+
+    // Touching the same time step again must not be counted twice
+    image->GetVolumeData(1);
+    CPPUNIT_ASSERT_EQUAL(VolumeSize, m_Store->GetResidentSize());
+
+    m_Store->SetResidencyBudget(0);
+    image->GetVolumeData(2);
+    CPPUNIT_ASSERT_EQUAL(2 * VolumeSize, m_Store->GetResidentSize());
+  }
+
+  void GetSliceData_OfExistingVolume_TouchesVolume()
+  {
+    m_Store->SetResidencyBudget(VolumeSize);
+    auto image = this->CreateImage();
+
+    image->GetVolumeData(0);
+    image->GetVolumeData(1);
+    m_Store->SetResidencyBudget(0);
+
+    // the slice counts as its whole time step, which is already resident
+    image->GetSliceData(Size / 2, 1);
+    CPPUNIT_ASSERT_EQUAL(VolumeSize, m_Store->GetResidentSize());
+
+    // time step 0 was evicted before and is resident again
+    image->GetSliceData(Size / 2, 0);
+    CPPUNIT_ASSERT_EQUAL(2 * VolumeSize, m_Store->GetResidentSize());
+  }
+
+  void Image_Destroyed_ReleasesMappedMemory()
+  {
+    auto image = this->CreateImage();
+    image->GetVolumeData(0);
+    CPPUNIT_ASSERT(m_Store->GetMappedSize() > 0);
+
+    image = nullptr;
+    CPPUNIT_ASSERT_EQUAL(size_t(0), m_Store->GetMappedSize());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), m_Store->GetResidentSize());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageDataBackingStore)
@@ -0,0 +1,203 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePyramid.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPixelType.h>
+
+#include <itkCommand.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class mitkImagePyramidTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImagePyramidTestSuite);
+  MITK_TEST(Update_IsotropicImage_AveragesBlocks);
+  MITK_TEST(Update_IsotropicImage_LevelsCoverImageRegion);
+  MITK_TEST(Update_AnisotropicImage_KeepsCoarseAxis);
+  MITK_TEST(GetLevel_ModifiedImage_ReturnsNull);
+  MITK_TEST(SelectLevel_MillimetersPerPixel_ReturnsCoarsestSufficientLevel);
+  MITK_TEST(StartBackgroundUpdate_Image_BuildsAllLevels);
+  MITK_TEST(StartBackgroundUpdate_ReleasedImage_IsDestroyedByWorker);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::ImagePyramid::Pointer m_Pyramid;
+
+  /** Voxel values are a linear function of the index, so block averages equal the value at the block center. */
+  static mitk::Image::Pointer CreateImage(unsigned int width, unsigned int height, unsigned int depth)
+  {
+    auto image = mitk::Image::New();
+    std::array<unsigned int, 3> dimensions = {{width, height, depth}};
+    image->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimensions.data());
+
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<float *>(writeAccess.GetData());
+
+    for (unsigned int z = 0; z < depth; ++z)
+      for (unsigned int y = 0; y < height; ++y)
+        for (unsigned int x = 0; x < width; ++x)
+          *data++ = x + 2.0f * y + 4.0f * z;
+
+    return image;
+  }
+
+  static void SetDeleted(itk::Object *, const itk::EventObject &, void *clientData)
+  {
+    *static_cast<std::atomic<bool> *>(clientData) = true;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = CreateImage(256, 256, 4);
+    m_Pyramid = mitk::ImagePyramid::New();
+    m_Image->SetPyramid(m_Pyramid);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Pyramid = nullptr;
+  }
+
+  void Update_IsotropicImage_AveragesBlocks()
+  {
+    m_Pyramid->Update(m_Image);
+
+    CPPUNIT_ASSERT(m_Pyramid->IsUpToDate(m_Image));
+    CPPUNIT_ASSERT_EQUAL(3u, m_Pyramid->GetNumberOfAvailableLevels(m_Image));
+
+    mitk::Image::Pointer level = m_Pyramid->GetLevel(m_Image, 1);
+    CPPUNIT_ASSERT(level.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(128u, level->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(128u, level->GetDimension(1));
+    CPPUNIT_ASSERT_EQUAL(2u, level->GetDimension(2));
+
+    mitk::ImagePixelReadAccessor<float, 3> readAccess(level);
+    itk::Index<3> index;
+    index[0] = 5;
+    index[1] = 7;
+    index[2] = 1;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.5 + 2.0 * 14.5 + 4.0 * 2.5, readAccess.GetPixelByIndex(index), 1e-4);
+
+    CPPUNIT_ASSERT(m_Pyramid->GetLevel(m_Image, 0) == m_Image);
+    CPPUNIT_ASSERT(m_Pyramid->GetLevel(m_Image, 3).IsNull());
+  }
+
+  void Update_IsotropicImage_LevelsCoverImageRegion()
+  {
+    m_Pyramid->Update(m_Image);
+
+    mitk::Image::Pointer level = m_Pyramid->GetLevel(m_Image, 2);
+    CPPUNIT_ASSERT(level.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(64u, level->GetDimension(0));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, level->GetGeometry()->GetSpacing()[0], mitk::eps);
+
+    // the first voxel of level 2 is centered in the first block of 4x4x4 voxels of the image
+    mitk::Point3D blockCenter;
+    mitk::FillVector3D(blockCenter, 1.5, 1.5, 1.5);
+    m_Image->GetGeometry()->IndexToWorld(blockCenter, blockCenter);
+    CPPUNIT_ASSERT(mitk::Equal(blockCenter, level->GetGeometry()->GetOrigin()));
+
+    for (unsigned int i = 0; i < 3; ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(m_Image->GetGeometry()->GetExtentInMM(i), level->GetGeometry()->GetExtentInMM(i), mitk::eps);
+  }
+
+  void Update_AnisotropicImage_KeepsCoarseAxis()
+  {
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 1.0, 1.0, 4.0);
+    m_Image->GetGeometry()->SetSpacing(spacing);
+
+    m_Pyramid->Update(m_Image);
+
+    mitk::Image::Pointer level = m_Pyramid->GetLevel(m_Image, 1);
+    CPPUNIT_ASSERT(level.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(128u, level->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(4u, level->GetDimension(2));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, level->GetGeometry()->GetSpacing()[2], mitk::eps);
+  }
+
+  void GetLevel_ModifiedImage_ReturnsNull()
+  {
+    m_Pyramid->Update(m_Image);
+    CPPUNIT_ASSERT(m_Pyramid->GetLevel(m_Image, 1).IsNotNull());
+
+    m_Image->Modified();
+
+    CPPUNIT_ASSERT(!m_Pyramid->IsUpToDate(m_Image));
+    CPPUNIT_ASSERT(m_Pyramid->GetLevel(m_Image, 1).IsNull());
+    CPPUNIT_ASSERT_EQUAL(1u, m_Pyramid->GetNumberOfAvailableLevels(m_Image));
+  }
+
+  void SelectLevel_MillimetersPerPixel_ReturnsCoarsestSufficientLevel()
+  {
+    m_Pyramid->Update(m_Image);
+
+    CPPUNIT_ASSERT_EQUAL(0u, m_Pyramid->SelectLevel(m_Image, 0.5));
+    CPPUNIT_ASSERT_EQUAL(0u, m_Pyramid->SelectLevel(m_Image, 1.5));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Pyramid->SelectLevel(m_Image, 2.5));
+    CPPUNIT_ASSERT_EQUAL(2u, m_Pyramid->SelectLevel(m_Image, 100.0));
+
+    CPPUNIT_ASSERT_EQUAL(0u, m_Pyramid->SelectLevelByNumberOfVoxels(m_Image, 256 * 256 * 4));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Pyramid->SelectLevelByNumberOfVoxels(m_Image, 128 * 128 * 2));
+    CPPUNIT_ASSERT_EQUAL(2u, m_Pyramid->SelectLevelByNumberOfVoxels(m_Image, 1));
+  }
+
+  void StartBackgroundUpdate_Image_BuildsAllLevels()
+  {
+    // selecting a level of an outdated pyramid starts building it
+    m_Pyramid->SelectLevel(m_Image, 100.0);
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!m_Pyramid->IsUpToDate(m_Image) && std::chrono::steady_clock::now() - start < std::chrono::seconds(30))
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    CPPUNIT_ASSERT(m_Pyramid->IsUpToDate(m_Image));
+    CPPUNIT_ASSERT_EQUAL(2u, m_Pyramid->SelectLevel(m_Image, 100.0));
+  }
+
+  void StartBackgroundUpdate_ReleasedImage_IsDestroyedByWorker()
+  {
+    std::atomic<bool> deleted(false);
+    auto command = itk::CStyleCommand::New();
+    command->SetClientData(&deleted);
+    command->SetCallback(&SetDeleted);
+
+    m_Image = CreateImage(512, 512, 64);
+    m_Image->SetPyramid(m_Pyramid);
+    m_Image->AddObserver(itk::DeleteEvent(), command);
+
+    // the worker holds the last reference to the image and, through it, to the pyramid
+    m_Pyramid->StartBackgroundUpdate(m_Image);
+    m_Pyramid = nullptr;
+    m_Image = nullptr;
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!deleted && std::chrono::steady_clock::now() - start < std::chrono::seconds(30))
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    CPPUNIT_ASSERT(deleted);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImagePyramid)
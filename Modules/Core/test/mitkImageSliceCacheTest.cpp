@@ -0,0 +1,166 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageSliceCache.h>
+#include <mitkPixelType.h>
+#include <mitkPlaneGeometry.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <array>
+
+class mitkImageSliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSliceCacheTestSuite);
+  MITK_TEST(Find_EmptyCache_ReturnsNull);
+  MITK_TEST(Insert_Slice_IsFoundAsDeepCopy);
+  MITK_TEST(Find_DifferentPlane_ReturnsNull);
+  MITK_TEST(Insert_ModifiedImage_DropsOutdatedSlices);
+  MITK_TEST(Insert_ExceedingMaximumSize_EvictsLeastRecentlyUsed);
+  MITK_TEST(SetMaximumSize_Zero_DisablesCache);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::ImageSliceCache *m_Cache;
+
+  mitk::PlaneGeometry::Pointer CreatePlane(mitk::ScalarType zPosition)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, zPosition);
+    return plane;
+  }
+
+  mitk::ImageSliceCache::KeyType CreateKey(const mitk::PlaneGeometry *plane)
+  {
+    return mitk::ImageSliceCache::CreateKey(m_Image, plane, 0, 0, 0, 1, false);
+  }
+
+  static vtkSmartPointer<vtkImageData> CreateSlice(unsigned char value)
+  {
+    auto slice = vtkSmartPointer<vtkImageData>::New();
+    slice->SetDimensions(64, 64, 1);
+    slice->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto *data = static_cast<unsigned char *>(slice->GetScalarPointer());
+    std::fill(data, data + 64 * 64, value);
+    return slice;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    std::array<unsigned int, 3> dimensions = {{64, 64, 8}};
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions.data());
+    m_Cache = new mitk::ImageSliceCache;
+  }
+
+  void tearDown() override
+  {
+    delete m_Cache;
+    m_Image = nullptr;
+  }
+
+  void Find_EmptyCache_ReturnsNull()
+  {
+    auto plane = this->CreatePlane(0);
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(plane)));
+  }
+
+  void Insert_Slice_IsFoundAsDeepCopy()
+  {
+    auto plane = this->CreatePlane(0);
+    auto slice = CreateSlice(42);
+    const mitk::ScalarType spacing[2] = {0.5, 2.0};
+
+    m_Cache->Insert(this->CreateKey(plane), slice, spacing);
+    std::fill(static_cast<unsigned char *>(slice->GetScalarPointer()),
+              static_cast<unsigned char *>(slice->GetScalarPointer()) + 64 * 64,
+              0);
+
+    const auto *entry = m_Cache->Find(this->CreateKey(plane));
+    CPPUNIT_ASSERT(nullptr != entry);
+    CPPUNIT_ASSERT(entry->Slice.GetPointer() != slice.GetPointer());
+    CPPUNIT_ASSERT_EQUAL(42, static_cast<int>(*static_cast<unsigned char *>(entry->Slice->GetScalarPointer())));
+    CPPUNIT_ASSERT_EQUAL(0.5, entry->Spacing[0]);
+    CPPUNIT_ASSERT_EQUAL(2.0, entry->Spacing[1]);
+  }
+
+  void Find_DifferentPlane_ReturnsNull()
+  {
+    auto plane = this->CreatePlane(0);
+    const mitk::ScalarType spacing[2] = {1.0, 1.0};
+    m_Cache->Insert(this->CreateKey(plane), CreateSlice(1), spacing);
+
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(this->CreatePlane(3))));
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(mitk::ImageSliceCache::CreateKey(m_Image, plane, 0, 1, 0, 1, false)));
+  }
+
+  void Insert_ModifiedImage_DropsOutdatedSlices()
+  {
+    auto plane = this->CreatePlane(0);
+    const mitk::ScalarType spacing[2] = {1.0, 1.0};
+    m_Cache->Insert(this->CreateKey(plane), CreateSlice(1), spacing);
+    m_Cache->Insert(this->CreateKey(this->CreatePlane(1)), CreateSlice(2), spacing);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), m_Cache->GetNumberOfEntries());
+
+    m_Image->Modified();
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(plane)));
+
+    m_Cache->Insert(this->CreateKey(plane), CreateSlice(3), spacing);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), m_Cache->GetNumberOfEntries());
+  }
+
+  void Insert_ExceedingMaximumSize_EvictsLeastRecentlyUsed()
+  {
+    const mitk::ScalarType spacing[2] = {1.0, 1.0};
+    auto plane0 = this->CreatePlane(0);
+    auto plane1 = this->CreatePlane(1);
+    auto plane2 = this->CreatePlane(2);
+
+    m_Cache->Insert(this->CreateKey(plane0), CreateSlice(0), spacing);
+    const size_t sliceSize = m_Cache->GetSize();
+    CPPUNIT_ASSERT(sliceSize > 0);
+    m_Cache->SetMaximumSize(2 * sliceSize);
+
+    m_Cache->Insert(this->CreateKey(plane1), CreateSlice(1), spacing);
+    // marks the first slice as recently used
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane0)));
+    m_Cache->Insert(this->CreateKey(plane2), CreateSlice(2), spacing);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(2), m_Cache->GetNumberOfEntries());
+    CPPUNIT_ASSERT(m_Cache->GetSize() <= m_Cache->GetMaximumSize());
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane0)));
+    CPPUNIT_ASSERT(nullptr == m_Cache->Find(this->CreateKey(plane1)));
+    CPPUNIT_ASSERT(nullptr != m_Cache->Find(this->CreateKey(plane2)));
+  }
+
+  void SetMaximumSize_Zero_DisablesCache()
+  {
+    auto plane = this->CreatePlane(0);
+    const mitk::ScalarType spacing[2] = {1.0, 1.0};
+    m_Cache->Insert(this->CreateKey(plane), CreateSlice(1), spacing);
+
+    m_Cache->SetMaximumSize(0);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), m_Cache->GetNumberOfEntries());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), m_Cache->GetSize());
+    CPPUNIT_ASSERT(nullptr == m_Cache->Insert(this->CreateKey(plane), CreateSlice(1), spacing));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSliceCache)
@@ -0,0 +1,145 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageVolumeLoader.h>
+#include <mitkPixelType.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+  const unsigned int TimeSteps = 5;
+
+  /** Fills every voxel of volume t with the value t. */
+  class TestVolumeLoader : public mitk::ImageVolumeLoader
+  {
+  public:
+    mitkClassMacro(TestVolumeLoader, mitk::ImageVolumeLoader);
+    itkFactorylessNewMacro(Self);
+
+    std::atomic<unsigned int> NumberOfReads;
+    size_t VolumeSize;
+
+  protected:
+    TestVolumeLoader() : NumberOfReads(0), VolumeSize(0) {}
+
+    void ReadVolume(int t, int, void *buffer) override
+    {
+      ++NumberOfReads;
+      auto *data = static_cast<unsigned char *>(buffer);
+      std::fill(data, data + VolumeSize, static_cast<unsigned char>(t));
+    }
+  };
+}
+
+class mitkImageVolumeLoaderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageVolumeLoaderTestSuite);
+  MITK_TEST(IsVolumeSet_PendingVolume_ReturnsTrueWithoutLoading);
+  MITK_TEST(GetVolumeData_PendingVolume_LoadsItOnce);
+  MITK_TEST(GetChannelData_PendingVolumes_LoadsAll);
+  MITK_TEST(StartBackgroundLoading_LoadsAllVolumes);
+  MITK_TEST(Initialize_RemovesLoader);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  TestVolumeLoader::Pointer m_Loader;
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    std::array<unsigned int, 4> dimensions = {{8, 8, 4, TimeSteps}};
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 4, dimensions.data());
+
+    m_Loader = TestVolumeLoader::New();
+    m_Loader->VolumeSize = 8 * 8 * 4;
+    m_Loader->InitializePendingVolumes(TimeSteps, 1);
+    m_Image->SetVolumeLoader(m_Loader);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Loader = nullptr;
+  }
+
+  void IsVolumeSet_PendingVolume_ReturnsTrueWithoutLoading()
+  {
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(2));
+    CPPUNIT_ASSERT(m_Image->IsSliceSet(1, 2));
+    CPPUNIT_ASSERT(m_Image->IsChannelSet());
+    CPPUNIT_ASSERT_EQUAL(0u, m_Loader->NumberOfReads.load());
+  }
+
+  void GetVolumeData_PendingVolume_LoadsItOnce()
+  {
+    auto volume = m_Image->GetVolumeData(3);
+    CPPUNIT_ASSERT(volume.IsNotNull());
+    CPPUNIT_ASSERT(!m_Loader->IsVolumePending(3, 0));
+    CPPUNIT_ASSERT(m_Loader->IsVolumePending(2, 0));
+
+    mitk::ImagePixelReadAccessor<unsigned char, 3> readAccess(m_Image, volume);
+    itk::Index<3> index;
+    index.Fill(1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(3), readAccess.GetPixelByIndex(index));
+
+    m_Image->GetVolumeData(3);
+    m_Image->GetSliceData(2, 3);
+    CPPUNIT_ASSERT_EQUAL(1u, m_Loader->NumberOfReads.load());
+  }
+
+  void GetChannelData_PendingVolumes_LoadsAll()
+  {
+    m_Image->GetChannelData();
+    CPPUNIT_ASSERT(!m_Loader->HasPendingVolumes());
+    CPPUNIT_ASSERT_EQUAL(TimeSteps, m_Loader->NumberOfReads.load());
+  }
+
+  void StartBackgroundLoading_LoadsAllVolumes()
+  {
+    m_Loader->StartBackgroundLoading(m_Image);
+
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (m_Loader->HasPendingVolumes() && std::chrono::steady_clock::now() < timeout)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    CPPUNIT_ASSERT(!m_Loader->HasPendingVolumes());
+    CPPUNIT_ASSERT_EQUAL(TimeSteps, m_Loader->NumberOfReads.load());
+
+    for (unsigned int t = 0; t < TimeSteps; ++t)
+    {
+      mitk::ImagePixelReadAccessor<unsigned char, 3> readAccess(m_Image, m_Image->GetVolumeData(t));
+      itk::Index<3> index;
+      index.Fill(0);
+      CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(t), readAccess.GetPixelByIndex(index));
+    }
+  }
+
+  void Initialize_RemovesLoader()
+  {
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), *m_Image->GetTimeGeometry());
+    CPPUNIT_ASSERT(m_Image->GetVolumeLoader() == nullptr);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageVolumeLoader)
@@ -0,0 +1,87 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkParallelFor.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+class mitkParallelForTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelForTestSuite);
+  MITK_TEST(ParallelFor_ManyItems_CallsFunctionOncePerItem);
+  MITK_TEST(ParallelFor_ThreadIndex_IsLessThanNumberOfThreads);
+  MITK_TEST(ParallelFor_NoItems_DoesNotCallFunction);
+  MITK_TEST(ParallelFor_FunctionThrows_RethrowsException);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void ParallelFor_ManyItems_CallsFunctionOncePerItem()
+  {
+    const std::size_t numberOfItems = 1000;
+    std::vector<std::atomic<unsigned int>> calls(numberOfItems);
+
+    for (auto &count : calls)
+      count = 0;
+
+    mitk::ParallelFor(numberOfItems, [&](std::size_t item) { ++calls[item]; });
+
+    for (const auto &count : calls)
+      CPPUNIT_ASSERT_EQUAL(1u, count.load());
+  }
+
+  void ParallelFor_ThreadIndex_IsLessThanNumberOfThreads()
+  {
+    const std::size_t numberOfItems = 100;
+    const auto numberOfThreads = mitk::GetParallelForNumberOfThreads(numberOfItems);
+    std::atomic<unsigned int> invalidThreads(0);
+
+    mitk::ParallelFor(numberOfItems, [&](std::size_t, unsigned int thread) {
+      if (thread >= numberOfThreads)
+        ++invalidThreads;
+    });
+
+    CPPUNIT_ASSERT_EQUAL(0u, invalidThreads.load());
+    CPPUNIT_ASSERT_EQUAL(1u, mitk::GetParallelForNumberOfThreads(1));
+    CPPUNIT_ASSERT_EQUAL(1u, mitk::GetParallelForNumberOfThreads(0));
+  }
+
+  void ParallelFor_NoItems_DoesNotCallFunction()
+  {
+    bool called = false;
+    mitk::ParallelFor(0, [&](std::size_t) { called = true; });
+
+    CPPUNIT_ASSERT(!called);
+  }
+
+  void ParallelFor_FunctionThrows_RethrowsException()
+  {
+    std::atomic<unsigned int> calls(0);
+
+    CPPUNIT_ASSERT_THROW(mitk::ParallelFor(1000,
+                                           [&](std::size_t item) {
+                                             ++calls;
+                                             if (10 == item)
+                                               throw std::runtime_error("item 10 failed");
+                                           }),
+                         std::runtime_error);
+
+    // the other threads stop after their current item
+    CPPUNIT_ASSERT(calls < 1000);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelFor)
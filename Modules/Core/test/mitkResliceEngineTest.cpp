@@ -0,0 +1,310 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImage.h>
+#include <mitkImageCast.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPixelType.h>
+#include <mitkPlaneGeometry.h>
+#include <mitkResliceEngine.h>
+
+#include <itkBSplineInterpolateImageFunction.h>
+#include <itkRGBPixel.h>
+
+#include <array>
+#include <vector>
+
+namespace
+{
+  const unsigned int Size = 10;
+
+  /** Voxel values are a linear function of the index, which is reproduced exactly by all interpolators. */
+  template <typename T>
+  mitk::Image::Pointer CreateImage()
+  {
+    auto image = mitk::Image::New();
+    std::array<unsigned int, 3> dimensions = {{Size, Size, Size}};
+    image->Initialize(mitk::MakeScalarPixelType<T>(), 3, dimensions.data());
+
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<T *>(writeAccess.GetData());
+
+    for (unsigned int z = 0; z < Size; ++z)
+      for (unsigned int y = 0; y < Size; ++y)
+        for (unsigned int x = 0; x < Size; ++x)
+          data[(z * Size + y) * Size + x] = static_cast<T>(x + 10 * y + 100 * z);
+
+    return image;
+  }
+
+  mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Point3D &origin,
+                                           const mitk::Vector3D &right,
+                                           const mitk::Vector3D &down,
+                                           unsigned int width,
+                                           unsigned int height)
+  {
+    mitk::Vector3D spacing;
+    spacing.Fill(1.0);
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, height, right, down, &spacing);
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+    return plane;
+  }
+
+  mitk::PlaneGeometry::Pointer CreateAxialPlane(double x, double z, unsigned int width = Size)
+  {
+    mitk::Point3D origin;
+    origin[0] = x;
+    origin[1] = 0.0;
+    origin[2] = z;
+
+    mitk::Vector3D right;
+    right[0] = 1.0;
+    right[1] = 0.0;
+    right[2] = 0.0;
+
+    mitk::Vector3D down;
+    down[0] = 0.0;
+    down[1] = 1.0;
+    down[2] = 0.0;
+
+    return CreatePlane(origin, right, down, width, Size);
+  }
+
+  mitk::PlaneGeometry::Pointer CreateObliquePlane()
+  {
+    mitk::Point3D origin;
+    origin[0] = -2.0;
+    origin[1] = 1.5;
+    origin[2] = 0.25;
+
+    mitk::Vector3D right;
+    right[0] = 1.0;
+    right[1] = 0.3;
+    right[2] = 0.4;
+
+    mitk::Vector3D down;
+    down[0] = -0.3;
+    down[1] = 1.0;
+    down[2] = 0.2;
+
+    return CreatePlane(origin, right, down, 17, 13);
+  }
+}
+
+class mitkResliceEngineTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkResliceEngineTestSuite);
+  MITK_TEST(Reslice_NearestNeighbor_ReturnsVoxelValues);
+  MITK_TEST(Reslice_LinearBetweenSlices_InterpolatesExactly);
+  MITK_TEST(Reslice_LinearIntegerPixels_Truncates);
+  MITK_TEST(Reslice_CubicBetweenSlices_InterpolatesExactly);
+  MITK_TEST(Reslice_OutsideOfVolume_ReturnsBackground);
+  MITK_TEST(Reslice_Oblique_IsIndependentOfNumberOfThreads);
+  MITK_TEST(IsPixelTypeSupported_RGBPixel_ReturnsTrue);
+  MITK_TEST(ExtractSliceFilter2_Linear_UsesResliceEngine);
+  MITK_TEST(ExtractSliceFilter2_Cubic_KeepsSecondOrderBSpline);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void Reslice_NearestNeighbor_ReturnsVoxelValues()
+  {
+    auto image = CreateImage<unsigned short>();
+    std::vector<unsigned short> output(Size * Size);
+
+    mitk::ResliceEngine engine;
+    engine.Reslice(image, 0, CreateAxialPlane(0.0, 3.4), output.data());
+
+    for (unsigned int y = 0; y < Size; ++y)
+      for (unsigned int x = 0; x < Size; ++x)
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(x + 10 * y + 300), output[y * Size + x]);
+  }
+
+  void Reslice_LinearBetweenSlices_InterpolatesExactly()
+  {
+    auto image = CreateImage<float>();
+    std::vector<float> output(Size * Size);
+
+    mitk::ResliceEngine engine;
+    engine.SetInterpolator(mitk::ResliceEngine::Linear);
+    engine.Reslice(image, 0, CreateAxialPlane(0.0, 3.5), output.data());
+
+    for (unsigned int y = 0; y < Size; ++y)
+      for (unsigned int x = 0; x < Size; ++x)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(x + 10.0 * y + 350.0, output[y * Size + x], 1e-4);
+  }
+
+  void Reslice_LinearIntegerPixels_Truncates()
+  {
+    auto image = CreateImage<unsigned short>();
+    std::vector<unsigned short> output(Size * Size);
+
+    mitk::ResliceEngine engine;
+    engine.SetInterpolator(mitk::ResliceEngine::Linear);
+    engine.Reslice(image, 0, CreateAxialPlane(0.5, 3.7), output.data());
+
+    // the interpolated values are x + 10 * y + 370.5, the last column is outside of the volume
+    for (unsigned int y = 0; y < Size; ++y)
+      for (unsigned int x = 0; x < Size - 1; ++x)
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(x + 10 * y + 370), output[y * Size + x]);
+  }
+
+  void Reslice_CubicBetweenSlices_InterpolatesExactly()
+  {
+    auto image = CreateImage<float>();
+    std::vector<float> output(Size * Size);
+
+    mitk::ResliceEngine engine;
+    engine.SetInterpolator(mitk::ResliceEngine::Cubic);
+    engine.Reslice(image, 0, CreateAxialPlane(0.0, 4.5), output.data());
+
+    // taps beyond the border repeat the border voxels, so only inner pixels are exact
+    for (unsigned int y = 1; y < Size - 1; ++y)
+      for (unsigned int x = 1; x < Size - 1; ++x)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(x + 10.0 * y + 450.0, output[y * Size + x], 1e-3);
+  }
+
+  void Reslice_OutsideOfVolume_ReturnsBackground()
+  {
+    auto image = CreateImage<short>();
+    const unsigned int width = Size + 4;
+    std::vector<short> output(width * Size);
+
+    mitk::ResliceEngine engine;
+    engine.SetBackgroundValue(-7);
+    engine.Reslice(image, 0, CreateAxialPlane(-2.0, 1.0, width), output.data());
+
+    for (unsigned int y = 0; y < Size; ++y)
+    {
+      CPPUNIT_ASSERT_EQUAL(short(-7), output[y * width]);
+      CPPUNIT_ASSERT_EQUAL(short(-7), output[y * width + 1]);
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(10 * y + 100), output[y * width + 2]);
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(9 + 10 * y + 100), output[y * width + Size + 1]);
+      CPPUNIT_ASSERT_EQUAL(short(-7), output[y * width + Size + 2]);
+      CPPUNIT_ASSERT_EQUAL(short(-7), output[y * width + Size + 3]);
+    }
+
+    engine.Reslice(image, 0, CreateAxialPlane(0.0, 12.0), output.data());
+    for (unsigned int i = 0; i < Size * Size; ++i)
+      CPPUNIT_ASSERT_EQUAL(short(-7), output[i]);
+  }
+
+  void Reslice_Oblique_IsIndependentOfNumberOfThreads()
+  {
+    auto image = CreateImage<float>();
+    auto plane = CreateObliquePlane();
+    std::vector<float> singleThreaded(17 * 13);
+    std::vector<float> multiThreaded(17 * 13);
+
+    for (auto interpolator : {mitk::ResliceEngine::NearestNeighbor, mitk::ResliceEngine::Linear, mitk::ResliceEngine::Cubic})
+    {
+      mitk::ResliceEngine engine;
+      engine.SetInterpolator(interpolator);
+      engine.SetBackgroundValue(-1.0);
+
+      engine.SetNumberOfThreads(1);
+      engine.Reslice(image, 0, plane, singleThreaded.data());
+
+      engine.SetNumberOfThreads(4);
+      engine.Reslice(image, 0, plane, multiThreaded.data());
+
+      CPPUNIT_ASSERT(singleThreaded == multiThreaded);
+    }
+
+    // the plane starts outside of the volume and leaves it again
+    CPPUNIT_ASSERT_EQUAL(-1.0f, singleThreaded.front());
+    CPPUNIT_ASSERT_EQUAL(-1.0f, singleThreaded.back());
+  }
+
+  void IsPixelTypeSupported_RGBPixel_ReturnsTrue()
+  {
+    CPPUNIT_ASSERT(mitk::ResliceEngine::IsPixelTypeSupported(mitk::MakePixelType<unsigned char, itk::RGBPixel<unsigned char>>(3)));
+    CPPUNIT_ASSERT(mitk::ResliceEngine::IsPixelTypeSupported(mitk::MakeScalarPixelType<double>()));
+  }
+
+  void ExtractSliceFilter2_Linear_UsesResliceEngine()
+  {
+    auto image = CreateImage<float>();
+
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(image);
+    filter->SetOutputGeometry(CreateAxialPlane(0.0, 2.5));
+    filter->SetInterpolator(mitk::ExtractSliceFilter2::Linear);
+    filter->Update();
+
+    mitk::Image::Pointer slice = filter->GetOutput();
+    mitk::ImagePixelReadAccessor<float, 2> readAccess(slice);
+
+    itk::Index<2> index;
+    index[0] = 3;
+    index[1] = 4;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 + 40.0 + 250.0, readAccess.GetPixelByIndex(index), 1e-4);
+  }
+
+  void ExtractSliceFilter2_Cubic_KeepsSecondOrderBSpline()
+  {
+    typedef itk::Image<float, 3> ItkImageType;
+
+    // values that are not reproduced exactly by any cubic kernel, so Catmull-Rom and B-spline differ
+    auto image = mitk::Image::New();
+    std::array<unsigned int, 3> dimensions = {{Size, Size, Size}};
+    image->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimensions.data());
+    {
+      mitk::ImageWriteAccessor writeAccess(image);
+      auto *data = static_cast<float *>(writeAccess.GetData());
+      for (unsigned int i = 0; i < Size * Size * Size; ++i)
+        data[i] = static_cast<float>((i * i) % 17);
+    }
+
+    ItkImageType::Pointer itkImage;
+    mitk::CastToItkImage(image, itkImage);
+
+    auto bSpline = itk::BSplineInterpolateImageFunction<ItkImageType>::New();
+    bSpline->SetSplineOrder(2);
+    bSpline->SetInputImage(itkImage);
+
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(image);
+    filter->SetOutputGeometry(CreateAxialPlane(0.0, 4.3));
+    filter->SetInterpolator(mitk::ExtractSliceFilter2::Cubic);
+    filter->Update();
+
+    mitk::Image::Pointer slice = filter->GetOutput();
+    mitk::ImagePixelReadAccessor<float, 2> readAccess(slice);
+
+    for (unsigned int y = 0; y < Size; ++y)
+    {
+      for (unsigned int x = 0; x < Size; ++x)
+      {
+        itk::ContinuousIndex<double, 3> continuousIndex;
+        continuousIndex[0] = x;
+        continuousIndex[1] = y;
+        continuousIndex[2] = 4.3;
+
+        itk::Index<2> index;
+        index[0] = x;
+        index[1] = y;
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(bSpline->EvaluateAtContinuousIndex(continuousIndex), readAccess.GetPixelByIndex(index), 1e-4);
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkResliceEngine)
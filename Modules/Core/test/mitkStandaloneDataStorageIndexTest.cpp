@@ -0,0 +1,280 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkDataNode.h>
+#include <mitkGeometryData.h>
+#include <mitkNodePredicateAnd.h>
+#include <mitkNodePredicateDataType.h>
+#include <mitkNodePredicateDataUID.h>
+#include <mitkNodePredicateNot.h>
+#include <mitkNodePredicateOr.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkPointSet.h>
+#include <mitkProperties.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkStringProperty.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+class mitkStandaloneDataStorageIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandaloneDataStorageIndexTestSuite);
+  MITK_TEST(GetSubset_DataTypeAndUID_ReturnsMatchingNodes);
+  MITK_TEST(GetSubset_Name_ReturnsMatchingNodes);
+  MITK_TEST(GetSubset_AndOr_MatchesUnindexedQuery);
+  MITK_TEST(GetSubset_ModifiedNodes_ReflectsChanges);
+  MITK_TEST(GetSubset_DataProperty_FallsBackOnData);
+  MITK_TEST(GetSubset_IndexedPropertyKey_ReturnsMatchingNodes);
+  MITK_TEST(GetSubset_RemovedNode_IsNotReturned);
+  MITK_TEST(Destructor_NodeOutlivesDataStorage_CanBeModified);
+  MITK_TEST(GetAll_ConcurrentWriter_ReturnsStableSnapshots);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+  mitk::DataNode::Pointer m_PointSetNode;
+  mitk::DataNode::Pointer m_GeometryNode;
+  mitk::DataNode::Pointer m_EmptyNode;
+
+  static mitk::DataNode::Pointer CreateNode(const std::string &name, mitk::BaseData *data)
+  {
+    auto node = mitk::DataNode::New();
+    node->SetName(name);
+    node->SetData(data);
+    return node;
+  }
+
+  /** Reference result of DataStorage::GetSubset() that checks the predicate for every node. */
+  mitk::DataStorage::SetOfObjects::ConstPointer GetUnindexedSubset(const mitk::NodePredicateBase *condition) const
+  {
+    auto result = mitk::DataStorage::SetOfObjects::New();
+    auto all = m_DataStorage->GetAll();
+
+    for (const auto &node : *all)
+    {
+      if (condition->CheckNode(node))
+        result->push_back(node);
+    }
+
+    return result.GetPointer();
+  }
+
+  static bool Contains(const mitk::DataStorage::SetOfObjects *set, const mitk::DataNode *node)
+  {
+    return std::find(set->begin(), set->end(), node) != set->end();
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+
+    m_PointSetNode = CreateNode("points", mitk::PointSet::New());
+    m_GeometryNode = CreateNode("geometry", mitk::GeometryData::New());
+    m_EmptyNode = mitk::DataNode::New();
+    m_EmptyNode->SetName("points");
+
+    m_DataStorage->Add(m_PointSetNode);
+    m_DataStorage->Add(m_GeometryNode);
+    m_DataStorage->Add(m_EmptyNode);
+
+    for (int i = 0; i < 10; ++i)
+      m_DataStorage->Add(CreateNode("points " + std::to_string(i), mitk::PointSet::New()));
+  }
+
+  void tearDown() override
+  {
+    m_DataStorage = nullptr;
+    m_PointSetNode = nullptr;
+    m_GeometryNode = nullptr;
+    m_EmptyNode = nullptr;
+  }
+
+  void GetSubset_DataTypeAndUID_ReturnsMatchingNodes()
+  {
+    auto pointSets = m_DataStorage->GetSubset(mitk::NodePredicateDataType::New("PointSet"));
+    CPPUNIT_ASSERT_EQUAL(11u, pointSets->Size());
+    CPPUNIT_ASSERT(!Contains(pointSets, m_EmptyNode));
+
+    auto geometries = m_DataStorage->GetSubset(mitk::NodePredicateDataType::New("GeometryData"));
+    CPPUNIT_ASSERT_EQUAL(1u, geometries->Size());
+    CPPUNIT_ASSERT(geometries->front() == m_GeometryNode);
+
+    auto byUID = m_DataStorage->GetSubset(mitk::NodePredicateDataUID::New(m_GeometryNode->GetData()->GetUID()));
+    CPPUNIT_ASSERT_EQUAL(1u, byUID->Size());
+    CPPUNIT_ASSERT(byUID->front() == m_GeometryNode);
+
+    CPPUNIT_ASSERT_EQUAL(0u, m_DataStorage->GetSubset(mitk::NodePredicateDataType::New("Image"))->Size());
+  }
+
+  void GetSubset_Name_ReturnsMatchingNodes()
+  {
+    auto nodes = m_DataStorage->GetSubset(mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("points")));
+    CPPUNIT_ASSERT_EQUAL(2u, nodes->Size());
+    CPPUNIT_ASSERT(Contains(nodes, m_PointSetNode));
+    CPPUNIT_ASSERT(Contains(nodes, m_EmptyNode));
+
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("geometry") == m_GeometryNode);
+    CPPUNIT_ASSERT(nullptr == m_DataStorage->GetNamedNode("unknown"));
+  }
+
+  void GetSubset_AndOr_MatchesUnindexedQuery()
+  {
+    auto isPointSet = mitk::NodePredicateDataType::New("PointSet");
+    auto isGeometry = mitk::NodePredicateDataType::New("GeometryData");
+    auto isNamedPoints = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("points"));
+    auto isNotNamedPoints = mitk::NodePredicateNot::New(isNamedPoints);
+
+    std::vector<mitk::NodePredicateBase::Pointer> predicates = {
+      mitk::NodePredicateAnd::New(isPointSet, isNamedPoints).GetPointer(),
+      mitk::NodePredicateAnd::New(isPointSet, isNotNamedPoints).GetPointer(),
+      mitk::NodePredicateOr::New(isGeometry, isNamedPoints).GetPointer(),
+      mitk::NodePredicateOr::New(isGeometry, isNotNamedPoints).GetPointer()};
+
+    for (const auto &predicate : predicates)
+    {
+      auto expected = this->GetUnindexedSubset(predicate);
+      auto result = m_DataStorage->GetSubset(predicate);
+
+      CPPUNIT_ASSERT_EQUAL(expected->Size(), result->Size());
+      CPPUNIT_ASSERT(std::equal(expected->begin(), expected->end(), result->begin()));
+    }
+  }
+
+  void GetSubset_ModifiedNodes_ReflectsChanges()
+  {
+    auto isRenamed = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("renamed"));
+
+    m_GeometryNode->SetName("renamed");
+    auto nodes = m_DataStorage->GetSubset(isRenamed);
+    CPPUNIT_ASSERT_EQUAL(1u, nodes->Size());
+    CPPUNIT_ASSERT(nodes->front() == m_GeometryNode);
+
+    // modifying the property object directly does not modify the node
+    auto nameProperty = dynamic_cast<mitk::StringProperty *>(m_PointSetNode->GetProperty("name"));
+    CPPUNIT_ASSERT(nullptr != nameProperty);
+    nameProperty->SetValue("renamed");
+    CPPUNIT_ASSERT_EQUAL(2u, m_DataStorage->GetSubset(isRenamed)->Size());
+
+    m_EmptyNode->SetData(mitk::GeometryData::New());
+    auto geometries = m_DataStorage->GetSubset(mitk::NodePredicateDataType::New("GeometryData"));
+    CPPUNIT_ASSERT_EQUAL(2u, geometries->Size());
+    CPPUNIT_ASSERT(Contains(geometries, m_EmptyNode));
+
+    m_GeometryNode->SetData(mitk::PointSet::New());
+    geometries = m_DataStorage->GetSubset(mitk::NodePredicateDataType::New("GeometryData"));
+    CPPUNIT_ASSERT_EQUAL(1u, geometries->Size());
+  }
+
+  void GetSubset_DataProperty_FallsBackOnData()
+  {
+    m_PointSetNode->GetData()->SetProperty("organ", mitk::StringProperty::New("liver"));
+    m_DataStorage->AddIndexedPropertyKey("organ");
+    m_GeometryNode->SetStringProperty("organ", "liver");
+
+    auto nodes = m_DataStorage->GetSubset(mitk::NodePredicateProperty::New("organ", mitk::StringProperty::New("liver")));
+    CPPUNIT_ASSERT_EQUAL(2u, nodes->Size());
+    CPPUNIT_ASSERT(Contains(nodes, m_PointSetNode));
+    CPPUNIT_ASSERT(Contains(nodes, m_GeometryNode));
+  }
+
+  void GetSubset_IndexedPropertyKey_ReturnsMatchingNodes()
+  {
+    m_DataStorage->AddIndexedPropertyKey("layer");
+    CPPUNIT_ASSERT(m_DataStorage->GetIndexedPropertyKeys().count("name") > 0);
+    CPPUNIT_ASSERT(m_DataStorage->GetIndexedPropertyKeys().count("layer") > 0);
+
+    m_PointSetNode->SetIntProperty("layer", 3);
+    m_GeometryNode->SetIntProperty("layer", 4);
+
+    auto nodes = m_DataStorage->GetSubset(mitk::NodePredicateProperty::New("layer", mitk::IntProperty::New(3)));
+    CPPUNIT_ASSERT_EQUAL(1u, nodes->Size());
+    CPPUNIT_ASSERT(nodes->front() == m_PointSetNode);
+  }
+
+  void GetSubset_RemovedNode_IsNotReturned()
+  {
+    m_DataStorage->Remove(m_PointSetNode);
+
+    auto nodes = m_DataStorage->GetSubset(mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("points")));
+    CPPUNIT_ASSERT_EQUAL(1u, nodes->Size());
+    CPPUNIT_ASSERT(nodes->front() == m_EmptyNode);
+
+    m_PointSetNode->SetName("geometry");
+    auto isGeometry = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("geometry"));
+    CPPUNIT_ASSERT_EQUAL(1u, m_DataStorage->GetSubset(isGeometry)->Size());
+  }
+
+  void Destructor_NodeOutlivesDataStorage_CanBeModified()
+  {
+    m_DataStorage = nullptr;
+
+    // neither the node nor its indexed properties may notify the deleted index
+    m_PointSetNode->Modified();
+    m_PointSetNode->SetName("renamed");
+    m_PointSetNode->SetData(mitk::GeometryData::New());
+
+    CPPUNIT_ASSERT_EQUAL(std::string("renamed"), m_PointSetNode->GetName());
+  }
+
+  void GetAll_ConcurrentWriter_ReturnsStableSnapshots()
+  {
+    auto snapshot = m_DataStorage->GetAll();
+    const auto size = snapshot->Size();
+
+    std::atomic<bool> stop(false);
+    std::atomic<bool> consistent(true);
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      readers.emplace_back([&]() {
+        auto isGeometry = mitk::NodePredicateDataType::New("GeometryData");
+
+        while (!stop)
+        {
+          auto all = m_DataStorage->GetAll();
+          if (all->Size() < size ||
+              std::any_of(all->begin(), all->end(), [](const mitk::DataNode::Pointer &node) { return node.IsNull(); }))
+            consistent = false;
+
+          if (!Contains(m_DataStorage->GetSubset(isGeometry), m_GeometryNode))
+            consistent = false;
+        }
+      });
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+      auto node = CreateNode("temporary", mitk::PointSet::New());
+      m_DataStorage->Add(node);
+      m_DataStorage->Remove(node);
+    }
+
+    stop = true;
+    for (auto &reader : readers)
+      reader.join();
+
+    CPPUNIT_ASSERT(consistent);
+    CPPUNIT_ASSERT_EQUAL(size, snapshot->Size());
+    CPPUNIT_ASSERT_EQUAL(size, m_DataStorage->GetAll()->Size());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandaloneDataStorageIndex)
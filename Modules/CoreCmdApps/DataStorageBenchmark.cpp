@@ -0,0 +1,179 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkDataNode.h>
+#include <mitkGeometryData.h>
+#include <mitkNodePredicateAnd.h>
+#include <mitkNodePredicateDataType.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkPointSet.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkStringProperty.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  mitk::DataNode::Pointer CreateNode(unsigned int i)
+  {
+    auto node = mitk::DataNode::New();
+    node->SetName("node " + std::to_string(i));
+
+    if (0 == i % 10)
+      node->SetData(mitk::GeometryData::New());
+    else
+      node->SetData(mitk::PointSet::New());
+
+    return node;
+  }
+
+  struct Result
+  {
+    double QueriesPerSecond;
+    double WritesPerSecond;
+  };
+
+  /** Runs numberOfReaders threads that query the data storage while one thread (optionally) adds and removes nodes. */
+  Result Measure(mitk::StandaloneDataStorage *dataStorage,
+                 unsigned int numberOfReaders,
+                 bool withWriter,
+                 std::chrono::milliseconds duration)
+  {
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned long long> queries(0);
+    std::atomic<unsigned long long> writes(0);
+
+    auto isGeometry = mitk::NodePredicateDataType::New("GeometryData");
+    auto isNamed = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("node 42"));
+    auto isNamedPointSet = mitk::NodePredicateAnd::New(mitk::NodePredicateDataType::New("PointSet"), isNamed);
+
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < numberOfReaders; ++i)
+    {
+      threads.emplace_back([&]() {
+        unsigned long long count = 0;
+        std::size_t visitedNodes = 0;
+
+        while (!stop)
+        {
+          visitedNodes += dataStorage->GetSubset(isGeometry)->Size();
+          visitedNodes += dataStorage->GetSubset(isNamedPointSet)->Size();
+          visitedNodes += nullptr != dataStorage->GetNamedNode("node 7") ? 1 : 0;
+
+          // the snapshot stays valid while the writer replaces it
+          auto all = dataStorage->GetAll();
+          for (const auto &node : *all)
+            visitedNodes += node.IsNotNull() ? 1 : 0;
+
+          count += 4;
+        }
+
+        queries += count;
+
+        // keep the compiler from discarding the queries
+        if (0 == visitedNodes)
+          std::cerr << "No nodes visited." << std::endl;
+      });
+    }
+
+    if (withWriter)
+    {
+      threads.emplace_back([&]() {
+        unsigned long long count = 0;
+
+        while (!stop)
+        {
+          auto node = CreateNode(100000 + static_cast<unsigned int>(count));
+          dataStorage->Add(node);
+          node->SetName("renamed");
+          dataStorage->Remove(node);
+          count += 3;
+        }
+
+        writes += count;
+      });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+
+    for (auto &thread : threads)
+      thread.join();
+
+    const double seconds = std::chrono::duration<double>(duration).count();
+    return {queries / seconds, writes / seconds};
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("DataStorage Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Measures the query throughput of mitk::StandaloneDataStorage with an increasing number of "
+                        "concurrent reader threads, with and without a concurrent writer thread.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("nodes", "n", mitkCommandLineParser::Int, "Nodes:", "Number of nodes in the data storage (default: 500)", us::Any(), true);
+  parser.addArgument("readers", "r", mitkCommandLineParser::Int, "Readers:", "Maximum number of reader threads (default: hardware concurrency)", us::Any(), true);
+  parser.addArgument("duration", "d", mitkCommandLineParser::Int, "Duration:", "Duration of each measurement in milliseconds (default: 1000)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int numberOfNodes = parsedArgs.count("nodes") ? us::any_cast<int>(parsedArgs["nodes"]) : 500;
+  const unsigned int maxReaders = parsedArgs.count("readers")
+                                    ? us::any_cast<int>(parsedArgs["readers"])
+                                    : std::max(1u, std::thread::hardware_concurrency());
+  const std::chrono::milliseconds duration(parsedArgs.count("duration") ? us::any_cast<int>(parsedArgs["duration"]) : 1000);
+
+  auto dataStorage = mitk::StandaloneDataStorage::New();
+
+  for (unsigned int i = 0; i < numberOfNodes; ++i)
+    dataStorage->Add(CreateNode(i));
+
+  std::cout << std::left << std::setw(10) << "readers" << std::right << std::setw(18) << "queries/s" << std::setw(24)
+            << "queries/s (writer)" << std::setw(18) << "writes/s" << std::endl;
+
+  for (unsigned int readers = 1; readers <= maxReaders; readers *= 2)
+  {
+    const auto readOnly = Measure(dataStorage, readers, false, duration);
+    const auto readWrite = Measure(dataStorage, readers, true, duration);
+
+    std::cout << std::left << std::setw(10) << readers << std::right << std::fixed << std::setprecision(0)
+              << std::setw(18) << readOnly.QueriesPerSecond << std::setw(24) << readWrite.QueriesPerSecond
+              << std::setw(18) << readWrite.WritesPerSecond << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
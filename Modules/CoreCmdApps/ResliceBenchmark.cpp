@@ -0,0 +1,195 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+#include "mitkIOUtil.h"
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImage.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPlaneGeometry.h>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  mitk::Image::Pointer CreateTestImage(unsigned int size)
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = {size, size, size};
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<short *>(writeAccess.GetData());
+    const std::size_t numberOfPixels = static_cast<std::size_t>(size) * size * size;
+
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+      data[i] = static_cast<short>((i * 2654435761u) >> 20);
+
+    return image;
+  }
+
+  /** Plane through the center of the image, tilted by \a angle degrees around the y axis. */
+  mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Image *image, double angle)
+  {
+    const auto *geometry = image->GetGeometry();
+    const double radians = angle * std::acos(-1.0) / 180.0;
+
+    mitk::Vector3D right;
+    right[0] = std::cos(radians);
+    right[1] = 0.0;
+    right[2] = std::sin(radians);
+
+    mitk::Vector3D down;
+    down[0] = 0.0;
+    down[1] = 1.0;
+    down[2] = 0.0;
+
+    mitk::Vector3D spacing;
+    spacing.Fill(geometry->GetSpacing()[0]);
+
+    const auto width = geometry->GetExtent(0);
+    const auto height = geometry->GetExtent(1);
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, height, right, down, &spacing);
+
+    auto origin = geometry->GetCenter();
+    origin -= right * (0.5 * width * spacing[0]);
+    origin -= down * (0.5 * height * spacing[1]);
+    plane->SetOrigin(origin);
+    plane->SetReferenceGeometry(geometry);
+
+    return plane;
+  }
+
+  template <typename TFunction>
+  double MeasureMilliseconds(unsigned int repetitions, TFunction function)
+  {
+    // warm up caches and lazily initialized state
+    function();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < repetitions; ++i)
+      function();
+
+    const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    return duration.count() / repetitions;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Reslice Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Compares the reslicing performance of mitk::ExtractSliceFilter (vtkImageReslice) and "
+                        "mitk::ExtractSliceFilter2 (mitk::ResliceEngine) on axis-aligned and oblique planes.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("input", "i", mitkCommandLineParser::File, "Input file:", "3-d image to reslice. A synthetic image is used if omitted.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("size", "s", mitkCommandLineParser::Int, "Size:", "Edge length of the synthetic image (default: 512)", us::Any(), true);
+  parser.addArgument("repetitions", "r", mitkCommandLineParser::Int, "Repetitions:", "Number of slices extracted per measurement (default: 20)", us::Any(), true);
+  parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Threads:", "Number of threads of the reslice engine (default: all)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int size = parsedArgs.count("size") ? us::any_cast<int>(parsedArgs["size"]) : 512;
+  const unsigned int repetitions = parsedArgs.count("repetitions") ? us::any_cast<int>(parsedArgs["repetitions"]) : 20;
+  const unsigned int threads = parsedArgs.count("threads") ? us::any_cast<int>(parsedArgs["threads"]) : 0;
+
+  mitk::Image::Pointer image = parsedArgs.count("input")
+                                 ? mitk::IOUtil::Load<mitk::Image>(us::any_cast<std::string>(parsedArgs["input"]))
+                                 : CreateTestImage(size);
+
+  if (3 != image->GetDimension())
+  {
+    std::cerr << "Only 3-d images are supported." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const struct
+  {
+    const char *Name;
+    mitk::ExtractSliceFilter::ResliceInterpolation VtkInterpolation;
+    mitk::ExtractSliceFilter2::Interpolator Interpolator;
+  } interpolators[] = {{"nearest", mitk::ExtractSliceFilter::RESLICE_NEAREST, mitk::ExtractSliceFilter2::NearestNeighbor},
+                       {"linear", mitk::ExtractSliceFilter::RESLICE_LINEAR, mitk::ExtractSliceFilter2::Linear},
+                       {"cubic", mitk::ExtractSliceFilter::RESLICE_CUBIC, mitk::ExtractSliceFilter2::Cubic}};
+
+  const struct
+  {
+    const char *Name;
+    double Angle;
+  } planes[] = {{"axis-aligned", 0.0}, {"oblique", 30.0}};
+
+  std::cout << std::left << std::setw(14) << "plane" << std::setw(10) << "kernel" << std::right << std::setw(14)
+            << "vtk [ms]" << std::setw(14) << "engine [ms]" << std::setw(10) << "speedup" << std::endl;
+
+  for (const auto &plane : planes)
+  {
+    auto worldGeometry = CreatePlane(image, plane.Angle);
+
+    // ExtractSliceFilter2 expects pixel centered output geometries
+    auto outputGeometry = worldGeometry->Clone();
+    outputGeometry->ChangeImageGeometryConsideringOriginOffset(true);
+
+    for (const auto &interpolator : interpolators)
+    {
+      auto vtkFilter = mitk::ExtractSliceFilter::New();
+      vtkFilter->SetInput(image);
+      vtkFilter->SetWorldGeometry(worldGeometry);
+      vtkFilter->SetInterpolationMode(interpolator.VtkInterpolation);
+      vtkFilter->SetVtkOutputRequest(true);
+
+      const double vtkTime = MeasureMilliseconds(repetitions, [&vtkFilter]() {
+        vtkFilter->Modified();
+        vtkFilter->Update();
+      });
+
+      auto engineFilter = mitk::ExtractSliceFilter2::New();
+      engineFilter->SetInput(image);
+      engineFilter->SetOutputGeometry(outputGeometry);
+      engineFilter->SetInterpolator(interpolator.Interpolator);
+      if (0 != threads)
+        engineFilter->SetNumberOfThreads(threads);
+
+      const double engineTime = MeasureMilliseconds(repetitions, [&engineFilter]() {
+        engineFilter->Modified();
+        engineFilter->Update();
+      });
+
+      std::cout << std::left << std::setw(14) << plane.Name << std::setw(10) << interpolator.Name << std::right
+                << std::fixed << std::setprecision(2) << std::setw(14) << vtkTime << std::setw(14) << engineTime
+                << std::setw(9) << vtkTime / engineTime << "x" << std::endl;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
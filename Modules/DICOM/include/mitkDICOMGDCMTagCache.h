@@ -15,8 +15,11 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagCache.h"
 
+#include <map>
 #include <set>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -35,6 +38,11 @@ namespace mitk
       itkFactorylessNewMacro( DICOMGDCMTagCache );
       itkCloneMacro(Self);
 
+      /**
+        \brief Values of the tags present in a file, tags missing in the file have no entry.
+      */
+      typedef std::map<DICOMTag, std::string> TagValueMapType;
+
       DICOMDatasetFinding GetTagValue(DICOMImageFrameInfo* frame, const DICOMTag& tag) const override;
 
       FindingsListType GetTagValue(DICOMImageFrameInfo* frame, const DICOMTagPath& path) const override;
@@ -43,6 +51,17 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+        \brief Initialize the cache with the tag values of each input file.
+        The values are copied, so they may come from several scanners or a DICOMPersistentTagCache.
+        Files that could not be read have an empty map.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, const StringList& inputFiles, const std::vector<TagValueMapType>& valuesOfFiles);
+
+      /**
+        \brief Retrieve the scanner passed to InitCache().
+        @pre The cache was initialized with a scanner.
+      */
       const gdcm::Scanner& GetScanner() const;
 
   protected:
@@ -54,6 +73,9 @@ namespace mitk
 
       std::shared_ptr<gdcm::Scanner> m_Scanner;
 
+      /** Storage of the copied values, the frame infos refer to them like to the values of a gdcm::Scanner. */
+      std::set<std::string> m_Values;
+
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
     private:
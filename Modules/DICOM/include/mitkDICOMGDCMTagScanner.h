@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkDICOMTagScanner.h"
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGDCMTagCache.h"
+#include "mitkDICOMPersistentTagCache.h"
 
 namespace mitk
 {
@@ -41,6 +42,11 @@ namespace mitk
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMGDCMTagScanner before requesting the results!
 
+    The files are distributed in chunks to the threads of itk::MultiThreader,
+    each chunk is read by its own gdcm::Scanner, which reads a header only up
+    to the last requested tag. Files with valid entries in the persistent tag
+    cache (see SetPersistentTagCache()) are not read at all.
+
     @remark This scanner does only support the scanning for simple value tag.
     If you need to scann for sequence items or non-top-level elements, this scanner
     will not be sufficient. See i.a. DICOMDCMTKTagScanner for these cases.
@@ -101,6 +107,13 @@ namespace mitk
       */
       virtual DICOMDatasetFinding GetTagValue(DICOMImageFrameInfo* frame, const DICOMTag& tag) const;
 
+      /**
+        \brief Cache that is asked for the tag values before a file is read and that remembers the values of read files.
+        Initialized with DICOMPersistentTagCache::GetDefault(), nullptr disables it.
+      */
+      void SetPersistentTagCache(DICOMPersistentTagCache* cache);
+      DICOMPersistentTagCache* GetPersistentTagCache() const;
+
     protected:
 
       DICOMGDCMTagScanner();
@@ -109,7 +122,7 @@ namespace mitk
       std::set<DICOMTag> m_ScannedTags;
       StringList m_InputFilenames;
       DICOMGDCMTagCache::Pointer m_Cache;
-      std::shared_ptr<gdcm::Scanner> m_GDCMScanner;
+      DICOMPersistentTagCache::Pointer m_PersistentTagCache;
 
     private:
       DICOMGDCMTagScanner(const DICOMGDCMTagScanner&);
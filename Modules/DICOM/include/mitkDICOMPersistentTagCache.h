@@ -0,0 +1,167 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCache_h
+#define mitkDICOMPersistentTagCache_h
+
+#include "itkObjectFactory.h"
+#include "mitkCommon.h"
+
+#include "mitkDICOMTag.h"
+#include "MitkDICOMExports.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Remembers the tag values of scanned DICOM files across scans, readers and sessions.
+
+    DICOMGDCMTagScanner asks this cache before it reads the header of a file and
+    adds the values of every file it had to read. An entry is valid as long as
+    the size and the modification time of its file are unchanged and it contains
+    all tags of the scan. Entries are keyed by the absolute path of the file.
+    Modification times have the sub-second resolution of the file system where
+    the platform provides it.
+
+    In contrast to DICOMTagCache, which holds the results of one scan, this cache
+    is meant to be long living: set it as the default cache via SetDefault() to
+    let all DICOMGDCMTagScanner instances share it (e.g. the ones created by
+    DICOMITKSeriesGDCMReader and DICOMFileReaderSelector).
+
+    To reuse the values in the next session, set a file name and call Load() on
+    startup and Save() when convenient, e.g. after a DICOM import. The file is
+    written in a binary format of the local machine and is ignored if it cannot
+    be parsed.
+
+    All methods are thread-safe.
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagCache : public itk::Object
+  {
+    public:
+
+      mitkClassMacroItkParent(DICOMPersistentTagCache, itk::Object);
+      itkFactorylessNewMacro( DICOMPersistentTagCache );
+
+      /**
+        \brief Values of the tags present in a file, tags missing in the file have no entry.
+      */
+      typedef std::map<DICOMTag, std::string> TagValueMapType;
+
+      /**
+        \brief Absolute path, size and modification time (in nanoseconds) of a file.
+      */
+      struct FileStatus
+      {
+        std::string Path;
+        std::uint64_t FileSize = 0;
+        std::int64_t ModificationTime = 0;
+      };
+
+      /**
+        \brief Current status of a file.
+        \return false if the file does not exist.
+      */
+      static bool GetFileStatus(const std::string& filename, FileStatus& status);
+
+      /**
+        \brief Cache used by DICOMGDCMTagScanner instances that did not get one explicitly (nullptr by default).
+      */
+      static Pointer GetDefault();
+      static void SetDefault(DICOMPersistentTagCache* cache);
+
+      /**
+        \brief File used by Load() and Save().
+      */
+      void SetFileName(const std::string& fileName);
+      std::string GetFileName() const;
+
+      /**
+        \brief Replaces the entries by the ones of the file.
+        \return false if the file does not exist or cannot be parsed, the cache is empty then.
+      */
+      bool Load();
+
+      /**
+        \brief Writes all entries to the file (via a temporary file, so a concurrent Load() never sees a partial file).
+        \return false if the file cannot be written.
+      */
+      bool Save() const;
+
+      /**
+        \brief Retrieve the values of tags of a file.
+        \return false if there is no entry of the unchanged file that contains all tags.
+      */
+      bool GetTagValues(const std::string& filename, const std::set<DICOMTag>& tags, TagValueMapType& values) const;
+      bool GetTagValues(const FileStatus& status, const std::set<DICOMTag>& tags, TagValueMapType& values) const;
+
+      /**
+        \brief Remember the values of the scanned tags of a file.
+        Values of other tags that are stored for the unchanged file are kept.
+
+        Pass the status that was taken before the values were read: an entry stored with
+        the status after the read would stay valid for a file that changed during the read.
+        The overload with a file name takes the current status.
+      */
+      void SetTagValues(const FileStatus& status, const std::set<DICOMTag>& scannedTags, const TagValueMapType& values);
+      void SetTagValues(const std::string& filename, const std::set<DICOMTag>& scannedTags, const TagValueMapType& values);
+
+      /**
+        \brief Number of files with an entry.
+      */
+      std::size_t GetNumberOfEntries() const;
+
+      /**
+        \brief Whether there are entries that were not saved yet.
+      */
+      bool IsSaveRequired() const;
+
+      void Clear();
+
+    protected:
+
+      DICOMPersistentTagCache();
+      ~DICOMPersistentTagCache() override;
+
+      struct Entry
+      {
+        std::uint64_t FileSize = 0;
+        std::int64_t ModificationTime = 0;
+        std::set<DICOMTag> ScannedTags;
+        TagValueMapType Values;
+      };
+
+      typedef std::unordered_map<std::string, Entry> EntryMapType;
+
+      static bool ReadEntries(std::istream& stream, EntryMapType& entries);
+      static void WriteEntries(std::ostream& stream, const EntryMapType& entries);
+
+      std::string m_FileName;
+      EntryMapType m_Entries;
+      mutable bool m_SaveRequired;
+
+      mutable std::mutex m_Mutex;
+
+    private:
+      DICOMPersistentTagCache(const DICOMPersistentTagCache&);
+  };
+}
+
+#endif
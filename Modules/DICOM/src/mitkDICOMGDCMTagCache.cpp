@@ -97,8 +97,45 @@ mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const
   }
 }
 
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const StringList& inputFiles, const std::vector<TagValueMapType>& valuesOfFiles)
+{
+  if (valuesOfFiles.size() != inputFiles.size())
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::InitCache(). Got tag values of " << valuesOfFiles.size()
+                << " files for " << inputFiles.size() << " input files.";
+  }
+
+  m_ScannedTags = scannedTags;
+  m_InputFilenames = inputFiles;
+  m_Scanner.reset();
+
+  // m_Values is not cleared, frame infos of a previous initialization may still refer to it
+
+  m_ScanResult.clear();
+  m_ScanResult.reserve(m_InputFilenames.size());
+
+  for (std::size_t fileIndex = 0; fileIndex < m_InputFilenames.size(); ++fileIndex)
+  {
+    gdcm::Scanner::TagToValue mapping;
+    for (const auto& tagAndValue : valuesOfFiles[fileIndex])
+    {
+      const gdcm::Tag tag(tagAndValue.first.GetGroup(), tagAndValue.first.GetElement());
+      mapping.insert(std::make_pair(tag, m_Values.insert(tagAndValue.second).first->c_str()));
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(m_InputFilenames[fileIndex], 0),
+      mapping).GetPointer());
+  }
+}
+
 const gdcm::Scanner&
 mitk::DICOMGDCMTagCache::GetScanner() const
 {
+  if (nullptr == m_Scanner)
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::GetScanner(). The cache was not initialized with a scanner.";
+  }
+
   return *(this->m_Scanner);
 }
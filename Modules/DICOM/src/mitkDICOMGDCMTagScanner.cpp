@@ -14,11 +14,21 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMTagCache.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
+#include <mitkParallelFor.h>
+
 #include <gdcmScanner.h>
 
+#include <algorithm>
+
+namespace
+{
+  // small enough to balance the threads, large enough to make the gdcm::Scanner setup negligible
+  const std::size_t FilesPerChunk = 16;
+}
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
+: m_PersistentTagCache(DICOMPersistentTagCache::GetDefault())
 {
-  m_GDCMScanner = std::make_shared<gdcm::Scanner>();
 }
 
 mitk::DICOMGDCMTagScanner::~DICOMGDCMTagScanner()
@@ -40,9 +50,7 @@ mitk::DICOMDatasetFinding mitk::DICOMGDCMTagScanner::GetTagValue( DICOMImageFram
 
 void mitk::DICOMGDCMTagScanner::AddTag( const DICOMTag& tag )
 {
-  m_ScannedTags.insert( tag );
-  m_GDCMScanner->AddTag(
-    gdcm::Tag( tag.GetGroup(), tag.GetElement() ) ); // also a set, duplicate calls to AddTag don't hurt
+  m_ScannedTags.insert( tag ); // a set, duplicate calls to AddTag don't hurt
 }
 
 void mitk::DICOMGDCMTagScanner::AddTags( const DICOMTagList& tags )
@@ -89,14 +97,85 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
   m_InputFilenames = filenames;
 }
 
+void mitk::DICOMGDCMTagScanner::SetPersistentTagCache( DICOMPersistentTagCache* cache )
+{
+  m_PersistentTagCache = cache;
+}
+
+mitk::DICOMPersistentTagCache* mitk::DICOMGDCMTagScanner::GetPersistentTagCache() const
+{
+  return m_PersistentTagCache;
+}
 
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  const std::size_t numberOfFiles = m_InputFilenames.size();
+  const std::size_t numberOfChunks = (numberOfFiles + FilesPerChunk - 1) / FilesPerChunk;
+
+  // empty for files that could not be read, like the mapping of gdcm::Scanner
+  std::vector<DICOMGDCMTagCache::TagValueMapType> valuesOfFiles(numberOfFiles);
+
+  mitk::ParallelFor(numberOfChunks, [&](std::size_t chunk) {
+    const std::size_t firstFile = chunk * FilesPerChunk;
+    const std::size_t endFile = std::min(firstFile + FilesPerChunk, numberOfFiles);
+
+    StringList filesToRead;
+    std::vector<std::size_t> indicesToRead;
+    std::vector<DICOMPersistentTagCache::FileStatus> statusesToRead;
+
+    for (auto fileIndex = firstFile; fileIndex < endFile; ++fileIndex)
+    {
+      // taken before gdcm reads the file, so a change during the read outdates the stored entry
+      DICOMPersistentTagCache::FileStatus status;
+
+      if (m_PersistentTagCache.IsNull() ||
+          !DICOMPersistentTagCache::GetFileStatus(m_InputFilenames[fileIndex], status) ||
+          !m_PersistentTagCache->GetTagValues(status, m_ScannedTags, valuesOfFiles[fileIndex]))
+      {
+        filesToRead.push_back(m_InputFilenames[fileIndex]);
+        indicesToRead.push_back(fileIndex);
+        statusesToRead.push_back(status);
+      }
+    }
+
+    if (filesToRead.empty())
+    {
+      return;
+    }
+
+    gdcm::Scanner gdcmScanner;
+    for (const auto& tag : m_ScannedTags)
+    {
+      gdcmScanner.AddTag( gdcm::Tag( tag.GetGroup(), tag.GetElement() ) );
+    }
+
+    gdcmScanner.Scan( filesToRead );
+
+    for (std::size_t i = 0; i < filesToRead.size(); ++i)
+    {
+      const char* filename = filesToRead[i].c_str();
+      if (!gdcmScanner.IsKey(filename))
+      {
+        continue; // not readable, do not remember
+      }
+
+      auto& values = valuesOfFiles[indicesToRead[i]];
+      for (const auto& tagAndValue : gdcmScanner.GetMapping(filename))
+      {
+        values.insert(std::make_pair(DICOMTag(tagAndValue.first.GetGroup(), tagAndValue.first.GetElement()),
+          std::string(nullptr != tagAndValue.second ? tagAndValue.second : "")));
+      }
+
+      if (m_PersistentTagCache.IsNotNull())
+      {
+        m_PersistentTagCache->SetTagValues(statusesToRead[i], m_ScannedTags, values);
+      }
+    }
+  });
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  newCache->InitCache(m_ScannedTags, m_InputFilenames, valuesOfFiles);
 
   m_Cache = newCache;
 }
@@ -0,0 +1,448 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+
+#include <itksys/Encoding.hxx>
+#include <itksys/SystemTools.hxx>
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+  const char FileSignature[] = "MITKDICOMTagCache";
+  // version 2 stores modification times in nanoseconds instead of seconds
+  const std::uint32_t FileFormatVersion = 2;
+
+  // rejects files written on a machine of another byte order
+  const std::uint32_t ByteOrderMark = 0x01020304;
+
+  // no value of a header is near this length, longer strings indicate a corrupt file
+  const std::uint32_t MaximumStringLength = 1 << 26;
+
+  std::mutex& DefaultCacheMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  mitk::DICOMPersistentTagCache::Pointer& DefaultCache()
+  {
+    static mitk::DICOMPersistentTagCache::Pointer cache;
+    return cache;
+  }
+
+  template <typename T>
+  void WriteValue(std::ostream& stream, T value)
+  {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool ReadValue(std::istream& stream, T& value)
+  {
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+
+  void WriteString(std::ostream& stream, const std::string& value)
+  {
+    WriteValue(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+  }
+
+  bool ReadString(std::istream& stream, std::string& value)
+  {
+    std::uint32_t length = 0;
+    if (!ReadValue(stream, length) || length > MaximumStringLength)
+      return false;
+
+    value.resize(length);
+    return 0 == length || static_cast<bool>(stream.read(&value[0], length));
+  }
+
+  void WriteTag(std::ostream& stream, const mitk::DICOMTag& tag)
+  {
+    WriteValue(stream, static_cast<std::uint16_t>(tag.GetGroup()));
+    WriteValue(stream, static_cast<std::uint16_t>(tag.GetElement()));
+  }
+
+  /** Size and modification time in nanoseconds of a regular file, false if there is none. */
+  bool GetFileSizeAndModificationTime(const std::string& path, std::uint64_t& fileSize, std::int64_t& modificationTime)
+  {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(itksys::Encoding::ToWide(path).c_str(), GetFileExInfoStandard, &attributes)
+        || 0 != (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+      return false;
+    }
+
+    // FILETIME counts 100 ns since 1601, the offset to 1970 keeps nanoseconds in range
+    const std::int64_t fileTime = (static_cast<std::int64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32)
+      | attributes.ftLastWriteTime.dwLowDateTime;
+    modificationTime = (fileTime - 116444736000000000LL) * 100;
+    fileSize = (static_cast<std::uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+#else
+    struct stat status;
+    if (0 != stat(path.c_str(), &status) || !S_ISREG(status.st_mode))
+    {
+      return false;
+    }
+
+#ifdef __APPLE__
+    const struct timespec& time = status.st_mtimespec;
+#else
+    const struct timespec& time = status.st_mtim;
+#endif
+    modificationTime = static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+    fileSize = static_cast<std::uint64_t>(status.st_size);
+#endif
+    return true;
+  }
+
+  bool ReadTag(std::istream& stream, mitk::DICOMTag& tag)
+  {
+    std::uint16_t group = 0;
+    std::uint16_t element = 0;
+    if (!ReadValue(stream, group) || !ReadValue(stream, element))
+      return false;
+
+    tag = mitk::DICOMTag(group, element);
+    return true;
+  }
+}
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache()
+: m_SaveRequired(false)
+{
+}
+
+mitk::DICOMPersistentTagCache::~DICOMPersistentTagCache()
+{
+}
+
+mitk::DICOMPersistentTagCache::Pointer mitk::DICOMPersistentTagCache::GetDefault()
+{
+  std::lock_guard<std::mutex> lock(DefaultCacheMutex());
+  return DefaultCache();
+}
+
+void mitk::DICOMPersistentTagCache::SetDefault(DICOMPersistentTagCache* cache)
+{
+  std::lock_guard<std::mutex> lock(DefaultCacheMutex());
+  DefaultCache() = cache;
+}
+
+void mitk::DICOMPersistentTagCache::SetFileName(const std::string& fileName)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_FileName = fileName;
+}
+
+std::string mitk::DICOMPersistentTagCache::GetFileName() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_FileName;
+}
+
+bool mitk::DICOMPersistentTagCache::Load()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Entries.clear();
+  m_SaveRequired = false;
+
+  std::ifstream stream(m_FileName, std::ios::binary);
+  if (!stream)
+  {
+    return false;
+  }
+
+  EntryMapType entries;
+  if (!ReadEntries(stream, entries))
+  {
+    MITK_WARN << "Ignoring DICOM tag cache file '" << m_FileName << "', it is not a valid cache of this machine.";
+    return false;
+  }
+
+  m_Entries.swap(entries);
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCache::Save() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (m_FileName.empty())
+  {
+    MITK_ERROR << "Cannot save DICOM tag cache, no file name was set.";
+    return false;
+  }
+
+  const std::string directory = itksys::SystemTools::GetFilenamePath(m_FileName);
+  if (!directory.empty())
+  {
+    itksys::SystemTools::MakeDirectory(directory.c_str());
+  }
+
+  const std::string temporaryFileName = m_FileName + ".tmp";
+  {
+    std::ofstream stream(temporaryFileName, std::ios::binary | std::ios::trunc);
+    if (stream)
+    {
+      WriteEntries(stream, m_Entries);
+    }
+
+    if (!stream)
+    {
+      MITK_ERROR << "Cannot write DICOM tag cache file '" << temporaryFileName << "'.";
+      return false;
+    }
+  }
+
+  if (!itksys::SystemTools::RenameFile(temporaryFileName.c_str(), m_FileName.c_str()))
+  {
+    MITK_ERROR << "Cannot replace DICOM tag cache file '" << m_FileName << "'.";
+    itksys::SystemTools::RemoveFile(temporaryFileName.c_str());
+    return false;
+  }
+
+  m_SaveRequired = false;
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCache::GetTagValues(const std::string& filename, const std::set<DICOMTag>& tags, TagValueMapType& values) const
+{
+  FileStatus status;
+  return GetFileStatus(filename, status) && this->GetTagValues(status, tags, values);
+}
+
+bool mitk::DICOMPersistentTagCache::GetTagValues(const FileStatus& status, const std::set<DICOMTag>& tags, TagValueMapType& values) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  const auto entryIter = m_Entries.find(status.Path);
+  if (entryIter == m_Entries.cend())
+  {
+    return false;
+  }
+
+  const Entry& entry = entryIter->second;
+  if (entry.FileSize != status.FileSize || entry.ModificationTime != status.ModificationTime)
+  {
+    return false;
+  }
+
+  for (const auto& tag : tags)
+  {
+    if (entry.ScannedTags.find(tag) == entry.ScannedTags.cend())
+    {
+      return false;
+    }
+  }
+
+  values.clear();
+  for (const auto& tag : tags)
+  {
+    const auto valueIter = entry.Values.find(tag);
+    if (valueIter != entry.Values.cend())
+    {
+      values.insert(*valueIter);
+    }
+  }
+
+  return true;
+}
+
+void mitk::DICOMPersistentTagCache::SetTagValues(const std::string& filename, const std::set<DICOMTag>& scannedTags, const TagValueMapType& values)
+{
+  FileStatus status;
+  if (GetFileStatus(filename, status))
+  {
+    this->SetTagValues(status, scannedTags, values);
+  }
+}
+
+void mitk::DICOMPersistentTagCache::SetTagValues(const FileStatus& status, const std::set<DICOMTag>& scannedTags, const TagValueMapType& values)
+{
+  if (status.Path.empty())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto entryIter = m_Entries.find(status.Path);
+  if (entryIter == m_Entries.end())
+  {
+    entryIter = m_Entries.insert(std::make_pair(status.Path, Entry())).first;
+  }
+
+  Entry& entry = entryIter->second;
+  if (entry.ScannedTags.empty() || entry.FileSize != status.FileSize || entry.ModificationTime != status.ModificationTime)
+  {
+    // new or outdated entry
+    entry.FileSize = status.FileSize;
+    entry.ModificationTime = status.ModificationTime;
+    entry.ScannedTags.clear();
+    entry.Values.clear();
+  }
+
+  for (const auto& tag : scannedTags)
+  {
+    entry.ScannedTags.insert(tag);
+    entry.Values.erase(tag);
+
+    const auto valueIter = values.find(tag);
+    if (valueIter != values.cend())
+    {
+      entry.Values.insert(*valueIter);
+    }
+  }
+
+  m_SaveRequired = true;
+}
+
+std::size_t mitk::DICOMPersistentTagCache::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+bool mitk::DICOMPersistentTagCache::IsSaveRequired() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_SaveRequired;
+}
+
+void mitk::DICOMPersistentTagCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (!m_Entries.empty())
+  {
+    m_Entries.clear();
+    m_SaveRequired = true;
+  }
+}
+
+bool mitk::DICOMPersistentTagCache::GetFileStatus(const std::string& filename, FileStatus& status)
+{
+  // itksys::SystemTools::ModifiedTime() has a resolution of one second only
+  std::string path = itksys::SystemTools::CollapseFullPath(filename);
+
+  if (!GetFileSizeAndModificationTime(path, status.FileSize, status.ModificationTime))
+  {
+    return false;
+  }
+
+  status.Path = std::move(path);
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCache::ReadEntries(std::istream& stream, EntryMapType& entries)
+{
+  char signature[sizeof(FileSignature)];
+  std::uint32_t version = 0;
+  std::uint32_t byteOrderMark = 0;
+  std::uint64_t numberOfEntries = 0;
+
+  if (!stream.read(signature, sizeof(FileSignature)) || 0 != std::memcmp(signature, FileSignature, sizeof(FileSignature))
+      || !ReadValue(stream, version) || version != FileFormatVersion
+      || !ReadValue(stream, byteOrderMark) || byteOrderMark != ByteOrderMark
+      || !ReadValue(stream, numberOfEntries))
+  {
+    return false;
+  }
+
+  for (std::uint64_t entryIndex = 0; entryIndex < numberOfEntries; ++entryIndex)
+  {
+    std::string path;
+    Entry entry;
+    std::uint32_t numberOfScannedTags = 0;
+    std::uint32_t numberOfValues = 0;
+
+    if (!ReadString(stream, path) || !ReadValue(stream, entry.FileSize) || !ReadValue(stream, entry.ModificationTime)
+        || !ReadValue(stream, numberOfScannedTags))
+    {
+      return false;
+    }
+
+    for (std::uint32_t tagIndex = 0; tagIndex < numberOfScannedTags; ++tagIndex)
+    {
+      DICOMTag tag(0, 0);
+      if (!ReadTag(stream, tag))
+      {
+        return false;
+      }
+      entry.ScannedTags.insert(tag);
+    }
+
+    if (!ReadValue(stream, numberOfValues))
+    {
+      return false;
+    }
+
+    for (std::uint32_t valueIndex = 0; valueIndex < numberOfValues; ++valueIndex)
+    {
+      DICOMTag tag(0, 0);
+      std::string value;
+      if (!ReadTag(stream, tag) || !ReadString(stream, value))
+      {
+        return false;
+      }
+      entry.Values.insert(std::make_pair(tag, value));
+    }
+
+    entries[path] = std::move(entry);
+  }
+
+  return true;
+}
+
+void mitk::DICOMPersistentTagCache::WriteEntries(std::ostream& stream, const EntryMapType& entries)
+{
+  stream.write(FileSignature, sizeof(FileSignature));
+  WriteValue(stream, FileFormatVersion);
+  WriteValue(stream, ByteOrderMark);
+  WriteValue(stream, static_cast<std::uint64_t>(entries.size()));
+
+  for (const auto& pathAndEntry : entries)
+  {
+    const Entry& entry = pathAndEntry.second;
+
+    WriteString(stream, pathAndEntry.first);
+    WriteValue(stream, entry.FileSize);
+    WriteValue(stream, entry.ModificationTime);
+
+    WriteValue(stream, static_cast<std::uint32_t>(entry.ScannedTags.size()));
+    for (const auto& tag : entry.ScannedTags)
+    {
+      WriteTag(stream, tag);
+    }
+
+    WriteValue(stream, static_cast<std::uint32_t>(entry.Values.size()));
+    for (const auto& tagAndValue : entry.Values)
+    {
+      WriteTag(stream, tagAndValue.first);
+      WriteString(stream, tagAndValue.second);
+    }
+  }
+}
@@ -0,0 +1,295 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
+
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <gdcmScanner.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+
+class mitkDICOMPersistentTagCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheTestSuite);
+
+  MITK_TEST(GetTagValues_AfterSetTagValues_ReturnsValuesOfRequestedTags);
+  MITK_TEST(GetTagValues_TagNotScanned_Fails);
+  MITK_TEST(GetTagValues_FileChanged_Fails);
+  MITK_TEST(SetTagValues_FileChangedAfterStatus_EntryIsOutdated);
+  MITK_TEST(GetFileStatus_ModificationTime_IsInNanoseconds);
+  MITK_TEST(Load_AfterSave_RestoresEntries);
+  MITK_TEST(Load_InvalidFile_IsEmpty);
+  MITK_TEST(Scan_ManyFiles_EqualsGDCMScanner);
+  MITK_TEST(Scan_WithPersistentTagCache_UsesCachedValues);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::DICOMTag m_InstanceUID = mitk::DICOMTag(0x0008, 0x0018);
+  mitk::DICOMTag m_PatientName = mitk::DICOMTag(0x0010, 0x0010);
+  mitk::DICOMTag m_ImagePosition = mitk::DICOMTag(0x0020, 0x0032);
+
+  mitk::StringList m_CTFiles;
+  mitk::StringList m_TemporaryFiles;
+
+  std::string CreateTemporaryFile(const std::string& content)
+  {
+    std::ofstream stream;
+    const std::string fileName = mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, "mitkDICOMTagCache-XXXXXX");
+    stream << content;
+    m_TemporaryFiles.push_back(fileName);
+    return fileName;
+  }
+
+  mitk::DICOMDatasetAccessingImageFrameList Scan(const mitk::StringList& files, mitk::DICOMPersistentTagCache* cache)
+  {
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetPersistentTagCache(cache);
+    scanner->SetInputFiles(files);
+    scanner->AddTag(m_InstanceUID);
+    scanner->AddTag(m_PatientName);
+    scanner->AddTag(m_ImagePosition);
+    scanner->Scan();
+
+    return scanner->GetFrameInfoList();
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_CTFiles.clear();
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+  }
+
+  void tearDown() override
+  {
+    for (const auto& fileName : m_TemporaryFiles)
+    {
+      itksys::SystemTools::RemoveFile(fileName.c_str());
+    }
+    m_TemporaryFiles.clear();
+  }
+
+  void GetTagValues_AfterSetTagValues_ReturnsValuesOfRequestedTags()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New();
+
+    mitk::DICOMPersistentTagCache::TagValueMapType values;
+    values.insert(std::make_pair(m_InstanceUID, "1.2.3"));
+    values.insert(std::make_pair(m_PatientName, "Doe^John"));
+
+    cache->SetTagValues(m_CTFiles[0], { m_InstanceUID, m_PatientName, m_ImagePosition }, values);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), cache->GetNumberOfEntries());
+    CPPUNIT_ASSERT(cache->IsSaveRequired());
+
+    mitk::DICOMPersistentTagCache::TagValueMapType cachedValues;
+    CPPUNIT_ASSERT(cache->GetTagValues(m_CTFiles[0], { m_InstanceUID, m_ImagePosition }, cachedValues));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), cachedValues.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.3"), cachedValues.find(m_InstanceUID)->second);
+
+    CPPUNIT_ASSERT(!cache->GetTagValues(m_CTFiles[1], { m_InstanceUID }, cachedValues));
+  }
+
+  void GetTagValues_TagNotScanned_Fails()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetTagValues(m_CTFiles[0], { m_InstanceUID }, mitk::DICOMPersistentTagCache::TagValueMapType());
+
+    mitk::DICOMPersistentTagCache::TagValueMapType cachedValues;
+    CPPUNIT_ASSERT(cache->GetTagValues(m_CTFiles[0], { m_InstanceUID }, cachedValues));
+    CPPUNIT_ASSERT(cachedValues.empty());
+    CPPUNIT_ASSERT(!cache->GetTagValues(m_CTFiles[0], { m_InstanceUID, m_PatientName }, cachedValues));
+
+    // a later scan of more tags extends the entry
+    cache->SetTagValues(m_CTFiles[0], { m_PatientName }, mitk::DICOMPersistentTagCache::TagValueMapType());
+    CPPUNIT_ASSERT(cache->GetTagValues(m_CTFiles[0], { m_InstanceUID, m_PatientName }, cachedValues));
+  }
+
+  void GetTagValues_FileChanged_Fails()
+  {
+    const std::string fileName = CreateTemporaryFile("DICM");
+
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetTagValues(fileName, { m_InstanceUID }, mitk::DICOMPersistentTagCache::TagValueMapType());
+
+    mitk::DICOMPersistentTagCache::TagValueMapType cachedValues;
+    CPPUNIT_ASSERT(cache->GetTagValues(fileName, { m_InstanceUID }, cachedValues));
+
+    std::ofstream(fileName, std::ios_base::binary | std::ios_base::app) << "more data";
+    CPPUNIT_ASSERT(!cache->GetTagValues(fileName, { m_InstanceUID }, cachedValues));
+
+    itksys::SystemTools::RemoveFile(fileName.c_str());
+    CPPUNIT_ASSERT(!cache->GetTagValues(fileName, { m_InstanceUID }, cachedValues));
+  }
+
+  void SetTagValues_FileChangedAfterStatus_EntryIsOutdated()
+  {
+    const std::string fileName = CreateTemporaryFile("DICM");
+
+    mitk::DICOMPersistentTagCache::FileStatus status;
+    CPPUNIT_ASSERT(mitk::DICOMPersistentTagCache::GetFileStatus(fileName, status));
+
+    // the file changes while its values are read
+    std::ofstream(fileName, std::ios_base::binary | std::ios_base::app) << "more data";
+
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetTagValues(status, { m_InstanceUID }, mitk::DICOMPersistentTagCache::TagValueMapType());
+
+    mitk::DICOMPersistentTagCache::TagValueMapType cachedValues;
+    CPPUNIT_ASSERT(cache->GetTagValues(status, { m_InstanceUID }, cachedValues));
+    CPPUNIT_ASSERT(!cache->GetTagValues(fileName, { m_InstanceUID }, cachedValues));
+
+    itksys::SystemTools::RemoveFile(fileName.c_str());
+  }
+
+  void GetFileStatus_ModificationTime_IsInNanoseconds()
+  {
+    const std::string fileName = CreateTemporaryFile("DICM");
+
+    mitk::DICOMPersistentTagCache::FileStatus status;
+    CPPUNIT_ASSERT(mitk::DICOMPersistentTagCache::GetFileStatus(fileName, status));
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::int64_t>(itksys::SystemTools::ModifiedTime(fileName.c_str())),
+                         status.ModificationTime / 1000000000);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(4), status.FileSize);
+
+    itksys::SystemTools::RemoveFile(fileName.c_str());
+    CPPUNIT_ASSERT(!mitk::DICOMPersistentTagCache::GetFileStatus(fileName, status));
+  }
+
+  void Load_AfterSave_RestoresEntries()
+  {
+    const std::string cacheFileName = CreateTemporaryFile("");
+
+    mitk::DICOMPersistentTagCache::TagValueMapType values;
+    values.insert(std::make_pair(m_InstanceUID, "1.2.3"));
+    values.insert(std::make_pair(m_PatientName, std::string("with\nline break\\and backslash\0zero", 34)));
+
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetFileName(cacheFileName);
+    for (const auto& fileName : m_CTFiles)
+    {
+      cache->SetTagValues(fileName, { m_InstanceUID, m_PatientName, m_ImagePosition }, values);
+    }
+
+    CPPUNIT_ASSERT(cache->Save());
+    CPPUNIT_ASSERT(!cache->IsSaveRequired());
+
+    auto loadedCache = mitk::DICOMPersistentTagCache::New();
+    loadedCache->SetFileName(cacheFileName);
+    CPPUNIT_ASSERT(loadedCache->Load());
+    CPPUNIT_ASSERT_EQUAL(m_CTFiles.size(), loadedCache->GetNumberOfEntries());
+
+    for (const auto& fileName : m_CTFiles)
+    {
+      mitk::DICOMPersistentTagCache::TagValueMapType cachedValues;
+      CPPUNIT_ASSERT(loadedCache->GetTagValues(fileName, { m_InstanceUID, m_PatientName, m_ImagePosition }, cachedValues));
+      CPPUNIT_ASSERT(values == cachedValues);
+    }
+  }
+
+  void Load_InvalidFile_IsEmpty()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetTagValues(m_CTFiles[0], { m_InstanceUID }, mitk::DICOMPersistentTagCache::TagValueMapType());
+
+    cache->SetFileName(CreateTemporaryFile("MITKDICOMTagCache but not really"));
+    CPPUNIT_ASSERT(!cache->Load());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache->GetNumberOfEntries());
+  }
+
+  void Scan_ManyFiles_EqualsGDCMScanner()
+  {
+    // several chunks of files for the threads, including one that is no DICOM file
+    mitk::StringList files;
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      files.insert(files.end(), m_CTFiles.cbegin(), m_CTFiles.cend());
+    }
+    files.push_back(CreateTemporaryFile("no DICOM"));
+
+    gdcm::Scanner gdcmScanner;
+    gdcmScanner.AddTag(gdcm::Tag(0x0008, 0x0018));
+    gdcmScanner.AddTag(gdcm::Tag(0x0010, 0x0010));
+    gdcmScanner.AddTag(gdcm::Tag(0x0020, 0x0032));
+    gdcmScanner.Scan(files);
+
+    auto cache = mitk::DICOMPersistentTagCache::New();
+
+    for (unsigned int scan = 0; scan < 2; ++scan)
+    {
+      const auto frames = Scan(files, scan == 0 ? nullptr : cache.GetPointer());
+      CPPUNIT_ASSERT_EQUAL(files.size(), frames.size());
+
+      for (std::size_t i = 0; i < files.size(); ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL(files[i], frames[i]->GetFilenameIfAvailable());
+
+        for (const auto& tag : { m_InstanceUID, m_PatientName, m_ImagePosition })
+        {
+          const char* expected = gdcmScanner.GetValue(files[i].c_str(), gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+          const auto finding = frames[i]->GetTagValueAsString(tag);
+
+          if (nullptr != expected)
+          {
+            std::string expectedValue(expected);
+            expectedValue.erase(expectedValue.find_last_not_of(" \n\r\t") + 1);
+
+            CPPUNIT_ASSERT(finding.isValid);
+            CPPUNIT_ASSERT_EQUAL(expectedValue, finding.value);
+          }
+        }
+      }
+    }
+
+    // the file that is no DICOM file is not remembered
+    CPPUNIT_ASSERT_EQUAL(m_CTFiles.size(), cache->GetNumberOfEntries());
+  }
+
+  void Scan_WithPersistentTagCache_UsesCachedValues()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    auto frames = Scan(m_CTFiles, cache);
+    CPPUNIT_ASSERT_EQUAL(m_CTFiles.size(), cache->GetNumberOfEntries());
+
+    const auto scannedUID = frames[0]->GetTagValueAsString(m_InstanceUID).value;
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.276.0.99.1.4.8323329.3795.1303917947.940051"), scannedUID);
+
+    // a scan that would read the file again would not find this value
+    mitk::DICOMPersistentTagCache::TagValueMapType values;
+    values.insert(std::make_pair(m_InstanceUID, "cached"));
+    cache->SetTagValues(m_CTFiles[0], { m_InstanceUID, m_PatientName, m_ImagePosition }, values);
+
+    frames = Scan(m_CTFiles, cache);
+    CPPUNIT_ASSERT_EQUAL(std::string("cached"), frames[0]->GetTagValueAsString(m_InstanceUID).value);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.276.0.99.1.4.8323329.3795.1303917947.940052"),
+      frames[1]->GetTagValueAsString(m_InstanceUID).value);
+
+    // the default cache is used by new scanners
+    mitk::DICOMPersistentTagCache::SetDefault(cache);
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    mitk::DICOMPersistentTagCache::SetDefault(nullptr);
+    CPPUNIT_ASSERT(cache.GetPointer() == scanner->GetPersistentTagCache());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCache)
@@ -176,3 +176,13 @@ mitk::Image::Pointer mitk::CompressedImageContainer::GetImage() const
 
   return image;
 }
+
+std::size_t mitk::CompressedImageContainer::GetMemorySize() const
+{
+  std::size_t memorySize = 0;
+
+  for (const auto &byteBuffer : m_ByteBuffers)
+    memorySize += byteBuffer.second;
+
+  return memorySize;
+}
@@ -0,0 +1,245 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkHotspotSearch.h>
+#include <mitkITKImageImport.h>
+
+#include <itkConstantBoundaryCondition.h>
+#include <itkFFTConvolutionImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  typedef itk::Image<float, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> MaskImageType;
+
+  /** Noisy background with a few bright spheres, like a PET scan. */
+  ImageType::Pointer CreateImage(unsigned int size, double spacing)
+  {
+    ImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    ImageType::SpacingType imageSpacing;
+    imageSpacing.Fill(spacing);
+
+    auto image = ImageType::New();
+    image->SetRegions(imageSize);
+    image->SetSpacing(imageSpacing);
+    image->Allocate();
+
+    const double centers[3][3] = {{0.3, 0.4, 0.5}, {0.7, 0.6, 0.4}, {0.5, 0.3, 0.7}};
+    unsigned int state = 4711;
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      state = state * 1103515245 + 12345;
+      double value = static_cast<double>((state >> 16) % 1000) / 100.0;
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        double squaredDistance = 0.0;
+        for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+          const double distance = (it.GetIndex()[dim] - centers[i][dim] * size) * spacing;
+          squaredDistance += distance * distance;
+        }
+
+        value += (i + 2) * 20.0 * std::exp(-squaredDistance / (2 * 100.0 * (i + 1)));
+      }
+
+      it.Set(static_cast<float>(value));
+    }
+
+    return image;
+  }
+
+  /** Label 1 in the central box of half the edge length. */
+  MaskImageType::Pointer CreateMask(unsigned int size)
+  {
+    MaskImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    auto mask = MaskImageType::New();
+    mask->SetRegions(imageSize);
+    mask->Allocate();
+
+    for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      bool inside = true;
+      for (unsigned int dim = 0; dim < 3; ++dim)
+        inside = inside && it.GetIndex()[dim] >= static_cast<long>(size / 4) &&
+                 it.GetIndex()[dim] < static_cast<long>(3 * size / 4);
+
+      it.Set(inside ? 1 : 0);
+    }
+
+    return mask;
+  }
+
+  /** The hotspot like HotspotMaskGenerator found it before: an FFT convolution of the whole image with the sub-voxel
+      sphere kernel and a scan of the convolution image within the mask. */
+  ImageType::IndexType FindHotspotByFFTConvolution(const ImageType *image, const MaskImageType *mask, double radiusInMM)
+  {
+    const auto spacing = image->GetSpacing();
+
+    ImageType::SizeType kernelSize;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      kernelSize[dim] = static_cast<int>(2 * radiusInMM / spacing[dim]);
+      if (0 == kernelSize[dim] % 2)
+        ++kernelSize[dim];
+    }
+
+    auto kernel = ImageType::New();
+    kernel->SetRegions(kernelSize);
+    kernel->SetSpacing(spacing);
+    kernel->Allocate();
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(kernel, kernel->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      unsigned int subVoxelsInside = 0;
+
+      for (double dx = -0.25; dx < 0.5; dx += 0.5)
+        for (double dy = -0.25; dy < 0.5; dy += 0.5)
+          for (double dz = -0.25; dz < 0.5; dz += 0.5)
+          {
+            const double x = (it.GetIndex()[0] + dx - 0.5 * (kernelSize[0] - 1)) * spacing[0];
+            const double y = (it.GetIndex()[1] + dy - 0.5 * (kernelSize[1] - 1)) * spacing[1];
+            const double z = (it.GetIndex()[2] + dz - 0.5 * (kernelSize[2] - 1)) * spacing[2];
+
+            if (x * x + y * y + z * z <= radiusInMM * radiusInMM)
+              ++subVoxelsInside;
+          }
+
+      it.Set(subVoxelsInside / 8.0f);
+    }
+
+    auto convolutionFilter = itk::FFTConvolutionImageFilter<ImageType, ImageType, ImageType>::New();
+    itk::ConstantBoundaryCondition<ImageType> boundaryCondition;
+    boundaryCondition.SetConstant(0.0);
+    convolutionFilter->SetBoundaryCondition(&boundaryCondition);
+    convolutionFilter->SetInput(image);
+    convolutionFilter->SetKernelImage(kernel);
+    convolutionFilter->SetNormalize(true);
+    convolutionFilter->UpdateLargestPossibleRegion();
+
+    auto region = image->GetLargestPossibleRegion();
+    ImageType::SizeType distance;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      distance[dim] = static_cast<int>(radiusInMM / spacing[dim] + 0.5);
+    region.ShrinkByRadius(distance);
+
+    ImageType::IndexType hotspotIndex;
+    hotspotIndex.Fill(0);
+    bool defined = false;
+    float maximum = 0.0f;
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(convolutionFilter->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      if (nullptr != mask && 1 != mask->GetPixel(it.GetIndex()))
+        continue;
+
+      if (!defined || it.Get() > maximum)
+      {
+        maximum = it.Get();
+        hotspotIndex = it.GetIndex();
+        defined = true;
+      }
+    }
+
+    return hotspotIndex;
+  }
+
+  double Seconds(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Hotspot Search Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Compares the hotspot search of mitk::HotspotSearch for several radii, with and without a "
+                        "mask, with the previous FFT convolution of mitk::HotspotMaskGenerator.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("size", "s", mitkCommandLineParser::Int, "Size:", "Edge length of the cubic image (default: 192)", us::Any(), true);
+  parser.addArgument("spacing", "p", mitkCommandLineParser::Float, "Spacing:", "Isotropic spacing in mm (default: 2)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int size = parsedArgs.count("size") ? us::any_cast<int>(parsedArgs["size"]) : 192;
+  const double spacing = parsedArgs.count("spacing") ? us::any_cast<float>(parsedArgs["spacing"]) : 2.0;
+
+  if (size < 16 || spacing <= 0.0)
+  {
+    std::cerr << "The image needs an edge length of at least 16 and a positive spacing." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto itkImage = CreateImage(size, spacing);
+  auto itkMask = CreateMask(size);
+  auto image = mitk::ImportItkImage(itkImage);
+  auto mask = mitk::ImportItkImage(itkMask);
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "image: " << size << "^3, spacing " << spacing << " mm" << std::endl;
+  std::cout << "radius [mm]  mask  FFT convolution [s]  HotspotSearch [s]  hotspot (FFT / HotspotSearch)" << std::endl;
+
+  for (double radius : {6.2035049089940, 10.0, 15.0, 20.0})
+  {
+    for (bool masked : {false, true})
+    {
+      auto start = std::chrono::steady_clock::now();
+      const auto expectedIndex = FindHotspotByFFTConvolution(itkImage, masked ? itkMask.GetPointer() : nullptr, radius);
+      const double fftSeconds = Seconds(start);
+
+      start = std::chrono::steady_clock::now();
+      mitk::HotspotSearch search;
+      search.SetHotspotRadiusInMM(radius);
+      search.Search(image, 0, masked ? mask.GetPointer() : nullptr, 1);
+      const double searchSeconds = Seconds(start);
+
+      std::cout << std::setw(11) << radius << "  " << (masked ? "yes " : "no  ") << std::setw(19) << fftSeconds
+                << std::setw(19) << searchSeconds << "  " << expectedIndex << " / ";
+
+      if (search.IsHotspotDefined())
+        std::cout << "[" << search.GetHotspotIndex()[0] << ", " << search.GetHotspotIndex()[1] << ", "
+                  << search.GetHotspotIndex()[2] << "]" << std::endl;
+      else
+        std::cout << "none" << std::endl;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkExtendedLabelStatisticsImageFilter.h>
+#include <mitkImageMaskGenerator.h>
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkImageToItk.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsCalculator.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  typedef itk::Image<short, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> LabelImageType;
+
+  /** Time series of noisy intensities that change over time. */
+  mitk::Image::Pointer CreateImage(unsigned int size, unsigned int numberOfTimeSteps)
+  {
+    auto image = mitk::Image::New();
+    const unsigned int dimensions[4] = {size, size, size, numberOfTimeSteps};
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions);
+
+    for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+    {
+      mitk::ImageWriteAccessor writeAccess(image, image->GetVolumeData(timeStep));
+      auto *pixel = static_cast<short *>(writeAccess.GetData());
+
+      for (unsigned int z = 0; z < size; ++z)
+        for (unsigned int y = 0; y < size; ++y)
+          for (unsigned int x = 0; x < size; ++x, ++pixel)
+            *pixel = static_cast<short>((x * 7 + y * 13 + z * 17 + timeStep * 31) % 200 - 50);
+    }
+
+    return image;
+  }
+
+  /** 5 x 5 x 2 boxes, labeled 1 to 50. */
+  mitk::Image::Pointer CreateLabelImage(unsigned int size)
+  {
+    auto labelImage = mitk::Image::New();
+    const unsigned int dimensions[3] = {size, size, size};
+    labelImage->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor writeAccess(labelImage);
+    auto *label = static_cast<unsigned short *>(writeAccess.GetData());
+
+    for (unsigned int z = 0; z < size; ++z)
+      for (unsigned int y = 0; y < size; ++y)
+        for (unsigned int x = 0; x < size; ++x, ++label)
+          *label = static_cast<unsigned short>(1 + x * 5 / size + 5 * (y * 5 / size) + 25 * (z * 2 / size));
+
+    return labelImage;
+  }
+
+  /** The statistics of each time step like ImageStatisticsCalculator computed them before: a time step copy, a
+      min/max filter to find the histogram bounds and a statistics filter. */
+  double ComputeStatisticsPerTimeStep(const mitk::Image *image, const mitk::Image *labelImage)
+  {
+    double sum = 0.0;
+    auto itkLabelImage = mitk::ImageToItkImage<unsigned short, 3>(labelImage);
+
+    for (unsigned int timeStep = 0; timeStep < image->GetTimeSteps(); ++timeStep)
+    {
+      auto timeSelector = mitk::ImageTimeSelector::New();
+      timeSelector->SetInput(image);
+      timeSelector->SetTimeNr(timeStep);
+      timeSelector->UpdateLargestPossibleRegion();
+      mitk::Image::Pointer timeStepImage = timeSelector->GetOutput();
+      auto itkImage = mitk::ImageToItkImage<short, 3>(timeStepImage);
+
+      auto minMaxFilter = itk::MinMaxLabelImageFilterWithIndex<ImageType, LabelImageType>::New();
+      minMaxFilter->SetInput(itkImage);
+      minMaxFilter->SetLabelInput(itkLabelImage);
+      minMaxFilter->UpdateLargestPossibleRegion();
+
+      std::map<unsigned short, unsigned int> numberOfBins;
+      std::map<unsigned short, short> minimums;
+      std::map<unsigned short, short> maximums;
+
+      for (auto label : minMaxFilter->GetRelevantLabels())
+      {
+        numberOfBins[label] = 100;
+        minimums[label] = minMaxFilter->GetMin(label);
+        maximums[label] = minMaxFilter->GetMax(label);
+      }
+
+      auto statisticsFilter = itk::ExtendedLabelStatisticsImageFilter<ImageType, LabelImageType>::New();
+      statisticsFilter->SetInput(itkImage);
+      statisticsFilter->SetLabelInput(itkLabelImage);
+      statisticsFilter->SetHistogramParametersForLabels(numberOfBins, minimums, maximums);
+      statisticsFilter->Update();
+
+      for (auto label : statisticsFilter->GetRelevantLabels())
+        sum += statisticsFilter->GetMean(label);
+    }
+
+    return sum;
+  }
+
+  double Seconds(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Multi-Label Statistics Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Compares the statistics of 50 labels in all time steps of a 4D image computed by "
+                        "mitk::MultiLabelStatisticsCalculator with the previous per time step filters.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("size", "s", mitkCommandLineParser::Int, "Size:", "Edge length of the cubic time steps (default: 256)", us::Any(), true);
+  parser.addArgument("timesteps", "t", mitkCommandLineParser::Int, "Time steps:", "Number of time steps (default: 10)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int size = parsedArgs.count("size") ? us::any_cast<int>(parsedArgs["size"]) : 256;
+  const unsigned int numberOfTimeSteps = parsedArgs.count("timesteps") ? us::any_cast<int>(parsedArgs["timesteps"]) : 10;
+
+  if (size < 5 || 0 == numberOfTimeSteps)
+  {
+    std::cerr << "The image needs an edge length of at least 5 and at least one time step." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto image = CreateImage(size, numberOfTimeSteps);
+  auto labelImage = CreateLabelImage(size);
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "image:                          " << size << "^3 x " << numberOfTimeSteps << ", 50 labels" << std::endl;
+
+  auto start = std::chrono::steady_clock::now();
+  const double perTimeStepSum = ComputeStatisticsPerTimeStep(image, labelImage);
+  std::cout << "per time step filters [s]:      " << Seconds(start) << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  mitk::MultiLabelStatisticsCalculator multiLabelCalculator;
+  multiLabelCalculator.Compute(image, std::vector<mitk::Image::ConstPointer>(1, labelImage.GetPointer()));
+  std::cout << "MultiLabelStatisticsCalculator: " << Seconds(start) << std::endl;
+
+  double multiLabelSum = 0.0;
+  for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+  {
+    for (const auto &labelStatistics : multiLabelCalculator.GetStatistics(timeStep))
+      multiLabelSum += labelStatistics.second.Mean;
+  }
+
+  // including the time step masks of the mask generator
+  start = std::chrono::steady_clock::now();
+  auto maskGenerator = mitk::ImageMaskGenerator::New();
+  maskGenerator->SetInputImage(image);
+  maskGenerator->SetImageMask(labelImage);
+  auto calculator = mitk::ImageStatisticsCalculator::New();
+  calculator->SetInputImage(image);
+  calculator->SetMask(maskGenerator.GetPointer());
+  calculator->GetStatistics(1);
+  std::cout << "ImageStatisticsCalculator [s]:  " << Seconds(start) << std::endl;
+
+  std::cout << std::setprecision(6);
+  std::cout << "sum of means:                   " << perTimeStepSum << " / " << multiLabelSum << std::endl;
+
+  return EXIT_SUCCESS;
+}
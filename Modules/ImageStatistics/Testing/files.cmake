@@ -5,6 +5,8 @@ set(MODULE_TESTS
   mitkImageStatisticsTextureAnalysisTest.cpp
   mitkImageStatisticsContainerTest.cpp
   mitkImageStatisticsContainerManagerTest.cpp
+  mitkMultiLabelStatisticsCalculatorTest.cpp
+  mitkHotspotSearchTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
@@ -0,0 +1,300 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkHotspotMaskGenerator.h>
+#include <mitkHotspotSearch.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageMaskGenerator.h>
+#include <mitkImageReadAccessor.h>
+
+#include <itkConstantBoundaryCondition.h>
+#include <itkFFTConvolutionImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <cmath>
+
+class mitkHotspotSearchTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkHotspotSearchTestSuite);
+  MITK_TEST(Search_HotspotInsideImage_EqualsFFTConvolution);
+  MITK_TEST(Search_HotspotMayBeOutsideImage_EqualsFFTConvolution);
+  MITK_TEST(Search_WithMask_EqualsFFTConvolutionWithinLabel);
+  MITK_TEST(Search_ImageSmallerThanHotspot_IsNotDefined);
+  MITK_TEST(GetMask_HotspotMaskGenerator_IsSphereAroundHotspot);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<double, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> MaskImageType;
+
+  ImageType::Pointer m_ItkImage;
+  MaskImageType::Pointer m_ItkMask;
+  mitk::Image::Pointer m_Image;
+  mitk::Image::Pointer m_Mask;
+
+  struct Extrema
+  {
+    bool Defined = false;
+    double Maximum = 0.0;
+    double Minimum = 0.0;
+    ImageType::IndexType MaximumIndex;
+    ImageType::IndexType MinimumIndex;
+  };
+
+  /** The normalized kernel of the FFT convolution that HotspotMaskGenerator computed before. */
+  static ImageType::Pointer CreateKernel(const ImageType::SpacingType &spacing, double radiusInMM)
+  {
+    ImageType::SizeType size;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      size[dim] = static_cast<int>(2 * radiusInMM / spacing[dim]);
+      if (0 == size[dim] % 2)
+        ++size[dim];
+    }
+
+    auto kernel = ImageType::New();
+    kernel->SetRegions(size);
+    kernel->SetSpacing(spacing);
+    kernel->Allocate();
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(kernel, kernel->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      unsigned int subVoxelsInside = 0;
+
+      for (double dx = -0.25; dx < 0.5; dx += 0.5)
+        for (double dy = -0.25; dy < 0.5; dy += 0.5)
+          for (double dz = -0.25; dz < 0.5; dz += 0.5)
+          {
+            const double x = (it.GetIndex()[0] + dx - 0.5 * (size[0] - 1)) * spacing[0];
+            const double y = (it.GetIndex()[1] + dy - 0.5 * (size[1] - 1)) * spacing[1];
+            const double z = (it.GetIndex()[2] + dz - 0.5 * (size[2] - 1)) * spacing[2];
+
+            if (x * x + y * y + z * z <= radiusInMM * radiusInMM)
+              ++subVoxelsInside;
+          }
+
+      it.Set(subVoxelsInside / 8.0);
+    }
+
+    return kernel;
+  }
+
+  /** The extrema of the FFT convolution of the voxels with the label (all voxels without a mask) that keep the
+      required distance to the image border, the first ones in memory order. */
+  static Extrema FindExtrema(const ImageType *image,
+                             const MaskImageType *mask,
+                             unsigned short label,
+                             double radiusInMM,
+                             bool hotspotMustBeCompletelyInsideImage)
+  {
+    typedef itk::FFTConvolutionImageFilter<ImageType, ImageType, ImageType> ConvolutionFilterType;
+    auto convolutionFilter = ConvolutionFilterType::New();
+
+    itk::ConstantBoundaryCondition<ImageType> boundaryCondition;
+    boundaryCondition.SetConstant(0.0);
+
+    if (hotspotMustBeCompletelyInsideImage)
+      convolutionFilter->SetBoundaryCondition(&boundaryCondition);
+
+    convolutionFilter->SetInput(image);
+    convolutionFilter->SetKernelImage(CreateKernel(image->GetSpacing(), radiusInMM));
+    convolutionFilter->SetNormalize(true);
+    convolutionFilter->Update();
+
+    auto region = image->GetLargestPossibleRegion();
+
+    if (hotspotMustBeCompletelyInsideImage)
+    {
+      ImageType::SizeType distance;
+      for (unsigned int dim = 0; dim < 3; ++dim)
+        distance[dim] = static_cast<int>(radiusInMM / image->GetSpacing()[dim] + 0.5);
+
+      region.ShrinkByRadius(distance);
+    }
+
+    Extrema extrema;
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(convolutionFilter->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      if (nullptr != mask && mask->GetPixel(it.GetIndex()) != label)
+        continue;
+
+      if (!extrema.Defined || it.Get() > extrema.Maximum)
+      {
+        extrema.Maximum = it.Get();
+        extrema.MaximumIndex = it.GetIndex();
+      }
+
+      if (!extrema.Defined || it.Get() < extrema.Minimum)
+      {
+        extrema.Minimum = it.Get();
+        extrema.MinimumIndex = it.GetIndex();
+      }
+
+      extrema.Defined = true;
+    }
+
+    return extrema;
+  }
+
+  static void AssertEqual(const Extrema &expected, const mitk::HotspotSearch &search)
+  {
+    CPPUNIT_ASSERT(expected.Defined);
+    CPPUNIT_ASSERT(search.IsHotspotDefined());
+    CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(search.GetHotspotIndex().size()));
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.MaximumIndex[dim]), search.GetHotspotIndex()[dim]);
+      CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.MinimumIndex[dim]), search.GetMinimumIndex()[dim]);
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.Maximum, search.GetHotspotMean(), 1e-9 * std::abs(expected.Maximum));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.Minimum, search.GetMinimumMean(), 1e-9 * std::abs(expected.Minimum));
+  }
+
+public:
+  void setUp() override
+  {
+    ImageType::SizeType size;
+    size[0] = 30;
+    size[1] = 26;
+    size[2] = 20;
+
+    ImageType::SpacingType spacing;
+    spacing[0] = 2.0;
+    spacing[1] = 2.5;
+    spacing[2] = 3.0;
+
+    m_ItkImage = ImageType::New();
+    m_ItkImage->SetRegions(size);
+    m_ItkImage->SetSpacing(spacing);
+    m_ItkImage->Allocate();
+
+    m_ItkMask = MaskImageType::New();
+    m_ItkMask->SetRegions(size);
+    m_ItkMask->SetSpacing(spacing);
+    m_ItkMask->Allocate();
+
+    // pseudo random values, label 2 in a box and in every 7th voxel
+    unsigned int state = 4711;
+    itk::ImageRegionIteratorWithIndex<ImageType> it(m_ItkImage, m_ItkImage->GetBufferedRegion());
+    itk::ImageRegionIteratorWithIndex<MaskImageType> maskIt(m_ItkMask, m_ItkMask->GetBufferedRegion());
+
+    for (unsigned int i = 0; !it.IsAtEnd(); ++it, ++maskIt, ++i)
+    {
+      state = state * 1103515245 + 12345;
+      it.Set(static_cast<double>((state >> 8) % 100000) / 1000.0 - 20.0);
+
+      const auto &index = it.GetIndex();
+      const bool inBox = index[0] >= 3 && index[0] < 12 && index[1] >= 10 && index[1] < 24 && index[2] >= 8;
+      maskIt.Set(inBox || 0 == i % 7 ? 2 : 1);
+    }
+
+    m_Image = mitk::ImportItkImage(m_ItkImage)->Clone();
+    m_Mask = mitk::ImportItkImage(m_ItkMask)->Clone();
+  }
+
+  void tearDown() override
+  {
+    m_ItkImage = nullptr;
+    m_ItkMask = nullptr;
+    m_Image = nullptr;
+    m_Mask = nullptr;
+  }
+
+  void Search_HotspotInsideImage_EqualsFFTConvolution()
+  {
+    for (double radius : {3.0, 6.2035049089940, 10.0})
+    {
+      mitk::HotspotSearch search;
+      search.SetHotspotRadiusInMM(radius);
+      search.Search(m_Image, 0);
+
+      AssertEqual(FindExtrema(m_ItkImage, nullptr, 0, radius, true), search);
+    }
+  }
+
+  void Search_HotspotMayBeOutsideImage_EqualsFFTConvolution()
+  {
+    for (double radius : {3.0, 6.2035049089940, 10.0})
+    {
+      mitk::HotspotSearch search;
+      search.SetHotspotRadiusInMM(radius);
+      search.SetHotspotMustBeCompletelyInsideImage(false);
+      search.Search(m_Image, 0);
+
+      AssertEqual(FindExtrema(m_ItkImage, nullptr, 0, radius, false), search);
+    }
+  }
+
+  void Search_WithMask_EqualsFFTConvolutionWithinLabel()
+  {
+    for (bool hotspotMustBeCompletelyInsideImage : {true, false})
+    {
+      mitk::HotspotSearch search;
+      search.SetHotspotRadiusInMM(7.5);
+      search.SetHotspotMustBeCompletelyInsideImage(hotspotMustBeCompletelyInsideImage);
+      search.Search(m_Image, 0, m_Mask, 2);
+
+      AssertEqual(FindExtrema(m_ItkImage, m_ItkMask, 2, 7.5, hotspotMustBeCompletelyInsideImage), search);
+    }
+  }
+
+  void Search_ImageSmallerThanHotspot_IsNotDefined()
+  {
+    mitk::HotspotSearch search;
+    search.SetHotspotRadiusInMM(40.0);
+    search.Search(m_Image, 0);
+
+    CPPUNIT_ASSERT(!search.IsHotspotDefined());
+  }
+
+  void GetMask_HotspotMaskGenerator_IsSphereAroundHotspot()
+  {
+    auto maskGenerator = mitk::ImageMaskGenerator::New();
+    maskGenerator->SetInputImage(m_Image);
+    maskGenerator->SetImageMask(m_Mask);
+
+    auto hotspotMaskGenerator = mitk::HotspotMaskGenerator::New();
+    hotspotMaskGenerator->SetInputImage(m_Image);
+    hotspotMaskGenerator->SetMask(maskGenerator.GetPointer());
+    hotspotMaskGenerator->SetLabel(2);
+    hotspotMaskGenerator->SetHotspotRadiusInMM(7.5);
+
+    const auto expected = FindExtrema(m_ItkImage, m_ItkMask, 2, 7.5, true);
+    const auto hotspotIndex = hotspotMaskGenerator->GetHotspotIndex();
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.MaximumIndex[dim]), hotspotIndex[dim]);
+
+    auto hotspotMask = hotspotMaskGenerator->GetMask();
+    mitk::ImageReadAccessor readAccess(hotspotMask);
+    const auto *maskPixels = static_cast<const unsigned short *>(readAccess.GetData());
+
+    ImageType::PointType center;
+    m_ItkImage->TransformIndexToPhysicalPoint(expected.MaximumIndex, center);
+
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(m_ItkImage, m_ItkImage->GetBufferedRegion()); !it.IsAtEnd();
+         ++it, ++maskPixels)
+    {
+      ImageType::PointType position;
+      m_ItkImage->TransformIndexToPhysicalPoint(it.GetIndex(), position);
+      CPPUNIT_ASSERT_EQUAL(position.EuclideanDistanceTo(center) <= 7.5 ? 1 : 0, static_cast<int>(*maskPixels));
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkHotspotSearch)
@@ -0,0 +1,702 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkExtendedLabelStatisticsImageFilter.h>
+#include <mitkITKImageImport.h>
+#include <mitkIgnorePixelMaskGenerator.h>
+#include <mitkImageMaskGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkImageVolumeLoader.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsCalculator.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  const unsigned int NumberOfTimeSteps = 3;
+
+  /** Copies the volumes of an image from 3D images on demand and records whether a previous volume of the image is
+      still locked for reading when the next one is requested. */
+  class TimeStepsVolumeLoader : public mitk::ImageVolumeLoader
+  {
+  public:
+    mitkClassMacro(TimeStepsVolumeLoader, mitk::ImageVolumeLoader);
+    itkFactorylessNewMacro(Self);
+
+    std::vector<itk::Image<short, 3>::Pointer> TimeSteps;
+    mitk::Image *LoadingImage = nullptr;
+    unsigned int NumberOfReads = 0;
+    bool PreviousVolumeLocked = false;
+
+  protected:
+    void ReadVolume(int t, int, void *buffer) override
+    {
+      ++NumberOfReads;
+
+      for (int previous = 0; previous < t; ++previous)
+      {
+        try
+        {
+          mitk::ImageWriteAccessor probe(
+            LoadingImage, LoadingImage->GetVolumeData(previous), mitk::ImageAccessorBase::ExceptionIfLocked);
+        }
+        catch (const mitk::MemoryIsLockedException &)
+        {
+          PreviousVolumeLocked = true;
+        }
+      }
+
+      const auto &timeStep = TimeSteps[t];
+      std::memcpy(
+        buffer, timeStep->GetBufferPointer(), timeStep->GetBufferedRegion().GetNumberOfPixels() * sizeof(short));
+    }
+  };
+}
+
+class mitkMultiLabelStatisticsCalculatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultiLabelStatisticsCalculatorTestSuite);
+  MITK_TEST(Compute_LabelImagePerTimeStep_EqualsLabelStatisticsFilter);
+  MITK_TEST(Compute_WithoutLabelImages_AllVoxelsAreLabel1);
+  MITK_TEST(Compute_LabelImageOfOtherPixelType_IsUsedForAllTimeSteps);
+  MITK_TEST(Compute_LabelImageOfOtherSize_Throws);
+  MITK_TEST(Compute_ImageWithVolumeLoader_LoadsOneTimeStepAtATime);
+  MITK_TEST(Compute_IgnoredPixelValue_IgnoredVoxelsAreLabel0);
+  MITK_TEST(GetStatistics_IgnorePixelMaskGenerator_EqualsIgnoredPixelValue);
+  MITK_TEST(GetStatistics_4DImageWithLabelMask_EqualsMultiLabelStatistics);
+  MITK_TEST(Update_ChangedRegion_EqualsCompute);
+  MITK_TEST(Update_WithoutIncrementalCompute_Throws);
+  MITK_TEST(FindChangedRegion_PaintedRegion_ContainsChangedVoxels);
+  MITK_TEST(UpdateStatistics_ChangedMask_EqualsGetStatistics);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> LabelImageType;
+  typedef mitk::MultiLabelStatisticsCalculator::LabelStatisticsMapType LabelStatisticsMapType;
+  typedef mitk::MultiLabelStatisticsCalculator::RegionType RegionType;
+
+  std::vector<ImageType::Pointer> m_TimeSteps;
+  std::vector<LabelImageType::Pointer> m_LabelTimeSteps;
+  mitk::Image::Pointer m_Image;
+
+  static unsigned int GetLabel(const ImageType::IndexType &index, unsigned int timeStep)
+  {
+    return (index[0] / 5 + (index[1] / 4) * 7 + index[2] / 6 + timeStep) % 9;
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer CreateItkImage()
+  {
+    typename TImage::SizeType size;
+    size[0] = 31;
+    size[1] = 23;
+    size[2] = 17;
+
+    auto image = TImage::New();
+    image->SetRegions(size);
+    image->Allocate();
+    return image;
+  }
+
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateLabelImage(unsigned int timeStep)
+  {
+    auto labelImage = CreateItkImage<itk::Image<TPixel, 3>>();
+    for (itk::ImageRegionIteratorWithIndex<itk::Image<TPixel, 3>> it(labelImage, labelImage->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+      it.Set(static_cast<TPixel>(GetLabel(it.GetIndex(), timeStep)));
+
+    return mitk::ImportItkImage(labelImage)->Clone();
+  }
+
+  /** Joins equally sized 3D images of the same pixel type to a 4D image. */
+  static mitk::Image::Pointer CreateTimeSeries(const std::vector<mitk::Image::Pointer> &timeSteps)
+  {
+    const unsigned int dimensions[4] = {timeSteps[0]->GetDimension(0),
+                                        timeSteps[0]->GetDimension(1),
+                                        timeSteps[0]->GetDimension(2),
+                                        static_cast<unsigned int>(timeSteps.size())};
+
+    auto image = mitk::Image::New();
+    image->Initialize(timeSteps[0]->GetPixelType(), 4, dimensions);
+
+    const std::size_t volumeSize = static_cast<std::size_t>(dimensions[0]) * dimensions[1] * dimensions[2] *
+                                   timeSteps[0]->GetPixelType().GetSize();
+
+    for (unsigned int timeStep = 0; timeStep < timeSteps.size(); ++timeStep)
+    {
+      mitk::ImageWriteAccessor writeAccess(image, image->GetVolumeData(timeStep));
+      mitk::ImageReadAccessor readAccess(timeSteps[timeStep].GetPointer());
+      std::memcpy(writeAccess.GetData(), readAccess.GetData(), volumeSize);
+    }
+
+    return image;
+  }
+
+  static void AssertEqual(double expected, double actual)
+  {
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, actual, 1e-9 * std::max(1.0, std::abs(expected)));
+  }
+
+  static void AssertEqualsLabelStatisticsFilter(const ImageType *image,
+                                                const LabelImageType *labelImage,
+                                                const LabelStatisticsMapType &statistics)
+  {
+    auto minMaxFilter = itk::MinMaxLabelImageFilterWithIndex<ImageType, LabelImageType>::New();
+    minMaxFilter->SetInput(image);
+    minMaxFilter->SetLabelInput(labelImage);
+    minMaxFilter->UpdateLargestPossibleRegion();
+
+    std::map<unsigned short, unsigned int> numberOfBins;
+    std::map<unsigned short, short> minimums;
+    std::map<unsigned short, short> maximums;
+
+    for (auto label : minMaxFilter->GetRelevantLabels())
+    {
+      numberOfBins[label] = 100;
+      minimums[label] = minMaxFilter->GetMin(label);
+      maximums[label] = minMaxFilter->GetMax(label);
+    }
+
+    auto filter = itk::ExtendedLabelStatisticsImageFilter<ImageType, LabelImageType>::New();
+    filter->SetInput(image);
+    filter->SetLabelInput(labelImage);
+    filter->SetHistogramParametersForLabels(numberOfBins, minimums, maximums);
+    filter->Update();
+
+    const auto labels = filter->GetRelevantLabels();
+    CPPUNIT_ASSERT_EQUAL(labels.size(), statistics.size());
+
+    for (auto label : labels)
+    {
+      const auto it = statistics.find(static_cast<unsigned short>(label));
+      CPPUNIT_ASSERT(it != statistics.end());
+      const auto &labelStatistics = it->second;
+
+      CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(filter->GetCount(label)), labelStatistics.NumberOfVoxels);
+      AssertEqual(filter->GetMean(label), labelStatistics.Mean);
+      AssertEqual(filter->GetMinimum(label), labelStatistics.Minimum);
+      AssertEqual(filter->GetMaximum(label), labelStatistics.Maximum);
+      AssertEqual(filter->GetSigma(label), labelStatistics.Sigma);
+      AssertEqual(filter->GetVariance(label), labelStatistics.Variance);
+      AssertEqual(filter->GetSkewness(label), labelStatistics.Skewness);
+      AssertEqual(filter->GetKurtosis(label), labelStatistics.Kurtosis);
+      AssertEqual(filter->GetMPP(label), labelStatistics.MPP);
+      AssertEqual(filter->GetMedian(label), labelStatistics.Median);
+      AssertEqual(filter->GetEntropy(label), labelStatistics.Entropy);
+      AssertEqual(filter->GetUniformity(label), labelStatistics.Uniformity);
+      AssertEqual(filter->GetUPP(label), labelStatistics.UPP);
+
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(minMaxFilter->GetMinIndex(label)[dim]),
+                             labelStatistics.MinimumIndex[dim]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(minMaxFilter->GetMaxIndex(label)[dim]),
+                             labelStatistics.MaximumIndex[dim]);
+      }
+
+      const auto histogram = filter->GetHistogram(label);
+      CPPUNIT_ASSERT_EQUAL(histogram->GetSize(0), labelStatistics.Histogram->GetSize(0));
+
+      for (unsigned int bin = 0; bin < histogram->GetSize(0); ++bin)
+        CPPUNIT_ASSERT_EQUAL(histogram->GetFrequency(bin), labelStatistics.Histogram->GetFrequency(bin));
+    }
+  }
+
+  static void AssertEqual(const LabelStatisticsMapType &expected, const LabelStatisticsMapType &actual)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+
+    for (const auto &expectedLabelStatistics : expected)
+    {
+      const auto it = actual.find(expectedLabelStatistics.first);
+      CPPUNIT_ASSERT(it != actual.end());
+      const auto &expectedStatistics = expectedLabelStatistics.second;
+      const auto &statistics = it->second;
+
+      CPPUNIT_ASSERT_EQUAL(expectedStatistics.NumberOfVoxels, statistics.NumberOfVoxels);
+      AssertEqual(expectedStatistics.Mean, statistics.Mean);
+      AssertEqual(expectedStatistics.Minimum, statistics.Minimum);
+      AssertEqual(expectedStatistics.Maximum, statistics.Maximum);
+      AssertEqual(expectedStatistics.Sigma, statistics.Sigma);
+      AssertEqual(expectedStatistics.Skewness, statistics.Skewness);
+      AssertEqual(expectedStatistics.Kurtosis, statistics.Kurtosis);
+      AssertEqual(expectedStatistics.MPP, statistics.MPP);
+      AssertEqual(expectedStatistics.Median, statistics.Median);
+      AssertEqual(expectedStatistics.Entropy, statistics.Entropy);
+      CPPUNIT_ASSERT(expectedStatistics.MinimumIndex == statistics.MinimumIndex);
+      CPPUNIT_ASSERT(expectedStatistics.MaximumIndex == statistics.MaximumIndex);
+
+      CPPUNIT_ASSERT_EQUAL(expectedStatistics.Histogram->GetSize(0), statistics.Histogram->GetSize(0));
+      for (unsigned int bin = 0; bin < statistics.Histogram->GetSize(0); ++bin)
+        CPPUNIT_ASSERT_EQUAL(expectedStatistics.Histogram->GetFrequency(bin), statistics.Histogram->GetFrequency(bin));
+    }
+  }
+
+  /** Sets the voxels of region (cropped to the image) to label, every third row to label + 1. */
+  template <typename TPixel>
+  static void Paint(mitk::Image *labelImage, unsigned int timeStep, RegionType region, TPixel label)
+  {
+    RegionType largestRegion;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      largestRegion.SetSize(dim, labelImage->GetDimension(dim));
+    region.Crop(largestRegion);
+
+    mitk::ImageWriteAccessor writeAccess(labelImage, labelImage->GetVolumeData(timeStep));
+    auto *labels = static_cast<TPixel *>(writeAccess.GetData());
+
+    for (auto z = region.GetIndex(2); z < region.GetUpperIndex()[2] + 1; ++z)
+      for (auto y = region.GetIndex(1); y < region.GetUpperIndex()[1] + 1; ++y)
+        for (auto x = region.GetIndex(0); x < region.GetUpperIndex()[0] + 1; ++x)
+          labels[(z * labelImage->GetDimension(1) + y) * labelImage->GetDimension(0) + x] =
+            0 == y % 3 ? static_cast<TPixel>(label + 1) : label;
+
+    labelImage->Modified();
+  }
+
+  /** A region around the minimum of label 4 in a time step, which overlaps the border of the image. */
+  static RegionType GetRegionAroundMinimum(const LabelStatisticsMapType &statistics)
+  {
+    const auto &minimumIndex = statistics.at(4).MinimumIndex;
+
+    RegionType region;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      region.SetIndex(dim, std::max(0, static_cast<int>(minimumIndex[dim]) - 2));
+      region.SetSize(dim, 5);
+    }
+
+    region.SetSize(0, 40);
+    return region;
+  }
+
+  static LabelImageType::Pointer CreateConstantLabelImage(unsigned short label)
+  {
+    auto labelImage = CreateItkImage<LabelImageType>();
+    labelImage->FillBuffer(label);
+    return labelImage;
+  }
+
+public:
+  void setUp() override
+  {
+    m_TimeSteps.clear();
+    m_LabelTimeSteps.clear();
+    std::vector<mitk::Image::Pointer> timeSteps;
+
+    // pseudo random values with an offset per label, so there are negative values and equal extrema
+    unsigned int state = 4711;
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      auto image = CreateItkImage<ImageType>();
+      auto labelImage = CreateItkImage<LabelImageType>();
+
+      itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+      itk::ImageRegionIteratorWithIndex<LabelImageType> labelIt(labelImage, labelImage->GetBufferedRegion());
+      for (; !it.IsAtEnd(); ++it, ++labelIt)
+      {
+        const unsigned int label = GetLabel(it.GetIndex(), timeStep);
+        state = state * 1103515245 + 12345;
+        it.Set(static_cast<short>(static_cast<int>((state >> 16) % 200) - 50 + 10 * static_cast<int>(label)));
+        labelIt.Set(static_cast<unsigned short>(label));
+      }
+
+      m_TimeSteps.push_back(image);
+      m_LabelTimeSteps.push_back(labelImage);
+      timeSteps.push_back(mitk::ImportItkImage(image)->Clone());
+    }
+
+    m_Image = CreateTimeSeries(timeSteps);
+  }
+
+  void tearDown() override
+  {
+    m_TimeSteps.clear();
+    m_LabelTimeSteps.clear();
+    m_Image = nullptr;
+  }
+
+  void Compute_LabelImagePerTimeStep_EqualsLabelStatisticsFilter()
+  {
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      labelImages.push_back(CreateLabelImage<unsigned short>(timeStep).GetPointer());
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.Compute(m_Image, labelImages);
+
+    CPPUNIT_ASSERT_EQUAL(NumberOfTimeSteps, calculator.GetNumberOfTimeSteps());
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      CPPUNIT_ASSERT_EQUAL(std::size_t(9), calculator.GetStatistics(timeStep).size());
+      AssertEqualsLabelStatisticsFilter(
+        m_TimeSteps[timeStep], m_LabelTimeSteps[timeStep], calculator.GetStatistics(timeStep));
+    }
+  }
+
+  void Compute_WithoutLabelImages_AllVoxelsAreLabel1()
+  {
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.Compute(m_Image);
+
+    auto labelImage = CreateConstantLabelImage(1);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      AssertEqualsLabelStatisticsFilter(m_TimeSteps[timeStep], labelImage, calculator.GetStatistics(timeStep));
+  }
+
+  void Compute_LabelImageOfOtherPixelType_IsUsedForAllTimeSteps()
+  {
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    labelImages.push_back(CreateLabelImage<unsigned char>(0).GetPointer());
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.Compute(m_Image, labelImages);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      AssertEqualsLabelStatisticsFilter(m_TimeSteps[timeStep], m_LabelTimeSteps[0], calculator.GetStatistics(timeStep));
+  }
+
+  void Compute_ImageWithVolumeLoader_LoadsOneTimeStepAtATime()
+  {
+    const unsigned int dimensions[4] = {
+      m_Image->GetDimension(0), m_Image->GetDimension(1), m_Image->GetDimension(2), NumberOfTimeSteps};
+
+    auto image = mitk::Image::New();
+    image->Initialize(m_Image->GetPixelType(), 4, dimensions);
+
+    auto loader = TimeStepsVolumeLoader::New();
+    loader->TimeSteps = m_TimeSteps;
+    loader->LoadingImage = image;
+    loader->InitializePendingVolumes(NumberOfTimeSteps, 1);
+    image->SetVolumeLoader(loader);
+
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      labelImages.push_back(CreateLabelImage<unsigned short>(timeStep).GetPointer());
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.Compute(image, labelImages);
+
+    // each volume is loaded once, and only after the scan of the previous time step released its volume
+    CPPUNIT_ASSERT_EQUAL(NumberOfTimeSteps, loader->NumberOfReads);
+    CPPUNIT_ASSERT(!loader->PreviousVolumeLocked);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      AssertEqualsLabelStatisticsFilter(
+        m_TimeSteps[timeStep], m_LabelTimeSteps[timeStep], calculator.GetStatistics(timeStep));
+    }
+  }
+
+  void Compute_LabelImageOfOtherSize_Throws()
+  {
+    auto labelImage = mitk::Image::New();
+    const unsigned int dimensions[3] = {31, 23, 16};
+    labelImage->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    labelImages.push_back(labelImage.GetPointer());
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    CPPUNIT_ASSERT_THROW(calculator.Compute(m_Image, labelImages), mitk::Exception);
+  }
+
+  void Compute_IgnoredPixelValue_IgnoredVoxelsAreLabel0()
+  {
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    labelImages.push_back(CreateLabelImage<unsigned char>(0).GetPointer());
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.SetIgnoredPixelValue(20.0);
+    calculator.Compute(m_Image, labelImages);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      auto labelImage = CreateItkImage<LabelImageType>();
+      itk::ImageRegionIteratorWithIndex<LabelImageType> labelIt(labelImage, labelImage->GetBufferedRegion());
+      itk::ImageRegionIteratorWithIndex<ImageType> it(m_TimeSteps[timeStep], labelImage->GetBufferedRegion());
+      itk::ImageRegionIteratorWithIndex<LabelImageType> unignoredLabelIt(m_LabelTimeSteps[0],
+                                                                         labelImage->GetBufferedRegion());
+      for (; !labelIt.IsAtEnd(); ++labelIt, ++it, ++unignoredLabelIt)
+        labelIt.Set(20 == it.Get() ? 0 : unignoredLabelIt.Get());
+
+      AssertEqualsLabelStatisticsFilter(m_TimeSteps[timeStep], labelImage, calculator.GetStatistics(timeStep));
+    }
+  }
+
+  void GetStatistics_IgnorePixelMaskGenerator_EqualsIgnoredPixelValue()
+  {
+    mitk::MultiLabelStatisticsCalculator multiLabelCalculator;
+    multiLabelCalculator.SetIgnoredPixelValue(20.0);
+    multiLabelCalculator.Compute(m_Image);
+
+    auto ignorePixelMaskGenerator = mitk::IgnorePixelMaskGenerator::New();
+    ignorePixelMaskGenerator->SetInputImage(m_Image);
+    ignorePixelMaskGenerator->SetIgnoredPixelValue(20.0);
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetSecondaryMask(ignorePixelMaskGenerator.GetPointer());
+
+    auto container = calculator->GetStatistics(1);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      const auto &statistics = container->GetStatisticsForTimeStep(timeStep);
+      const auto &expected = multiLabelCalculator.GetStatistics(timeStep).at(1);
+
+      CPPUNIT_ASSERT(multiLabelCalculator.GetStatistics(timeStep).count(0) > 0);
+      CPPUNIT_ASSERT_EQUAL(static_cast<mitk::ImageStatisticsContainer::VoxelCountType>(expected.NumberOfVoxels),
+                           statistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(
+                             mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+      AssertEqual(expected.Mean, statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEAN()));
+      AssertEqual(expected.Sigma,
+                  statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::STANDARDDEVIATION()));
+      AssertEqual(expected.Median, statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEDIAN()));
+    }
+  }
+
+  void GetStatistics_4DImageWithLabelMask_EqualsMultiLabelStatistics()
+  {
+    std::vector<mitk::Image::Pointer> labelTimeSteps;
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      labelTimeSteps.push_back(CreateLabelImage<unsigned char>(timeStep));
+      labelImages.push_back(CreateLabelImage<unsigned short>(timeStep).GetPointer());
+    }
+
+    mitk::MultiLabelStatisticsCalculator multiLabelCalculator;
+    multiLabelCalculator.Compute(m_Image, labelImages);
+
+    auto maskGenerator = mitk::ImageMaskGenerator::New();
+    maskGenerator->SetInputImage(m_Image);
+    maskGenerator->SetImageMask(CreateTimeSeries(labelTimeSteps));
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(maskGenerator.GetPointer());
+
+    for (unsigned short label = 0; label < 9; ++label)
+    {
+      auto container = calculator->GetStatistics(label);
+
+      for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      {
+        const auto &statistics = container->GetStatisticsForTimeStep(timeStep);
+        const auto &expected = multiLabelCalculator.GetStatistics(timeStep).at(label);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<mitk::ImageStatisticsContainer::VoxelCountType>(expected.NumberOfVoxels),
+                             statistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(
+                               mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+        AssertEqual(expected.Mean, statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEAN()));
+        AssertEqual(expected.Sigma,
+                    statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::STANDARDDEVIATION()));
+        AssertEqual(expected.RMS, statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::RMS()));
+        AssertEqual(expected.Median, statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEDIAN()));
+
+        const auto minimumPosition = statistics.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(
+          mitk::ImageStatisticsConstants::MINIMUMPOSITION());
+        const auto maximumPosition = statistics.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(
+          mitk::ImageStatisticsConstants::MAXIMUMPOSITION());
+        CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(minimumPosition.size()));
+
+        for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+          CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.MinimumIndex[dim]), minimumPosition[dim]);
+          CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.MaximumIndex[dim]), maximumPosition[dim]);
+        }
+
+        CPPUNIT_ASSERT(nullptr != container->GetHistogramForTimeStep(timeStep));
+        for (unsigned int bin = 0; bin < expected.Histogram->GetSize(0); ++bin)
+          CPPUNIT_ASSERT_EQUAL(expected.Histogram->GetFrequency(bin),
+                               container->GetHistogramForTimeStep(timeStep)->GetFrequency(bin));
+      }
+    }
+  }
+
+  void Update_ChangedRegion_EqualsCompute()
+  {
+    std::vector<mitk::Image::Pointer> labelTimeSteps;
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      labelTimeSteps.push_back(CreateLabelImage<unsigned char>(timeStep));
+      labelImages.push_back(labelTimeSteps.back().GetPointer());
+    }
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.SetIncremental(true);
+    calculator.Compute(m_Image, labelImages);
+
+    // label 4 loses the voxel of its minimum, label 10 is new
+    const auto region = GetRegionAroundMinimum(calculator.GetStatistics(1));
+    Paint<unsigned char>(labelTimeSteps[1], 0, region, 9);
+    calculator.Update(labelTimeSteps[1], 1, region);
+
+    // labels that do not change
+    calculator.Update(labelTimeSteps[2], 2, region);
+
+    mitk::MultiLabelStatisticsCalculator expectedCalculator;
+    expectedCalculator.SetIncremental(true);
+    expectedCalculator.Compute(m_Image, labelImages);
+
+    CPPUNIT_ASSERT(expectedCalculator.GetStatistics(1).count(10) > 0);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      AssertEqual(expectedCalculator.GetStatistics(timeStep), calculator.GetStatistics(timeStep));
+  }
+
+  void Update_WithoutIncrementalCompute_Throws()
+  {
+    auto labelImage = CreateLabelImage<unsigned short>(0);
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    labelImages.push_back(labelImage.GetPointer());
+
+    RegionType region;
+    region.SetSize(0, 5);
+    region.SetSize(1, 5);
+    region.SetSize(2, 5);
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.Compute(m_Image, labelImages);
+    CPPUNIT_ASSERT_THROW(calculator.Update(labelImage, 0, region), mitk::Exception);
+  }
+
+  void FindChangedRegion_PaintedRegion_ContainsChangedVoxels()
+  {
+    std::vector<mitk::Image::Pointer> labelTimeSteps;
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+    {
+      labelTimeSteps.push_back(CreateLabelImage<unsigned char>(timeStep));
+      labelImages.push_back(labelTimeSteps.back().GetPointer());
+    }
+
+    mitk::MultiLabelStatisticsCalculator calculator;
+    calculator.SetIncremental(true);
+    calculator.Compute(m_Image, labelImages);
+
+    RegionType changedRegion;
+    CPPUNIT_ASSERT(!calculator.FindChangedRegion(labelTimeSteps[1], 1, changedRegion));
+
+    auto paintedRegion = GetRegionAroundMinimum(calculator.GetStatistics(1));
+    Paint<unsigned char>(labelTimeSteps[1], 0, paintedRegion, 9);
+
+    RegionType largestRegion;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      largestRegion.SetSize(dim, labelTimeSteps[1]->GetDimension(dim));
+    paintedRegion.Crop(largestRegion);
+
+    CPPUNIT_ASSERT(calculator.FindChangedRegion(labelTimeSteps[1], 1, changedRegion));
+    CPPUNIT_ASSERT(paintedRegion.IsInside(changedRegion));
+
+    calculator.Update(labelTimeSteps[1], 1, changedRegion);
+    CPPUNIT_ASSERT(!calculator.FindChangedRegion(labelTimeSteps[1], 1, changedRegion));
+
+    mitk::MultiLabelStatisticsCalculator expectedCalculator;
+    expectedCalculator.SetIncremental(true);
+    expectedCalculator.Compute(m_Image, labelImages);
+
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      AssertEqual(expectedCalculator.GetStatistics(timeStep), calculator.GetStatistics(timeStep));
+  }
+
+  void UpdateStatistics_ChangedMask_EqualsGetStatistics()
+  {
+    std::vector<mitk::Image::Pointer> labelTimeSteps;
+    for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      labelTimeSteps.push_back(CreateLabelImage<unsigned char>(timeStep));
+
+    auto mask = CreateTimeSeries(labelTimeSteps);
+
+    auto maskGenerator = mitk::ImageMaskGenerator::New();
+    maskGenerator->SetInputImage(m_Image);
+    maskGenerator->SetImageMask(mask);
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(maskGenerator.GetPointer());
+    calculator->SetIncrementalUpdates(true);
+
+    const auto *unchangedHistogram = calculator->GetStatistics(0)->GetHistogramForTimeStep(0);
+
+    mitk::MultiLabelStatisticsCalculator multiLabelCalculator;
+    multiLabelCalculator.Compute(m_Image, std::vector<mitk::Image::ConstPointer>(1, labelTimeSteps[2].GetPointer()));
+    const auto region = GetRegionAroundMinimum(multiLabelCalculator.GetStatistics(2));
+
+    Paint<unsigned char>(mask, 2, region, 9);
+    calculator->UpdateStatistics(2, region);
+
+    // the other time steps are not computed again
+    CPPUNIT_ASSERT(unchangedHistogram == calculator->GetStatistics(0)->GetHistogramForTimeStep(0));
+
+    auto expectedMaskGenerator = mitk::ImageMaskGenerator::New();
+    expectedMaskGenerator->SetInputImage(m_Image);
+    expectedMaskGenerator->SetImageMask(mask);
+
+    auto expectedCalculator = mitk::ImageStatisticsCalculator::New();
+    expectedCalculator->SetInputImage(m_Image);
+    expectedCalculator->SetMask(expectedMaskGenerator.GetPointer());
+    expectedCalculator->SetIncrementalUpdates(true);
+
+    for (unsigned short label = 0; label < 11; ++label)
+    {
+      auto expectedContainer = expectedCalculator->GetStatistics(label);
+      auto container = calculator->GetStatistics(label);
+
+      for (unsigned int timeStep = 0; timeStep < NumberOfTimeSteps; ++timeStep)
+      {
+        if (!expectedContainer->TimeStepExists(timeStep))
+          continue;
+
+        const auto &expected = expectedContainer->GetStatisticsForTimeStep(timeStep);
+        const auto &statistics = container->GetStatisticsForTimeStep(timeStep);
+
+        CPPUNIT_ASSERT_EQUAL(expected.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(
+                               mitk::ImageStatisticsConstants::NUMBEROFVOXELS()),
+                             statistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(
+                               mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+        AssertEqual(expected.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEAN()),
+                    statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEAN()));
+        AssertEqual(expected.GetValueConverted<double>(mitk::ImageStatisticsConstants::MINIMUM()),
+                    statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MINIMUM()));
+        AssertEqual(expected.GetValueConverted<double>(mitk::ImageStatisticsConstants::STANDARDDEVIATION()),
+                    statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::STANDARDDEVIATION()));
+        AssertEqual(expected.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEDIAN()),
+                    statistics.GetValueConverted<double>(mitk::ImageStatisticsConstants::MEDIAN()));
+        CPPUNIT_ASSERT(expected.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(
+                         mitk::ImageStatisticsConstants::MINIMUMPOSITION()) ==
+                       statistics.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(
+                         mitk::ImageStatisticsConstants::MINIMUMPOSITION()));
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelStatisticsCalculator)
@@ -17,6 +17,8 @@ set(CPP_FILES
   mitkStatisticsToImageRelationRule.cpp
   mitkStatisticsToMaskRelationRule.cpp
   mitkImageStatisticsConstants.cpp
+  mitkMultiLabelStatisticsCalculator.cpp
+  mitkHotspotSearch.cpp
 )
 
 set(H_FILES
@@ -43,6 +45,8 @@ set(H_FILES
   mitkStatisticsToImageRelationRule.h
   mitkStatisticsToMaskRelationRule.h
   mitkImageStatisticsConstants.h
+  mitkMultiLabelStatisticsCalculator.h
+  mitkHotspotSearch.h
 )
 
 set(TPP_FILES
@@ -28,11 +28,10 @@ namespace mitk
 /**
      * @brief The HotspotMaskGenerator class is used when a hotspot has to be found in an image. A hotspot is
      * the region of the image where the mean intensity is maximal (=brightest spot). It is usually used in PET scans.
-     * The identification of the hotspot is done as follows: First a cubic (or circular, if image is 2d)
-     * mask of predefined size is generated. This mask is then convolved with the input image (in fourier domain).
-     * The maximum value of the convolved image then corresponds to the hotspot.
-     * If a maskGenerator is set, only the pixels of the convolved image where the corresponding mask is == @a label
-     * are searched for the maximum value.
+     * The identification of the hotspot is done by mitk::HotspotSearch: the mean of a spherical (or circular, if image
+     * is 2d) kernel of predefined size is computed around each candidate pixel from the prefix sums of the image rows.
+     * The maximum mean then corresponds to the hotspot.
+     * If a maskGenerator is set, only the pixels where the corresponding mask is == @a label are candidates.
      */
     class MITKIMAGESTATISTICS_EXPORT HotspotMaskGenerator: public MaskGenerator
     {
@@ -102,61 +101,20 @@ namespace mitk
 
         ~HotspotMaskGenerator() override;
 
-        class ImageExtrema
-        {
-        public:
-          bool Defined;
-          double Max;
-          double Min;
-          vnl_vector<int> MaxIndex;
-          vnl_vector<int> MinIndex;
-
-          ImageExtrema()
-            :Defined(false)
-            ,Max(itk::NumericTraits<double>::min())
-            ,Min(itk::NumericTraits<double>::max())
-          {
-          }
-        };
-
     private:
-        /** \brief Returns size of convolution kernel depending on spacing and radius. */
-        template <unsigned int VImageDimension>
-        itk::Size<VImageDimension>
-          CalculateConvolutionKernelSize(double spacing[VImageDimension], double radiusInMM);
-
-        /** \brief Generates image of kernel which is needed for convolution. */
-        template <unsigned int VImageDimension>
-        itk::SmartPointer< itk::Image<float, VImageDimension> >
-          GenerateHotspotSearchConvolutionKernel(double spacing[VImageDimension], double radiusInMM);
-
-        /** \brief Convolves image with spherical kernel image. Used for hotspot calculation.   */
-        template <typename TPixel, unsigned int VImageDimension>
-        itk::SmartPointer< itk::Image<TPixel, VImageDimension> >
-          GenerateConvolutionImage( const itk::Image<TPixel, VImageDimension>* inputImage );
-
-
-        /** \brief Fills pixels of the spherical hotspot mask. */
+        /** \brief Fills the pixels of the spherical hotspot mask within region. */
         template < typename TPixel, unsigned int VImageDimension>
         void
           FillHotspotMaskPixels( itk::Image<TPixel, VImageDimension>* maskImage,
+          const itk::ImageRegion<VImageDimension>& region,
           itk::Point<double, VImageDimension> sphereCenter,
           double sphereRadiusInMM);
 
 
-        /** \brief */
+        /** \brief Creates the mask of the hotspot sphere around hotspotIndex on the grid of inputImage. */
         template <typename TPixel, unsigned int VImageDimension>
         void
-          CalculateHotspotMask(itk::Image<TPixel, VImageDimension>* inputImage,
-                               typename itk::Image<unsigned short, VImageDimension>::Pointer maskImage,
-                               unsigned int label);
-
-
-        template <typename TPixel, unsigned int VImageDimension  >
-        ImageExtrema CalculateExtremaWorld( const itk::Image<TPixel, VImageDimension>* inputImage,
-                                                        typename itk::Image<unsigned short, VImageDimension>::Pointer maskImage,
-                                                        double neccessaryDistanceToImageBorderInMM,
-                                                        unsigned int label);
+          CreateHotspotMask(itk::Image<TPixel, VImageDimension>* inputImage, const vnl_vector<int>& hotspotIndex);
 
         bool IsUpdateRequired() const;
 
@@ -165,8 +123,6 @@ namespace mitk
 
         MaskGenerator::Pointer m_Mask;
         mitk::Image::Pointer m_internalImage;
-        itk::Image<unsigned short, 2>::Pointer m_internalMask2D;
-        itk::Image<unsigned short, 3>::Pointer m_internalMask3D;
         double m_HotspotRadiusinMM;
         bool m_HotspotMustBeCompletelyInsideImage;
         unsigned short m_Label;
@@ -0,0 +1,612 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkHotspotSearch.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkParallelFor.h>
+#include <mitkPixelTypeMultiplex.h>
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  /// limits the memory of the prefix sums of a slab (128 MB)
+  const std::size_t MaximumNumberOfPrefixSums = 1 << 24;
+
+  /// voxels of a kernel row with equal weights. The positions are relative to the center of the kernel.
+  struct KernelRun
+  {
+    int Y;
+    int Z;
+    int BeginX;
+    int EndX; // exclusive
+    double Weight;
+  };
+
+  struct Kernel
+  {
+    int Radius[3]; // in voxels
+    double SumOfWeights;
+    std::vector<KernelRun> Runs; // without the runs of weight 0
+  };
+
+  /// the kernel of HotspotMaskGenerator: the weight of a voxel is the fraction of its sub-voxels whose centers are
+  /// inside the sphere
+  Kernel CreateKernel(const mitk::Vector3D &spacing, unsigned int dimension, double radiusInMM)
+  {
+    Kernel kernel;
+
+    // an uneven size has a clear center
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      kernel.Radius[dim] = dim < dimension ? static_cast<int>(2 * radiusInMM / spacing[dim]) / 2 : 0;
+
+    const double squaredRadius = radiusInMM * radiusInMM;
+    const unsigned int numberOfSubVoxels = 1u << dimension;
+    std::vector<double> rowWeights(2 * kernel.Radius[0] + 1);
+    kernel.SumOfWeights = 0.0;
+
+    for (int z = -kernel.Radius[2]; z <= kernel.Radius[2]; ++z)
+    {
+      for (int y = -kernel.Radius[1]; y <= kernel.Radius[1]; ++y)
+      {
+        for (int x = -kernel.Radius[0]; x <= kernel.Radius[0]; ++x)
+        {
+          const int position[3] = {x, y, z};
+          unsigned int subVoxelsInside = 0;
+
+          for (unsigned int subVoxel = 0; subVoxel < numberOfSubVoxels; ++subVoxel)
+          {
+            double squaredDistance = 0.0;
+
+            for (unsigned int dim = 0; dim < dimension; ++dim)
+            {
+              const double subVoxelPosition = position[dim] + ((subVoxel >> dim) & 1 ? 0.25 : -0.25);
+              squaredDistance += subVoxelPosition * spacing[dim] * subVoxelPosition * spacing[dim];
+            }
+
+            if (squaredDistance <= squaredRadius)
+              ++subVoxelsInside;
+          }
+
+          rowWeights[x + kernel.Radius[0]] = static_cast<double>(subVoxelsInside) / numberOfSubVoxels;
+        }
+
+        for (int begin = 0; begin < static_cast<int>(rowWeights.size());)
+        {
+          int end = begin + 1;
+          while (end < static_cast<int>(rowWeights.size()) && rowWeights[end] == rowWeights[begin])
+            ++end;
+
+          if (rowWeights[begin] > 0.0)
+          {
+            kernel.Runs.push_back({y, z, begin - kernel.Radius[0], end - kernel.Radius[0], rowWeights[begin]});
+            kernel.SumOfWeights += (end - begin) * rowWeights[begin];
+          }
+
+          begin = end;
+        }
+      }
+    }
+
+    return kernel;
+  }
+
+  typedef void (*ReadCandidatesFunction)(const void *, std::size_t, std::size_t, unsigned short, unsigned char *);
+
+  template <typename TMaskPixel>
+  void ReadCandidates(
+    const void *mask, std::size_t first, std::size_t count, unsigned short label, unsigned char *candidates)
+  {
+    const auto *maskPixels = static_cast<const TMaskPixel *>(mask) + first;
+
+    for (std::size_t i = 0; i < count; ++i)
+      candidates[i] = static_cast<unsigned short>(maskPixels[i]) == label ? 1 : 0;
+  }
+
+  template <typename TMaskPixel>
+  void GetReadCandidatesFunction(const mitk::PixelType &, ReadCandidatesFunction &function)
+  {
+    function = &ReadCandidates<TMaskPixel>;
+  }
+
+  struct SearchData
+  {
+    const void *Image;
+    int Size[3];
+    bool RepeatBorder; // otherwise the voxels outside of the image are 0
+
+    const void *Mask; // nullptr if all voxels are candidates
+    ReadCandidatesFunction ReadCandidates;
+    unsigned short Label;
+
+    // bounding box of the candidates
+    int CandidateBegin[3];
+    int CandidateEnd[3];
+
+    // box of the prefix sums, which contains the kernels of the candidates of the current slab within the image
+    int BoxBegin[3];
+    int BoxEnd[3];
+    std::vector<double> PrefixSums; // [z][y][x], the sums of the voxels of a row before x
+  };
+
+  std::size_t GetPrefixSumsPerRow(const SearchData &data)
+  {
+    return static_cast<std::size_t>(data.BoxEnd[0] - data.BoxBegin[0]) + 1;
+  }
+
+  /// the prefix sums of a row of the box, indexed by x - BoxBegin[0]
+  const double *GetPrefixSums(const SearchData &data, int y, int z)
+  {
+    const std::size_t row =
+      static_cast<std::size_t>(z - data.BoxBegin[2]) * (data.BoxEnd[1] - data.BoxBegin[1]) + (y - data.BoxBegin[1]);
+    return data.PrefixSums.data() + row * GetPrefixSumsPerRow(data);
+  }
+
+  template <typename TPixel>
+  void ComputePrefixSums(const mitk::PixelType &, SearchData &data)
+  {
+    const std::size_t rowsPerSlice = data.BoxEnd[1] - data.BoxBegin[1];
+    const std::size_t numberOfRows = rowsPerSlice * (data.BoxEnd[2] - data.BoxBegin[2]);
+    const std::size_t prefixSumsPerRow = GetPrefixSumsPerRow(data);
+    data.PrefixSums.resize(numberOfRows * prefixSumsPerRow);
+
+    mitk::ParallelFor(numberOfRows, [&data, rowsPerSlice, prefixSumsPerRow](std::size_t row, unsigned int) {
+      const std::size_t y = data.BoxBegin[1] + row % rowsPerSlice;
+      const std::size_t z = data.BoxBegin[2] + row / rowsPerSlice;
+      const auto *pixels = static_cast<const TPixel *>(data.Image) + (z * data.Size[1] + y) * data.Size[0] +
+                           data.BoxBegin[0];
+      double *prefixSums = data.PrefixSums.data() + row * prefixSumsPerRow;
+
+      double sum = 0.0;
+      prefixSums[0] = sum;
+
+      for (std::size_t x = 1; x < prefixSumsPerRow; ++x)
+      {
+        sum += static_cast<double>(pixels[x - 1]);
+        prefixSums[x] = sum;
+      }
+    });
+  }
+
+  /// a weighted prefix sum of the sum over the kernel. The offset is relative to the prefix sum of the center.
+  struct Tap
+  {
+    std::ptrdiff_t Offset;
+    double Weight;
+  };
+
+  /// a run adds its weight at its end and subtracts it at its begin, so adjacent runs share their prefix sum
+  std::vector<Tap> GetTaps(const Kernel &kernel, const SearchData &data)
+  {
+    const auto prefixSumsPerRow = static_cast<std::ptrdiff_t>(GetPrefixSumsPerRow(data));
+    const std::ptrdiff_t prefixSumsPerSlice = prefixSumsPerRow * (data.BoxEnd[1] - data.BoxBegin[1]);
+    std::map<std::ptrdiff_t, double> weights;
+
+    for (const auto &run : kernel.Runs)
+    {
+      const std::ptrdiff_t rowOffset = run.Z * prefixSumsPerSlice + run.Y * prefixSumsPerRow;
+      weights[rowOffset + run.EndX] += run.Weight;
+      weights[rowOffset + run.BeginX] -= run.Weight;
+    }
+
+    std::vector<Tap> taps;
+
+    for (const auto &weight : weights)
+    {
+      if (0.0 != weight.second)
+        taps.push_back({weight.first, weight.second});
+    }
+
+    return taps;
+  }
+
+  /// the sum of the voxels begin to end - 1 of a row, which may be partially or completely outside of the image
+  double SumOfRun(const SearchData &data, int y, int z, int begin, int end)
+  {
+    if (data.RepeatBorder)
+    {
+      y = std::min(std::max(y, 0), data.Size[1] - 1);
+      z = std::min(std::max(z, 0), data.Size[2] - 1);
+    }
+    else if (y < 0 || y >= data.Size[1] || z < 0 || z >= data.Size[2])
+    {
+      return 0.0;
+    }
+
+    const double *prefixSums = GetPrefixSums(data, y, z);
+    const auto prefixSum = [&data, prefixSums](int x) { return prefixSums[x - data.BoxBegin[0]]; };
+    double sum = 0.0;
+
+    if (begin < 0)
+    {
+      if (data.RepeatBorder)
+        sum += (std::min(end, 0) - begin) * (prefixSum(1) - prefixSum(0));
+
+      begin = 0;
+    }
+
+    if (end > data.Size[0])
+    {
+      if (data.RepeatBorder)
+        sum += (end - std::max(begin, data.Size[0])) * (prefixSum(data.Size[0]) - prefixSum(data.Size[0] - 1));
+
+      end = data.Size[0];
+    }
+
+    if (begin < end)
+      sum += prefixSum(end) - prefixSum(begin);
+
+    return sum;
+  }
+
+  /// the extrema of the kernel sums of the candidates. Of equal sums, the first candidate in memory order is kept.
+  struct Extrema
+  {
+    bool Defined = false;
+    double Maximum = 0.0;
+    double Minimum = 0.0;
+    std::size_t MaximumOffset = 0;
+    std::size_t MinimumOffset = 0;
+
+    void Add(double value, std::size_t offset)
+    {
+      if (!Defined)
+      {
+        Defined = true;
+        Maximum = Minimum = value;
+        MaximumOffset = MinimumOffset = offset;
+        return;
+      }
+
+      if (value > Maximum || (value == Maximum && offset < MaximumOffset))
+      {
+        Maximum = value;
+        MaximumOffset = offset;
+      }
+
+      if (value < Minimum || (value == Minimum && offset < MinimumOffset))
+      {
+        Minimum = value;
+        MinimumOffset = offset;
+      }
+    }
+
+    void Merge(const Extrema &other)
+    {
+      if (!other.Defined)
+        return;
+
+      this->Add(other.Maximum, other.MaximumOffset);
+      this->Add(other.Minimum, other.MinimumOffset);
+    }
+  };
+
+  void SearchRow(const SearchData &data,
+                 const Kernel &kernel,
+                 const std::vector<Tap> &taps,
+                 int y,
+                 int z,
+                 std::vector<unsigned char> &candidates,
+                 Extrema &extrema)
+  {
+    const int begin = data.CandidateBegin[0];
+    const int end = data.CandidateEnd[0];
+    const std::size_t rowOffset = (static_cast<std::size_t>(z) * data.Size[1] + y) * data.Size[0];
+
+    if (nullptr != data.Mask)
+    {
+      candidates.resize(end - begin);
+      data.ReadCandidates(data.Mask, rowOffset + begin, end - begin, data.Label, candidates.data());
+    }
+
+    // the kernel of the voxels of the row between xBegin and xEnd - 1 is completely inside the image
+    const bool rowInside = y >= kernel.Radius[1] && y + kernel.Radius[1] < data.Size[1] && z >= kernel.Radius[2] &&
+                           z + kernel.Radius[2] < data.Size[2];
+    const int xBegin = rowInside ? kernel.Radius[0] : 0;
+    const int xEnd = rowInside ? data.Size[0] - kernel.Radius[0] : 0;
+    const double *prefixSums = GetPrefixSums(data, y, z);
+
+    for (int x = begin; x < end; ++x)
+    {
+      if (nullptr != data.Mask && 0 == candidates[x - begin])
+        continue;
+
+      double sum = 0.0;
+
+      if (x >= xBegin && x < xEnd)
+      {
+        const double *center = prefixSums + (x - data.BoxBegin[0]);
+
+        for (const auto &tap : taps)
+          sum += tap.Weight * center[tap.Offset];
+      }
+      else
+      {
+        for (const auto &run : kernel.Runs)
+          sum += run.Weight * SumOfRun(data, y + run.Y, z + run.Z, x + run.BeginX, x + run.EndX);
+      }
+
+      extrema.Add(sum, rowOffset + x);
+    }
+  }
+
+  /// shrinks the candidate box to the bounding box of the voxels of the mask with the label
+  void FindCandidates(SearchData &data)
+  {
+    const auto numberOfThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+    const int none = std::numeric_limits<int>::max();
+    std::vector<std::array<int, 6>> boxes(numberOfThreads, {{none, none, none, -1, -1, -1}}); // begin and last index
+    std::vector<std::vector<unsigned char>> candidates(numberOfThreads);
+
+    const int rowBegin = data.CandidateBegin[0];
+    const int rowEnd = data.CandidateEnd[0];
+
+    mitk::ParallelFor(data.CandidateEnd[2] - data.CandidateBegin[2], [&](std::size_t slice, unsigned int thread) {
+      const int z = data.CandidateBegin[2] + static_cast<int>(slice);
+      auto &box = boxes[thread];
+      auto &rowCandidates = candidates[thread];
+      rowCandidates.resize(rowEnd - rowBegin);
+
+      for (int y = data.CandidateBegin[1]; y < data.CandidateEnd[1]; ++y)
+      {
+        const std::size_t rowOffset = (static_cast<std::size_t>(z) * data.Size[1] + y) * data.Size[0];
+        data.ReadCandidates(data.Mask, rowOffset + rowBegin, rowEnd - rowBegin, data.Label, rowCandidates.data());
+
+        const auto first = std::find(rowCandidates.begin(), rowCandidates.end(), 1);
+        if (first == rowCandidates.end())
+          continue;
+
+        const auto last = std::find(rowCandidates.rbegin(), rowCandidates.rend(), 1);
+        const int position[3] = {rowBegin + static_cast<int>(first - rowCandidates.begin()), y, z};
+        const int lastX = rowEnd - 1 - static_cast<int>(last - rowCandidates.rbegin());
+
+        for (unsigned int dim = 0; dim < 3; ++dim)
+          box[dim] = std::min(box[dim], position[dim]);
+
+        box[3] = std::max(box[3], lastX);
+        box[4] = std::max(box[4], y);
+        box[5] = std::max(box[5], z);
+      }
+    });
+
+    auto box = boxes.front();
+
+    for (const auto &threadBox : boxes)
+    {
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        box[dim] = std::min(box[dim], threadBox[dim]);
+        box[dim + 3] = std::max(box[dim + 3], threadBox[dim + 3]);
+      }
+    }
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      data.CandidateBegin[dim] = box[3] < 0 ? 0 : box[dim];
+      data.CandidateEnd[dim] = box[3] < 0 ? 0 : box[dim + 3] + 1;
+    }
+  }
+
+  vnl_vector<int> GetIndex(const SearchData &data, std::size_t offset, unsigned int dimension)
+  {
+    const int index[3] = {static_cast<int>(offset % data.Size[0]),
+                          static_cast<int>(offset / data.Size[0] % data.Size[1]),
+                          static_cast<int>(offset / data.Size[0] / data.Size[1])};
+
+    return vnl_vector<int>(index, dimension);
+  }
+}
+
+mitk::HotspotSearch::HotspotSearch()
+  : m_HotspotRadiusInMM(6.2035049089940), // radius of a 1cm3 sphere in mm
+    m_HotspotMustBeCompletelyInsideImage(true),
+    m_HotspotDefined(false),
+    m_HotspotMean(0.0),
+    m_MinimumMean(0.0)
+{
+}
+
+void mitk::HotspotSearch::SetHotspotRadiusInMM(double radiusInMillimeter)
+{
+  m_HotspotRadiusInMM = radiusInMillimeter;
+}
+
+double mitk::HotspotSearch::GetHotspotRadiusInMM() const
+{
+  return m_HotspotRadiusInMM;
+}
+
+void mitk::HotspotSearch::SetHotspotMustBeCompletelyInsideImage(bool hotspotCompletelyInsideImage)
+{
+  m_HotspotMustBeCompletelyInsideImage = hotspotCompletelyInsideImage;
+}
+
+bool mitk::HotspotSearch::GetHotspotMustBeCompletelyInsideImage() const
+{
+  return m_HotspotMustBeCompletelyInsideImage;
+}
+
+void mitk::HotspotSearch::Search(const Image *image, unsigned int timeStep, const Image *mask, unsigned short label)
+{
+  if (nullptr == image || !image->IsInitialized())
+    mitkThrow() << "Image not initialized!";
+
+  if (image->GetPixelType().GetNumberOfComponents() != 1)
+    mitkThrow() << "Only images with single component pixels are supported.";
+
+  if (timeStep >= image->GetTimeSteps())
+    mitkThrow() << "Invalid time step " << timeStep << ".";
+
+  if (m_HotspotRadiusInMM <= 0.0)
+    mitkThrow() << "Invalid hotspot radius " << m_HotspotRadiusInMM << " mm.";
+
+  m_HotspotDefined = false;
+
+  const unsigned int dimension = image->GetDimension() < 3 ? 2 : 3;
+  const auto kernel = CreateKernel(image->GetGeometry(timeStep)->GetSpacing(), dimension, m_HotspotRadiusInMM);
+
+  if (kernel.SumOfWeights <= 0.0)
+    mitkThrow() << "The hotspot radius " << m_HotspotRadiusInMM << " mm is too small for the spacing of the image.";
+
+  SearchData data;
+  data.RepeatBorder = !m_HotspotMustBeCompletelyInsideImage;
+  data.Mask = nullptr;
+  data.ReadCandidates = nullptr;
+  data.Label = label;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    data.Size[dim] = static_cast<int>(image->GetDimension(dim));
+    data.CandidateBegin[dim] = 0;
+    data.CandidateEnd[dim] = data.Size[dim];
+  }
+
+  if (m_HotspotMustBeCompletelyInsideImage)
+  {
+    const auto spacing = image->GetGeometry(timeStep)->GetSpacing();
+
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+    {
+      // voxels are center based: with a spacing of 1, a radius of 2.2 needs 2 voxels to the border and a radius of 2.7
+      // needs 3 voxels
+      const int distanceToBorder = static_cast<int>(m_HotspotRadiusInMM / spacing[dim] + 0.5);
+      data.CandidateBegin[dim] = distanceToBorder;
+      data.CandidateEnd[dim] = std::max(distanceToBorder, data.Size[dim] - distanceToBorder);
+    }
+  }
+
+  ImageReadAccessor imageAccessor(image, image->GetVolumeData(timeStep));
+  data.Image = imageAccessor.GetData();
+
+  std::unique_ptr<ImageReadAccessor> maskAccessor;
+
+  if (nullptr != mask)
+  {
+    if (!mask->IsInitialized())
+      mitkThrow() << "Mask not initialized!";
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      if (mask->GetDimension(dim) != image->GetDimension(dim))
+        mitkThrow() << "The mask has to be of the size of a time step of the image.";
+    }
+
+    const auto maskPixelType = mask->GetPixelType();
+
+    if (maskPixelType.GetNumberOfComponents() != 1)
+      mitkThrow() << "Only masks with single component pixels are supported.";
+
+    mitkPixelTypeMultiplex1(GetReadCandidatesFunction, maskPixelType, data.ReadCandidates);
+
+    if (nullptr == data.ReadCandidates)
+      mitkThrow() << "Unsupported pixel type of mask: " << maskPixelType.GetComponentTypeAsString() << ".";
+
+    maskAccessor.reset(new ImageReadAccessor(mask, mask->GetVolumeData(0)));
+    data.Mask = maskAccessor->GetData();
+
+    bool empty = false;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      empty = empty || data.CandidateBegin[dim] >= data.CandidateEnd[dim];
+
+    if (!empty)
+      FindCandidates(data);
+  }
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (data.CandidateBegin[dim] >= data.CandidateEnd[dim])
+      return;
+  }
+
+  // the kernels of the candidates within the image
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    data.BoxBegin[dim] = std::max(0, data.CandidateBegin[dim] - kernel.Radius[dim]);
+    data.BoxEnd[dim] = std::min(data.Size[dim], data.CandidateEnd[dim] + kernel.Radius[dim]);
+  }
+
+  const std::size_t prefixSumsPerSlice = GetPrefixSumsPerRow(data) * (data.BoxEnd[1] - data.BoxBegin[1]);
+  const int slabDepth = std::max(
+    1, static_cast<int>(MaximumNumberOfPrefixSums / prefixSumsPerSlice) - 2 * kernel.Radius[2]);
+
+  const auto numberOfThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  std::vector<Extrema> extrema(numberOfThreads);
+  std::vector<std::vector<unsigned char>> candidates(numberOfThreads);
+
+  const auto pixelType = image->GetPixelType();
+  const int rowsPerSlice = data.CandidateEnd[1] - data.CandidateBegin[1];
+
+  for (int slabBegin = data.CandidateBegin[2]; slabBegin < data.CandidateEnd[2]; slabBegin += slabDepth)
+  {
+    const int slabEnd = std::min(data.CandidateEnd[2], slabBegin + slabDepth);
+    data.BoxBegin[2] = std::max(0, slabBegin - kernel.Radius[2]);
+    data.BoxEnd[2] = std::min(data.Size[2], slabEnd + kernel.Radius[2]);
+
+    mitkPixelTypeMultiplex1(ComputePrefixSums, pixelType, data);
+    const auto taps = GetTaps(kernel, data);
+
+    mitk::ParallelFor(static_cast<std::size_t>(slabEnd - slabBegin) * rowsPerSlice,
+                      [&](std::size_t row, unsigned int thread) {
+                        const int y = data.CandidateBegin[1] + static_cast<int>(row % rowsPerSlice);
+                        const int z = slabBegin + static_cast<int>(row / rowsPerSlice);
+                        SearchRow(data, kernel, taps, y, z, candidates[thread], extrema[thread]);
+                      });
+  }
+
+  for (std::size_t thread = 1; thread < extrema.size(); ++thread)
+    extrema.front().Merge(extrema[thread]);
+
+  const auto &result = extrema.front();
+
+  if (!result.Defined)
+    return;
+
+  m_HotspotDefined = true;
+  m_HotspotIndex = GetIndex(data, result.MaximumOffset, dimension);
+  m_HotspotMean = result.Maximum / kernel.SumOfWeights;
+  m_MinimumIndex = GetIndex(data, result.MinimumOffset, dimension);
+  m_MinimumMean = result.Minimum / kernel.SumOfWeights;
+}
+
+bool mitk::HotspotSearch::IsHotspotDefined() const
+{
+  return m_HotspotDefined;
+}
+
+const vnl_vector<int> &mitk::HotspotSearch::GetHotspotIndex() const
+{
+  return m_HotspotIndex;
+}
+
+double mitk::HotspotSearch::GetHotspotMean() const
+{
+  return m_HotspotMean;
+}
+
+const vnl_vector<int> &mitk::HotspotSearch::GetMinimumIndex() const
+{
+  return m_MinimumIndex;
+}
+
+double mitk::HotspotSearch::GetMinimumMean() const
+{
+  return m_MinimumMean;
+}
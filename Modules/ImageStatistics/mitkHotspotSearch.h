@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkHotspotSearch_h
+#define mitkHotspotSearch_h
+
+#include <MitkImageStatisticsExports.h>
+#include <mitkImage.h>
+
+#include <vnl/vnl_vector.h>
+
+namespace mitk
+{
+  /** \brief Finds the sphere of maximal mean intensity (the hotspot) in a time step of a 2D or 3D image.
+
+    The mean of the sphere around a voxel is the normalized convolution of the image with the kernel of
+    HotspotMaskGenerator, whose weights are the fractions of the kernel voxels inside the sphere (sampled by 2
+    sub-voxels per dimension). Each kernel row consists of a few runs of equal weights, so the convolution at a voxel
+    is a short sum of differences of the prefix sums of the image rows (a summed-area table along x) instead of an FFT
+    convolution of the whole image.
+
+    Only the candidates are evaluated: the voxels of the mask with the label (all voxels without a mask) that keep the
+    required distance to the image border. The prefix sums are computed within the bounding box of the candidates
+    extended by the kernel radius, slab by slab to bound their memory, and the rows of candidates are distributed to
+    the threads.
+
+    The sums are computed in double precision. Voxels outside of the image are 0 if the hotspot has to be completely
+    inside the image, otherwise they repeat the border voxels, like the boundary conditions HotspotMaskGenerator used
+    for itk::FFTConvolutionImageFilter. Of equal means, the first candidate in memory order is the hotspot.
+  */
+  class MITKIMAGESTATISTICS_EXPORT HotspotSearch
+  {
+  public:
+    HotspotSearch();
+
+    /** \brief Radius of the hotspot sphere in mm (default: 6.2035, the radius of a 1 cm^3 sphere).*/
+    void SetHotspotRadiusInMM(double radiusInMillimeter);
+    double GetHotspotRadiusInMM() const;
+
+    /** \brief Whether the hotspot has to be completely inside the image (default: true).*/
+    void SetHotspotMustBeCompletelyInsideImage(bool hotspotCompletelyInsideImage);
+    bool GetHotspotMustBeCompletelyInsideImage() const;
+
+    /** \brief Searches the hotspot in a time step of image.
+
+      \param image A 2D, 3D or 4D image with single component pixels.
+      \param timeStep The time step of image.
+      \param mask nullptr or a 2D or 3D mask of the size of a time step of image. Its pixels are cast to unsigned short.
+      \param label The mask value of the candidates.
+      \throw mitk::Exception if the image or the mask are not suitable.
+    */
+    void Search(const Image *image, unsigned int timeStep, const Image *mask = nullptr, unsigned short label = 1);
+
+    /** \brief Whether there was a candidate in the last Search().*/
+    bool IsHotspotDefined() const;
+
+    /** \brief Index of the center of the hotspot, with one element per dimension of the image.*/
+    const vnl_vector<int> &GetHotspotIndex() const;
+
+    /** \brief Mean intensity of the hotspot sphere.*/
+    double GetHotspotMean() const;
+
+    /** \brief Index of the candidate with the minimal mean of its sphere (the darkest spot).*/
+    const vnl_vector<int> &GetMinimumIndex() const;
+    double GetMinimumMean() const;
+
+  private:
+    double m_HotspotRadiusInMM;
+    bool m_HotspotMustBeCompletelyInsideImage;
+
+    bool m_HotspotDefined;
+    vnl_vector<int> m_HotspotIndex;
+    double m_HotspotMean;
+    vnl_vector<int> m_MinimumIndex;
+    double m_MinimumMean;
+  };
+}
+
+#endif
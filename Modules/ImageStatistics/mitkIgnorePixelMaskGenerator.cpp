@@ -28,6 +28,11 @@ void IgnorePixelMaskGenerator::SetIgnoredPixelValue(RealType pixelValue)
     }
 }
 
+IgnorePixelMaskGenerator::RealType IgnorePixelMaskGenerator::GetIgnoredPixelValue() const
+{
+    return m_IgnoredPixelValue;
+}
+
 void IgnorePixelMaskGenerator::SetTimeStep(unsigned int timeStep)
 {
     if (m_TimeStep != timeStep)
@@ -44,6 +44,8 @@ public:
      */
     void SetIgnoredPixelValue(RealType pixelValue);
 
+    RealType GetIgnoredPixelValue() const;
+
     /**
      * @brief Computes and returns the mask
      */
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkImageStatisticsCalculator.h"
 #include <mitkExtendedLabelStatisticsImageFilter.h>
 #include <mitkExtendedStatisticsImageFilter.h>
+#include <mitkIgnorePixelMaskGenerator.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
@@ -22,8 +23,11 @@ found in the LICENSE file.
 #include <mitkMaskUtilities.h>
 #include <mitkMinMaxImageFilterWithIndex.h>
 #include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsCalculator.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <algorithm>
+
 namespace mitk
 {
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
@@ -104,7 +108,34 @@ namespace mitk
 
     if (IsUpdateRequired(label))
     {
-      auto timeGeometry = m_Image->GetTimeGeometry();
+      this->CalculateStatistics();
+    }
+
+    auto it = m_StatisticContainers.find(label);
+    if (it != m_StatisticContainers.end())
+    {
+      return (it->second).GetPointer();
+    }
+    else
+    {
+      mitkThrow() << "unknown label";
+      return nullptr;
+    }
+  }
+
+  void ImageStatisticsCalculator::CalculateStatistics()
+  {
+    auto timeGeometry = m_Image->GetTimeGeometry();
+    std::vector<mitk::Image::ConstPointer> labelImages;
+    m_HasIncrementalStatistics = false;
+
+    if (this->GetLabelImagesOfAllTimeSteps(labelImages))
+    {
+      // all labels of all time steps in one scan of the image
+      this->CalculateStatisticsOfAllTimeSteps(labelImages);
+    }
+    else
+    {
       // always compute statistics on all timesteps
       for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
       {
@@ -154,17 +185,6 @@ namespace mitk
         }
       }
     }
-
-    auto it = m_StatisticContainers.find(label);
-    if (it != m_StatisticContainers.end())
-    {
-      return (it->second).GetPointer();
-    }
-    else
-    {
-      mitkThrow() << "unknown label";
-      return nullptr;
-    }
   }
 
   template <typename TPixel, unsigned int VImageDimension>
@@ -506,6 +526,291 @@ namespace mitk
     }
   }
 
+  bool ImageStatisticsCalculator::GetLabelImagesOfAllTimeSteps(std::vector<mitk::Image::ConstPointer> &labelImages)
+  {
+    labelImages.clear();
+
+    if (m_Image->GetPixelType().GetNumberOfComponents() != 1)
+    {
+      return false;
+    }
+
+    // the voxels of a secondary mask that ignores a pixel value of the image are assigned to label 0 during the scan
+    if (m_SecondaryMaskGenerator.IsNotNull())
+    {
+      auto ignorePixelMaskGenerator = dynamic_cast<IgnorePixelMaskGenerator *>(m_SecondaryMaskGenerator.GetPointer());
+      if (nullptr == ignorePixelMaskGenerator || ignorePixelMaskGenerator->GetReferenceImage() != m_Image)
+      {
+        return false;
+      }
+    }
+
+    if (m_MaskGenerator.IsNull())
+    {
+      return true;
+    }
+
+    // e.g. planar figure masks refer to a slice of the image
+    auto referenceImage = m_MaskGenerator->GetReferenceImage();
+    if (referenceImage.IsNotNull() && referenceImage != m_Image)
+    {
+      return false;
+    }
+
+    for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
+    {
+      m_MaskGenerator->SetTimeStep(timeStep);
+      //See T25625: otherwise, the mask is not computed again after setting a different time step
+      m_MaskGenerator->Modified();
+      mitk::Image::ConstPointer mask = m_MaskGenerator->GetMask().GetPointer();
+
+      if (mask.IsNull() || !mask->IsInitialized() || mask->GetTimeSteps() != 1)
+      {
+        return false;
+      }
+
+      // a mask generator that updates its mask in place cannot provide the masks of all time steps at once
+      if (std::find(labelImages.begin(), labelImages.end(), mask) != labelImages.end())
+      {
+        return false;
+      }
+
+      for (unsigned int dim = 0; dim < 3; dim++)
+      {
+        if (mask->GetDimension(dim) != m_Image->GetDimension(dim))
+        {
+          return false;
+        }
+      }
+
+      if (!mitk::Equal(*mask->GetGeometry(), *m_Image->GetGeometry(timeStep), 0.001, 0.001))
+      {
+        return false;
+      }
+
+      labelImages.push_back(mask);
+    }
+
+    return true;
+  }
+
+  void ImageStatisticsCalculator::CalculateStatisticsOfAllTimeSteps(
+    const std::vector<mitk::Image::ConstPointer> &labelImages)
+  {
+    if (m_UseBinSizeOverNBins)
+    {
+      m_MultiLabelStatisticsCalculator.SetBinSize(m_binSizeForHistogramStatistics);
+    }
+    else
+    {
+      m_MultiLabelStatisticsCalculator.SetNumberOfBins(m_nBinsForHistogramStatistics);
+    }
+
+    auto ignorePixelMaskGenerator = dynamic_cast<IgnorePixelMaskGenerator *>(m_SecondaryMaskGenerator.GetPointer());
+    if (nullptr != ignorePixelMaskGenerator)
+    {
+      m_MultiLabelStatisticsCalculator.SetIgnoredPixelValue(ignorePixelMaskGenerator->GetIgnoredPixelValue());
+    }
+    else
+    {
+      m_MultiLabelStatisticsCalculator.ResetIgnoredPixelValue();
+    }
+
+    // only edits of a mask can be applied incrementally
+    m_MultiLabelStatisticsCalculator.SetIncremental(m_IncrementalUpdates && !labelImages.empty());
+    m_MultiLabelStatisticsCalculator.Compute(m_Image, labelImages);
+
+    const bool masked = !labelImages.empty() || nullptr != ignorePixelMaskGenerator;
+
+    for (unsigned int timeStep = 0; timeStep < m_MultiLabelStatisticsCalculator.GetNumberOfTimeSteps(); timeStep++)
+    {
+      this->SetStatisticsOfTimeStep(timeStep, masked);
+    }
+
+    if (m_MultiLabelStatisticsCalculator.GetIncremental())
+    {
+      m_HasIncrementalStatistics = true;
+      m_IncrementalStatisticsTime.Modified();
+    }
+  }
+
+  void ImageStatisticsCalculator::SetStatisticsOfTimeStep(TimeStepType timeStep, bool masked)
+  {
+    // like the itk images of the time steps: the positions of unmasked statistics have their dimension
+    const unsigned int imageDimension = std::min(m_Image->GetDimension(), 3u);
+    const unsigned int indexDimension = masked ? 3 : imageDimension;
+
+    const auto spacing = m_Image->GetGeometry()->GetSpacing();
+    double voxelVolume = 1.;
+    for (unsigned int i = 0; i < imageDimension; i++)
+    {
+      voxelVolume *= spacing[i];
+    }
+
+    for (const auto &labelStatistics : m_MultiLabelStatisticsCalculator.GetStatistics(timeStep))
+    {
+      ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
+      auto labelIt = m_StatisticContainers.find(labelStatistics.first);
+      // reset if statisticContainer already exist
+      if (labelIt != m_StatisticContainers.end())
+      {
+        statisticContainerForLabelImage = labelIt->second;
+      }
+      // create new statisticContainer
+      else
+      {
+        statisticContainerForLabelImage = ImageStatisticsContainer::New();
+        statisticContainerForLabelImage->SetTimeGeometry(
+          const_cast<mitk::TimeGeometry *>(m_Image->GetTimeGeometry()));
+        m_StatisticContainers.emplace(labelStatistics.first, statisticContainerForLabelImage);
+      }
+
+      const auto &statistics = labelStatistics.second;
+      ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+      vnl_vector<int> minIndex, maxIndex;
+      minIndex.set_size(indexDimension);
+      maxIndex.set_size(indexDimension);
+
+      for (unsigned int i = 0; i < indexDimension; i++)
+      {
+        minIndex[i] = statistics.MinimumIndex[i];
+        maxIndex[i] = statistics.MaximumIndex[i];
+      }
+
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(),
+                           static_cast<ImageStatisticsContainer::VoxelCountType>(statistics.NumberOfVoxels));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(),
+                           static_cast<double>(statistics.NumberOfVoxels) * voxelVolume);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), statistics.Mean);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), statistics.Minimum);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), statistics.Maximum);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), statistics.Sigma);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), statistics.Variance);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), statistics.Skewness);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), statistics.Kurtosis);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), statistics.RMS);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), statistics.MPP);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), statistics.Entropy);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), statistics.Median);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), statistics.Uniformity);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), statistics.UPP);
+      statObj.m_Histogram = statistics.Histogram.GetPointer();
+
+      statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
+    }
+  }
+
+  void ImageStatisticsCalculator::SetIncrementalUpdates(bool incrementalUpdates)
+  {
+    if (incrementalUpdates != m_IncrementalUpdates)
+    {
+      m_IncrementalUpdates = incrementalUpdates;
+      this->Modified();
+    }
+  }
+
+  bool ImageStatisticsCalculator::GetIncrementalUpdates() const { return m_IncrementalUpdates; }
+
+  void ImageStatisticsCalculator::UpdateStatistics(TimeStepType timeStep, const itk::ImageRegion<3> &changedRegion)
+  {
+    if (m_Image.IsNull())
+    {
+      mitkThrow() << "no image";
+    }
+
+    if (!m_Image->IsInitialized())
+    {
+      mitkThrow() << "Image not initialized!";
+    }
+
+    if (!this->IsIncrementalUpdatePossible())
+    {
+      this->CalculateStatistics();
+      return;
+    }
+
+    this->UpdateStatisticsOfTimeStep(timeStep, &changedRegion);
+
+    // the statistics of all labels are up to date with the modified mask generator
+    for (auto &statisticContainer : m_StatisticContainers)
+    {
+      statisticContainer.second->Modified();
+    }
+
+    m_IncrementalStatisticsTime.Modified();
+  }
+
+  void ImageStatisticsCalculator::UpdateStatistics()
+  {
+    if (m_Image.IsNull())
+    {
+      mitkThrow() << "no image";
+    }
+
+    if (!m_Image->IsInitialized())
+    {
+      mitkThrow() << "Image not initialized!";
+    }
+
+    if (!this->IsIncrementalUpdatePossible())
+    {
+      this->CalculateStatistics();
+      return;
+    }
+
+    for (unsigned int timeStep = 0; timeStep < m_MultiLabelStatisticsCalculator.GetNumberOfTimeSteps(); timeStep++)
+    {
+      this->UpdateStatisticsOfTimeStep(timeStep, nullptr);
+    }
+
+    for (auto &statisticContainer : m_StatisticContainers)
+    {
+      statisticContainer.second->Modified();
+    }
+
+    m_IncrementalStatisticsTime.Modified();
+  }
+
+  void ImageStatisticsCalculator::UpdateStatisticsOfTimeStep(TimeStepType timeStep, const itk::ImageRegion<3> *changedRegion)
+  {
+    m_MaskGenerator->SetTimeStep(timeStep);
+    //See T25625: otherwise, the mask is not computed again after setting a different time step
+    m_MaskGenerator->Modified();
+    mitk::Image::ConstPointer mask = m_MaskGenerator->GetMask().GetPointer();
+
+    itk::ImageRegion<3> region;
+
+    if (nullptr != changedRegion)
+    {
+      region = *changedRegion;
+    }
+    else if (!m_MultiLabelStatisticsCalculator.FindChangedRegion(mask, timeStep, region))
+    {
+      return;
+    }
+
+    m_MultiLabelStatisticsCalculator.Update(mask, timeStep, region);
+    this->SetStatisticsOfTimeStep(timeStep, true);
+  }
+
+  bool ImageStatisticsCalculator::IsIncrementalUpdatePossible() const
+  {
+    if (!m_IncrementalUpdates || !m_HasIncrementalStatistics || m_MaskGenerator.IsNull())
+    {
+      return false;
+    }
+
+    // the inputs have changed since the statistics were computed or updated
+    const auto incrementalStatisticsTime = m_IncrementalStatisticsTime.GetMTime();
+    return this->GetMTime() <= incrementalStatisticsTime && m_Image->GetMTime() <= incrementalStatisticsTime &&
+           m_MaskGenerator->GetMTime() <= incrementalStatisticsTime &&
+           (m_SecondaryMaskGenerator.IsNull() || m_SecondaryMaskGenerator->GetMTime() <= incrementalStatisticsTime);
+  }
+
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
   {
     unsigned long thisClassTimeStamp = this->GetMTime();
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
+#include <mitkMultiLabelStatisticsCalculator.h>
 
 namespace mitk
 {
@@ -73,14 +74,39 @@ namespace mitk
         /**Documentation
         @brief Returns the statistics for label @a label. If these requested statistics are not computed yet the computation is done as well.
         For performance reasons, statistics for all labels in the image are computed at once.
+        With incremental updates (see SetIncrementalUpdates()), the histograms of all labels of a time step share the bins over the value range
+        of the time step. The histogram based statistics (Median, Entropy, Uniformity and UPP) thus differ from those computed without
+        incremental updates, where the bins span the extrema of each label.
          */
         ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
 
+        /**Documentation
+        @brief Keep the accumulated statistics of image masks, so UpdateStatistics() can apply edits of the mask without computing all statistics again.
+        The histograms of all labels of a time step then share the bins over the value range of the time step instead of spanning the extrema of each label.
+        This requires a copy of the labels of each time step. Default is false.*/
+        void SetIncrementalUpdates(bool incrementalUpdates);
+        bool GetIncrementalUpdates() const;
+
+        /**Documentation
+        @brief Updates the statistics after the mask of time step @a timeStep has been changed within @a changedRegion (index coordinates of the mask), e.g. by a paint stroke.
+        Only the voxels of the region are subtracted from the statistics of their previous labels and added to the statistics of their current labels.
+        All statistics are computed instead if there are no incremental statistics of the current inputs (see SetIncrementalUpdates()) or if the mask is no
+        label image on the grid of the image. Labels that no longer occur keep their previous statistics.*/
+        void UpdateStatistics(TimeStepType timeStep, const itk::ImageRegion<3>& changedRegion);
+
+        /**Documentation
+        @brief Updates the statistics of all time steps after the mask has been changed in unknown regions, e.g. by a segmentation tool.
+        The changed region of each time step is found by comparing the mask with the labels kept for the incremental statistics.
+        Apart from that like UpdateStatistics(TimeStepType, const itk::ImageRegion<3>&).*/
+        void UpdateStatistics();
+
     protected:
         ImageStatisticsCalculator(){
             m_nBinsForHistogramStatistics = 100;
             m_binSizeForHistogramStatistics = 10;
             m_UseBinSizeOverNBins = false;
+            m_IncrementalUpdates = false;
+            m_HasIncrementalStatistics = false;
         };
 
 
@@ -96,6 +122,22 @@ namespace mitk
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
 
+        /** Collects the masks of all time steps if they are label images on the grid of the image (or if there is no
+        mask), so the statistics of all time steps can be computed at once by MultiLabelStatisticsCalculator. A
+        secondary mask is only supported if it is an IgnorePixelMaskGenerator of the image.*/
+        bool GetLabelImagesOfAllTimeSteps(std::vector<mitk::Image::ConstPointer>& labelImages);
+
+        void CalculateStatistics();
+
+        void CalculateStatisticsOfAllTimeSteps(const std::vector<mitk::Image::ConstPointer>& labelImages);
+
+        /** Copies the statistics of a time step from m_MultiLabelStatisticsCalculator to the statistic containers.*/
+        void SetStatisticsOfTimeStep(TimeStepType timeStep, bool masked);
+
+        bool IsIncrementalUpdatePossible() const;
+
+        void UpdateStatisticsOfTimeStep(TimeStepType timeStep, const itk::ImageRegion<3>* changedRegion);
+
         bool IsUpdateRequired(LabelIndex label) const;
 
         mitk::Image::ConstPointer m_Image;
@@ -112,6 +154,11 @@ namespace mitk
         double m_binSizeForHistogramStatistics;
         bool m_UseBinSizeOverNBins;
 
+        bool m_IncrementalUpdates;
+        bool m_HasIncrementalStatistics;
+        itk::TimeStamp m_IncrementalStatisticsTime;
+        MultiLabelStatisticsCalculator m_MultiLabelStatisticsCalculator;
+
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
     };
 
@@ -0,0 +1,1067 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMultiLabelStatisticsCalculator.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkHistogramStatisticsCalculator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkParallelFor.h>
+#include <mitkPixelTypeMultiplex.h>
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace
+{
+  typedef mitk::MultiLabelStatisticsCalculator::LabelPixelType LabelPixelType;
+  typedef mitk::MultiLabelStatisticsCalculator::HistogramType HistogramType;
+
+  /// limits the labels that a thread holds at once
+  const std::size_t MaximumVoxelsPerBlock = 1 << 20;
+
+  /// moments and extrema of the voxels of one label in one time step. The offsets are relative to the time step.
+  struct Accumulator
+  {
+    std::size_t Count = 0;
+    double Sum = 0.0;
+    double SumOfSquares = 0.0;
+    double SumOfCubes = 0.0;
+    double SumOfQuadruples = 0.0;
+    std::size_t PositiveCount = 0;
+    double PositiveSum = 0.0;
+    double Minimum = 0.0;
+    double Maximum = 0.0;
+    std::size_t MinimumOffset = 0;
+    std::size_t MaximumOffset = 0;
+  };
+
+  /// accumulators of a time step, indexed by label
+  typedef std::vector<Accumulator> AccumulatorsType;
+
+  void AddVoxel(double value, std::size_t offset, Accumulator &accumulator)
+  {
+    // the first extremum in memory order is kept
+    if (0 == accumulator.Count)
+    {
+      accumulator.Minimum = accumulator.Maximum = value;
+      accumulator.MinimumOffset = accumulator.MaximumOffset = offset;
+    }
+    else
+    {
+      if (value < accumulator.Minimum || (value == accumulator.Minimum && offset < accumulator.MinimumOffset))
+      {
+        accumulator.Minimum = value;
+        accumulator.MinimumOffset = offset;
+      }
+
+      if (value > accumulator.Maximum || (value == accumulator.Maximum && offset < accumulator.MaximumOffset))
+      {
+        accumulator.Maximum = value;
+        accumulator.MaximumOffset = offset;
+      }
+    }
+
+    const double square = value * value;
+
+    ++accumulator.Count;
+    accumulator.Sum += value;
+    accumulator.SumOfSquares += square;
+    accumulator.SumOfCubes += square * value;
+    accumulator.SumOfQuadruples += square * square;
+
+    if (value > 0)
+    {
+      ++accumulator.PositiveCount;
+      accumulator.PositiveSum += value;
+    }
+  }
+
+  /// returns whether the extrema of the accumulator have to be searched again
+  bool RemoveVoxel(double value, std::size_t offset, Accumulator &accumulator)
+  {
+    if (1 == accumulator.Count)
+    {
+      // no rounding errors of the sums remain
+      accumulator = Accumulator();
+      return false;
+    }
+
+    const double square = value * value;
+
+    --accumulator.Count;
+    accumulator.Sum -= value;
+    accumulator.SumOfSquares -= square;
+    accumulator.SumOfCubes -= square * value;
+    accumulator.SumOfQuadruples -= square * square;
+
+    if (value > 0)
+    {
+      --accumulator.PositiveCount;
+      accumulator.PositiveSum -= value;
+    }
+
+    return offset == accumulator.MinimumOffset || offset == accumulator.MaximumOffset;
+  }
+
+  /// histogram bins of one label in one time step
+  struct Binning
+  {
+    unsigned int NumberOfBins = 0;
+    std::size_t Offset = 0; // of the first bin within the frequencies of the time step
+    double Lower = 0.0;
+    double Upper = 0.0;
+    double Width = 0.0;
+    std::vector<double> BinMins;
+
+    /// the bin of itk::Statistics::Histogram::GetIndex(): the last bin whose minimum is <= value
+    unsigned int GetBin(double value) const
+    {
+      unsigned int bin = NumberOfBins - 1;
+
+      if (Width > 0.0)
+      {
+        const double estimate = (value - Lower) / Width;
+        if (estimate < bin)
+          bin = estimate > 0.0 ? static_cast<unsigned int>(estimate) : 0;
+      }
+
+      // the estimate may be off by one due to the rounding of the bin boundaries of the histogram
+      while (bin + 1 < NumberOfBins && BinMins[bin + 1] <= value)
+        ++bin;
+      while (bin > 0 && BinMins[bin] > value)
+        --bin;
+
+      return bin;
+    }
+  };
+
+  typedef void (*CastLabelsFunction)(const void *, std::size_t, LabelPixelType *);
+
+  template <typename TLabelPixel>
+  void CastLabels(const void *source, std::size_t numberOfVoxels, LabelPixelType *target)
+  {
+    const auto *labels = static_cast<const TLabelPixel *>(source);
+    std::transform(labels, labels + numberOfVoxels, target, [](TLabelPixel label) {
+      return static_cast<LabelPixelType>(label);
+    });
+  }
+
+  template <typename TLabelPixel>
+  void GetCastLabelsFunction(const mitk::PixelType &, CastLabelsFunction &function)
+  {
+    function = &CastLabels<TLabelPixel>;
+  }
+
+  /// the labels of a time step. Labels of another pixel type are cast while they are read, so there is no copy of the
+  /// whole label image.
+  struct LabelSource
+  {
+    const char *Data = nullptr;
+    std::size_t PixelSize = sizeof(LabelPixelType);
+    CastLabelsFunction Cast = nullptr; // nullptr for LabelPixelType
+
+    /// the labels of count voxels from first on. They are cast into buffer if necessary.
+    const LabelPixelType *Read(std::size_t first, std::size_t count, std::vector<LabelPixelType> &buffer) const
+    {
+      if (nullptr == Cast)
+        return static_cast<const LabelPixelType *>(static_cast<const void *>(Data)) + first;
+
+      buffer.resize(count);
+      Cast(Data + first * PixelSize, count, buffer.data());
+      return buffer.data();
+    }
+  };
+
+  LabelSource GetLabelSource(const void *labels, const mitk::PixelType &pixelType)
+  {
+    LabelSource source;
+    source.Data = static_cast<const char *>(labels);
+    source.PixelSize = pixelType.GetSize();
+
+    if (pixelType.GetComponentType() != itk::ImageIOBase::USHORT)
+    {
+      mitkPixelTypeMultiplex1(GetCastLabelsFunction, pixelType, source.Cast);
+
+      if (nullptr == source.Cast)
+        mitkThrow() << "Unsupported pixel type of label image: " << pixelType.GetComponentTypeAsString() << ".";
+    }
+
+    return source;
+  }
+
+  struct ScanData
+  {
+    std::size_t NumberOfVoxels; // of a time step
+    std::size_t VoxelsPerBlock;
+    std::size_t BlocksPerTimeStep;
+    std::size_t TimeStep; // the time step that is currently scanned
+    const void *Volume;   // of the time step that is currently scanned
+    std::vector<LabelSource> Labels; // empty if all voxels belong to label 1
+    bool IgnorePixelValue;
+    double IgnoredPixelValue;
+
+    std::vector<std::vector<LabelPixelType>> LabelBuffers; // [thread], the labels of a block
+    std::vector<LabelPixelType *> LabelCopies;              // [timeStep], filled in incremental mode
+
+    std::vector<std::vector<AccumulatorsType>> Accumulators; // [thread][timeStep]
+
+    std::vector<std::vector<Binning>> Binnings;                      // [timeStep][label]
+    std::vector<std::size_t> NumberOfBins;                           // [timeStep]
+    std::vector<std::vector<std::vector<std::size_t>>> Frequencies; // [thread][timeStep]
+  };
+
+  /// the labels of the voxels begin to end - 1 of the current time step or nullptr if all of them belong to label 1.
+  /// Voxels with the ignored pixel value belong to label 0.
+  template <typename TPixel>
+  const LabelPixelType *ReadBlockLabels(ScanData &data, std::size_t begin, std::size_t end, unsigned int thread)
+  {
+    auto &buffer = data.LabelBuffers[thread];
+    const LabelPixelType *labels = nullptr;
+
+    if (!data.Labels.empty())
+      labels = data.Labels[data.TimeStep].Read(begin, end - begin, buffer);
+
+    if (!data.IgnorePixelValue)
+      return labels;
+
+    if (nullptr == labels)
+      buffer.assign(end - begin, 1);
+    else if (labels != buffer.data())
+      buffer.assign(labels, labels + (end - begin));
+
+    const auto *pixels = static_cast<const TPixel *>(data.Volume) + begin;
+    const auto ignoredPixel = static_cast<TPixel>(data.IgnoredPixelValue);
+
+    for (std::size_t i = 0; i < end - begin; ++i)
+    {
+      if (pixels[i] == ignoredPixel)
+        buffer[i] = 0;
+    }
+
+    return buffer.data();
+  }
+
+  template <typename TPixel>
+  void AccumulateBlock(ScanData &data, std::size_t block, unsigned int thread)
+  {
+    const std::size_t timeStep = data.TimeStep;
+    const std::size_t begin = block * data.VoxelsPerBlock;
+    const std::size_t end = std::min(data.NumberOfVoxels, begin + data.VoxelsPerBlock);
+
+    const auto *pixels = static_cast<const TPixel *>(data.Volume);
+    const LabelPixelType *labels = ReadBlockLabels<TPixel>(data, begin, end, thread);
+    auto &accumulators = data.Accumulators[thread][timeStep];
+
+    if (!data.LabelCopies.empty())
+    {
+      if (nullptr != labels)
+        std::copy(labels, labels + (end - begin), data.LabelCopies[timeStep] + begin);
+      else
+        std::fill(data.LabelCopies[timeStep] + begin, data.LabelCopies[timeStep] + end, 1);
+    }
+
+    for (std::size_t offset = begin; offset < end; ++offset)
+    {
+      const LabelPixelType label = nullptr != labels ? labels[offset - begin] : 1;
+
+      if (label >= accumulators.size())
+        accumulators.resize(label + 1);
+
+      AddVoxel(static_cast<double>(pixels[offset]), offset, accumulators[label]);
+    }
+  }
+
+  template <typename TPixel>
+  void BinBlock(ScanData &data, std::size_t block, unsigned int thread)
+  {
+    const std::size_t timeStep = data.TimeStep;
+    const std::size_t begin = block * data.VoxelsPerBlock;
+    const std::size_t end = std::min(data.NumberOfVoxels, begin + data.VoxelsPerBlock);
+
+    const auto *pixels = static_cast<const TPixel *>(data.Volume);
+    const LabelPixelType *labels = ReadBlockLabels<TPixel>(data, begin, end, thread);
+    const auto &binnings = data.Binnings[timeStep];
+    auto &frequencies = data.Frequencies[thread][timeStep];
+
+    if (frequencies.empty())
+      frequencies.assign(data.NumberOfBins[timeStep], 0);
+
+    for (std::size_t offset = begin; offset < end; ++offset)
+    {
+      const auto &binning = binnings[nullptr != labels ? labels[offset - begin] : 1];
+      ++frequencies[binning.Offset + binning.GetBin(static_cast<double>(pixels[offset]))];
+    }
+  }
+
+  void MergeAccumulators(const Accumulator &source, Accumulator &target)
+  {
+    if (0 == source.Count)
+      return;
+
+    // the first extremum in memory order wins, like in a single-threaded scan
+    if (0 == target.Count || source.Minimum < target.Minimum ||
+        (source.Minimum == target.Minimum && source.MinimumOffset < target.MinimumOffset))
+    {
+      target.Minimum = source.Minimum;
+      target.MinimumOffset = source.MinimumOffset;
+    }
+
+    if (0 == target.Count || source.Maximum > target.Maximum ||
+        (source.Maximum == target.Maximum && source.MaximumOffset < target.MaximumOffset))
+    {
+      target.Maximum = source.Maximum;
+      target.MaximumOffset = source.MaximumOffset;
+    }
+
+    target.Count += source.Count;
+    target.Sum += source.Sum;
+    target.SumOfSquares += source.SumOfSquares;
+    target.SumOfCubes += source.SumOfCubes;
+    target.SumOfQuadruples += source.SumOfQuadruples;
+    target.PositiveCount += source.PositiveCount;
+    target.PositiveSum += source.PositiveSum;
+  }
+
+  template <typename TPixel>
+  void ScanOfPixelType(const mitk::PixelType &, ScanData &data)
+  {
+    mitk::ParallelFor(data.BlocksPerTimeStep, [&](std::size_t block, unsigned int thread) {
+      AccumulateBlock<TPixel>(data, block, thread);
+    });
+  }
+
+  template <typename TPixel>
+  void BinOfPixelType(const mitk::PixelType &, ScanData &data)
+  {
+    mitk::ParallelFor(data.BlocksPerTimeStep, [&](std::size_t block, unsigned int thread) {
+      BinBlock<TPixel>(data, block, thread);
+    });
+  }
+
+  HistogramType::Pointer CreateHistogram(unsigned int numberOfBins, double lower, double upper)
+  {
+    auto histogram = HistogramType::New();
+    HistogramType::SizeType size;
+    HistogramType::MeasurementVectorType lowerBound;
+    HistogramType::MeasurementVectorType upperBound;
+    size.SetSize(1);
+    lowerBound.SetSize(1);
+    upperBound.SetSize(1);
+    histogram->SetMeasurementVectorSize(1);
+    size[0] = numberOfBins;
+    lowerBound[0] = lower;
+    upperBound[0] = upper;
+    histogram->Initialize(size, lowerBound, upperBound);
+
+    return histogram;
+  }
+
+  Binning GetBinning(const HistogramType *histogram)
+  {
+    Binning binning;
+    binning.NumberOfBins = static_cast<unsigned int>(histogram->GetSize(0));
+    binning.Lower = histogram->GetBinMin(0, 0);
+    binning.Upper = histogram->GetBinMax(0, binning.NumberOfBins - 1);
+    binning.Width = (binning.Upper - binning.Lower) / binning.NumberOfBins;
+
+    binning.BinMins.resize(binning.NumberOfBins);
+    for (unsigned int bin = 0; bin < binning.NumberOfBins; ++bin)
+      binning.BinMins[bin] = histogram->GetBinMin(0, bin);
+
+    return binning;
+  }
+
+  /// converts an offset within a time step to its index
+  struct OffsetToIndex
+  {
+    std::size_t RowLength;
+    std::size_t SliceSize;
+
+    mitk::MultiLabelStatisticsCalculator::IndexType operator()(std::size_t offset) const
+    {
+      mitk::MultiLabelStatisticsCalculator::IndexType index;
+      index[0] = static_cast<unsigned int>(offset % RowLength);
+      index[1] = static_cast<unsigned int>((offset % SliceSize) / RowLength);
+      index[2] = static_cast<unsigned int>(offset / SliceSize);
+      return index;
+    }
+  };
+
+  /// the statistics of a label, with the formulas of ExtendedLabelStatisticsImageFilter. The frequencies of the
+  /// histogram of the statistics have to be set.
+  void ComputeLabelStatistics(const Accumulator &accumulator,
+                              const OffsetToIndex &offsetToIndex,
+                              mitk::MultiLabelStatisticsCalculator::LabelStatistics &statistics)
+  {
+    const double count = static_cast<double>(accumulator.Count);
+    const double mean = accumulator.Sum / count;
+    const double secondMoment = accumulator.SumOfSquares / count;
+    const double thirdMoment = accumulator.SumOfCubes / count;
+    const double fourthMoment = accumulator.SumOfQuadruples / count;
+    const double centralSecondMoment = secondMoment - mean * mean;
+
+    statistics.NumberOfVoxels = accumulator.Count;
+    statistics.Mean = mean;
+    statistics.Minimum = accumulator.Minimum;
+    statistics.Maximum = accumulator.Maximum;
+    statistics.Variance = (accumulator.SumOfSquares - accumulator.Sum * accumulator.Sum / count) / count;
+    statistics.Sigma = std::sqrt(statistics.Variance);
+    statistics.Skewness =
+      (thirdMoment - 3. * secondMoment * mean + 2. * std::pow(mean, 3.)) / std::pow(centralSecondMoment, 1.5);
+    statistics.Kurtosis = (fourthMoment - 4. * thirdMoment * mean + 6. * secondMoment * std::pow(mean, 2.) -
+                           3. * std::pow(mean, 4.)) /
+                          std::pow(centralSecondMoment, 2.); // dropped -3
+    statistics.RMS = std::sqrt(mean * mean + statistics.Variance);
+    statistics.MPP = accumulator.PositiveSum / static_cast<double>(accumulator.PositiveCount);
+    statistics.MinimumIndex = offsetToIndex(accumulator.MinimumOffset);
+    statistics.MaximumIndex = offsetToIndex(accumulator.MaximumOffset);
+
+    mitk::HistogramStatisticsCalculator histogramStatisticsCalculator;
+    histogramStatisticsCalculator.SetHistogram(statistics.Histogram);
+    histogramStatisticsCalculator.CalculateStatistics();
+    statistics.Median = histogramStatisticsCalculator.GetMedian();
+    statistics.Entropy = histogramStatisticsCalculator.GetEntropy();
+    statistics.Uniformity = histogramStatisticsCalculator.GetUniformity();
+    statistics.UPP = histogramStatisticsCalculator.GetUPP();
+  }
+
+  struct UpdateData
+  {
+    const void *Volume;
+    OffsetToIndex Offsets;
+    mitk::MultiLabelStatisticsCalculator::RegionType Region;
+    const LabelPixelType *RegionLabels; // current labels of the region in memory order
+    LabelPixelType *Labels;             // previous labels of the time step
+    AccumulatorsType *Accumulators;
+    const Binning *TimeStepBinning;
+    std::vector<std::vector<std::size_t>> *Frequencies; // [label]
+    bool IgnorePixelValue;
+    double IgnoredPixelValue;
+    std::vector<bool> ChangedLabels;
+    std::vector<bool> LabelsWithoutExtrema;
+  };
+
+  template <typename TPixel>
+  void UpdateOfPixelType(const mitk::PixelType &, UpdateData &data)
+  {
+    const auto *pixels = static_cast<const TPixel *>(data.Volume);
+    const auto ignoredPixel = static_cast<TPixel>(data.IgnoredPixelValue);
+    const LabelPixelType *regionLabel = data.RegionLabels;
+    auto &accumulators = *data.Accumulators;
+    auto &frequencies = *data.Frequencies;
+
+    const auto &index = data.Region.GetIndex();
+    const auto &size = data.Region.GetSize();
+
+    for (std::size_t z = index[2]; z < index[2] + size[2]; ++z)
+    {
+      for (std::size_t y = index[1]; y < index[1] + size[1]; ++y)
+      {
+        const std::size_t rowOffset = z * data.Offsets.SliceSize + y * data.Offsets.RowLength;
+
+        for (std::size_t x = index[0]; x < index[0] + size[0]; ++x, ++regionLabel)
+        {
+          const std::size_t offset = rowOffset + x;
+          const LabelPixelType previousLabel = data.Labels[offset];
+          const LabelPixelType label = data.IgnorePixelValue && pixels[offset] == ignoredPixel ? 0 : *regionLabel;
+
+          if (label == previousLabel)
+            continue;
+
+          if (label >= accumulators.size())
+          {
+            accumulators.resize(label + 1);
+            frequencies.resize(label + 1);
+            data.ChangedLabels.resize(label + 1, false);
+            data.LabelsWithoutExtrema.resize(label + 1, false);
+          }
+
+          const double value = static_cast<double>(pixels[offset]);
+          const unsigned int bin = data.TimeStepBinning->GetBin(value);
+
+          if (RemoveVoxel(value, offset, accumulators[previousLabel]))
+            data.LabelsWithoutExtrema[previousLabel] = true;
+
+          --frequencies[previousLabel][bin];
+
+          AddVoxel(value, offset, accumulators[label]);
+
+          if (frequencies[label].empty())
+            frequencies[label].assign(data.TimeStepBinning->NumberOfBins, 0);
+
+          ++frequencies[label][bin];
+
+          data.ChangedLabels[previousLabel] = true;
+          data.ChangedLabels[label] = true;
+          data.Labels[offset] = label;
+        }
+      }
+    }
+  }
+
+  template <typename TPixel>
+  void FindExtremaOfPixelType(const mitk::PixelType &, UpdateData &data, std::size_t numberOfVoxels)
+  {
+    const auto *pixels = static_cast<const TPixel *>(data.Volume);
+    auto &accumulators = *data.Accumulators;
+    std::vector<bool> found(accumulators.size(), false);
+
+    for (std::size_t offset = 0; offset < numberOfVoxels; ++offset)
+    {
+      const LabelPixelType label = data.Labels[offset];
+
+      if (!data.LabelsWithoutExtrema[label])
+        continue;
+
+      auto &accumulator = accumulators[label];
+      const double value = static_cast<double>(pixels[offset]);
+
+      if (!found[label])
+      {
+        accumulator.Minimum = accumulator.Maximum = value;
+        accumulator.MinimumOffset = accumulator.MaximumOffset = offset;
+        found[label] = true;
+      }
+      else if (value < accumulator.Minimum)
+      {
+        accumulator.Minimum = value;
+        accumulator.MinimumOffset = offset;
+      }
+      else if (value > accumulator.Maximum)
+      {
+        accumulator.Maximum = value;
+        accumulator.MaximumOffset = offset;
+      }
+    }
+  }
+}
+
+/// the state of the statistics that Update() changes
+struct mitk::MultiLabelStatisticsCalculator::IncrementalState
+{
+  Image::ConstPointer InputImage;
+  unsigned int Size[3];
+  bool IgnorePixelValue;
+  double IgnoredPixelValue;
+  std::vector<std::vector<LabelPixelType>> Labels;                // [timeStep]
+  std::vector<AccumulatorsType> Accumulators;                     // [timeStep]
+  std::vector<Binning> Binnings;                                  // [timeStep]
+  std::vector<std::vector<std::vector<std::size_t>>> Frequencies; // [timeStep][label]
+};
+
+mitk::MultiLabelStatisticsCalculator::MultiLabelStatisticsCalculator()
+  : m_NumberOfBins(100),
+    m_BinSize(10.0),
+    m_UseBinSize(false),
+    m_Incremental(false),
+    m_IgnorePixelValue(false),
+    m_IgnoredPixelValue(0.0)
+{
+}
+
+mitk::MultiLabelStatisticsCalculator::~MultiLabelStatisticsCalculator()
+{
+}
+
+void mitk::MultiLabelStatisticsCalculator::SetNumberOfBins(unsigned int numberOfBins)
+{
+  m_NumberOfBins = numberOfBins;
+  m_UseBinSize = false;
+}
+
+unsigned int mitk::MultiLabelStatisticsCalculator::GetNumberOfBins() const
+{
+  return m_NumberOfBins;
+}
+
+void mitk::MultiLabelStatisticsCalculator::SetBinSize(double binSize)
+{
+  m_BinSize = binSize;
+  m_UseBinSize = true;
+}
+
+double mitk::MultiLabelStatisticsCalculator::GetBinSize() const
+{
+  return m_BinSize;
+}
+
+void mitk::MultiLabelStatisticsCalculator::SetIncremental(bool incremental)
+{
+  m_Incremental = incremental;
+}
+
+bool mitk::MultiLabelStatisticsCalculator::GetIncremental() const
+{
+  return m_Incremental;
+}
+
+void mitk::MultiLabelStatisticsCalculator::SetIgnoredPixelValue(double pixelValue)
+{
+  m_IgnoredPixelValue = pixelValue;
+  m_IgnorePixelValue = true;
+}
+
+void mitk::MultiLabelStatisticsCalculator::ResetIgnoredPixelValue()
+{
+  m_IgnorePixelValue = false;
+}
+
+bool mitk::MultiLabelStatisticsCalculator::HasIgnoredPixelValue() const
+{
+  return m_IgnorePixelValue;
+}
+
+double mitk::MultiLabelStatisticsCalculator::GetIgnoredPixelValue() const
+{
+  return m_IgnoredPixelValue;
+}
+
+void mitk::MultiLabelStatisticsCalculator::Compute(const Image *image,
+                                                   const std::vector<Image::ConstPointer> &labelImages)
+{
+  if (nullptr == image || !image->IsInitialized())
+    mitkThrow() << "Image not initialized!";
+
+  if (image->GetPixelType().GetNumberOfComponents() != 1)
+    mitkThrow() << "Only images with single component pixels are supported.";
+
+  const unsigned int numberOfTimeSteps = image->GetTimeSteps();
+
+  if (!labelImages.empty() && labelImages.size() != 1 && labelImages.size() != numberOfTimeSteps)
+    mitkThrow() << "There has to be one label image or one label image per time step.";
+
+  if (0 == m_NumberOfBins || (m_UseBinSize && m_BinSize <= 0.0))
+    mitkThrow() << "Invalid histogram parameters.";
+
+  m_IncrementalState.reset();
+
+  ScanData data;
+  data.NumberOfVoxels =
+    static_cast<std::size_t>(image->GetDimension(0)) * image->GetDimension(1) * image->GetDimension(2);
+
+  // several blocks per thread balance the load of unevenly distributed labels. The size of the blocks is limited, since
+  // each thread holds the labels of its current block.
+  const std::size_t rowLength = image->GetDimension(0);
+  const std::size_t numberOfRows = data.NumberOfVoxels / rowLength;
+  const std::size_t numberOfBlocks = 4 * itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  const std::size_t rowsPerBlock = std::max<std::size_t>(1, MaximumVoxelsPerBlock / rowLength);
+  const std::size_t blocksPerTimeStep =
+    std::max(std::min(numberOfRows, numberOfBlocks), (numberOfRows + rowsPerBlock - 1) / rowsPerBlock);
+  data.VoxelsPerBlock = ((numberOfRows + blocksPerTimeStep - 1) / blocksPerTimeStep) * rowLength;
+  data.BlocksPerTimeStep = (data.NumberOfVoxels + data.VoxelsPerBlock - 1) / data.VoxelsPerBlock;
+
+  // keep the label images accessible (and locked) while the threads scan them. The volumes of the image are accessed
+  // one time step at a time.
+  std::vector<std::unique_ptr<ImageReadAccessor>> readAccessors;
+
+  for (const auto &labelImage : labelImages)
+  {
+    if (labelImage.IsNull() || !labelImage->IsInitialized())
+      mitkThrow() << "Label image not initialized!";
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      if (labelImage->GetDimension(dim) != image->GetDimension(dim))
+        mitkThrow() << "The label images must have the size of a time step of the image.";
+    }
+
+    const auto labelPixelType = labelImage->GetPixelType();
+
+    if (labelPixelType.GetNumberOfComponents() != 1)
+      mitkThrow() << "Only label images with single component pixels are supported.";
+
+    readAccessors.emplace_back(new ImageReadAccessor(labelImage, labelImage->GetVolumeData(0)));
+    data.Labels.push_back(GetLabelSource(readAccessors.back()->GetData(), labelPixelType));
+  }
+
+  // one label image for all time steps
+  if (1 == data.Labels.size())
+    data.Labels.resize(numberOfTimeSteps, data.Labels.front());
+
+  data.IgnorePixelValue = m_IgnorePixelValue;
+  data.IgnoredPixelValue = m_IgnoredPixelValue;
+
+  // the labels of each time step for Update(), written by the first pass
+  std::vector<std::vector<LabelPixelType>> labelCopies;
+
+  if (m_Incremental)
+  {
+    labelCopies.assign(numberOfTimeSteps, std::vector<LabelPixelType>(data.NumberOfVoxels));
+
+    for (auto &labelCopy : labelCopies)
+      data.LabelCopies.push_back(labelCopy.data());
+  }
+
+  const auto numberOfThreads = mitk::GetParallelForNumberOfThreads(data.BlocksPerTimeStep);
+  data.Accumulators.assign(numberOfThreads, std::vector<AccumulatorsType>(numberOfTimeSteps));
+  data.LabelBuffers.resize(numberOfThreads);
+  data.Frequencies.assign(numberOfThreads, std::vector<std::vector<std::size_t>>(numberOfTimeSteps));
+
+  const auto getNumberOfBins = [this](double lower, double upper) {
+    // do not allow less than 10 bins if the bin size is given
+    return m_UseBinSize ? static_cast<unsigned int>(std::max(std::ceil(upper - lower) / m_BinSize, 10.))
+                        : m_NumberOfBins;
+  };
+
+  const auto pixelType = image->GetPixelType();
+  std::vector<AccumulatorsType> accumulators(numberOfTimeSteps);
+  data.Binnings.resize(numberOfTimeSteps);
+  data.NumberOfBins.assign(numberOfTimeSteps, 0);
+  m_Statistics.assign(numberOfTimeSteps, LabelStatisticsMapType());
+
+  for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+  {
+    ImageReadAccessor volumeAccessor(image, image->GetVolumeData(timeStep));
+    data.TimeStep = timeStep;
+    data.Volume = volumeAccessor.GetData();
+
+    // 1. moments and extrema of all labels of the time step
+    mitkPixelTypeMultiplex1(ScanOfPixelType, pixelType, data);
+
+    for (auto &threadAccumulators : data.Accumulators)
+    {
+      const auto &source = threadAccumulators[timeStep];
+
+      if (source.size() > accumulators[timeStep].size())
+        accumulators[timeStep].resize(source.size());
+
+      for (std::size_t label = 0; label < source.size(); ++label)
+        MergeAccumulators(source[label], accumulators[timeStep][label]);
+
+      threadAccumulators[timeStep].clear();
+    }
+
+    // 2. histograms over the extrema of each label, or over the value range of the time step in incremental mode
+    data.Binnings[timeStep].resize(accumulators[timeStep].size());
+
+    Accumulator timeStepAccumulator;
+    if (m_Incremental)
+    {
+      for (const auto &accumulator : accumulators[timeStep])
+        MergeAccumulators(accumulator, timeStepAccumulator);
+    }
+
+    for (std::size_t label = 0; label < accumulators[timeStep].size(); ++label)
+    {
+      const auto &accumulator = accumulators[timeStep][label];
+
+      if (0 == accumulator.Count)
+        continue;
+
+      const auto &range = m_Incremental ? timeStepAccumulator : accumulator;
+      auto histogram = CreateHistogram(getNumberOfBins(range.Minimum, range.Maximum), range.Minimum, range.Maximum);
+
+      auto &binning = data.Binnings[timeStep][label];
+      binning = GetBinning(histogram);
+      binning.Offset = data.NumberOfBins[timeStep];
+      data.NumberOfBins[timeStep] += binning.NumberOfBins;
+
+      m_Statistics[timeStep][static_cast<LabelPixelType>(label)].Histogram = histogram;
+    }
+
+    mitkPixelTypeMultiplex1(BinOfPixelType, pixelType, data);
+  }
+
+  data.Accumulators.clear();
+
+  // 3. statistics of each label
+  const std::size_t sliceSize = rowLength * image->GetDimension(1);
+  const OffsetToIndex offsetToIndex = {rowLength, sliceSize};
+  std::vector<std::vector<std::vector<std::size_t>>> labelFrequencies(numberOfTimeSteps);
+
+  for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+  {
+    labelFrequencies[timeStep].resize(accumulators[timeStep].size());
+
+    for (auto &labelStatistics : m_Statistics[timeStep])
+    {
+      const auto &binning = data.Binnings[timeStep][labelStatistics.first];
+      auto &statistics = labelStatistics.second;
+      auto &frequencies = labelFrequencies[timeStep][labelStatistics.first];
+      frequencies.assign(binning.NumberOfBins, 0);
+
+      for (const auto &threadFrequencies : data.Frequencies)
+      {
+        if (threadFrequencies[timeStep].empty())
+          continue;
+
+        for (unsigned int bin = 0; bin < binning.NumberOfBins; ++bin)
+          frequencies[bin] += threadFrequencies[timeStep][binning.Offset + bin];
+      }
+
+      for (unsigned int bin = 0; bin < binning.NumberOfBins; ++bin)
+        statistics.Histogram->SetFrequency(bin, frequencies[bin]);
+
+      ComputeLabelStatistics(accumulators[timeStep][labelStatistics.first], offsetToIndex, statistics);
+    }
+  }
+
+  if (!m_Incremental)
+    return;
+
+  // 4. the state for Update()
+  m_IncrementalState.reset(new IncrementalState);
+  auto &state = *m_IncrementalState;
+  state.InputImage = image;
+  state.IgnorePixelValue = m_IgnorePixelValue;
+  state.IgnoredPixelValue = m_IgnoredPixelValue;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    state.Size[dim] = image->GetDimension(dim);
+
+  state.Binnings.resize(numberOfTimeSteps);
+
+  for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+  {
+    // all labels share the bins of the time step
+    const auto binning = std::find_if(data.Binnings[timeStep].begin(),
+                                      data.Binnings[timeStep].end(),
+                                      [](const Binning &labelBinning) { return labelBinning.NumberOfBins > 0; });
+    state.Binnings[timeStep] = *binning;
+    state.Binnings[timeStep].Offset = 0;
+  }
+
+  state.Labels = std::move(labelCopies);
+  state.Accumulators = std::move(accumulators);
+  state.Frequencies = std::move(labelFrequencies);
+}
+
+unsigned int mitk::MultiLabelStatisticsCalculator::GetNumberOfTimeSteps() const
+{
+  return static_cast<unsigned int>(m_Statistics.size());
+}
+
+const mitk::MultiLabelStatisticsCalculator::LabelStatisticsMapType &mitk::MultiLabelStatisticsCalculator::GetStatistics(
+  unsigned int timeStep) const
+{
+  if (timeStep >= m_Statistics.size())
+    mitkThrow() << "Invalid time step " << timeStep << ".";
+
+  return m_Statistics[timeStep];
+}
+
+void mitk::MultiLabelStatisticsCalculator::Update(const Image *labelImage,
+                                                  unsigned int timeStep,
+                                                  const RegionType &region)
+{
+  if (nullptr == m_IncrementalState)
+    mitkThrow() << "Update() requires a previous Compute() in incremental mode.";
+
+  if (timeStep >= m_Statistics.size())
+    mitkThrow() << "Invalid time step " << timeStep << ".";
+
+  if (nullptr == labelImage || !labelImage->IsInitialized())
+    mitkThrow() << "Label image not initialized!";
+
+  auto &state = *m_IncrementalState;
+  RegionType labelImageRegion;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (labelImage->GetDimension(dim) != state.Size[dim])
+      mitkThrow() << "The label image must have the size of a time step of the image.";
+
+    labelImageRegion.SetSize(dim, state.Size[dim]);
+  }
+
+  const auto labelPixelType = labelImage->GetPixelType();
+
+  if (labelPixelType.GetNumberOfComponents() != 1)
+    mitkThrow() << "Only label images with single component pixels are supported.";
+
+  auto changedRegion = region;
+
+  if (!changedRegion.Crop(labelImageRegion))
+    return;
+
+  const OffsetToIndex offsetToIndex = {state.Size[0], static_cast<std::size_t>(state.Size[0]) * state.Size[1]};
+  const auto &index = changedRegion.GetIndex();
+  const auto &size = changedRegion.GetSize();
+
+  // the current labels of the changed region, cast row by row
+  std::vector<LabelPixelType> regionLabels(changedRegion.GetNumberOfPixels());
+
+  {
+    ImageReadAccessor labelAccessor(labelImage, labelImage->GetVolumeData(0));
+    const auto labels = GetLabelSource(labelAccessor.GetData(), labelPixelType);
+    std::vector<LabelPixelType> buffer;
+    auto *regionLabel = regionLabels.data();
+
+    for (std::size_t z = index[2]; z < index[2] + size[2]; ++z)
+    {
+      for (std::size_t y = index[1]; y < index[1] + size[1]; ++y, regionLabel += size[0])
+      {
+        const std::size_t offset = z * offsetToIndex.SliceSize + y * offsetToIndex.RowLength + index[0];
+        const auto *rowLabels = labels.Read(offset, size[0], buffer);
+        std::copy(rowLabels, rowLabels + size[0], regionLabel);
+      }
+    }
+  }
+
+  ImageReadAccessor imageAccessor(state.InputImage, state.InputImage->GetVolumeData(timeStep));
+
+  UpdateData data;
+  data.Volume = imageAccessor.GetData();
+  data.Offsets = offsetToIndex;
+  data.Region = changedRegion;
+  data.RegionLabels = regionLabels.data();
+  data.Labels = state.Labels[timeStep].data();
+  data.Accumulators = &state.Accumulators[timeStep];
+  data.TimeStepBinning = &state.Binnings[timeStep];
+  data.Frequencies = &state.Frequencies[timeStep];
+  data.IgnorePixelValue = state.IgnorePixelValue;
+  data.IgnoredPixelValue = state.IgnoredPixelValue;
+  data.ChangedLabels.assign(state.Accumulators[timeStep].size(), false);
+  data.LabelsWithoutExtrema.assign(state.Accumulators[timeStep].size(), false);
+
+  const auto pixelType = state.InputImage->GetPixelType();
+  mitkPixelTypeMultiplex1(UpdateOfPixelType, pixelType, data);
+
+  // only labels that lost the voxel of an extremum have to be searched
+  if (std::find(data.LabelsWithoutExtrema.begin(), data.LabelsWithoutExtrema.end(), true) !=
+      data.LabelsWithoutExtrema.end())
+  {
+    mitkPixelTypeMultiplex2(FindExtremaOfPixelType, pixelType, data, state.Labels[timeStep].size());
+  }
+
+  for (std::size_t label = 0; label < data.ChangedLabels.size(); ++label)
+  {
+    if (!data.ChangedLabels[label])
+      continue;
+
+    const auto &accumulator = state.Accumulators[timeStep][label];
+
+    if (0 == accumulator.Count)
+    {
+      m_Statistics[timeStep].erase(static_cast<LabelPixelType>(label));
+      continue;
+    }
+
+    // a new histogram, since earlier results may still refer to the previous one
+    const auto &binning = state.Binnings[timeStep];
+    const auto &frequencies = state.Frequencies[timeStep][label];
+    auto &statistics = m_Statistics[timeStep][static_cast<LabelPixelType>(label)];
+    statistics.Histogram = CreateHistogram(binning.NumberOfBins, binning.Lower, binning.Upper);
+
+    for (unsigned int bin = 0; bin < binning.NumberOfBins; ++bin)
+      statistics.Histogram->SetFrequency(bin, frequencies[bin]);
+
+    ComputeLabelStatistics(accumulator, offsetToIndex, statistics);
+  }
+}
+
+bool mitk::MultiLabelStatisticsCalculator::FindChangedRegion(const Image *labelImage,
+                                                             unsigned int timeStep,
+                                                             RegionType &region) const
+{
+  if (nullptr == m_IncrementalState)
+    mitkThrow() << "FindChangedRegion() requires a previous Compute() in incremental mode.";
+
+  if (timeStep >= m_Statistics.size())
+    mitkThrow() << "Invalid time step " << timeStep << ".";
+
+  if (nullptr == labelImage || !labelImage->IsInitialized())
+    mitkThrow() << "Label image not initialized!";
+
+  const auto &state = *m_IncrementalState;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (labelImage->GetDimension(dim) != state.Size[dim])
+      mitkThrow() << "The label image must have the size of a time step of the image.";
+  }
+
+  const auto labelPixelType = labelImage->GetPixelType();
+
+  if (labelPixelType.GetNumberOfComponents() != 1)
+    mitkThrow() << "Only label images with single component pixels are supported.";
+
+  ImageReadAccessor labelAccessor(labelImage, labelImage->GetVolumeData(0));
+  const auto labels = GetLabelSource(labelAccessor.GetData(), labelPixelType);
+  const auto *previousLabels = state.Labels[timeStep].data();
+  const std::size_t rowLength = state.Size[0];
+
+  // the bounding box of the changed voxels of the slices of each thread
+  struct ChangedBox
+  {
+    bool Changed = false;
+    RegionType::IndexType Lower;
+    RegionType::IndexType Upper;
+  };
+
+  const auto numberOfThreads = mitk::GetParallelForNumberOfThreads(state.Size[2]);
+  std::vector<ChangedBox> boxes(numberOfThreads);
+  std::vector<std::vector<LabelPixelType>> buffers(numberOfThreads);
+
+  mitk::ParallelFor(state.Size[2], [&](std::size_t z, unsigned int thread) {
+    auto &box = boxes[thread];
+
+    for (std::size_t y = 0; y < state.Size[1]; ++y)
+    {
+      const std::size_t offset = (z * state.Size[1] + y) * rowLength;
+      const auto *current = labels.Read(offset, rowLength, buffers[thread]);
+      const auto *previous = previousLabels + offset;
+
+      const auto first = std::mismatch(current, current + rowLength, previous).first - current;
+
+      if (static_cast<std::size_t>(first) == rowLength)
+        continue;
+
+      auto last = rowLength - 1;
+      while (current[last] == previous[last])
+        --last;
+
+      RegionType::IndexType lower;
+      lower[0] = static_cast<itk::IndexValueType>(first);
+      lower[1] = static_cast<itk::IndexValueType>(y);
+      lower[2] = static_cast<itk::IndexValueType>(z);
+
+      auto upper = lower;
+      upper[0] = static_cast<itk::IndexValueType>(last);
+
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        box.Lower[dim] = box.Changed ? std::min(box.Lower[dim], lower[dim]) : lower[dim];
+        box.Upper[dim] = box.Changed ? std::max(box.Upper[dim], upper[dim]) : upper[dim];
+      }
+
+      box.Changed = true;
+    }
+  });
+
+  ChangedBox changedBox;
+
+  for (const auto &box : boxes)
+  {
+    if (!box.Changed)
+      continue;
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      changedBox.Lower[dim] = changedBox.Changed ? std::min(changedBox.Lower[dim], box.Lower[dim]) : box.Lower[dim];
+      changedBox.Upper[dim] = changedBox.Changed ? std::max(changedBox.Upper[dim], box.Upper[dim]) : box.Upper[dim];
+    }
+
+    changedBox.Changed = true;
+  }
+
+  if (!changedBox.Changed)
+    return false;
+
+  region.SetIndex(changedBox.Lower);
+  region.SetUpperIndex(changedBox.Upper);
+  return true;
+}
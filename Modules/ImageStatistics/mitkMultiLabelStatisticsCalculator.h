@@ -0,0 +1,171 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultiLabelStatisticsCalculator_h
+#define mitkMultiLabelStatisticsCalculator_h
+
+#include <MitkImageStatisticsExports.h>
+#include <mitkImage.h>
+
+#include <itkHistogram.h>
+#include <itkImageRegion.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Computes the statistics of all labels of all time steps of an image at once.
+
+    The time steps are scanned one after another. The rows of a time step are distributed to the threads, and each
+    thread accumulates the moments, the extrema and their positions of each label in its own accumulators. These are
+    merged after the scan, so there is neither an ImageTimeSelector copy nor a separate min/max filter run per time
+    step.
+
+    The histogram of a label spans its extrema, so the histograms of a time step are filled in a second parallel pass
+    after the extrema are known.
+
+    The labels of a time step are given by a label image of the size of a time step of the image. Without label images,
+    all voxels belong to label 1 like in the unmasked statistics of ImageStatisticsCalculator. The results are those of
+    ExtendedStatisticsImageFilter and ExtendedLabelStatisticsImageFilter.
+
+    The image and the label images are read in place, slab by slab. Label images of another pixel type than
+    LabelPixelType are cast slab by slab as well, so the memory needed besides the images is bounded by the number of
+    threads and the number of labels. Only the volume of the current time step of the image is accessed, so the volumes
+    of an image with an ImageVolumeLoader are loaded one after another instead of all before the scan.
+
+    In incremental mode, the accumulated moments, extrema and histogram frequencies of each label are kept after
+    Compute(), so Update() can apply the edits of a label image (e.g. a paint stroke) by subtracting the voxels of the
+    changed region from their previous labels and adding them to their current labels.
+  */
+  class MITKIMAGESTATISTICS_EXPORT MultiLabelStatisticsCalculator
+  {
+  public:
+    typedef unsigned short LabelPixelType;
+    typedef itk::Statistics::Histogram<double> HistogramType;
+    typedef std::array<unsigned int, 3> IndexType;
+    typedef itk::ImageRegion<3> RegionType;
+
+    struct LabelStatistics
+    {
+      std::size_t NumberOfVoxels;
+      double Mean;
+      double Minimum;
+      double Maximum;
+      double Sigma;
+      double Variance;
+      double Skewness;
+      double Kurtosis;
+      double RMS;
+      double MPP;
+      double Median;
+      double Entropy;
+      double Uniformity;
+      double UPP;
+
+      /** \brief Index of the first voxel (in memory order) with the minimum or maximum value.*/
+      IndexType MinimumIndex;
+      IndexType MaximumIndex;
+
+      HistogramType::Pointer Histogram;
+    };
+
+    typedef std::map<LabelPixelType, LabelStatistics> LabelStatisticsMapType;
+
+    MultiLabelStatisticsCalculator();
+    ~MultiLabelStatisticsCalculator();
+
+    /** \brief Number of histogram bins per label (default: 100). Disables the bin size.*/
+    void SetNumberOfBins(unsigned int numberOfBins);
+    unsigned int GetNumberOfBins() const;
+
+    /** \brief Size of the histogram bins, at least 10 bins are used per label. Disables the number of bins.*/
+    void SetBinSize(double binSize);
+    double GetBinSize() const;
+
+    /** \brief Keep the state of the statistics for Update() (default: false).
+
+      The histograms of all labels of a time step then share the bins over the value range of the whole time step,
+      which does not change with the labels, instead of spanning the extrema of each label. Each time step keeps a
+      copy of its labels to know the previous labels of changed voxels.
+    */
+    void SetIncremental(bool incremental);
+    bool GetIncremental() const;
+
+    /** \brief Voxels with this value (cast to the pixel type of the image) belong to label 0, like with an
+      IgnorePixelMaskGenerator as secondary mask of ImageStatisticsCalculator.*/
+    void SetIgnoredPixelValue(double pixelValue);
+
+    /** \brief No voxels are assigned to label 0 because of their value (default).*/
+    void ResetIgnoredPixelValue();
+
+    bool HasIgnoredPixelValue() const;
+    double GetIgnoredPixelValue() const;
+
+    /** \brief Computes the statistics of all labels of all time steps of image.
+
+      \param image A 2D, 3D or 4D image with single component pixels.
+      \param labelImages Empty, a single label image for all time steps or one label image per time step. Each label
+      image has the size of a time step of image and integral pixels, which are cast to LabelPixelType.
+      \throw mitk::Exception if the image or the label images are not suitable.
+    */
+    void Compute(const Image *image,
+                 const std::vector<Image::ConstPointer> &labelImages = std::vector<Image::ConstPointer>());
+
+    unsigned int GetNumberOfTimeSteps() const;
+
+    /** \brief Statistics of all labels that occur in a time step.*/
+    const LabelStatisticsMapType &GetStatistics(unsigned int timeStep) const;
+
+    /** \brief Applies the changes of the labels of a time step within region to its statistics.
+
+      Only the statistics of labels that gained or lost voxels are updated. If a label loses the voxel of its minimum
+      or maximum, its extrema are searched again in the time step.
+
+      \param labelImage The current label image of the time step, of the size of a time step of the image.
+      \param timeStep The time step of the image.
+      \param region The changed region of the label image. It is cropped to the label image.
+      \throw mitk::Exception if there is no previous Compute() in incremental mode or the label image is not suitable.
+    */
+    void Update(const Image *labelImage, unsigned int timeStep, const RegionType &region);
+
+    /** \brief Finds the region of the voxels whose labels differ from the labels that the statistics of a time step
+      were last computed or updated with.
+
+      This allows to call Update() after edits of unknown extent, at the cost of comparing the labels of the time step.
+
+      \param labelImage The current label image of the time step, of the size of a time step of the image.
+      \param timeStep The time step of the image.
+      \param region The bounding region of the changed voxels, unchanged if there are none.
+      \return false if no label changed.
+      \throw mitk::Exception if there is no previous Compute() in incremental mode or the label image is not suitable.
+    */
+    bool FindChangedRegion(const Image *labelImage, unsigned int timeStep, RegionType &region) const;
+
+  private:
+    struct IncrementalState;
+
+    unsigned int m_NumberOfBins;
+    double m_BinSize;
+    bool m_UseBinSize;
+    bool m_Incremental;
+    bool m_IgnorePixelValue;
+    double m_IgnoredPixelValue;
+
+    std::vector<LabelStatisticsMapType> m_Statistics;
+    std::unique_ptr<IncrementalState> m_IncrementalState;
+  };
+}
+
+#endif
@@ -36,6 +36,9 @@ QmitkDataGeneratorBase::~QmitkDataGeneratorBase()
     // remove "change node listener" from data storage
     dataStorage->ChangedNodeEvent.RemoveListener(
       mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeAddedOrModified));
+    // remove "remove node listener" from data storage
+    dataStorage->RemoveNodeEvent.RemoveListener(
+      mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeRemoved));
   }
 }
 
@@ -66,6 +69,8 @@ void QmitkDataGeneratorBase::SetDataStorage(mitk::DataStorage* storage)
     // remove "change node listener" from old data storage
     oldStorage->ChangedNodeEvent.RemoveListener(
       mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeAddedOrModified));
+    oldStorage->RemoveNodeEvent.RemoveListener(
+      mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeRemoved));
   }
 
   m_Storage = storage;
@@ -77,6 +82,8 @@ void QmitkDataGeneratorBase::SetDataStorage(mitk::DataStorage* storage)
     // add change node listener for new data storage
     newStorage->ChangedNodeEvent.AddListener(
       mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeAddedOrModified));
+    newStorage->RemoveNodeEvent.AddListener(
+      mitk::MessageDelegate1<QmitkDataGeneratorBase, const mitk::DataNode*>(this, &QmitkDataGeneratorBase::NodeRemoved));
   }
 }
 
@@ -132,6 +139,15 @@ void QmitkDataGeneratorBase::NodeAddedOrModified(const mitk::DataNode* node)
   }
 }
 
+void QmitkDataGeneratorBase::NodeRemoved(const mitk::DataNode* node)
+{
+  this->RemovedNodeCleanUp(node);
+}
+
+void QmitkDataGeneratorBase::RemovedNodeCleanUp(const mitk::DataNode* /*removedNode*/) const
+{
+}
+
 void QmitkDataGeneratorBase::EnsureRecheckingAndGeneration() const
 {
   m_RestartGeneration = true;
@@ -133,6 +133,9 @@ protected:
   virtual void RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const = 0;
   /** Prepares result to be added to the storage in an appropriate way and returns the data node for that.*/
   virtual mitk::DataNode::Pointer PrepareResultForStorage(const std::string& label, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const = 0;
+  /** Is called when a node is about to be removed from the storage. Derived classes can override it to release
+  state they keep for the node. The default implementation does nothing.*/
+  virtual void RemovedNodeCleanUp(const mitk::DataNode* removedNode) const;
 
   /*! Creates a data node for WIP place holder results. It can be used by IndicateFutureResults().*/
   static mitk::DataNode::Pointer CreateWIPDataNode(mitk::BaseData* dataDummy, const std::string& nodeName);
@@ -168,6 +171,8 @@ private:
 
   /**Member is called when a node is added to the storage.*/
   void NodeAddedOrModified(const mitk::DataNode* node);
+  /**Member is called when a node is removed from the storage.*/
+  void NodeRemoved(const mitk::DataNode* node);
 
   unsigned long m_DataStorageDeletedTag;
 };
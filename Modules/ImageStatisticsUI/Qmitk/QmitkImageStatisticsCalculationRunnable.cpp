@@ -24,6 +24,37 @@ See LICENSE.txt or http://www.mitk.org for details.
 #include "mitkStatisticsToMaskRelationRule.h"
 #include "mitkImageStatisticsContainerManager.h"
 #include "mitkProperties.h"
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <cstring>
+
+namespace
+{
+  std::size_t GetNumberOfBytes(const mitk::Image *image)
+  {
+    std::size_t numberOfBytes = image->GetPixelType().GetSize();
+
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      numberOfBytes *= image->GetDimension(i);
+
+    return numberOfBytes;
+  }
+
+  bool HaveSameLayout(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    if (image1->GetPixelType() != image2->GetPixelType() || image1->GetDimension() != image2->GetDimension())
+      return false;
+
+    for (unsigned int i = 0; i < image1->GetDimension(); ++i)
+    {
+      if (image1->GetDimension(i) != image2->GetDimension(i))
+        return false;
+    }
+
+    return mitk::Equal(*image1->GetTimeGeometry(), *image2->GetTimeGeometry(), mitk::eps, false);
+  }
+}
 
 QmitkImageStatisticsCalculationRunnable::QmitkImageStatisticsCalculationRunnable()
   : QmitkDataGenerationJobBase()
@@ -88,6 +119,30 @@ unsigned int QmitkImageStatisticsCalculationRunnable::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsCalculationRunnable::SetIncrementalState(std::shared_ptr<IncrementalState> state)
+{
+  this->m_IncrementalState = state;
+}
+
+mitk::ImageStatisticsCalculator::Pointer QmitkImageStatisticsCalculationRunnable::UpdateIncrementalMask()
+{
+  if (nullptr == m_IncrementalState || m_BinaryMask.IsNull() || m_IncrementalState->Calculator.IsNull() ||
+      m_IncrementalState->Mask.IsNull() || !HaveSameLayout(m_BinaryMask, m_IncrementalState->Mask))
+  {
+    return nullptr;
+  }
+
+  {
+    mitk::ImageReadAccessor readAccess(m_BinaryMask);
+    mitk::ImageWriteAccessor writeAccess(m_IncrementalState->Mask);
+    std::memcpy(writeAccess.GetData(), readAccess.GetData(), GetNumberOfBytes(m_BinaryMask));
+  }
+
+  // the mask generator keeps its modification time, so the calculator only recomputes the changed region
+  m_IncrementalState->Mask->Modified();
+  return m_IncrementalState->Calculator;
+}
+
 QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnable::GetResults() const
 {
   ResultMapType result;
@@ -95,10 +150,16 @@ QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnabl
   return result;
 }
 
-bool QmitkImageStatisticsCalculationRunnable::RunComputation()
+bool QmitkImageStatisticsCalculationRunnable::ConfigureAndCalculate(mitk::ImageStatisticsCalculator::Pointer &calculator)
 {
   bool statisticCalculationSuccessful = true;
-  mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+  calculator = mitk::ImageStatisticsCalculator::New();
+
+  if (nullptr != m_IncrementalState)
+  {
+    m_IncrementalState->Calculator = nullptr;
+    m_IncrementalState->Mask = nullptr;
+  }
 
   if (this->m_StatisticsImage.IsNotNull())
   {
@@ -116,9 +177,17 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
   {
     if (this->m_BinaryMask.IsNotNull())
     {
+      mitk::Image::Pointer mask = m_BinaryMask->Clone();
       mitk::ImageMaskGenerator::Pointer imgMask = mitk::ImageMaskGenerator::New();
-      imgMask->SetImageMask(m_BinaryMask->Clone());
+      imgMask->SetImageMask(mask);
       calculator->SetMask(imgMask.GetPointer());
+
+      if (nullptr != m_IncrementalState)
+      {
+        calculator->SetIncrementalUpdates(true);
+        m_IncrementalState->Calculator = calculator;
+        m_IncrementalState->Mask = mask;
+      }
     }
     if (this->m_PlanarFigureMask.IsNotNull())
     {
@@ -160,10 +229,50 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
     statisticCalculationSuccessful = false;
   }
 
+  if (!statisticCalculationSuccessful && nullptr != m_IncrementalState)
+    m_IncrementalState->Calculator = nullptr;
+
+  return statisticCalculationSuccessful;
+}
+
+bool QmitkImageStatisticsCalculationRunnable::RunComputation()
+{
+  bool statisticCalculationSuccessful = true;
+  std::unique_lock<std::mutex> incrementalStateLock;
+
+  if (nullptr != m_IncrementalState)
+    incrementalStateLock = std::unique_lock<std::mutex>(m_IncrementalState->Mutex);
+
+  mitk::ImageStatisticsCalculator::Pointer calculator = this->UpdateIncrementalMask();
+
+  if (calculator.IsNotNull())
+  {
+    try
+    {
+      calculator->UpdateStatistics();
+      calculator->GetStatistics();
+    }
+    catch (const std::exception &e)
+    {
+      m_LastErrorMessage = "Failure while updating the statistics: " + std::string(e.what());
+      MITK_ERROR << m_LastErrorMessage;
+      statisticCalculationSuccessful = false;
+      m_IncrementalState->Calculator = nullptr;
+    }
+  }
+  else
+  {
+    statisticCalculationSuccessful = this->ConfigureAndCalculate(calculator);
+  }
+
   if (statisticCalculationSuccessful)
   {
     m_StatisticsContainer = calculator->GetStatistics();
 
+    // the calculator of the incremental state keeps updating its container, so results get a copy
+    if (nullptr != m_IncrementalState && m_BinaryMask.IsNotNull())
+      m_StatisticsContainer = m_StatisticsContainer->Clone();
+
     auto imageRule = mitk::StatisticsToImageRelationRule::New();
     imageRule->Connect(m_StatisticsContainer, m_StatisticsImage);
 
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkImage.h"
 #include "mitkPlanarFigure.h"
 #include "mitkImageStatisticsContainer.h"
+#include "mitkImageStatisticsCalculator.h"
 
 #include "QmitkDataGenerationJobBase.h"
 
@@ -26,6 +27,9 @@ found in the LICENSE file.
 
 #include <MitkImageStatisticsUIExports.h>
 
+#include <memory>
+#include <mutex>
+
 /**
 * /brief This class is executed as background thread for image statistics calculation.
 *
@@ -39,6 +43,16 @@ public:
 
   typedef itk::Statistics::Histogram<double> HistogramType;
 
+  /*!
+  /brief Calculator and mask copy of an earlier computation of the same image and binary mask, so that edits of
+  the mask are applied by mitk::ImageStatisticsCalculator::UpdateStatistics() instead of a full computation. */
+  struct IncrementalState
+  {
+    mitk::ImageStatisticsCalculator::Pointer Calculator;
+    mitk::Image::Pointer Mask;
+    std::mutex Mutex; ///< serializes the computations that share the state
+  };
+
   /*!
   /brief standard constructor. */
   QmitkImageStatisticsCalculationRunnable();
@@ -69,6 +83,9 @@ public:
   /*!
   /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
+  /*!
+  /brief Set the state that is used and updated by computations with a binary mask. nullptr (default) disables incremental updates.*/
+  void SetIncrementalState(std::shared_ptr<IncrementalState> state);
 
   ResultMapType GetResults() const override;
 
@@ -76,11 +93,18 @@ protected:
   bool RunComputation() override;
 
 private:
+  /** Copies the binary mask into the mask of the incremental state and returns its calculator, if the
+      calculator can be reused. Otherwise nullptr is returned. */
+  mitk::ImageStatisticsCalculator::Pointer UpdateIncrementalMask();
+  /** Configures a new calculator and calculates all statistics. */
+  bool ConfigureAndCalculate(mitk::ImageStatisticsCalculator::Pointer &calculator);
+
   mitk::Image::ConstPointer m_StatisticsImage;                         ///< member variable holds the input image for which the statistics need to be calculated.
   mitk::Image::ConstPointer m_BinaryMask;                              ///< member variable holds the binary mask image for segmentation image statistics calculation.
   mitk::PlanarFigure::ConstPointer m_PlanarFigureMask;                 ///< member variable holds the planar figure for segmentation image statistics calculation.
   mitk::ImageStatisticsContainer::Pointer m_StatisticsContainer;
   bool m_IgnoreZeros;                                             ///< member variable holds flag to indicate if zero valued voxel should be suppressed
   unsigned int m_HistogramNBins;                                      ///< member variable holds the bin size for histogram resolution.
+  std::shared_ptr<IncrementalState> m_IncrementalState;
 };
 #endif // QMITKIMAGESTATISTICSCALCULATIONRUNNABLE_H_INCLUDED
@@ -24,11 +24,15 @@ found in the LICENSE file.
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
+#include <set>
+
 void QmitkImageStatisticsDataGenerator::SetIgnoreZeroValueVoxel(bool _arg)
 {
   if (m_IgnoreZeroValueVoxel != _arg)
   {
     m_IgnoreZeroValueVoxel = _arg;
+    // the kept calculators are configured with the old settings
+    m_IncrementalStates.clear();
 
     if (m_AutoUpdate)
     {
@@ -47,6 +51,8 @@ void QmitkImageStatisticsDataGenerator::SetHistogramNBins(unsigned int nbins)
   if (m_HistogramNBins != nbins)
   {
     m_HistogramNBins = nbins;
+    // the kept calculators are configured with the old settings
+    m_IncrementalStates.clear();
 
     if (m_AutoUpdate)
     {
@@ -60,6 +66,72 @@ unsigned int QmitkImageStatisticsDataGenerator::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsDataGenerator::SetIncrementalUpdates(bool _arg)
+{
+  m_IncrementalUpdates = _arg;
+
+  if (!m_IncrementalUpdates)
+  {
+    m_IncrementalStates.clear();
+  }
+}
+
+bool QmitkImageStatisticsDataGenerator::GetIncrementalUpdates() const
+{
+  return this->m_IncrementalUpdates;
+}
+
+void QmitkImageStatisticsDataGenerator::RemovedNodeCleanUp(const mitk::DataNode* removedNode) const
+{
+  if (removedNode == nullptr || removedNode->GetData() == nullptr)
+  {
+    return;
+  }
+
+  const auto uid = removedNode->GetData()->GetUID();
+
+  for (auto iter = m_IncrementalStates.begin(); iter != m_IncrementalStates.end();)
+  {
+    if (iter->first.first == uid || iter->first.second == uid)
+    {
+      iter = m_IncrementalStates.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
+void QmitkImageStatisticsDataGenerator::RemoveUnusedIncrementalStates() const
+{
+  if (m_IncrementalStates.empty())
+  {
+    return;
+  }
+
+  std::set<IncrementalStateMapType::key_type> usedKeys;
+  for (const auto& inputPair : this->FilterImageROICombinations(this->GetAllImageROICombinations()))
+  {
+    if (inputPair.first->GetData() != nullptr && inputPair.second.IsNotNull() && inputPair.second->GetData() != nullptr)
+    {
+      usedKeys.emplace(inputPair.first->GetData()->GetUID(), inputPair.second->GetData()->GetUID());
+    }
+  }
+
+  for (auto iter = m_IncrementalStates.begin(); iter != m_IncrementalStates.end();)
+  {
+    if (usedKeys.find(iter->first) == usedKeys.end())
+    {
+      iter = m_IncrementalStates.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
 bool QmitkImageStatisticsDataGenerator::ChangedNodeIsRelevant(const mitk::DataNode* changedNode) const
 {
   auto result = QmitkImageAndRoiDataGeneratorBase::ChangedNodeIsRelevant(changedNode);
@@ -180,6 +252,20 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
     newJob->SetIgnoreZeroValueVoxel(m_IgnoreZeroValueVoxel);
     newJob->SetHistogramNBins(m_HistogramNBins);
 
+    if (m_IncrementalUpdates && mask != nullptr)
+    {
+      this->RemoveUnusedIncrementalStates();
+
+      auto& incrementalState = m_IncrementalStates[std::make_pair(image->GetUID(), mask->GetUID())];
+
+      if (nullptr == incrementalState)
+      {
+        incrementalState = std::make_shared<QmitkImageStatisticsCalculationRunnable::IncrementalState>();
+      }
+
+      newJob->SetIncrementalState(incrementalState);
+    }
+
     return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(newJob, resultDataNode.GetPointer());
   }
   else if (resultDataNode->GetStringProperty(mitk::STATS_GENERATION_STATUS_PROPERTY_NAME.c_str(), status) && status == mitk::STATS_GENERATION_STATUS_VALUE_WORK_IN_PROGRESS)
@@ -203,6 +289,8 @@ void QmitkImageStatisticsDataGenerator::RemoveObsoleteDataNodes(const mitk::Data
     mask = roiNode->GetData();
   }
 
+  this->RemoveUnusedIncrementalStates();
+
   auto lastResult = this->GetLatestResult(imageNode, roiNode, false, false);
 
   auto rulePredicate = mitk::ImageStatisticsContainerManager::GetStatisticsPredicateForSources(image, mask);
@@ -14,9 +14,15 @@ found in the LICENSE file.
 #define QmitkImageStatisticsDataGenerator_h
 
 #include "QmitkImageAndRoiDataGeneratorBase.h"
+#include "QmitkImageStatisticsCalculationRunnable.h"
 
 #include <MitkImageStatisticsUIExports.h>
 
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
 /**
 Generates ImageStatisticContainers by using QmitkImageStatisticsCalculationRunnables for each pair if image and ROIs and ensures their
 validity.
@@ -52,18 +58,35 @@ public:
   /*! /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
 
+  /*! /brief Set flag to apply edits of image masks incrementally to the previous statistics (see
+  mitk::ImageStatisticsCalculator::SetIncrementalUpdates()). The calculator and a copy of the mask are kept per
+  image and mask of the current selection and released as soon as the pair is deselected, one of its nodes is removed
+  from the storage or the settings change. The histogram based statistics differ from a full computation.*/
+  void SetIncrementalUpdates(bool _arg);
+  /*! /brief Get status of incremental updates.*/
+  bool GetIncrementalUpdates() const;
+
 protected:
   bool ChangedNodeIsRelevant(const mitk::DataNode* changedNode) const;
   void IndicateFutureResults(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> GetNextMissingGenerationJob(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   void RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   mitk::DataNode::Pointer PrepareResultForStorage(const std::string& label, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const;
+  void RemovedNodeCleanUp(const mitk::DataNode* removedNode) const;
+
+  /** Releases the incremental states of all image and mask pairs that are not selected any more.*/
+  void RemoveUnusedIncrementalStates() const;
 
   QmitkImageStatisticsDataGenerator(const QmitkImageStatisticsDataGenerator&) = delete;
   QmitkImageStatisticsDataGenerator& operator = (const QmitkImageStatisticsDataGenerator&) = delete;
 
   bool m_IgnoreZeroValueVoxel = false;
   unsigned int m_HistogramNBins = 100;
+  bool m_IncrementalUpdates = false;
+
+  /** Incremental states per UIDs of image and mask.*/
+  using IncrementalStateMapType = std::map<std::pair<std::string, std::string>, std::shared_ptr<QmitkImageStatisticsCalculationRunnable::IncrementalState>>;
+  mutable IncrementalStateMapType m_IncrementalStates;
 };
 
 #endif
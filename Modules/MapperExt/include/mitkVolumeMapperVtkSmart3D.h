@@ -48,6 +48,14 @@ namespace mitk
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
     void ApplyProperties(vtkActor *actor, mitk::BaseRenderer *renderer) override;
+
+    /** \brief Level of detail rendering is used for images with a multi-resolution pyramid.
+     *
+     * As long as RenderingManager::GetNextLOD() is 0, i.e., during interaction, a coarse level
+     * of the pyramid is rendered as a preview.
+     */
+    bool IsLODEnabled(mitk::BaseRenderer *renderer) const override;
+
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
   protected:
@@ -60,12 +68,17 @@ namespace mitk
     void createVolume();
     void createVolumeProperty();
     vtkImageData* GetInputImage();
+    void UpdatePreview(mitk::BaseRenderer *renderer);
 
     vtkSmartPointer<vtkVolume> m_Volume;
     vtkSmartPointer<vtkImageChangeInformation> m_ImageChangeInformation;
     vtkSmartPointer<vtkSmartVolumeMapper> m_SmartVolumeMapper;
     vtkSmartPointer<vtkVolumeProperty> m_VolumeProperty;
 
+    /** \brief Pyramid level of the image that is currently rendered instead of the image itself. */
+    mitk::Image::Pointer m_Preview;
+    mitk::TimeStepType m_PreviewTimeStep;
+
     void UpdateTransferFunctions(mitk::BaseRenderer *renderer);
     void UpdateRenderMode(mitk::BaseRenderer *renderer);
   };
@@ -14,11 +14,18 @@ found in the LICENSE file.
 #include "mitkTransferFunctionProperty.h"
 #include "mitkTransferFunctionInitializer.h"
 #include "mitkLevelWindowProperty.h"
+#include "mitkRenderingManager.h"
 #include <vtkObjectFactory.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkPiecewiseFunction.h>
 #include <vtkAutoInit.h>
 
+namespace
+{
+  /** Maximum number of voxels of the pyramid level that is rendered during interaction. */
+  const size_t PreviewNumberOfVoxels = 256 * 256 * 256;
+}
+
 void mitk::VolumeMapperVtkSmart3D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   bool value;
@@ -33,6 +40,7 @@ void mitk::VolumeMapperVtkSmart3D::GenerateDataForRenderer(mitk::BaseRenderer *r
     m_Volume->VisibilityOn();
   }
 
+  UpdatePreview(renderer);
   UpdateTransferFunctions(renderer);
   UpdateRenderMode(renderer);
   this->Modified();
@@ -55,6 +63,15 @@ void mitk::VolumeMapperVtkSmart3D::ApplyProperties(vtkActor *, mitk::BaseRendere
 
 }
 
+bool mitk::VolumeMapperVtkSmart3D::IsLODEnabled(mitk::BaseRenderer *renderer) const
+{
+  auto image = dynamic_cast<mitk::Image *>(this->GetDataNode()->GetData());
+  bool volumeRendering = false;
+  this->GetDataNode()->GetBoolProperty("volumerendering", volumeRendering, renderer);
+
+  return volumeRendering && nullptr != image && nullptr != image->GetPyramid();
+}
+
 void mitk::VolumeMapperVtkSmart3D::SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer, bool overwrite)
 {
   // GPU_INFO << "SetDefaultProperties";
@@ -98,6 +115,52 @@ vtkImageData* mitk::VolumeMapperVtkSmart3D::GetInputImage()
   return input->GetVtkImageData(this->GetTimestep());
 }
 
+void mitk::VolumeMapperVtkSmart3D::UpdatePreview(mitk::BaseRenderer *renderer)
+{
+  auto image = dynamic_cast<mitk::Image*>(this->GetDataNode()->GetData());
+  auto renderingManager = mitk::RenderingManager::GetInstance();
+
+  mitk::Image::Pointer preview;
+  if (nullptr != image->GetPyramid() && !renderingManager->GetLODIncreaseBlocked() &&
+      0 == renderingManager->GetNextLOD(renderer))
+  {
+    auto level = image->GetPyramid()->SelectLevelByNumberOfVoxels(image, PreviewNumberOfVoxels);
+    if (0 != level)
+      preview = image->GetPyramid()->GetLevel(image, level);
+  }
+
+  if (preview == m_Preview && (preview.IsNull() || this->GetTimestep() == m_PreviewTimeStep))
+    return;
+
+  m_Preview = preview;
+  m_PreviewTimeStep = this->GetTimestep();
+
+  auto imageData = GetInputImage();
+  Vector3D spacing;
+  FillVector3D(spacing, 1.0, 1.0, 1.0);
+  double origin[3];
+  imageData->GetOrigin(origin);
+
+  if (preview.IsNotNull())
+  {
+    // voxels of the preview are mapped into the index space of the image
+    const auto imageSpacing = image->GetGeometry(m_PreviewTimeStep)->GetSpacing();
+    const auto previewSpacing = preview->GetGeometry(m_PreviewTimeStep)->GetSpacing();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      spacing[i] = previewSpacing[i] / imageSpacing[i];
+      origin[i] += 0.5 * (spacing[i] - 1.0);
+    }
+
+    imageData = preview->GetVtkImageData(m_PreviewTimeStep);
+  }
+
+  m_ImageChangeInformation->SetInputData(imageData);
+  m_ImageChangeInformation->SetOutputSpacing(spacing.GetDataPointer());
+  m_ImageChangeInformation->SetOutputOrigin(origin);
+}
+
 void mitk::VolumeMapperVtkSmart3D::createMapper(vtkImageData* imageData)
 {
   Vector3D spacing;
@@ -108,6 +171,9 @@ void mitk::VolumeMapperVtkSmart3D::createMapper(vtkImageData* imageData)
 
   m_SmartVolumeMapper->SetBlendModeToComposite();
   m_SmartVolumeMapper->SetInputConnection(m_ImageChangeInformation->GetOutputPort());
+
+  // the preview is set again by the next update
+  m_Preview = nullptr;
 }
 
 void mitk::VolumeMapperVtkSmart3D::createVolume()
@@ -221,6 +287,7 @@ void mitk::VolumeMapperVtkSmart3D::UpdateRenderMode(mitk::BaseRenderer *renderer
 }
 
 mitk::VolumeMapperVtkSmart3D::VolumeMapperVtkSmart3D()
+  : m_PreviewTimeStep(0)
 {
   m_SmartVolumeMapper = vtkSmartPointer<vtkSmartVolumeMapper>::New();
   m_SmartVolumeMapper->SetBlendModeToComposite();
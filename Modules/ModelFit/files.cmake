@@ -25,6 +25,7 @@ set(CPP_FILES
   Common/mitkModelFitPlotDataHelper.cpp
   Common/mitkModelSignalImageGenerator.cpp
   Common/mitkModelFitResultRelationRule.cpp
+  Common/mitkWorkStealingBatchScheduler.cpp
   Functors/mitkSimpleFunctorBase.cpp
   Functors/mitkSimpleFunctorPolicy.cpp
   Functors/mitkChiSquareFitCostFunction.cpp
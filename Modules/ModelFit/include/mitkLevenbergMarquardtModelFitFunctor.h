@@ -60,6 +60,8 @@ namespace mitk
 
     ParameterNamesType GetCriterionNames() const override;
 
+    std::unique_ptr<FitState> CreateFitState() const override;
+
   protected:
 
     typedef Superclass::ParametersType ParametersType;
@@ -73,6 +75,12 @@ namespace mitk
                                       const ModelBase::ParametersType& initialParameters,
                                       DebugParameterMapType& debugParameters) const override;
 
+    /** Reuses the optimizer and the cost function of the state as long as the number of model parameters
+     and the number of signal values do not change.*/
+    ParametersType DoModelFitWithState(const SignalType& value, const ModelBase* model,
+                                       const ModelBase::ParametersType& initialParameters,
+                                       DebugParameterMapType& debugParameters, FitState& state) const override;
+
     OutputPixelArrayType GetCriteria(const ModelBase* model, const ParametersType& parameters,
         const SignalType& sample) const override;
 
@@ -80,9 +88,28 @@ namespace mitk
     virtual MVModelFitCostFunction::Pointer GenerateCostFunction(const SignalType& value,
         const ModelBase* model) const;
 
+    /** Reconfigures a cost function that was generated by GenerateCostFunction() for the given signal and model,
+     so that it can be reused for another fit. Returns false if the cost function cannot be reused; it is generated
+     again then. Only the cost functions of this class itself are reused by default. Derived classes opt in by
+     reimplementing this method, e.g. by calling ReconfigureCostFunction().*/
+    virtual bool UpdateCostFunction(MVModelFitCostFunction* costFunction, const SignalType& value,
+        const ModelBase* model) const;
+
+    /** Sets signal and model of a cost function generated by LevenbergMarquardtModelFitFunctor::GenerateCostFunction()
+     (including its constraint decorator) and resets its evaluation counts.*/
+    void ReconfigureCostFunction(MVModelFitCostFunction* costFunction, const SignalType& value,
+        const ModelBase* model) const;
+
     ParameterNamesType DefineDebugParameterNames() const override;
 
   private:
+    ParametersType RunOptimization(const ModelBase* model, const ModelBase::ParametersType& initialParameters,
+                                   DebugParameterMapType& debugParameters, const MVModelFitCostFunction* metric,
+                                   ::itk::LevenbergMarquardtOptimizer* optimizer) const;
+
+    ::itk::LevenbergMarquardtOptimizer::Pointer GenerateOptimizer(MVModelFitCostFunction* metric,
+        const ModelBase* model) const;
+
     double m_Epsilon;
     double m_GradientTolerance;
     double m_ValueTolerance;
@@ -74,6 +74,10 @@ public:
 
     /**Returns the index of the first (in terms of index position) failed parameter in the last failed evaluation.*/
     ParametersType::size_type GetFailedParameter() const;
+
+    /**Resets the evaluation, penalty and failure counts, e.g. if the instance is reused for another fit.*/
+    void ResetEvaluationCounts();
+
 protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
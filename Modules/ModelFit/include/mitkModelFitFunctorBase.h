@@ -15,6 +15,9 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 
+#include <map>
+#include <memory>
+
 #include <mitkVector.h>
 
 #include "mitkModelBase.h"
@@ -54,13 +57,35 @@ namespace mitk
     OutputPixelArrayType Compute(const InputPixelArrayType& value, const ModelBase* model,
                                  const ModelBase::ParametersType& initialParameters) const;
 
+    typedef ModelBase::ParameterNamesType ParameterNamesType;
+
+    /** Working memory of a functor that is reused by consecutive calls of Compute() within one thread,
+     * so that buffers, cost functions and optimizers are not recreated for every fitted signal.
+     * A state must not be shared between threads. Derived functors may extend it by overriding CreateFitState().*/
+    class MITKMODELFIT_EXPORT FitState
+    {
+    public:
+      virtual ~FitState();
+
+      ModelFitCostFunctionInterface::SignalType Sample;
+      std::map<std::string, ParameterImagePixelType> DebugParameters;
+      ParameterNamesType DebugParameterNames;
+      OutputPixelArrayType Result;
+    };
+
+    /** Creates a new state for the use with Compute(). The state captures the debug parameter settings of the functor. */
+    virtual std::unique_ptr<FitState> CreateFitState() const;
+
+    /** Same as Compute() above, but uses the passed state as working memory.
+     * @return Reference to the result that is stored in the state. It is valid until the state is used again.*/
+    const OutputPixelArrayType& Compute(const InputPixelArrayType& value, const ModelBase* model,
+                                        const ModelBase::ParametersType& initialParameters, FitState& state) const;
+
     /** Returns the number of outputs the fit functor will return if compute is called.
      * The number depends in parts on the passed model.
      * @exception Exception will be thrown if no valid model is passed.*/
     unsigned int GetNumberOfOutputs(const ModelBase* model) const;
 
-    typedef ModelBase::ParameterNamesType ParameterNamesType;
-
     /** Returns names of all evaluation parameters defined by the user*/
     ParameterNamesType GetEvaluationParameterNames() const;
     void ResetEvaluationParameters();
@@ -119,6 +144,14 @@ namespace mitk
                                       const ModelBase::ParametersType& initialParameters,
                                       DebugParameterMapType& debugParameters) const = 0;
 
+    /** Internal Method called by Compute() if a fit state is used. The default implementation calls DoModelFit().
+    Functors that can reuse working memory between fits (e.g. optimizers or cost functions) should override
+    CreateFitState() and this method.
+    @param state State that was created by CreateFitState() of this functor.*/
+    virtual ParametersType DoModelFitWithState(const SignalType& value, const ModelBase* model,
+                                               const ModelBase::ParametersType& initialParameters,
+                                               DebugParameterMapType& debugParameters, FitState& state) const;
+
     /** Returns names of the depug parameters generated by the functor. Will be called by GetDebugParameterNames,
     if debug is activated. */
     virtual ParameterNamesType DefineDebugParameterNames()const = 0;
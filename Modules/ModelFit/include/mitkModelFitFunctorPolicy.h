@@ -105,6 +105,40 @@ namespace mitk
       return result;
     }
 
+    /** Creates the working memory for Compute() calls of one thread.*/
+    std::unique_ptr<FunctorType::FitState> CreateFitState() const
+    {
+      if (!m_Functor)
+      {
+        itkGenericExceptionMacro( << "Error. Cannot create fit state. Functor is Null.");
+      }
+
+      return m_Functor->CreateFitState();
+    }
+
+    /** Same as operator(), but reuses the passed state (see CreateFitState()) as working memory.
+     * @return Reference to the result that is stored in the state. It is valid until the state is used again.*/
+    inline const OutputPixelArrayType& Compute(const InputPixelArrayType& value,
+                                               const IndexType& currentIndex, FunctorType::FitState& state) const
+    {
+      if (!m_Functor)
+      {
+        itkGenericExceptionMacro( << "Error. Cannot process Compute(). Functor is Null.");
+      }
+
+      if (!m_ModelParameterizer)
+      {
+        itkGenericExceptionMacro( << "Error. Cannot process Compute(). Parameterizer is Null.");
+      }
+
+      ParameterizerType::ModelBasePointer parameterizedModel =
+        m_ModelParameterizer->GenerateParameterizedModel(currentIndex);
+      ParameterizerType::ParametersType initialParams = m_ModelParameterizer->GetInitialParameterization(
+            currentIndex);
+
+      return m_Functor->Compute(value, parameterizedModel, initialParams, state);
+    }
+
   private:
 
     FunctorConstPointer m_Functor;
@@ -36,6 +36,11 @@ namespace mitk
    * - criterion images: Images that encode the criterion value of the fitting strategy for the fitted parameters
    * - evaluation parameter images: Images that encode measures of additional evaluation cost functions defined by the user. (These were not part of the fitting strategy)
    * .
+   * The signals of all voxels that should be fitted (all voxels or the voxels within the mask) are transposed once
+   * into a voxel-major matrix, so that the time curve of each voxel is contiguous in memory. The voxels are
+   * fitted in small batches that are distributed by a WorkStealingBatchScheduler, and the results are scattered
+   * back into the parameter images. Each thread reuses the working memory of the fit functor (see
+   * ModelFitFunctorBase::CreateFitState()) for all of its voxels.
    */
 class MITKMODELFIT_EXPORT PixelBasedParameterFitImageGenerator: public ParameterFitImageGeneratorBase
 {
@@ -97,8 +102,6 @@ protected:
     template <typename TPixel, unsigned int VDim>
     void DoPrepareMask(itk::Image<TPixel, VDim>* image);
 
-    void onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& eventObject);
-
     bool HasOutdatedResult() const override;
     void CheckValidInputs() const override;
     void DoFitAndGetResults(ParameterImageMapType& parameterImages, ParameterImageMapType& derivedParameterImages, ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages) override;
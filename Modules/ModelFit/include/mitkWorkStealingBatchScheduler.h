@@ -0,0 +1,60 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __MITK_WORK_STEALING_BATCH_SCHEDULER_H_
+#define __MITK_WORK_STEALING_BATCH_SCHEDULER_H_
+
+#include <cstddef>
+#include <functional>
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+
+  /** Processes a range of items in small batches on multiple threads.
+   * Each thread starts with a contiguous block of batches and processes it from the front. A thread that
+   * runs out of batches steals half of the remaining batches from the back of another thread. Thus threads
+   * that got items which are cheap to process (e.g. fast converging fits) do not idle while others are still busy.
+   * Exceptions thrown by the batch function stop all threads and are rethrown by Run().
+   */
+  class MITKMODELFIT_EXPORT WorkStealingBatchScheduler
+  {
+  public:
+    /** Function that processes the items [begin, end). threadId is in the range [0, ComputeNumberOfThreads(numberOfItems)).
+     The thread with the id 0 is the calling thread of Run().*/
+    typedef std::function<void(std::size_t begin, std::size_t end, unsigned int threadId)> BatchFunctionType;
+
+    WorkStealingBatchScheduler();
+
+    /** Number of items per batch (default: 16).*/
+    void SetBatchSize(std::size_t batchSize);
+    std::size_t GetBatchSize() const;
+
+    /** Maximum number of threads. 0 (default) uses the global default number of threads of ITK.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** Returns the number of threads that Run() uses to process numberOfItems items.*/
+    unsigned int ComputeNumberOfThreads(std::size_t numberOfItems) const;
+
+    /** Processes the items [0, numberOfItems) and blocks until all items are processed.*/
+    void Run(std::size_t numberOfItems, const BatchFunctionType& function) const;
+
+  private:
+    std::size_t m_BatchSize;
+    unsigned int m_NumberOfThreads;
+  };
+
+}
+
+#endif // __MITK_WORK_STEALING_BATCH_SCHEDULER_H_
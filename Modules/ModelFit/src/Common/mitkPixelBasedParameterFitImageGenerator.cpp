@@ -10,29 +10,36 @@ found in the LICENSE file.
 
 ============================================================================*/
 
-#include "itkCommand.h"
-#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionConstIterator.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
-#include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkModelFitFunctorPolicy.h"
+#include "mitkWorkStealingBatchScheduler.h"
 
 #include "mitkExtractTimeGrid.h"
 
-void
-  mitk::PixelBasedParameterFitImageGenerator::
-  onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& /*eventObject*/)
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace
 {
-  this->InvokeEvent(::itk::ProgressEvent());
+  /** Number of voxels whose signals are gathered together while transposing the dynamic image. */
+  const std::size_t TransposeTileSize = 256;
 
-  auto* process = dynamic_cast<itk::ProcessObject*>(caller);
-  if (process)
+  /** Masked voxels of a dynamic image with their signals stored voxel-major, so that the
+   * time curve of each voxel is contiguous in memory. */
+  template <typename TPixel>
+  struct SignalMatrix
   {
-    this->m_Progress = process->GetProgress();
-  }
-};
+    std::vector<itk::OffsetValueType> Offsets;
+    std::vector<TPixel> Signals;
+    std::size_t NumberOfTimeSteps = 0;
+  };
+}
 
 template <typename TPixel, unsigned int VDim>
 void
@@ -55,18 +62,18 @@ void
 }
 
 template<typename TImage>
-mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultImages( mitk::ModelFitFunctorBase::ParameterNamesType &paramNames, itk::ImageSource<TImage>* source, mitk::ModelFitFunctorBase::ParameterNamesType::size_type startPos, mitk::ModelFitFunctorBase::ParameterNamesType::size_type& endPos )
+mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultImages( mitk::ModelFitFunctorBase::ParameterNamesType &paramNames, const std::vector<typename TImage::Pointer>& images, mitk::ModelFitFunctorBase::ParameterNamesType::size_type startPos, mitk::ModelFitFunctorBase::ParameterNamesType::size_type& endPos )
 {
   mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType result;
   for (mitk::ModelFitFunctorBase::ParameterNamesType::size_type j = 0; j < paramNames.size(); ++j)
   {
-    if (source->GetNumberOfOutputs() < startPos+j)
+    if (images.size() <= startPos+j)
     {
-      mitkThrow() << "Error while generating fitted parameter images. Number of sources is too low and does not match expected parameter number. Output size: "<< source->GetNumberOfOutputs()<<"; number of param names: "<<paramNames.size()<<";source start pos: " << startPos;
+      mitkThrow() << "Error while generating fitted parameter images. Number of sources is too low and does not match expected parameter number. Output size: "<< images.size()<<"; number of param names: "<<paramNames.size()<<";source start pos: " << startPos;
     }
 
     mitk::Image::Pointer paramImage = mitk::Image::New();
-    typename TImage::ConstPointer outputImg = source->GetOutput(startPos+j);
+    typename TImage::ConstPointer outputImg = images[startPos+j].GetPointer();
     mitk::CastToMitkImage(outputImg, paramImage);
 
     result.insert(std::make_pair(paramNames[j],paramImage));
@@ -79,34 +86,10 @@ mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultIma
 
 template <typename TPixel, unsigned int VDim>
 void
-  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* /*image*/)
+  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* image)
 {
-  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
   using ParameterImageType = itk::Image<ScalarType, VDim-1>;
-
-  using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
-
-  typename FitFilterType::Pointer fitFilter = FitFilterType::New();
-
-  typename ::itk::MemberCommand<Self>::Pointer spProgressCommand = ::itk::MemberCommand<Self>::New();
-  spProgressCommand->SetCallbackFunction(this, &Self::onFitProgressEvent);
-  fitFilter->AddObserver(::itk::ProgressEvent(), spProgressCommand);
-
-  //add the time frames to the fit filter
-  mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(this->m_DynamicImage);
-  std::vector<Image::Pointer> frameCache;
-  for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
-  {
-    typename InputFrameImageType::Pointer frameImage;
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
-
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    fitFilter->SetInput(i,frameImage);
-  }
+  using FrameRegionType = typename ParameterImageType::RegionType;
 
   ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
   if (m_TimeGridByParameterizer)
@@ -126,16 +109,149 @@ void
 
   functor.SetModelFitFunctor(this->m_FitFunctor);
   functor.SetModelParameterizer(this->m_ModelParameterizer);
-  fitFilter->SetFunctor(functor);
+
+  //the parameter images share the spatial geometry of the time frames of the dynamic image
+  const auto& inputRegion = image->GetLargestPossibleRegion();
+  FrameRegionType frameRegion;
+  typename ParameterImageType::SpacingType frameSpacing;
+  typename ParameterImageType::PointType frameOrigin;
+  typename ParameterImageType::DirectionType frameDirection;
+
+  for (unsigned int i = 0; i < VDim - 1; ++i)
+  {
+    frameRegion.SetIndex(i, inputRegion.GetIndex(i));
+    frameRegion.SetSize(i, inputRegion.GetSize(i));
+    frameSpacing[i] = image->GetSpacing()[i];
+    frameOrigin[i] = image->GetOrigin()[i];
+
+    for (unsigned int j = 0; j < VDim - 1; ++j)
+    {
+      frameDirection[i][j] = image->GetDirection()[i][j];
+    }
+  }
+
+  const std::size_t numberOfTimeSteps = inputRegion.GetSize(VDim - 1);
+  const std::size_t frameSize = frameRegion.GetNumberOfPixels();
+
+  std::vector<typename ParameterImageType::Pointer> outputImages(functor.GetNumberOfOutputs());
+  std::vector<ScalarType*> outputBuffers;
+
+  for (auto& outputImage : outputImages)
+  {
+    outputImage = ParameterImageType::New();
+    outputImage->SetRegions(frameRegion);
+    outputImage->SetSpacing(frameSpacing);
+    outputImage->SetOrigin(frameOrigin);
+    outputImage->SetDirection(frameDirection);
+    outputImage->Allocate();
+    outputImage->FillBuffer(0.0);
+    outputBuffers.push_back(outputImage->GetBufferPointer());
+  }
+
+  //collect the masked voxels of a time frame
+  SignalMatrix<TPixel> matrix;
+  matrix.NumberOfTimeSteps = numberOfTimeSteps;
+
   if (this->m_InternalMask.IsNotNull())
   {
-    fitFilter->SetMask(this->m_InternalMask);
+    if (!this->m_InternalMask->GetLargestPossibleRegion().IsInside(frameRegion))
+    {
+      mitkThrow() << "Mask of generator is set but does not cover the region of the dynamic image. Mask region: " << this->m_InternalMask->GetLargestPossibleRegion() << "Image region: " << frameRegion;
+    }
+
+    itk::ImageRegionConstIterator<InternalMaskType> maskIter(this->m_InternalMask, frameRegion);
+    for (itk::OffsetValueType offset = 0; !maskIter.IsAtEnd(); ++maskIter, ++offset)
+    {
+      if (maskIter.Get() > 0)
+      {
+        matrix.Offsets.push_back(offset);
+      }
+    }
+  }
+  else
+  {
+    matrix.Offsets.resize(frameSize);
+    std::iota(matrix.Offsets.begin(), matrix.Offsets.end(), 0);
+  }
+
+  //transpose the frame-major dynamic image once into a voxel-major signal matrix. Tiles of voxels
+  //keep the rows of the matrix that are written for all frames in the cache.
+  const std::size_t numberOfVoxels = matrix.Offsets.size();
+  const TPixel* inputBuffer = image->GetBufferPointer();
+  matrix.Signals.resize(numberOfVoxels * numberOfTimeSteps);
+
+  for (std::size_t tileBegin = 0; tileBegin < numberOfVoxels; tileBegin += TransposeTileSize)
+  {
+    const std::size_t tileEnd = std::min(tileBegin + TransposeTileSize, numberOfVoxels);
+
+    for (std::size_t t = 0; t < numberOfTimeSteps; ++t)
+    {
+      const TPixel* frame = inputBuffer + t * frameSize;
+
+      for (std::size_t voxel = tileBegin; voxel < tileEnd; ++voxel)
+      {
+        matrix.Signals[voxel * numberOfTimeSteps + t] = frame[matrix.Offsets[voxel]];
+      }
+    }
   }
 
-  //generate the fits
-  fitFilter->Update();
+  //generate the fits. The scheduler distributes small batches of voxels to the threads. Each thread reuses
+  //its signal buffer and the working memory of the fit functor for all voxels it fits.
+  WorkStealingBatchScheduler scheduler;
+  const unsigned int numberOfThreads = scheduler.ComputeNumberOfThreads(numberOfVoxels);
+
+  std::vector<ModelFitFunctorPolicy::InputPixelArrayType> signals(numberOfThreads, ModelFitFunctorPolicy::InputPixelArrayType(numberOfTimeSteps));
+  std::vector<std::unique_ptr<ModelFitFunctorBase::FitState> > fitStates;
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  {
+    fitStates.push_back(functor.CreateFitState());
+  }
+
+  std::atomic<std::size_t> numberOfFittedVoxels(0);
+
+  if (!outputImages.empty())
+  {
+    const ParameterImageType* referenceFrame = outputImages.front();
+
+    scheduler.Run(numberOfVoxels, [&](std::size_t begin, std::size_t end, unsigned int threadId)
+    {
+      auto& signal = signals[threadId];
+      auto& fitState = *fitStates[threadId];
+
+      for (std::size_t voxel = begin; voxel < end; ++voxel)
+      {
+        const TPixel* voxelSignal = matrix.Signals.data() + voxel * numberOfTimeSteps;
+        std::copy(voxelSignal, voxelSignal + numberOfTimeSteps, signal.begin());
+
+        const auto offset = matrix.Offsets[voxel];
+        const auto& result = functor.Compute(signal, referenceFrame->ComputeIndex(offset), fitState);
+
+        if (outputBuffers.size() != result.size())
+        {
+          mitkThrow() << "Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: " << outputBuffers.size() << "; needed output number:" << result.size();
+        }
+
+        for (std::size_t i = 0; i < outputBuffers.size(); ++i)
+        {
+          outputBuffers[i][offset] = result[i];
+        }
+      }
+
+      const std::size_t fittedVoxels = numberOfFittedVoxels += end - begin;
+
+      //thread 0 is the calling thread
+      if (0 == threadId)
+      {
+        this->m_Progress = static_cast<double>(fittedVoxels) / numberOfVoxels;
+        this->InvokeEvent(::itk::ProgressEvent());
+      }
+    });
+  }
+
+  this->m_Progress = 1.0;
+  this->InvokeEvent(::itk::ProgressEvent());
 
-  //convert the outputs into mitk images and fill the parameter image map
+  //fill the parameter image map
   ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
   ModelFitFunctorBase::ParameterNamesType paramNames = refModel->GetParameterNames();
   ModelFitFunctorBase::ParameterNamesType derivedParamNames = refModel->GetDerivedParameterNames();
@@ -143,18 +259,18 @@ void
   ModelFitFunctorBase::ParameterNamesType evaluationParamNames = this->m_FitFunctor->GetEvaluationParameterNames();
   ModelFitFunctorBase::ParameterNamesType debugParamNames = this->m_FitFunctor->GetDebugParameterNames();
 
-  if (fitFilter->GetNumberOfOutputs() != (paramNames.size() + derivedParamNames.size() + criterionNames.size() + evaluationParamNames.size() + debugParamNames.size()))
+  if (outputImages.size() != (paramNames.size() + derivedParamNames.size() + criterionNames.size() + evaluationParamNames.size() + debugParamNames.size()))
   {
-    mitkThrow() << "Error while generating fitted parameter images. Fit filter output size does not match expected parameter number. Output size: "<< fitFilter->GetNumberOfOutputs();
+    mitkThrow() << "Error while generating fitted parameter images. Fit output size does not match expected parameter number. Output size: "<< outputImages.size();
   }
 
   ModelFitFunctorBase::ParameterNamesType::size_type resultPos = 0;
-  this->m_TempResultMap = StoreResultImages<ParameterImageType>(paramNames,fitFilter,resultPos, resultPos);
-  this->m_TempDerivedResultMap = StoreResultImages<ParameterImageType>(derivedParamNames,fitFilter,resultPos, resultPos);
-  this->m_TempCriterionResultMap = StoreResultImages<ParameterImageType>(criterionNames,fitFilter,resultPos, resultPos);
-  this->m_TempEvaluationResultMap = StoreResultImages<ParameterImageType>(evaluationParamNames,fitFilter,resultPos, resultPos);
+  this->m_TempResultMap = StoreResultImages<ParameterImageType>(paramNames,outputImages,resultPos, resultPos);
+  this->m_TempDerivedResultMap = StoreResultImages<ParameterImageType>(derivedParamNames,outputImages,resultPos, resultPos);
+  this->m_TempCriterionResultMap = StoreResultImages<ParameterImageType>(criterionNames,outputImages,resultPos, resultPos);
+  this->m_TempEvaluationResultMap = StoreResultImages<ParameterImageType>(evaluationParamNames,outputImages,resultPos, resultPos);
   //also add debug params (if generated) to the evaluation result map
-  mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType debugMap = StoreResultImages<ParameterImageType>(debugParamNames, fitFilter, resultPos, resultPos);
+  mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType debugMap = StoreResultImages<ParameterImageType>(debugParamNames, outputImages, resultPos, resultPos);
   this->m_TempEvaluationResultMap.insert(debugMap.begin(), debugMap.end());
 }
 
@@ -0,0 +1,214 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkWorkStealingBatchScheduler.h"
+
+#include "itkMultiThreader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  /** Batches [Begin, End) that are not processed yet. The owning thread takes batches from the front,
+   other threads steal from the back.*/
+  struct BatchQueue
+  {
+    std::mutex Mutex;
+    std::size_t Begin = 0;
+    std::size_t End = 0;
+  };
+
+  struct SchedulerThreadData
+  {
+    const mitk::WorkStealingBatchScheduler::BatchFunctionType* Function;
+    std::size_t NumberOfItems;
+    std::size_t BatchSize;
+    std::vector<BatchQueue> Queues;
+
+    std::atomic<bool> Abort;
+    std::mutex ErrorMutex;
+    std::exception_ptr Error;
+
+    explicit SchedulerThreadData(unsigned int numberOfThreads) : Queues(numberOfThreads), Abort(false) {}
+  };
+
+  bool PopFront(BatchQueue& queue, std::size_t& batch)
+  {
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+
+    if (queue.Begin == queue.End)
+    {
+      return false;
+    }
+
+    batch = queue.Begin++;
+    return true;
+  }
+
+  /** Moves the back half of the batches of another thread into the (empty) queue of the thread.*/
+  bool Steal(SchedulerThreadData& data, unsigned int threadId)
+  {
+    const auto numberOfThreads = static_cast<unsigned int>(data.Queues.size());
+
+    for (unsigned int i = 1; i < numberOfThreads; ++i)
+    {
+      auto& victim = data.Queues[(threadId + i) % numberOfThreads];
+      std::size_t begin = 0;
+      std::size_t end = 0;
+
+      {
+        std::lock_guard<std::mutex> lock(victim.Mutex);
+        const std::size_t remaining = victim.End - victim.Begin;
+
+        if (0 == remaining)
+        {
+          continue;
+        }
+
+        end = victim.End;
+        begin = end - (remaining + 1) / 2;
+        victim.End = begin;
+      }
+
+      auto& own = data.Queues[threadId];
+      std::lock_guard<std::mutex> lock(own.Mutex);
+      own.Begin = begin;
+      own.End = end;
+      return true;
+    }
+
+    return false;
+  }
+
+  ITK_THREAD_RETURN_TYPE SchedulerThreaderCallback(void* arg)
+  {
+    auto* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+    auto& data = *static_cast<SchedulerThreadData*>(info->UserData);
+    const auto threadId = static_cast<unsigned int>(info->ThreadID);
+
+    try
+    {
+      std::size_t batch = 0;
+
+      while (!data.Abort)
+      {
+        if (!PopFront(data.Queues[threadId], batch))
+        {
+          if (Steal(data, threadId))
+          {
+            continue;
+          }
+
+          break;
+        }
+
+        const std::size_t begin = batch * data.BatchSize;
+        const std::size_t end = std::min(begin + data.BatchSize, data.NumberOfItems);
+        (*data.Function)(begin, end, threadId);
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(data.ErrorMutex);
+
+      if (!data.Error)
+      {
+        data.Error = std::current_exception();
+      }
+
+      data.Abort = true;
+    }
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+}
+
+mitk::WorkStealingBatchScheduler::WorkStealingBatchScheduler() : m_BatchSize(16), m_NumberOfThreads(0)
+{
+}
+
+void mitk::WorkStealingBatchScheduler::SetBatchSize(std::size_t batchSize)
+{
+  m_BatchSize = std::max<std::size_t>(1, batchSize);
+}
+
+std::size_t mitk::WorkStealingBatchScheduler::GetBatchSize() const
+{
+  return m_BatchSize;
+}
+
+void mitk::WorkStealingBatchScheduler::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::WorkStealingBatchScheduler::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+unsigned int mitk::WorkStealingBatchScheduler::ComputeNumberOfThreads(std::size_t numberOfItems) const
+{
+  const std::size_t numberOfBatches = (numberOfItems + m_BatchSize - 1) / m_BatchSize;
+  const unsigned int numberOfThreads =
+    0 != m_NumberOfThreads ? m_NumberOfThreads : itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  return static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, numberOfBatches)));
+}
+
+void mitk::WorkStealingBatchScheduler::Run(std::size_t numberOfItems, const BatchFunctionType& function) const
+{
+  if (0 == numberOfItems)
+  {
+    return;
+  }
+
+  const std::size_t numberOfBatches = (numberOfItems + m_BatchSize - 1) / m_BatchSize;
+  const unsigned int numberOfThreads = this->ComputeNumberOfThreads(numberOfItems);
+
+  SchedulerThreadData data(numberOfThreads);
+  data.Function = &function;
+  data.NumberOfItems = numberOfItems;
+  data.BatchSize = m_BatchSize;
+
+  //contiguous blocks keep the items of a thread close together in memory as long as no batches are stolen
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  {
+    data.Queues[i].Begin = numberOfBatches * i / numberOfThreads;
+    data.Queues[i].End = numberOfBatches * (i + 1) / numberOfThreads;
+  }
+
+  if (1 == numberOfThreads)
+  {
+    itk::MultiThreader::ThreadInfoStruct info;
+    info.ThreadID = 0;
+    info.NumberOfThreads = 1;
+    info.UserData = &data;
+    SchedulerThreaderCallback(&info);
+  }
+  else
+  {
+    auto threader = itk::MultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(SchedulerThreaderCallback, &data);
+    threader->SingleMethodExecute();
+  }
+
+  if (data.Error)
+  {
+    std::rethrow_exception(data.Error);
+  }
+}
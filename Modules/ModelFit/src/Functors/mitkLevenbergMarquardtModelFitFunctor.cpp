@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkSquaredDifferencesFitCostFunction.h"
 #include "mitkSumOfSquaredDifferencesFitCostFunction.h"
 #include <chrono>
+#include <typeinfo>
 #include <mitkExceptionMacro.h>
 
 mitk::LevenbergMarquardtModelFitFunctor::
@@ -96,25 +97,64 @@ mitk::LevenbergMarquardtModelFitFunctor::DefineDebugParameterNames() const
   return result;
 };
 
-mitk::LevenbergMarquardtModelFitFunctor::ParametersType
-mitk::LevenbergMarquardtModelFitFunctor::
-DoModelFit(const SignalType& value, const ModelBase* model,
-           const ModelBase::ParametersType& initialParameters,
-           DebugParameterMapType& debugParameters) const
+namespace
 {
-    std::chrono::time_point<std::chrono::system_clock> startTime;
-    startTime = std::chrono::system_clock::now();
-  ::itk::LevenbergMarquardtOptimizer::ParametersType internalInitParam = initialParameters;
-  ::itk::LevenbergMarquardtOptimizer::ScalesType scales = m_Scales;
+  /** Optimizer and cost function of one thread that are reused for consecutive fits. */
+  class LevenbergMarquardtFitState : public mitk::ModelFitFunctorBase::FitState
+  {
+  public:
+    mitk::MVModelFitCostFunction::Pointer CostFunction;
+    ::itk::LevenbergMarquardtOptimizer::Pointer Optimizer;
+    unsigned int NumberOfParameters = 0;
+    unsigned int NumberOfValues = 0;
+  };
+}
 
-  if (initialParameters.GetNumberOfElements() != model->GetNumberOfParameters())
+bool mitk::LevenbergMarquardtModelFitFunctor::UpdateCostFunction(MVModelFitCostFunction* costFunction,
+  const SignalType& value, const ModelBase* model) const
+{
+  //derived classes may generate other cost functions and have to opt in to the reuse explicitly
+  if (typeid(*this) != typeid(LevenbergMarquardtModelFitFunctor))
   {
-    MITK_DEBUG <<
-               "Size of initial parameters of fit functor optimizer do not match number of model parameters. Renitialize parameters with 0.0.";
-    internalInitParam.SetSize(model->GetNumberOfParameters());
-    internalInitParam.Fill(0.0);
+    return false;
   }
 
+  this->ReconfigureCostFunction(costFunction, value, model);
+  return true;
+};
+
+void mitk::LevenbergMarquardtModelFitFunctor::ReconfigureCostFunction(MVModelFitCostFunction* costFunction,
+  const SignalType& value, const ModelBase* model) const
+{
+  auto* decorator = dynamic_cast<::mitk::MVConstrainedCostFunctionDecorator*>(costFunction);
+  if (decorator)
+  {
+    //break constness to reconfigure the wrapped cost function. It was generated by GenerateCostFunction()
+    //and is exclusively owned by the fit state of the calling thread.
+    auto* wrapped = const_cast<MVModelFitCostFunction*>(decorator->GetWrappedCostFunction());
+    wrapped->SetModel(model);
+    wrapped->SetSample(value);
+    decorator->ResetEvaluationCounts();
+  }
+
+  costFunction->SetModel(model);
+  costFunction->SetSample(value);
+};
+
+std::unique_ptr<mitk::ModelFitFunctorBase::FitState>
+mitk::LevenbergMarquardtModelFitFunctor::CreateFitState() const
+{
+  std::unique_ptr<FitState> state(new LevenbergMarquardtFitState);
+  state->DebugParameterNames = this->GetDebugParameterNames();
+  return state;
+};
+
+::itk::LevenbergMarquardtOptimizer::Pointer
+mitk::LevenbergMarquardtModelFitFunctor::
+GenerateOptimizer(MVModelFitCostFunction* metric, const ModelBase* model) const
+{
+  ::itk::LevenbergMarquardtOptimizer::ScalesType scales = m_Scales;
+
   if (m_Scales.GetNumberOfElements() != model->GetNumberOfParameters())
   {
     MITK_DEBUG <<
@@ -123,8 +163,6 @@ DoModelFit(const SignalType& value, const ModelBase* model,
     scales.Fill(1.0);
   }
 
-  mitk::MVModelFitCostFunction::Pointer metric = this->GenerateCostFunction(value, model);
-
   ::itk::LevenbergMarquardtOptimizer::Pointer optimizer = ::itk::LevenbergMarquardtOptimizer::New();
 
   optimizer->SetCostFunction(metric);
@@ -132,6 +170,66 @@ DoModelFit(const SignalType& value, const ModelBase* model,
   optimizer->SetGradientTolerance(m_GradientTolerance);
   optimizer->SetNumberOfIterations(m_Iterations);
   optimizer->SetScales(scales);
+
+  return optimizer;
+};
+
+mitk::LevenbergMarquardtModelFitFunctor::ParametersType
+mitk::LevenbergMarquardtModelFitFunctor::
+DoModelFit(const SignalType& value, const ModelBase* model,
+           const ModelBase::ParametersType& initialParameters,
+           DebugParameterMapType& debugParameters) const
+{
+  mitk::MVModelFitCostFunction::Pointer metric = this->GenerateCostFunction(value, model);
+  ::itk::LevenbergMarquardtOptimizer::Pointer optimizer = this->GenerateOptimizer(metric, model);
+
+  return this->RunOptimization(model, initialParameters, debugParameters, metric, optimizer);
+};
+
+mitk::LevenbergMarquardtModelFitFunctor::ParametersType
+mitk::LevenbergMarquardtModelFitFunctor::
+DoModelFitWithState(const SignalType& value, const ModelBase* model,
+                    const ModelBase::ParametersType& initialParameters,
+                    DebugParameterMapType& debugParameters, FitState& state) const
+{
+  auto* lmState = dynamic_cast<LevenbergMarquardtFitState*>(&state);
+  if (!lmState)
+  {
+    return this->DoModelFit(value, model, initialParameters, debugParameters);
+  }
+
+  //the optimizer is bound to the number of parameters and values of the cost function it was created for
+  if (lmState->Optimizer.IsNull() || lmState->NumberOfParameters != model->GetNumberOfParameters()
+      || lmState->NumberOfValues != value.GetSize()
+      || !this->UpdateCostFunction(lmState->CostFunction, value, model))
+  {
+    lmState->CostFunction = this->GenerateCostFunction(value, model);
+    lmState->Optimizer = this->GenerateOptimizer(lmState->CostFunction, model);
+    lmState->NumberOfParameters = model->GetNumberOfParameters();
+    lmState->NumberOfValues = value.GetSize();
+  }
+
+  return this->RunOptimization(model, initialParameters, debugParameters, lmState->CostFunction, lmState->Optimizer);
+};
+
+mitk::LevenbergMarquardtModelFitFunctor::ParametersType
+mitk::LevenbergMarquardtModelFitFunctor::
+RunOptimization(const ModelBase* model, const ModelBase::ParametersType& initialParameters,
+                DebugParameterMapType& debugParameters, const MVModelFitCostFunction* metric,
+                ::itk::LevenbergMarquardtOptimizer* optimizer) const
+{
+    std::chrono::time_point<std::chrono::system_clock> startTime;
+    startTime = std::chrono::system_clock::now();
+  ::itk::LevenbergMarquardtOptimizer::ParametersType internalInitParam = initialParameters;
+
+  if (initialParameters.GetNumberOfElements() != model->GetNumberOfParameters())
+  {
+    MITK_DEBUG <<
+               "Size of initial parameters of fit functor optimizer do not match number of model parameters. Renitialize parameters with 0.0.";
+    internalInitParam.SetSize(model->GetNumberOfParameters());
+    internalInitParam.Fill(0.0);
+  }
+
   optimizer->SetInitialPosition(internalInitParam);
 
   optimizer->StartOptimization();
@@ -152,7 +250,7 @@ DoModelFit(const SignalType& value, const ModelBase* model,
     debugParameters.insert(std::make_pair("stop_condition", value));
 
 
-    const ::mitk::MVConstrainedCostFunctionDecorator* decorator = dynamic_cast<const ::mitk::MVConstrainedCostFunctionDecorator*>(metric.GetPointer());
+    const ::mitk::MVConstrainedCostFunctionDecorator* decorator = dynamic_cast<const ::mitk::MVConstrainedCostFunctionDecorator*>(metric);
     if (decorator)
     {
       value = decorator->GetPenaltyRatio();
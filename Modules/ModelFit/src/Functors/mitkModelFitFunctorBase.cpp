@@ -16,6 +16,15 @@ mitk::ModelFitFunctorBase::OutputPixelArrayType
 mitk::ModelFitFunctorBase::
 Compute(const InputPixelArrayType& value, const ModelBase* model,
         const ModelBase::ParametersType& initialParameters) const
+{
+  std::unique_ptr<FitState> state = this->CreateFitState();
+  return this->Compute(value, model, initialParameters, *state);
+};
+
+const mitk::ModelFitFunctorBase::OutputPixelArrayType&
+mitk::ModelFitFunctorBase::
+Compute(const InputPixelArrayType& value, const ModelBase* model,
+        const ModelBase::ParametersType& initialParameters, FitState& state) const
 {
   if (!model)
   {
@@ -28,21 +37,21 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
                       << model->GetNumberOfParameters() << "; Initial parameters: " << initialParameters);
   }
 
-  SignalType sample(value.size());
+  SignalType& sample = state.Sample;
+  if (sample.Size() != value.size())
+  {
+    sample.SetSize(value.size());
+  }
 
   for (SignalType::SizeValueType i = 0; i < sample.Size(); ++i)
   {
     sample[i] = value [i];
   }
 
-  DebugParameterMapType debugParams;
-  ParameterNamesType debugNames;
-  if (this->m_DebugParameterMaps)
-  {
-    debugNames = this->GetDebugParameterNames();
-  }
+  DebugParameterMapType& debugParams = state.DebugParameters;
+  const ParameterNamesType& debugNames = state.DebugParameterNames;
 
-  ParametersType fittedParameters = DoModelFit(sample, model, initialParameters, debugParams);
+  ParametersType fittedParameters = DoModelFitWithState(sample, model, initialParameters, debugParams, state);
 
   OutputPixelArrayType derivedParameters = this->GetDerivedParameters(model, fittedParameters);
 
@@ -56,8 +65,9 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
     itkExceptionMacro("ModelFitInfo implementation seems to be inconsitent. Number of criterion values is not equal to number of criterion names.");
   }
 
-  OutputPixelArrayType result(fittedParameters.Size() + derivedParameters.size() + criteria.size() +
-                              evaluationParameters.size() + debugNames.size());
+  OutputPixelArrayType& result = state.Result;
+  result.resize(fittedParameters.Size() + derivedParameters.size() + criteria.size() +
+                evaluationParameters.size() + debugNames.size());
 
   for (ParametersType::SizeValueType i = 0; i < fittedParameters.Size(); ++i)
   {
@@ -100,6 +110,23 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
   return result;
 };
 
+std::unique_ptr<mitk::ModelFitFunctorBase::FitState>
+mitk::ModelFitFunctorBase::CreateFitState() const
+{
+  std::unique_ptr<FitState> state(new FitState);
+  state->DebugParameterNames = this->GetDebugParameterNames();
+  return state;
+};
+
+mitk::ModelFitFunctorBase::ParametersType
+mitk::ModelFitFunctorBase::DoModelFitWithState(const SignalType& value, const ModelBase* model,
+    const ModelBase::ParametersType& initialParameters, DebugParameterMapType& debugParameters, FitState& /*state*/) const
+{
+  return this->DoModelFit(value, model, initialParameters, debugParameters);
+};
+
+mitk::ModelFitFunctorBase::FitState::~FitState() {};
+
 unsigned int
 mitk::ModelFitFunctorBase::GetNumberOfOutputs(const ModelBase* model) const
 {
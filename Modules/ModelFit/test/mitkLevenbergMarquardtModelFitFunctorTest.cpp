@@ -20,6 +20,27 @@ found in the LICENSE file.
 
 #include "mitkLinearModel.h"
 
+namespace
+{
+  /** Reimplements the cost function generation without opting in to the reuse of cost functions.*/
+  class CountingModelFitFunctor : public mitk::LevenbergMarquardtModelFitFunctor
+  {
+  public:
+    mitkClassMacro(CountingModelFitFunctor, mitk::LevenbergMarquardtModelFitFunctor);
+    itkFactorylessNewMacro(Self);
+
+    mutable unsigned int m_NumberOfGeneratedCostFunctions = 0;
+
+  protected:
+    mitk::MVModelFitCostFunction::Pointer GenerateCostFunction(const SignalType& value,
+      const mitk::ModelBase* model) const override
+    {
+      ++m_NumberOfGeneratedCostFunctions;
+      return Superclass::GenerateCostFunction(value, model);
+    }
+  };
+}
+
 int mitkLevenbergMarquardtModelFitFunctorTest(int  /*argc*/, char*[] /*argv[]*/)
 {
   // always start with this!
@@ -81,5 +102,30 @@ int mitkLevenbergMarquardtModelFitFunctorTest(int  /*argc*/, char*[] /*argv[]*/)
   MITK_TEST_CONDITION_REQUIRED(mitk::Equal(-5, output[2], 1e-6, true) == true,
                                "Check derived parameter 1 (x-intercept) for sample 2.");
 
+  //Test reuse of a fit state for consecutive fits
+  std::unique_ptr<mitk::ModelFitFunctorBase::FitState> state = testFunctor->CreateFitState();
+
+  output = testFunctor->Compute(sample1, model, initParams, *state);
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(5, output[0], 1e-6, true) == true,
+                               "Check fitted parameter 1 (slope) for sample 1 with fit state.");
+
+  output = testFunctor->Compute(sample2, model, initParams, *state);
+  CPPUNIT_ASSERT_MESSAGE("Check number of values in functor output with fit state.", 4 == output.size());
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2, output[0], 1e-6, true) == true,
+                               "Check fitted parameter 1 (slope) for sample 2 with reused fit state.");
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(10, output[1], 1e-6, true) == true,
+                               "Check fitted parameter 2 (offset) for sample 2 with reused fit state.");
+
+  //Test that reimplemented cost function generators are called for every fit
+  CountingModelFitFunctor::Pointer countingFunctor = CountingModelFitFunctor::New();
+  state = countingFunctor->CreateFitState();
+
+  countingFunctor->Compute(sample1, model, initParams, *state);
+  output = countingFunctor->Compute(sample2, model, initParams, *state);
+  CPPUNIT_ASSERT_MESSAGE("Check that the cost function is generated for each fit without opt-in to reuse.",
+                         2 == countingFunctor->m_NumberOfGeneratedCostFunctions);
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2, output[0], 1e-6, true) == true,
+                               "Check fitted parameter 1 (slope) for sample 2 with derived functor.");
+
   MITK_TEST_END()
 }
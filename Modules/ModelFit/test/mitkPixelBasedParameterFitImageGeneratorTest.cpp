@@ -77,6 +77,8 @@ int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]
 
     generator->Generate();
 
+    MITK_TEST_CONDITION(mitk::Equal(1.0, generator->GetProgress()), "Check if progress is complete after generation.");
+
     mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType resultImages = generator->GetParameterImages();
     mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType derivedResultImages = generator->GetDerivedParameterImages();
 
@@ -138,6 +140,10 @@ int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]
     testValue = slopeAccessor2.GetPixelByIndex(testIndex6);
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #1 (slope) at index #6");
 
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> interceptAccessor2(derivedResultImages["x-intercept"]);
+    testValue = interceptAccessor2.GetPixelByIndex(testIndex6);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check derived param (x-intercept) of masked out voxel at index #6");
+
     testValue = offsetAccessor2.GetPixelByIndex(testIndex1);
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #1");
     testValue = offsetAccessor2.GetPixelByIndex(testIndex2);
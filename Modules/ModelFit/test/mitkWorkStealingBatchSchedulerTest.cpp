@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkWorkStealingBatchScheduler.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class mitkWorkStealingBatchSchedulerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkWorkStealingBatchSchedulerTestSuite);
+
+  MITK_TEST(ComputeNumberOfThreads);
+  MITK_TEST(Run_ProcessesEveryItemOnce);
+  MITK_TEST(Run_UnbalancedItems_StealsBatches);
+  MITK_TEST(Run_Exception_IsRethrown);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void ComputeNumberOfThreads()
+  {
+    mitk::WorkStealingBatchScheduler scheduler;
+    scheduler.SetBatchSize(10);
+    scheduler.SetNumberOfThreads(4);
+
+    CPPUNIT_ASSERT_EQUAL(1u, scheduler.ComputeNumberOfThreads(0));
+    CPPUNIT_ASSERT_EQUAL(1u, scheduler.ComputeNumberOfThreads(10));
+    CPPUNIT_ASSERT_EQUAL(2u, scheduler.ComputeNumberOfThreads(11));
+    CPPUNIT_ASSERT_EQUAL(4u, scheduler.ComputeNumberOfThreads(1000));
+  }
+
+  void Run_ProcessesEveryItemOnce()
+  {
+    mitk::WorkStealingBatchScheduler scheduler;
+    scheduler.SetBatchSize(7);
+    scheduler.SetNumberOfThreads(4);
+
+    const std::size_t numberOfItems = 1000;
+    std::vector<std::atomic<int>> counts(numberOfItems);
+    for (auto& count : counts)
+      count = 0;
+
+    std::atomic<bool> validThreadIds(true);
+    const auto numberOfThreads = scheduler.ComputeNumberOfThreads(numberOfItems);
+
+    scheduler.Run(numberOfItems, [&](std::size_t begin, std::size_t end, unsigned int threadId) {
+      if (threadId >= numberOfThreads || end - begin > scheduler.GetBatchSize())
+        validThreadIds = false;
+
+      for (auto i = begin; i < end; ++i)
+        ++counts[i];
+    });
+
+    CPPUNIT_ASSERT(validThreadIds);
+
+    for (const auto& count : counts)
+      CPPUNIT_ASSERT_EQUAL(1, count.load());
+  }
+
+  void Run_UnbalancedItems_StealsBatches()
+  {
+    mitk::WorkStealingBatchScheduler scheduler;
+    scheduler.SetBatchSize(1);
+    scheduler.SetNumberOfThreads(2);
+
+    // all expensive items are initially assigned to thread 0
+    const std::size_t numberOfItems = 40;
+    std::vector<unsigned int> processingThread(numberOfItems);
+
+    scheduler.Run(numberOfItems, [&](std::size_t begin, std::size_t end, unsigned int threadId) {
+      for (auto i = begin; i < end; ++i)
+      {
+        processingThread[i] = threadId;
+
+        if (i < numberOfItems / 2)
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    });
+
+    std::size_t stolenItems = 0;
+    for (std::size_t i = 0; i < numberOfItems / 2; ++i)
+    {
+      if (0 != processingThread[i])
+        ++stolenItems;
+    }
+
+    CPPUNIT_ASSERT(stolenItems > 0);
+  }
+
+  void Run_Exception_IsRethrown()
+  {
+    mitk::WorkStealingBatchScheduler scheduler;
+    scheduler.SetBatchSize(4);
+    scheduler.SetNumberOfThreads(4);
+
+    CPPUNIT_ASSERT_THROW(scheduler.Run(100,
+                                       [](std::size_t begin, std::size_t end, unsigned int) {
+                                         if (begin <= 50 && 50 < end)
+                                           throw std::runtime_error("Fit failed.");
+                                       }),
+                         std::runtime_error);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkWorkStealingBatchScheduler)
@@ -0,0 +1,118 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  /** Labels a small cube at a position that differs per layer, like a lesion segmented in its own layer. */
+  void PaintLesion(mitk::LabelSetImage *image, unsigned int layer, unsigned int lesionSize)
+  {
+    const unsigned int size = image->GetDimension(0);
+    const unsigned int begin = (layer * 37 + 11) % (size - lesionSize);
+
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<mitk::Label::PixelType *>(writeAccess.GetData());
+
+    for (unsigned int z = begin; z < begin + lesionSize; ++z)
+      for (unsigned int y = begin; y < begin + lesionSize; ++y)
+        for (unsigned int x = begin; x < begin + lesionSize; ++x)
+          data[(static_cast<std::size_t>(z) * size + y) * size + x] = 1;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Multilabel Memory Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Measures the memory of a multi-layer label set image with one small lesion per layer in "
+                        "sparse layer storage and the time of switching the active layer.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("size", "s", mitkCommandLineParser::Int, "Size:", "Edge length of the cubic image (default: 512)", us::Any(), true);
+  parser.addArgument("layers", "l", mitkCommandLineParser::Int, "Layers:", "Number of layers (default: 30)", us::Any(), true);
+  parser.addArgument("lesion", "e", mitkCommandLineParser::Int, "Lesion:", "Edge length of the lesion per layer (default: 20)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int size = parsedArgs.count("size") ? us::any_cast<int>(parsedArgs["size"]) : 512;
+  const unsigned int numberOfLayers = parsedArgs.count("layers") ? us::any_cast<int>(parsedArgs["layers"]) : 30;
+  const unsigned int lesionSize = parsedArgs.count("lesion") ? us::any_cast<int>(parsedArgs["lesion"]) : 20;
+
+  if (0 == numberOfLayers || lesionSize >= size)
+  {
+    std::cerr << "The lesion must be smaller than the image and there must be at least one layer." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto referenceImage = mitk::Image::New();
+  const unsigned int dimensions[3] = {size, size, size};
+  referenceImage->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), 3, dimensions);
+
+  auto image = mitk::LabelSetImage::New();
+  image->Initialize(referenceImage);
+  referenceImage = nullptr;
+
+  image->SetSparseLayerStorage(true);
+
+  for (unsigned int layer = 0; layer < numberOfLayers; ++layer)
+  {
+    if (layer > 0)
+      image->AddLayer();
+
+    PaintLesion(image, layer, lesionSize);
+  }
+
+  // switch once through all layers, so each of them is stored in its final state
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned int layer = 0; layer < numberOfLayers; ++layer)
+    image->SetActiveLayer(layer);
+
+  const double switchTime =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / numberOfLayers;
+
+  // the active image and one dense image per layer without sparse storage
+  const double megaByte = 1024.0 * 1024.0;
+  const double denseMemory =
+    (numberOfLayers + 1.0) * size * size * size * sizeof(mitk::Label::PixelType) / megaByte;
+  const double sparseMemory = image->GetLayerMemorySize() / megaByte;
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "layers:             " << numberOfLayers << " x " << size << "^3" << std::endl;
+  std::cout << "dense memory [MB]:  " << denseMemory << std::endl;
+  std::cout << "sparse memory [MB]: " << sparseMemory << std::endl;
+  std::cout << std::setprecision(3);
+  std::cout << "layer switch [s]:   " << switchTime << std::endl;
+
+  return EXIT_SUCCESS;
+}
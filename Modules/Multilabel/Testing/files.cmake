@@ -2,7 +2,10 @@ set(MODULE_TESTS
     mitkLabelTest.cpp
     mitkLabelSetTest.cpp
     mitkLabelSetImageTest.cpp
+    mitkSparseLabelVolumeTest.cpp
     mitkLabelSetImageIOTest.cpp
+    mitkLabelSetImageVtkMapper2DTest.cpp
     mitkLabelSetImageSurfaceStampFilterTest.cpp
+    mitkLabelSetImageToSurfaceFilterTest.cpp
 )
 
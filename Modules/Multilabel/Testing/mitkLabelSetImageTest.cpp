@@ -11,11 +11,15 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <algorithm>
+
 class mitkLabelSetImageTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkLabelSetImageTestSuite);
@@ -34,11 +38,70 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestMergeLabel);
+  MITK_TEST(TestGetLabelRegionInfo);
+  MITK_TEST(TestLabelRegionInfoAfterEraseAndMerge);
+  MITK_TEST(TestEraseLabelAfterInvalidateLabelRegionInfos);
+  MITK_TEST(TestCreateLabelMaskAndCenterOfMass);
+  MITK_TEST(TestLabelRegionInfoAfterMaskStamp);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::LabelSetImage::Pointer m_LabelSetImage;
 
+  typedef mitk::LabelSetImage::PixelType PixelType;
+
+  static void FillBox(mitk::Image *image, const unsigned int lower[3], const unsigned int upper[3], PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(image);
+    itk::Index<3> index;
+
+    for (index[2] = lower[2]; index[2] <= upper[2]; ++index[2])
+      for (index[1] = lower[1]; index[1] <= upper[1]; ++index[1])
+        for (index[0] = lower[0]; index[0] <= upper[0]; ++index[0])
+          accessor.SetPixelByIndex(index, value);
+  }
+
+  static std::size_t CountVoxels(mitk::Image *image, PixelType value)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 3> accessor(image);
+    std::size_t numberOfPixels = 1;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      numberOfPixels *= image->GetDimension(dim);
+
+    return std::count(accessor.GetData(), accessor.GetData() + numberOfPixels, value);
+  }
+
+  /** Label 1 is a box of 10 x 10 x 5 voxels, label 2 consists of two distant voxels. */
+  void FillLabels()
+  {
+    const unsigned int lower1[3] = {10, 20, 5};
+    const unsigned int upper1[3] = {19, 29, 9};
+    FillBox(m_LabelSetImage, lower1, upper1, 1);
+
+    const unsigned int voxel1[3] = {50, 60, 40};
+    const unsigned int voxel2[3] = {52, 61, 41};
+    FillBox(m_LabelSetImage, voxel1, voxel1, 2);
+    FillBox(m_LabelSetImage, voxel2, voxel2, 2);
+
+    m_LabelSetImage->Modified();
+
+    for (PixelType value = 1; value <= 2; ++value)
+    {
+      mitk::Label::Pointer label = mitk::Label::New();
+      label->SetValue(value);
+      label->SetLocked(false);
+      m_LabelSetImage->GetActiveLabelSet()->AddLabel(label);
+    }
+  }
+
+  static void CheckRegion(const mitk::LabelSetImage::LabelRegionInfo &info,
+                          const itk::Index<3> &lower,
+                          const itk::Index<3> &upper)
+  {
+    CPPUNIT_ASSERT_EQUAL(lower, info.Region.GetIndex());
+    CPPUNIT_ASSERT_EQUAL(upper, info.Region.GetUpperIndex());
+  }
+
 public:
   void setUp() override
   {
@@ -437,6 +500,130 @@ public:
     // Check if merge label has 507 + 823 = 1330 pixels
     CPPUNIT_ASSERT_MESSAGE("Label with value 7 was not remove from the image", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 1330);
   }
+
+  void TestGetLabelRegionInfo()
+  {
+    FillLabels();
+
+    mitk::LabelSetImage::LabelRegionInfo info;
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(1, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(500), info.NumberOfVoxels);
+    CheckRegion(info, {{10, 20, 5}}, {{19, 29, 9}});
+
+    mitk::Point3D centroid;
+    mitk::FillVector3D(centroid, 14.5, 24.5, 7.0);
+    CPPUNIT_ASSERT(mitk::Equal(centroid, info.GetCentroidIndex()));
+
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(2, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), info.NumberOfVoxels);
+    CheckRegion(info, {{50, 60, 40}}, {{52, 61, 41}});
+
+    CPPUNIT_ASSERT_MESSAGE("Exterior label must not be tracked", !m_LabelSetImage->GetLabelRegionInfo(0, info));
+    CPPUNIT_ASSERT_MESSAGE("Label without voxels has a region", !m_LabelSetImage->GetLabelRegionInfo(3, info));
+
+    // changes from outside are announced by Modified()
+    const unsigned int voxel[3] = {0, 0, 0};
+    FillBox(m_LabelSetImage, voxel, voxel, 3);
+    m_LabelSetImage->Modified();
+
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(3, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), info.NumberOfVoxels);
+  }
+
+  void TestLabelRegionInfoAfterEraseAndMerge()
+  {
+    FillLabels();
+
+    mitk::LabelSetImage::LabelRegionInfo info;
+    m_LabelSetImage->MergeLabel(1, 2);
+
+    CPPUNIT_ASSERT(!m_LabelSetImage->GetLabelRegionInfo(2, info));
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(1, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(502), info.NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(CountVoxels(m_LabelSetImage, 1), info.NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), CountVoxels(m_LabelSetImage, 2));
+    CheckRegion(info, {{10, 20, 5}}, {{52, 61, 41}});
+
+    m_LabelSetImage->EraseLabel(1);
+
+    CPPUNIT_ASSERT(!m_LabelSetImage->GetLabelRegionInfo(1, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), CountVoxels(m_LabelSetImage, 1));
+  }
+
+  void TestEraseLabelAfterInvalidateLabelRegionInfos()
+  {
+    FillLabels();
+
+    mitk::LabelSetImage::LabelRegionInfo info;
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(1, info));
+
+    // voxels outside of the known region of label 1, written without Modified()
+    const unsigned int voxel[3] = {80, 100, 45};
+    FillBox(m_LabelSetImage, voxel, voxel, 1);
+    m_LabelSetImage->InvalidateLabelRegionInfos();
+
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(1, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(501), info.NumberOfVoxels);
+
+    FillBox(m_LabelSetImage, voxel, voxel, 2);
+    m_LabelSetImage->InvalidateLabelRegionInfos();
+    m_LabelSetImage->MergeLabel(1, 2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), CountVoxels(m_LabelSetImage, 2));
+
+    m_LabelSetImage->EraseLabel(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), CountVoxels(m_LabelSetImage, 1));
+  }
+
+  void TestCreateLabelMaskAndCenterOfMass()
+  {
+    FillLabels();
+
+    auto mask = m_LabelSetImage->CreateLabelMask(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(500), CountVoxels(mask, 1));
+
+    // the center of mass is the middle voxel of the label in memory order
+    m_LabelSetImage->UpdateCenterOfMass(1);
+
+    mitk::Point3D centerOfMass;
+    mitk::FillVector3D(centerOfMass, 10.0, 25.0, 7.0);
+    CPPUNIT_ASSERT(mitk::Equal(centerOfMass, m_LabelSetImage->GetLabel(1)->GetCenterOfMassIndex()));
+  }
+
+  void TestLabelRegionInfoAfterMaskStamp()
+  {
+    FillLabels();
+
+    mitk::LabelSetImage::LabelRegionInfo info;
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(1, info));
+
+    // the mask covers one half of label 1
+    auto mask = mitk::Image::New();
+    mask->Initialize(m_LabelSetImage);
+    {
+      const unsigned int lower[3] = {0, 0, 0};
+      const unsigned int upper[3] = {95, 127, 51};
+      FillBox(mask, lower, upper, 0);
+    }
+    const unsigned int lower[3] = {15, 20, 5};
+    const unsigned int upper[3] = {24, 29, 9};
+    FillBox(mask, lower, upper, 1);
+
+    m_LabelSetImage->GetActiveLabelSet()->SetActiveLabel(2);
+    m_LabelSetImage->MaskStamp(mask, true);
+
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(1, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(250), info.NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(CountVoxels(m_LabelSetImage, 1), info.NumberOfVoxels);
+
+    mitk::Point3D centroid;
+    mitk::FillVector3D(centroid, 12.0, 24.5, 7.0);
+    CPPUNIT_ASSERT(mitk::Equal(centroid, info.GetCentroidIndex()));
+
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelRegionInfo(2, info));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(502), info.NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(CountVoxels(m_LabelSetImage, 2), info.NumberOfVoxels);
+    CheckRegion(info, {{15, 20, 5}}, {{52, 61, 41}});
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
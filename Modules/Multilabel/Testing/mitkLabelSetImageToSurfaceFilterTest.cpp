@@ -0,0 +1,158 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImageToSurfaceFilter.h>
+#include <mitkSurface.h>
+
+#include <vtkPolyData.h>
+
+#include <cstring>
+
+class mitkLabelSetImageToSurfaceFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageToSurfaceFilterTestSuite);
+  MITK_TEST(Update_AllLabels_OneSurfacePerLabel);
+  MITK_TEST(Update_AllLabels_EqualsSingleLabelSurfaces);
+  MITK_TEST(Update_Decimation_ReducesTriangles);
+  MITK_TEST(Update_MissingLabel_Throws);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int Size = 40;
+
+  mitk::Image::Pointer m_Image;
+
+  /** Fills a cube of voxels from min to max (both included) with the given label. */
+  static void FillCube(mitk::Image *image, unsigned int min[3], unsigned int max[3], unsigned short label)
+  {
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<unsigned short *>(writeAccess.GetData());
+
+    for (unsigned int z = min[2]; z <= max[2]; ++z)
+      for (unsigned int y = min[1]; y <= max[1]; ++y)
+        for (unsigned int x = min[0]; x <= max[0]; ++x)
+          data[(z * Size + y) * Size + x] = label;
+  }
+
+  mitk::LabelSetImageToSurfaceFilter::Pointer CreateFilter()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_Image);
+    return filter;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    unsigned int dimensions[3] = {Size, Size, Size};
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    mitk::Vector3D spacing;
+    spacing[0] = 1.0;
+    spacing[1] = 1.5;
+    spacing[2] = 2.0;
+    m_Image->SetSpacing(spacing);
+
+    {
+      mitk::ImageWriteAccessor writeAccess(m_Image);
+      std::memset(writeAccess.GetData(), 0, Size * Size * Size * sizeof(unsigned short));
+    }
+
+    // three labels, label 7 touches the border of the image
+    unsigned int min1[3] = {5, 5, 5};
+    unsigned int max1[3] = {14, 12, 10};
+    FillCube(m_Image, min1, max1, 1);
+
+    unsigned int min2[3] = {20, 22, 18};
+    unsigned int max2[3] = {30, 32, 28};
+    FillCube(m_Image, min2, max2, 3);
+
+    unsigned int min3[3] = {0, 30, 30};
+    unsigned int max3[3] = {8, 39, 39};
+    FillCube(m_Image, min3, max3, 7);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void Update_AllLabels_OneSurfacePerLabel()
+  {
+    auto filter = CreateFilter();
+    filter->GenerateAllLabelsOn();
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(filter->GetNumberOfIndexedOutputs()));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImageToSurfaceFilter::LabelType(1), filter->GetLabelForNthOutput(0));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImageToSurfaceFilter::LabelType(3), filter->GetLabelForNthOutput(1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImageToSurfaceFilter::LabelType(7), filter->GetLabelForNthOutput(2));
+
+    // label 3 covers the voxels 20 to 30 (in x), so its surface lies between the centers of the voxels 19 and 31
+    vtkPolyData *polydata = filter->GetOutput(1)->GetVtkPolyData();
+    CPPUNIT_ASSERT(nullptr != polydata && polydata->GetNumberOfPoints() > 0);
+
+    double bounds[6];
+    polydata->GetBounds(bounds);
+    CPPUNIT_ASSERT(bounds[0] >= 19.0 * 1.0 && bounds[1] <= 31.0 * 1.0);
+    CPPUNIT_ASSERT(bounds[2] >= 21.0 * 1.5 && bounds[3] <= 33.0 * 1.5);
+    CPPUNIT_ASSERT(bounds[4] >= 17.0 * 2.0 && bounds[5] <= 29.0 * 2.0);
+  }
+
+  void Update_AllLabels_EqualsSingleLabelSurfaces()
+  {
+    auto filter = CreateFilter();
+    filter->GenerateAllLabelsOn();
+    filter->Update();
+
+    for (unsigned int i = 0; i < filter->GetNumberOfIndexedOutputs(); ++i)
+    {
+      auto singleLabelFilter = CreateFilter();
+      singleLabelFilter->SetRequestedLabel(filter->GetLabelForNthOutput(i));
+      singleLabelFilter->Update();
+
+      CPPUNIT_ASSERT_MESSAGE("Surface of a label differs from the surface of the single label.",
+                             mitk::Equal(*(singleLabelFilter->GetOutput()->GetVtkPolyData()),
+                                         *(filter->GetOutput(i)->GetVtkPolyData()),
+                                         0.0001,
+                                         true));
+    }
+  }
+
+  void Update_Decimation_ReducesTriangles()
+  {
+    auto filter = CreateFilter();
+    filter->SetRequestedLabel(3);
+    filter->Update();
+    const auto numberOfPolys = filter->GetOutput()->GetVtkPolyData()->GetNumberOfPolys();
+
+    auto decimationFilter = CreateFilter();
+    decimationFilter->SetRequestedLabel(3);
+    decimationFilter->SetDecimate(mitk::ImageToSurfaceFilter::QuadricDecimation);
+    decimationFilter->SetTargetReduction(0.5f);
+    decimationFilter->Update();
+
+    CPPUNIT_ASSERT(decimationFilter->GetOutput()->GetVtkPolyData()->GetNumberOfPolys() < 0.6 * numberOfPolys);
+  }
+
+  void Update_MissingLabel_Throws()
+  {
+    auto filter = CreateFilter();
+    filter->SetRequestedLabel(2);
+
+    CPPUNIT_ASSERT_THROW(filter->Update(), itk::ExceptionObject);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageToSurfaceFilter)
@@ -0,0 +1,258 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageVtkMapper2D.h>
+#include <mitkRenderingTestHelper.h>
+
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+class mitkLabelSetImageVtkMapper2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageVtkMapper2DTestSuite);
+  MITK_TEST(CompositeLayers_AxialPlane_EqualsLayerSlices);
+  MITK_TEST(CompositeLayers_ObliquePlane_EqualsLayerSlices);
+  MITK_TEST(Render_SparseLayers_KeepsLayersSparse);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int Width = 30;
+  static const unsigned int Height = 20;
+  static const unsigned int Depth = 10;
+
+  typedef mitk::Label::PixelType PixelType;
+
+  mitk::LabelSetImage::Pointer m_LabelSetImage;
+  mitk::DataNode::Pointer m_Node;
+  mitk::LabelSetImageVtkMapper2D::Pointer m_Mapper;
+
+  /** Labels a box of the active layer. */
+  static void PaintBox(mitk::LabelSetImage *image, const unsigned int begin[3], const unsigned int end[3], PixelType value)
+  {
+    mitk::ImageWriteAccessor writeAccess(image, image->GetVolumeData(0));
+    auto *data = static_cast<PixelType *>(writeAccess.GetData());
+
+    for (unsigned int z = begin[2]; z < end[2]; ++z)
+      for (unsigned int y = begin[1]; y < end[1]; ++y)
+        for (unsigned int x = begin[0]; x < end[0]; ++x)
+          data[(z * Height + y) * Width + x] = value;
+
+    image->Modified();
+  }
+
+  static vtkSmartPointer<vtkImageData> Copy(vtkImageData *image)
+  {
+    auto copy = vtkSmartPointer<vtkImageData>::New();
+    copy->DeepCopy(image);
+    return copy;
+  }
+
+  /** Renders the image once per layer and once composited, and compares the composited slice with the "over"
+      compositing of the per-layer slices of ExtractSliceFilter. */
+  void AssertCompositedEqualsLayerSlices(mitk::RenderingTestHelper &renderingHelper)
+  {
+    auto renderer = mitk::BaseRenderer::GetInstance(renderingHelper.GetVtkRenderWindow());
+    const unsigned int numberOfLayers = m_LabelSetImage->GetNumberOfLayers();
+    const unsigned int activeLayer = m_LabelSetImage->GetActiveLayer();
+
+    m_Node->SetBoolProperty("labelset.layers.composite", false);
+    m_LabelSetImage->Modified();
+    renderingHelper.Render();
+
+    auto *localStorage = m_Mapper->GetLocalStorage(renderer);
+    CPPUNIT_ASSERT_EQUAL(numberOfLayers, static_cast<unsigned int>(localStorage->m_ReslicedImageVector.size()));
+
+    std::vector<vtkSmartPointer<vtkImageData>> layerSlices;
+    for (unsigned int lidx = 0; lidx < numberOfLayers; ++lidx)
+      layerSlices.push_back(Copy(localStorage->m_ReslicedImageVector[lidx]));
+
+    m_Node->SetBoolProperty("labelset.layers.composite", true);
+    m_LabelSetImage->Modified();
+    renderingHelper.Render();
+
+    localStorage = m_Mapper->GetLocalStorage(renderer);
+    CPPUNIT_ASSERT(localStorage->m_CompositeLayers);
+
+    vtkImageData *composited = localStorage->m_CompositedImage;
+    vtkImageData *activeLayerSlice = localStorage->m_ActiveLayerSlice;
+
+    int extent[6];
+    int layerExtent[6];
+    composited->GetExtent(extent);
+    for (const auto &layerSlice : layerSlices)
+    {
+      layerSlice->GetExtent(layerExtent);
+      CPPUNIT_ASSERT(std::equal(extent, extent + 6, layerExtent));
+    }
+
+    bool labelsFound = false;
+
+    for (int y = extent[2]; y <= extent[3]; ++y)
+    {
+      for (int x = extent[0]; x <= extent[1]; ++x)
+      {
+        double color[3] = {0.0, 0.0, 0.0};
+        double alpha = 0.0;
+
+        for (unsigned int lidx = 0; lidx < numberOfLayers; ++lidx)
+        {
+          const auto label = *static_cast<PixelType *>(layerSlices[lidx]->GetScalarPointer(x, y, 0));
+          labelsFound = labelsFound || 0 != label;
+
+          if (lidx == activeLayer)
+            CPPUNIT_ASSERT_EQUAL(label, *static_cast<PixelType *>(activeLayerSlice->GetScalarPointer(x, y, 0)));
+
+          auto lookupTable = m_LabelSetImage->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable();
+          const unsigned char *labelColor = lookupTable->MapValue(label);
+          const double labelAlpha = labelColor[3] / 255.0;
+
+          if (labelAlpha <= 0.0)
+            continue;
+
+          const double compositedAlpha = labelAlpha + alpha * (1.0 - labelAlpha);
+          for (unsigned int i = 0; i < 3; ++i)
+            color[i] = (labelColor[i] * labelAlpha + color[i] * alpha * (1.0 - labelAlpha)) / compositedAlpha;
+          alpha = compositedAlpha;
+        }
+
+        const auto *rgba = static_cast<unsigned char *>(composited->GetScalarPointer(x, y, 0));
+        for (unsigned int i = 0; i < 3; ++i)
+          CPPUNIT_ASSERT(std::abs(static_cast<int>(color[i] + 0.5) - rgba[i]) <= 1);
+        CPPUNIT_ASSERT(std::abs(static_cast<int>(alpha * 255.0 + 0.5) - rgba[3]) <= 1);
+      }
+    }
+
+    // the plane must hit the labels, otherwise the comparison is trivial
+    CPPUNIT_ASSERT(labelsFound);
+  }
+
+public:
+  void setUp() override
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = {Width, Height, Depth};
+    image->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+    {
+      mitk::ImageWriteAccessor writeAccess(image);
+      auto *data = static_cast<PixelType *>(writeAccess.GetData());
+      std::fill(data, data + Width * Height * Depth, 0);
+    }
+
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->Initialize(image);
+    m_LabelSetImage->AddLayer();
+
+    // overlapping boxes of different labels in both layers
+    m_LabelSetImage->SetActiveLayer(0);
+    const unsigned int begin0[3] = {2, 3, 1};
+    const unsigned int end0[3] = {16, 15, 8};
+    PaintBox(m_LabelSetImage, begin0, end0, 1);
+
+    m_LabelSetImage->SetActiveLayer(1);
+    const unsigned int begin1[3] = {10, 6, 3};
+    const unsigned int end1[3] = {27, 18, 10};
+    PaintBox(m_LabelSetImage, begin1, end1, 2);
+    const unsigned int begin2[3] = {20, 1, 0};
+    const unsigned int end2[3] = {24, 5, 6};
+    PaintBox(m_LabelSetImage, begin2, end2, 3);
+
+    // the composited slice is resliced like the active layer, so test an inactive layer below and above it
+    m_LabelSetImage->SetActiveLayer(0);
+
+    m_Mapper = mitk::LabelSetImageVtkMapper2D::New();
+    m_Node = mitk::DataNode::New();
+    m_Node->SetData(m_LabelSetImage);
+    m_Node->SetMapper(mitk::BaseRenderer::Standard2D, m_Mapper);
+    m_Node->SetBoolProperty("labelset.contour.active", false);
+  }
+
+  void tearDown() override
+  {
+    m_Node = nullptr;
+    m_Mapper = nullptr;
+    m_LabelSetImage = nullptr;
+  }
+
+  void CompositeLayers_AxialPlane_EqualsLayerSlices()
+  {
+    mitk::RenderingTestHelper renderingHelper(200, 200);
+    renderingHelper.AddNodeToStorage(m_Node);
+    renderingHelper.SetViewDirection(mitk::SliceNavigationController::Axial);
+
+    AssertCompositedEqualsLayerSlices(renderingHelper);
+
+    m_LabelSetImage->SetActiveLayer(1);
+    AssertCompositedEqualsLayerSlices(renderingHelper);
+  }
+
+  void CompositeLayers_ObliquePlane_EqualsLayerSlices()
+  {
+    mitk::RenderingTestHelper renderingHelper(200, 200);
+    renderingHelper.AddNodeToStorage(m_Node);
+    renderingHelper.SetViewDirection(mitk::SliceNavigationController::Axial);
+
+    mitk::Point3D origin;
+    origin[0] = 14.3;
+    origin[1] = 9.6;
+    origin[2] = 4.2;
+
+    mitk::Vector3D normal;
+    normal[0] = 0.3;
+    normal[1] = 0.5;
+    normal[2] = 1.0;
+
+    renderingHelper.ReorientSlices(origin, normal);
+
+    AssertCompositedEqualsLayerSlices(renderingHelper);
+
+    m_LabelSetImage->SetActiveLayer(1);
+    AssertCompositedEqualsLayerSlices(renderingHelper);
+  }
+
+  void Render_SparseLayers_KeepsLayersSparse()
+  {
+    m_LabelSetImage->SetSparseLayerStorage(true);
+    CPPUNIT_ASSERT(nullptr != m_LabelSetImage->GetSparseLayer(1));
+
+    mitk::RenderingTestHelper renderingHelper(200, 200);
+    renderingHelper.AddNodeToStorage(m_Node);
+    renderingHelper.SetViewDirection(mitk::SliceNavigationController::Axial);
+
+    for (bool composite : {true, false})
+    {
+      m_Node->SetBoolProperty("labelset.layers.composite", composite);
+      m_LabelSetImage->Modified();
+      renderingHelper.Render();
+
+      CPPUNIT_ASSERT(nullptr == m_LabelSetImage->GetSparseLayer(0));
+      CPPUNIT_ASSERT(nullptr != m_LabelSetImage->GetSparseLayer(1));
+    }
+
+    m_LabelSetImage->SetActiveLayer(1);
+    renderingHelper.Render();
+
+    CPPUNIT_ASSERT(nullptr != m_LabelSetImage->GetSparseLayer(0));
+    CPPUNIT_ASSERT(nullptr == m_LabelSetImage->GetSparseLayer(1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageVtkMapper2D)
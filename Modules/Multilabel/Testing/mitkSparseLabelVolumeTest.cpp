@@ -0,0 +1,238 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkException.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkSparseLabelVolume.h>
+
+#include <algorithm>
+
+class mitkSparseLabelVolumeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSparseLabelVolumeTestSuite);
+  MITK_TEST(New_Image_AllocatesLabeledTilesOnly);
+  MITK_TEST(WriteToImage_RoundTrip_RestoresLabels);
+  MITK_TEST(New_IncompatibleImage_Throws);
+  MITK_TEST(SetSparseLayerStorage_SwitchLayers_KeepsLabels);
+  MITK_TEST(GetLayerImage_SparseLayer_Materializes);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  // not a multiple of the tile size, so the border tiles are padded
+  static const unsigned int Width = 100;
+  static const unsigned int Height = 70;
+  static const unsigned int Depth = 35;
+
+  typedef mitk::SparseLabelVolume::PixelType PixelType;
+
+  mitk::LabelSetImage::Pointer m_LabelSetImage;
+
+  static mitk::Image::Pointer CreateImage(unsigned int timeSteps = 1)
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[4] = {Width, Height, Depth, timeSteps};
+    image->Initialize(mitk::MakeScalarPixelType<PixelType>(), timeSteps > 1 ? 4 : 3, dimensions);
+
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<PixelType *>(writeAccess.GetData());
+    std::fill(data, data + static_cast<std::size_t>(Width) * Height * Depth * timeSteps, 0);
+
+    return image;
+  }
+
+  /** Labels a box of the given image (time step 0). */
+  static void PaintBox(mitk::Image *image, const unsigned int begin[3], const unsigned int end[3], PixelType value)
+  {
+    mitk::ImageWriteAccessor writeAccess(image, image->GetVolumeData(0));
+    auto *data = static_cast<PixelType *>(writeAccess.GetData());
+
+    for (unsigned int z = begin[2]; z < end[2]; ++z)
+      for (unsigned int y = begin[1]; y < end[1]; ++y)
+        for (unsigned int x = begin[0]; x < end[0]; ++x)
+          data[(z * Height + y) * Width + x] = value;
+  }
+
+  static PixelType GetPixel(const mitk::Image *image, unsigned int x, unsigned int y, unsigned int z)
+  {
+    mitk::ImageReadAccessor readAccess(image, image->GetVolumeData(0));
+    return static_cast<const PixelType *>(readAccess.GetData())[(z * Height + y) * Width + x];
+  }
+
+  static bool Equal(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    mitk::ImageReadAccessor access1(image1);
+    mitk::ImageReadAccessor access2(image2);
+    const std::size_t numberOfPixels = static_cast<std::size_t>(Width) * Height * Depth * image1->GetTimeSteps();
+    const auto *data1 = static_cast<const PixelType *>(access1.GetData());
+
+    return std::equal(data1, data1 + numberOfPixels, static_cast<const PixelType *>(access2.GetData()));
+  }
+
+public:
+  void setUp() override
+  {
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->Initialize(CreateImage());
+  }
+
+  void tearDown() override { m_LabelSetImage = nullptr; }
+
+  void New_Image_AllocatesLabeledTilesOnly()
+  {
+    auto image = CreateImage();
+
+    auto volume = mitk::SparseLabelVolume::New(image);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4 * 3 * 2), volume->GetNumberOfTiles());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), volume->GetNumberOfAllocatedTiles());
+
+    // the box spans two tiles in x and lies in the upper border tile in z
+    const unsigned int begin[3] = {30, 3, 33};
+    const unsigned int end[3] = {34, 5, 35};
+    PaintBox(image, begin, end, 3);
+
+    volume = mitk::SparseLabelVolume::New(image);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), volume->GetNumberOfAllocatedTiles());
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), volume->GetPixel(31, 4, 34));
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), volume->GetPixel(33, 3, 33));
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), volume->GetPixel(34, 3, 33));
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), volume->GetPixel(Width - 1, Height - 1, 0));
+  }
+
+  void WriteToImage_RoundTrip_RestoresLabels()
+  {
+    auto image = CreateImage(2);
+    const unsigned int begin[3] = {90, 60, 0};
+    const unsigned int end[3] = {Width, Height, 20};
+    PaintBox(image, begin, end, 1);
+    {
+      // a second time step with a label at the last voxel
+      mitk::ImageWriteAccessor writeAccess(image, image->GetVolumeData(1));
+      static_cast<PixelType *>(writeAccess.GetData())[static_cast<std::size_t>(Width) * Height * Depth - 1] = 2;
+    }
+
+    auto volume = mitk::SparseLabelVolume::New(image);
+    CPPUNIT_ASSERT_EQUAL(PixelType(2), volume->GetPixel(Width - 1, Height - 1, Depth - 1, 1));
+
+    // unallocated tiles must overwrite former labels, too
+    auto result = CreateImage(2);
+    const unsigned int allBegin[3] = {0, 0, 0};
+    const unsigned int allEnd[3] = {Width, Height, Depth};
+    PaintBox(result, allBegin, allEnd, 5);
+
+    CPPUNIT_ASSERT(volume->IsCompatible(result));
+    volume->WriteToImage(result);
+    CPPUNIT_ASSERT(Equal(image, result));
+  }
+
+  void New_IncompatibleImage_Throws()
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = {Width, Height, Depth};
+    image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    CPPUNIT_ASSERT_THROW(mitk::SparseLabelVolume::New(image), mitk::Exception);
+
+    auto volume = mitk::SparseLabelVolume::New(CreateImage());
+    CPPUNIT_ASSERT(!volume->IsCompatible(image));
+    CPPUNIT_ASSERT(!volume->IsCompatible(CreateImage(2)));
+    CPPUNIT_ASSERT_THROW(volume->WriteToImage(image), mitk::Exception);
+  }
+
+  void SetSparseLayerStorage_SwitchLayers_KeepsLabels()
+  {
+    m_LabelSetImage->SetSparseLayerStorage(true);
+    CPPUNIT_ASSERT(m_LabelSetImage->GetSparseLayerStorage());
+
+    const unsigned int layerCount = 4;
+    for (unsigned int layer = 1; layer < layerCount; ++layer)
+      m_LabelSetImage->AddLayer();
+
+    // one small box per layer
+    for (unsigned int layer = 0; layer < layerCount; ++layer)
+    {
+      m_LabelSetImage->SetActiveLayer(layer);
+      const unsigned int begin[3] = {6 * layer, 2, 2};
+      const unsigned int end[3] = {6 * layer + 5, 6, 6};
+      PaintBox(m_LabelSetImage, begin, end, layer + 1);
+    }
+
+    for (unsigned int layer = 0; layer < layerCount; ++layer)
+    {
+      m_LabelSetImage->SetActiveLayer(layer);
+      CPPUNIT_ASSERT_EQUAL(PixelType(layer + 1), GetPixel(m_LabelSetImage, 6 * layer + 2, 3, 3));
+      CPPUNIT_ASSERT_EQUAL(PixelType(0), GetPixel(m_LabelSetImage, 6 * ((layer + 1) % layerCount) + 2, 3, 3));
+
+      // inactive layers are stored sparsely, one tile each
+      for (unsigned int other = 0; other < layerCount; ++other)
+      {
+        auto sparseLayer = m_LabelSetImage->GetSparseLayer(other);
+        CPPUNIT_ASSERT(other == layer || (nullptr != sparseLayer && 1 == sparseLayer->GetNumberOfAllocatedTiles()));
+      }
+    }
+
+    const std::size_t denseLayerSize = static_cast<std::size_t>(Width) * Height * Depth * sizeof(PixelType);
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLayerMemorySize() < 2 * denseLayerSize);
+
+    // switching back to dense storage keeps the labels
+    m_LabelSetImage->SetSparseLayerStorage(false);
+    m_LabelSetImage->SetActiveLayer(1);
+    CPPUNIT_ASSERT_EQUAL(PixelType(2), GetPixel(m_LabelSetImage, 8, 3, 3));
+    CPPUNIT_ASSERT(nullptr == m_LabelSetImage->GetSparseLayer(2));
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), GetPixel(m_LabelSetImage->GetLayerImage(2), 14, 3, 3));
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLayerMemorySize() >= (layerCount + 1) * denseLayerSize);
+  }
+
+  void GetLayerImage_SparseLayer_Materializes()
+  {
+    m_LabelSetImage->SetSparseLayerStorage(true);
+    m_LabelSetImage->AddLayer();
+
+    const unsigned int begin[3] = {1, 1, 1};
+    const unsigned int end[3] = {3, 3, 3};
+    PaintBox(m_LabelSetImage, begin, end, 7);
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT(nullptr != m_LabelSetImage->GetSparseLayer(1));
+
+    // reading a sparse layer through the const interface keeps it sparse
+    const mitk::LabelSetImage *constImage = m_LabelSetImage;
+    CPPUNIT_ASSERT(nullptr == constImage->GetLayerImage(1));
+    CPPUNIT_ASSERT_EQUAL(PixelType(7), GetPixel(constImage->GetDenseLayerImage(1), 2, 2, 2));
+    CPPUNIT_ASSERT(nullptr != m_LabelSetImage->GetSparseLayer(1));
+
+    // the dense image replaces the sparse storage, also when switching layers
+    mitk::Image::Pointer layerImage = m_LabelSetImage->GetLayerImage(1);
+    CPPUNIT_ASSERT(nullptr == m_LabelSetImage->GetSparseLayer(1));
+    CPPUNIT_ASSERT_EQUAL(PixelType(7), GetPixel(layerImage, 2, 2, 2));
+
+    m_LabelSetImage->SetActiveLayer(1);
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT(layerImage.GetPointer() == m_LabelSetImage->GetLayerImage(1));
+
+    // until it is compacted explicitly
+    m_LabelSetImage->CompactLayers();
+    CPPUNIT_ASSERT(nullptr != m_LabelSetImage->GetSparseLayer(1));
+    CPPUNIT_ASSERT(nullptr == constImage->GetLayerImage(1));
+
+    // a copy shares the sparse layers
+    auto clone = m_LabelSetImage->Clone();
+    CPPUNIT_ASSERT(clone->GetSparseLayer(1) == m_LabelSetImage->GetSparseLayer(1));
+    clone->SetActiveLayer(1);
+    CPPUNIT_ASSERT_EQUAL(PixelType(7), GetPixel(clone, 1, 1, 1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSparseLabelVolume)
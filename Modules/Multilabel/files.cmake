@@ -2,6 +2,7 @@ set(CPP_FILES
   mitkLabel.cpp
   mitkLabelSet.cpp
   mitkLabelSetImage.cpp
+  mitkSparseLabelVolume.cpp
   mitkLabelSetImageConverter.cpp
   mitkLabelSetImageSource.cpp
   mitkLabelSetImageSurfaceStampFilter.cpp
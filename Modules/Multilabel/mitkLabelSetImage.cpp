@@ -27,41 +27,79 @@ found in the LICENSE file.
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 
+#include <itkImageLinearConstIteratorWithIndex.h>
 #include <itkImageRegionIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
 #include <itkQuadEdgeMesh.h>
 #include <itkTriangleMeshToBinaryImageFilter.h>
 //#include <itkRelabelComponentImageFilter.h>
 
 #include <itkCommand.h>
 
+#include <algorithm>
+
 template <typename TPixel, unsigned int VDimensions>
 void SetToZero(itk::Image<TPixel, VDimensions> *source)
 {
   source->FillBuffer(0);
 }
 
+/// spatial region of a label region info extended to all time steps of the image
+template <typename ImageType>
+typename ImageType::RegionType ToImageRegion(const ImageType *itkImage, const itk::ImageRegion<3> &labelRegion)
+{
+  auto region = itkImage->GetLargestPossibleRegion();
+  for (unsigned int dim = 0; dim < std::min(3u, static_cast<unsigned int>(ImageType::ImageDimension)); ++dim)
+  {
+    region.SetIndex(dim, labelRegion.GetIndex(dim));
+    region.SetSize(dim, labelRegion.GetSize(dim));
+  }
+  return region;
+}
+
 template <unsigned int VImageDimension = 3>
-void CreateLabelMaskProcessing(mitk::Image *layerImage, mitk::Image *mask, mitk::LabelSet::PixelType index)
+void CreateLabelMaskProcessing(mitk::Image *layerImage,
+                               mitk::Image *mask,
+                               mitk::LabelSet::PixelType index,
+                               const itk::ImageRegion<3> &region)
 {
   mitk::ImagePixelReadAccessor<mitk::LabelSet::PixelType, VImageDimension> readAccessor(layerImage);
   mitk::ImagePixelWriteAccessor<mitk::LabelSet::PixelType, VImageDimension> writeAccessor(mask);
 
-  std::size_t numberOfPixels = 1;
-  for (int dim = 0; dim < static_cast<int>(VImageDimension); ++dim)
-    numberOfPixels *= static_cast<std::size_t>(readAccessor.GetDimension(dim));
+  const std::size_t dimX = readAccessor.GetDimension(0);
+  const std::size_t dimY = readAccessor.GetDimension(1);
+  const std::size_t dimZ = readAccessor.GetDimension(2);
+  const std::size_t timeSteps = 4 == VImageDimension ? readAccessor.GetDimension(3) : 1;
 
   auto src = readAccessor.GetData();
   auto dest = writeAccessor.GetData();
 
-  for (std::size_t i = 0; i < numberOfPixels; ++i)
+  // only the lines of the region of the label can contain it
+  for (std::size_t t = 0; t < timeSteps; ++t)
   {
-    if (index == *(src + i))
-      *(dest + i) = 1;
+    for (std::size_t z = region.GetIndex(2); z < region.GetIndex(2) + region.GetSize(2); ++z)
+    {
+      for (std::size_t y = region.GetIndex(1); y < region.GetIndex(1) + region.GetSize(1); ++y)
+      {
+        const std::size_t lineStart = ((t * dimZ + z) * dimY + y) * dimX + region.GetIndex(0);
+
+        for (std::size_t i = lineStart; i < lineStart + region.GetSize(0); ++i)
+        {
+          if (index == *(src + i))
+            *(dest + i) = 1;
+        }
+      }
+    }
   }
 }
 
 mitk::LabelSetImage::LabelSetImage()
-  : mitk::Image(), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr)
+  : mitk::Image(),
+    m_SparseLayerStorage(false),
+    m_ActiveLayer(0),
+    m_activeLayerInvalid(false),
+    m_ExteriorLabel(nullptr),
+    m_LabelRegionInfosValid(false)
 {
   // Iniitlaize Background Label
   mitk::Color color;
@@ -79,9 +117,11 @@ mitk::LabelSetImage::LabelSetImage()
 
 mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
   : Image(other),
+    m_SparseLayerStorage(other.m_SparseLayerStorage),
     m_ActiveLayer(other.GetActiveLayer()),
     m_activeLayerInvalid(false),
-    m_ExteriorLabel(other.GetExteriorLabel()->Clone())
+    m_ExteriorLabel(other.GetExteriorLabel()->Clone()),
+    m_LabelRegionInfosValid(false)
 {
   for (unsigned int i = 0; i < other.GetNumberOfLayers(); i++)
   {
@@ -93,9 +133,12 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     lsClone->AddObserver(itk::ModifiedEvent(), command);
     m_LabelSetContainer.push_back(lsClone);
 
-    // clone layer Image data
-    mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
+    // clone layer Image data, sparse layers are immutable and can be shared
+    mitk::Image::Pointer liClone;
+    if (other.m_LayerContainer[i].IsNotNull())
+      liClone = other.m_LayerContainer[i]->Clone();
     m_LayerContainer.push_back(liClone);
+    m_SparseLayerContainer.push_back(other.m_SparseLayerContainer[i]);
   }
 
   // Add some DICOM Tags as properties to segmentation image
@@ -104,7 +147,8 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
 
 void mitk::LabelSetImage::OnLabelSetModified()
 {
-  Superclass::Modified();
+  // changes of the label sets do not touch the voxels
+  this->ModifiedWithLabelRegionInfos(m_LabelRegionInfosValid);
 }
 
 void mitk::LabelSetImage::SetExteriorLabel(mitk::Label *label)
@@ -153,6 +197,9 @@ void mitk::LabelSetImage::Initialize(const mitk::Image *other)
 
   // Add a inital LabelSet ans corresponding image data to the stack
   AddLayer();
+
+  m_LabelRegionInfos.clear();
+  m_LabelRegionInfosValid = true;
 }
 
 mitk::LabelSetImage::~LabelSetImage()
@@ -162,6 +209,14 @@ mitk::LabelSetImage::~LabelSetImage()
 
 mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer)
 {
+  if (m_LayerContainer[layer].IsNull())
+  {
+    // the dense image replaces the sparse storage until the next CompactLayers()
+    m_LayerContainer[layer] = this->CreateLayerImage();
+    m_SparseLayerContainer[layer]->WriteToImage(m_LayerContainer[layer]);
+    m_SparseLayerContainer[layer] = nullptr;
+  }
+
   return m_LayerContainer[layer];
 }
 
@@ -170,6 +225,83 @@ const mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer) const
   return m_LayerContainer[layer];
 }
 
+mitk::Image::ConstPointer mitk::LabelSetImage::GetDenseLayerImage(unsigned int layer) const
+{
+  if (m_LayerContainer[layer].IsNotNull())
+    return m_LayerContainer[layer].GetPointer();
+
+  auto layerImage = this->CreateLayerImage();
+  m_SparseLayerContainer[layer]->WriteToImage(layerImage);
+  return layerImage.GetPointer();
+}
+
+std::shared_ptr<const mitk::SparseLabelVolume> mitk::LabelSetImage::GetSparseLayer(unsigned int layer) const
+{
+  return m_SparseLayerContainer[layer];
+}
+
+void mitk::LabelSetImage::SetSparseLayerStorage(bool sparse)
+{
+  if (sparse == m_SparseLayerStorage)
+    return;
+
+  m_SparseLayerStorage = sparse;
+
+  if (sparse)
+  {
+    this->CompactLayers();
+  }
+  else
+  {
+    for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+      this->GetLayerImage(layer);
+  }
+}
+
+bool mitk::LabelSetImage::GetSparseLayerStorage() const
+{
+  return m_SparseLayerStorage;
+}
+
+void mitk::LabelSetImage::CompactLayers()
+{
+  if (!m_SparseLayerStorage)
+    return;
+
+  for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+  {
+    auto &layerImage = m_LayerContainer[layer];
+
+    if (layerImage.IsNotNull())
+    {
+      m_SparseLayerContainer[layer] = SparseLabelVolume::New(layerImage);
+      layerImage = nullptr;
+    }
+  }
+}
+
+std::size_t mitk::LabelSetImage::GetLayerMemorySize() const
+{
+  auto imageMemorySize = [](const mitk::Image *image) {
+    std::size_t memorySize = image->GetPixelType().GetSize();
+    for (unsigned int dim = 0; dim < image->GetDimension(); ++dim)
+      memorySize *= image->GetDimension(dim);
+    return memorySize;
+  };
+
+  std::size_t memorySize = imageMemorySize(this);
+
+  for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+  {
+    if (m_LayerContainer[layer].IsNotNull())
+      memorySize += imageMemorySize(m_LayerContainer[layer]);
+    else if (nullptr != m_SparseLayerContainer[layer])
+      memorySize += m_SparseLayerContainer[layer]->GetMemorySize();
+  }
+
+  return memorySize;
+}
+
 unsigned int mitk::LabelSetImage::GetActiveLayer() const
 {
   return m_ActiveLayer;
@@ -200,6 +332,7 @@ void mitk::LabelSetImage::RemoveLayer()
   // remove labelset and image data
   m_LabelSetContainer.erase(m_LabelSetContainer.begin() + layerToDelete);
   m_LayerContainer.erase(m_LayerContainer.begin() + layerToDelete);
+  m_SparseLayerContainer.erase(m_SparseLayerContainer.begin() + layerToDelete);
 
   if (layerToDelete == 0)
   {
@@ -209,7 +342,7 @@ void mitk::LabelSetImage::RemoveLayer()
   this->Modified();
 }
 
-unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
+mitk::Image::Pointer mitk::LabelSetImage::CreateLayerImage() const
 {
   mitk::Image::Pointer newImage = mitk::Image::New();
   newImage->Initialize(this->GetPixelType(),
@@ -217,6 +350,20 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
                        this->GetDimensions(),
                        this->GetImageDescriptor()->GetNumberOfChannels());
   newImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+  return newImage;
+}
+
+unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
+{
+  if (m_SparseLayerStorage)
+  {
+    // an empty layer does not need any tiles
+    const SparseLabelVolume::SizeType size = {
+      {this->GetDimension(0), this->GetDimension(1), this->GetDimension(2), this->GetTimeSteps()}};
+    return this->AddLayerStorage(nullptr, SparseLabelVolume::New(size), lset);
+  }
+
+  mitk::Image::Pointer newImage = this->CreateLayerImage();
 
   if (newImage->GetDimension() < 4)
   {
@@ -233,6 +380,13 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 }
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
+{
+  return this->AddLayerStorage(layerImage, nullptr, lset);
+}
+
+unsigned int mitk::LabelSetImage::AddLayerStorage(mitk::Image::Pointer layerImage,
+                                                  std::shared_ptr<const SparseLabelVolume> sparseLayer,
+                                                  mitk::LabelSet::Pointer lset)
 {
   unsigned int newLabelSetId = m_LayerContainer.size();
 
@@ -255,6 +409,7 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk
 
   // push a new working image for the new layer
   m_LayerContainer.push_back(layerImage);
+  m_SparseLayerContainer.push_back(sparseLayer);
 
   // push a new labelset for the new layer
   m_LabelSetContainer.push_back(ls);
@@ -299,47 +454,23 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
   try
   {
-    if (4 == this->GetDimension())
+    if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
     {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
+      BeforeChangeLayerEvent.Send();
 
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (GetActiveLayer()));
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
-
-        AfterChangeLayerEvent.Send();
+      if (m_activeLayerInvalid)
+      {
+        // We should not write the invalid layer back to the vector
+        m_activeLayerInvalid = false;
       }
-    }
-    else
-    {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
+      else
       {
-        BeforeChangeLayerEvent.Send();
-
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessByItk_1(this, ImageToLayerContainerProcessing, GetActiveLayer());
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
-
-        AfterChangeLayerEvent.Send();
+        this->StoreActiveLayer();
       }
+      m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
+      this->LoadActiveLayer();
+
+      AfterChangeLayerEvent.Send();
     }
   }
   catch (itk::ExceptionObject &e)
@@ -349,6 +480,42 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
   this->Modified();
 }
 
+void mitk::LabelSetImage::StoreActiveLayer()
+{
+  const unsigned int layer = this->GetActiveLayer();
+
+  if (m_LayerContainer[layer].IsNull())
+  {
+    m_SparseLayerContainer[layer] = SparseLabelVolume::New(this);
+  }
+  else if (4 == this->GetDimension())
+  {
+    AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (layer));
+  }
+  else
+  {
+    AccessByItk_1(this, ImageToLayerContainerProcessing, layer);
+  }
+}
+
+void mitk::LabelSetImage::LoadActiveLayer()
+{
+  const unsigned int layer = this->GetActiveLayer();
+
+  if (m_LayerContainer[layer].IsNull())
+  {
+    m_SparseLayerContainer[layer]->WriteToImage(this);
+  }
+  else if (4 == this->GetDimension())
+  {
+    AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (layer));
+  }
+  else
+  {
+    AccessByItk_1(this, LayerContainerToImageProcessing, layer);
+  }
+}
+
 void mitk::LabelSetImage::Concatenate(mitk::LabelSetImage *other)
 {
   const unsigned int *otherDims = other->GetDimensions();
@@ -388,6 +555,9 @@ void mitk::LabelSetImage::ClearBuffer()
   {
     AccessByItk(this, ClearBufferProcessing);
     this->Modified();
+
+    m_LabelRegionInfos.clear();
+    m_LabelRegionInfosValid = true;
   }
   catch (itk::ExceptionObject &e)
   {
@@ -416,25 +586,29 @@ bool mitk::LabelSetImage::ExistLabelSet(unsigned int layer) const
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue, unsigned int layer)
 {
+  this->UpdateLabelRegionInfos();
+
   try
   {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
+    this->MergeLabelInActiveLayer(pixelValue, sourcePixelValue);
   }
   catch (itk::ExceptionObject &e)
   {
     mitkThrow() << e.GetDescription();
   }
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
-  Modified();
+  this->ModifiedWithLabelRegionInfos(true);
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer)
 {
+  this->UpdateLabelRegionInfos();
+
   try
   {
     for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
     {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
+      this->MergeLabelInActiveLayer(pixelValue, vectorOfSourcePixelValues[idx]);
     }
   }
   catch (itk::ExceptionObject &e)
@@ -442,7 +616,76 @@ void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelTyp
     mitkThrow() << e.GetDescription();
   }
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
-  Modified();
+  this->ModifiedWithLabelRegionInfos(true);
+}
+
+void mitk::LabelSetImage::MergeLabelInActiveLayer(PixelType pixelValue, PixelType sourcePixelValue)
+{
+  if (pixelValue == sourcePixelValue)
+    return;
+
+  if (0 == sourcePixelValue)
+  {
+    // the exterior is not tracked, so merge it in the whole image and rescan
+    itk::ImageRegion<3> region;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      region.SetSize(dim, this->GetDimension(dim));
+
+    if (4 == this->GetDimension())
+    {
+      AccessFixedDimensionByItk_3(this, MergeLabelProcessing, 4, pixelValue, sourcePixelValue, region);
+    }
+    else
+    {
+      AccessByItk_3(this, MergeLabelProcessing, pixelValue, sourcePixelValue, region);
+    }
+
+    m_LabelRegionInfosValid = false;
+    this->UpdateLabelRegionInfos();
+    return;
+  }
+
+  auto sourceIter = m_LabelRegionInfos.find(sourcePixelValue);
+
+  if (m_LabelRegionInfos.end() == sourceIter)
+    return;
+
+  const LabelRegionInfo sourceInfo = sourceIter->second;
+  m_LabelRegionInfos.erase(sourceIter);
+
+  if (4 == this->GetDimension())
+  {
+    AccessFixedDimensionByItk_3(this, MergeLabelProcessing, 4, pixelValue, sourcePixelValue, sourceInfo.Region);
+  }
+  else
+  {
+    AccessByItk_3(this, MergeLabelProcessing, pixelValue, sourcePixelValue, sourceInfo.Region);
+  }
+
+  if (0 == pixelValue)
+    return;
+
+  auto targetIter = m_LabelRegionInfos.find(pixelValue);
+
+  if (m_LabelRegionInfos.end() == targetIter)
+  {
+    m_LabelRegionInfos[pixelValue] = sourceInfo;
+    return;
+  }
+
+  auto &targetInfo = targetIter->second;
+  targetInfo.NumberOfVoxels += sourceInfo.NumberOfVoxels;
+  targetInfo.IndexSum += sourceInfo.IndexSum;
+
+  itk::ImageRegion<3>::IndexType lower;
+  itk::ImageRegion<3>::IndexType upper;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    lower[dim] = std::min(targetInfo.Region.GetIndex(dim), sourceInfo.Region.GetIndex(dim));
+    upper[dim] = std::max(targetInfo.Region.GetUpperIndex()[dim], sourceInfo.Region.GetUpperIndex()[dim]);
+  }
+  targetInfo.Region.SetIndex(lower);
+  targetInfo.Region.SetUpperIndex(upper);
 }
 
 void mitk::LabelSetImage::RemoveLabels(std::vector<PixelType> &VectorOfLabelPixelValues, unsigned int layer)
@@ -462,24 +705,35 @@ void mitk::LabelSetImage::EraseLabels(std::vector<PixelType> &VectorOfLabelPixel
   }
 }
 
-void mitk::LabelSetImage::EraseLabel(PixelType pixelValue, unsigned int layer)
+void mitk::LabelSetImage::EraseLabel(PixelType pixelValue, unsigned int /*layer*/)
 {
-  try
+  this->UpdateLabelRegionInfos();
+
+  auto infoIter = m_LabelRegionInfos.find(pixelValue);
+
+  if (m_LabelRegionInfos.end() != infoIter)
   {
-    if (4 == this->GetDimension())
+    const auto region = infoIter->second.Region;
+    m_LabelRegionInfos.erase(infoIter);
+
+    try
     {
-      AccessFixedDimensionByItk_2(this, EraseLabelProcessing, 4, pixelValue, layer);
+      if (4 == this->GetDimension())
+      {
+        AccessFixedDimensionByItk_2(this, EraseLabelProcessing, 4, pixelValue, region);
+      }
+      else
+      {
+        AccessByItk_2(this, EraseLabelProcessing, pixelValue, region);
+      }
     }
-    else
+    catch (const itk::ExceptionObject &e)
     {
-      AccessByItk_2(this, EraseLabelProcessing, pixelValue, layer);
+      mitkThrow() << e.GetDescription();
     }
   }
-  catch (const itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
-  Modified();
+
+  this->ModifiedWithLabelRegionInfos(true);
 }
 
 mitk::Label *mitk::LabelSetImage::GetActiveLabel(unsigned int layer)
@@ -550,6 +804,62 @@ void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue, unsigned int
   }
 }
 
+bool mitk::LabelSetImage::GetLabelRegionInfo(PixelType pixelValue, LabelRegionInfo &info) const
+{
+  this->UpdateLabelRegionInfos();
+
+  auto infoIter = m_LabelRegionInfos.find(pixelValue);
+
+  if (m_LabelRegionInfos.end() == infoIter)
+    return false;
+
+  info = infoIter->second;
+  return true;
+}
+
+void mitk::LabelSetImage::InvalidateLabelRegionInfos()
+{
+  m_LabelRegionInfosValid = false;
+}
+
+void mitk::LabelSetImage::Modified() const
+{
+  m_LabelRegionInfosValid = false;
+  Superclass::Modified();
+}
+
+void mitk::LabelSetImage::UpdateLabelRegionInfos() const
+{
+  std::lock_guard<std::mutex> lock(m_LabelRegionInfosMutex);
+
+  if (m_LabelRegionInfosValid || !this->IsInitialized())
+    return;
+
+  try
+  {
+    if (4 == this->GetDimension())
+    {
+      AccessFixedDimensionByItk(this, ScanLabelRegionsProcessing, 4);
+    }
+    else
+    {
+      AccessByItk(this, ScanLabelRegionsProcessing);
+    }
+  }
+  catch (const itk::ExceptionObject &e)
+  {
+    mitkThrow() << e.GetDescription();
+  }
+
+  m_LabelRegionInfosValid = true;
+}
+
+void mitk::LabelSetImage::ModifiedWithLabelRegionInfos(bool infosWereValid)
+{
+  this->Modified();
+  m_LabelRegionInfosValid = infosWereValid;
+}
+
 unsigned int mitk::LabelSetImage::GetNumberOfLabels(unsigned int layer) const
 {
   return m_LabelSetContainer[layer]->GetNumberOfLabels();
@@ -612,13 +922,26 @@ mitk::Image::Pointer mitk::LabelSetImage::CreateLabelMask(PixelType index, bool
     if (!useActiveLayer)
       this->SetActiveLayer(layer);
 
+    LabelRegionInfo info;
+
+    if (!this->GetLabelRegionInfo(index, info))
+    {
+      // empty mask, unless the exterior is requested
+      info.Region = itk::ImageRegion<3>();
+      if (0 == index)
+      {
+        for (unsigned int dim = 0; dim < 3; ++dim)
+          info.Region.SetSize(dim, this->GetDimension(dim));
+      }
+    }
+
     if (4 == this->GetDimension())
     {
-      ::CreateLabelMaskProcessing<4>(this, mask, index);
+      ::CreateLabelMaskProcessing<4>(this, mask, index, info.Region);
     }
     else if (3 == this->GetDimension())
     {
-      ::CreateLabelMaskProcessing(this, mask, index);
+      ::CreateLabelMaskProcessing(this, mask, index, info.Region);
     }
     else
     {
@@ -657,6 +980,7 @@ void mitk::LabelSetImage::InitializeByLabeledImage(mitk::Image::Pointer image)
     mitk::ImageWriteAccessor *accessor = new mitk::ImageWriteAccessor(static_cast<mitk::Image *>(this));
     memset(accessor->GetData(), 0, byteSize);
     delete accessor;
+    this->InvalidateLabelRegionInfos();
 
     auto geometry = image->GetTimeGeometry()->Clone();
     this->SetTimeGeometry(geometry);
@@ -736,7 +1060,9 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
   mitk::CastToItkImage(mask, itkMask);
 
   typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> TargetIteratorType;
+
+  const bool infosWereValid = m_LabelRegionInfosValid;
 
   SourceIteratorType sourceIter(itkMask, itkMask->GetLargestPossibleRegion());
   sourceIter.GoToBegin();
@@ -746,6 +1072,15 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
 
   int activeLabel = this->GetActiveLabel(GetActiveLayer())->GetValue();
 
+  // the region of the active label is extended by the stamped voxels, the regions of overwritten labels are kept
+  LabelRegionInfo stampedInfo;
+  stampedInfo.NumberOfVoxels = 0;
+  stampedInfo.IndexSum.Fill(0.0);
+  itk::ImageRegion<3>::IndexType lower;
+  itk::ImageRegion<3>::IndexType upper;
+  lower.Fill(itk::NumericTraits<itk::IndexValueType>::max());
+  upper.Fill(itk::NumericTraits<itk::IndexValueType>::NonpositiveMin());
+
   while (!sourceIter.IsAtEnd())
   {
     PixelType sourceValue = sourceIter.Get();
@@ -755,49 +1090,105 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
         (forceOverwrite || !this->GetLabel(targetValue)->GetLocked())) // skip exterior and locked labels
     {
       targetIter.Set(activeLabel);
+
+      if (infosWereValid && targetValue != activeLabel)
+      {
+        itk::ImageRegion<3>::IndexType index;
+        for (unsigned int dim = 0; dim < 3; ++dim)
+          index[dim] = dim < ImageType::ImageDimension ? targetIter.GetIndex()[dim] : 0;
+
+        if (0 != targetValue)
+        {
+          auto &overwrittenInfo = m_LabelRegionInfos[targetValue];
+          --overwrittenInfo.NumberOfVoxels;
+          for (unsigned int dim = 0; dim < 3; ++dim)
+            overwrittenInfo.IndexSum[dim] -= index[dim];
+        }
+
+        ++stampedInfo.NumberOfVoxels;
+        for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+          stampedInfo.IndexSum[dim] += index[dim];
+          lower[dim] = std::min(lower[dim], index[dim]);
+          upper[dim] = std::max(upper[dim], index[dim]);
+        }
+      }
     }
     ++sourceIter;
     ++targetIter;
   }
 
-  this->Modified();
-}
+  if (infosWereValid)
+  {
+    for (auto infoIter = m_LabelRegionInfos.begin(); infoIter != m_LabelRegionInfos.end();)
+    {
+      if (0 == infoIter->second.NumberOfVoxels)
+        infoIter = m_LabelRegionInfos.erase(infoIter);
+      else
+        ++infoIter;
+    }
 
-template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int layer)
-{
-  // for now, we just retrieve the voxel in the middle
-  typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
+    if (0 != activeLabel && 0 != stampedInfo.NumberOfVoxels)
+    {
+      auto activeIter = m_LabelRegionInfos.find(activeLabel);
 
-  std::vector<typename ImageType::IndexType> indexVector;
+      if (m_LabelRegionInfos.end() != activeIter)
+      {
+        auto &activeInfo = activeIter->second;
+        activeInfo.NumberOfVoxels += stampedInfo.NumberOfVoxels;
+        activeInfo.IndexSum += stampedInfo.IndexSum;
+        for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+          lower[dim] = std::min(lower[dim], activeInfo.Region.GetIndex(dim));
+          upper[dim] = std::max(upper[dim], activeInfo.Region.GetUpperIndex()[dim]);
+        }
+      }
 
-  while (!iter.IsAtEnd())
-  {
-    // TODO fix comparison warning more effective
-    if (iter.Get() == pixelValue)
-    {
-      indexVector.push_back(iter.GetIndex());
+      auto &activeInfo = m_LabelRegionInfos[activeLabel];
+      if (m_LabelRegionInfos.end() == activeIter)
+        activeInfo = stampedInfo;
+      activeInfo.Region.SetIndex(lower);
+      activeInfo.Region.SetUpperIndex(upper);
     }
-    ++iter;
   }
 
+  this->ModifiedWithLabelRegionInfos(infosWereValid);
+}
+
+template <typename ImageType>
+void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int layer)
+{
   mitk::Point3D pos;
   pos.Fill(0.0);
 
-  if (!indexVector.empty())
+  LabelRegionInfo info;
+
+  if (this->GetLabelRegionInfo(pixelValue, info))
   {
-    typename itk::ImageRegionConstIteratorWithIndex<ImageType>::IndexType centerIndex;
-    centerIndex = indexVector.at(indexVector.size() / 2);
-    if (centerIndex.GetIndexDimension() == 3)
+    if (ImageType::ImageDimension != 3)
+      return;
+
+    // for now, we just retrieve the voxel in the middle. The order of the voxels within the region of the label
+    // equals their order in the whole image, and the number of voxels is known, so the scan stops at the middle.
+    typedef itk::ImageRegionConstIteratorWithIndex<ImageType> IteratorType;
+    IteratorType iter(itkImage, ToImageRegion(itkImage, info.Region));
+    iter.GoToBegin();
+
+    std::size_t count = 0;
+    const std::size_t centerCount = info.NumberOfVoxels / 2;
+
+    while (!iter.IsAtEnd())
     {
-      pos[0] = centerIndex[0];
-      pos[1] = centerIndex[1];
-      pos[2] = centerIndex[2];
+      if (iter.Get() == pixelValue && centerCount == count++)
+      {
+        const auto &centerIndex = iter.GetIndex();
+        pos[0] = centerIndex[0];
+        pos[1] = centerIndex[1];
+        pos[2] = centerIndex[2];
+        break;
+      }
+      ++iter;
     }
-    else
-      return;
   }
 
   GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
@@ -893,11 +1284,13 @@ void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VIm
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int /*layer*/)
+void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage,
+                                               PixelType pixelValue,
+                                               const itk::ImageRegion<3> &region)
 {
   typedef itk::ImageRegionIterator<ImageType> IteratorType;
 
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
+  IteratorType iter(itkImage, ToImageRegion(itkImage, region));
   iter.GoToBegin();
 
   while (!iter.IsAtEnd())
@@ -913,11 +1306,14 @@ void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pi
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
+void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage,
+                                               PixelType pixelValue,
+                                               PixelType index,
+                                               const itk::ImageRegion<3> &region)
 {
   typedef itk::ImageRegionIterator<ImageType> IteratorType;
 
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
+  IteratorType iter(itkImage, ToImageRegion(itkImage, region));
   iter.GoToBegin();
 
   while (!iter.IsAtEnd())
@@ -930,6 +1326,85 @@ void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pi
   }
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::LabelSetImage::ScanLabelRegionsProcessing(const itk::Image<TPixel, VImageDimension> *input) const
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  typedef itk::ImageRegion<3>::IndexType IndexType;
+
+  struct Bounds
+  {
+    IndexType Lower;
+    IndexType Upper;
+  };
+
+  LabelRegionInfoMapType infos;
+  std::map<PixelType, Bounds> bounds;
+
+  // scan line by line, so the bounds in y, z and the sums are updated once per run of equal labels
+  itk::ImageLinearConstIteratorWithIndex<ImageType> iter(input, input->GetLargestPossibleRegion());
+  iter.SetDirection(0);
+
+  for (iter.GoToBegin(); !iter.IsAtEnd(); iter.NextLine())
+  {
+    while (!iter.IsAtEndOfLine())
+    {
+      const PixelType value = static_cast<PixelType>(iter.Get());
+
+      if (0 == value)
+      {
+        ++iter;
+        continue;
+      }
+
+      IndexType index;
+      for (unsigned int dim = 0; dim < 3; ++dim)
+        index[dim] = dim < VImageDimension ? iter.GetIndex()[dim] : 0;
+
+      std::size_t runLength = 0;
+      while (!iter.IsAtEndOfLine() && value == static_cast<PixelType>(iter.Get()))
+      {
+        ++runLength;
+        ++iter;
+      }
+
+      auto infoIter = infos.find(value);
+      if (infos.end() == infoIter)
+      {
+        infoIter = infos.insert(std::make_pair(value, LabelRegionInfo())).first;
+        infoIter->second.NumberOfVoxels = 0;
+        infoIter->second.IndexSum.Fill(0.0);
+        bounds[value] = {index, index};
+      }
+
+      auto &info = infoIter->second;
+      auto &labelBounds = bounds[value];
+
+      IndexType last = index;
+      last[0] += static_cast<itk::IndexValueType>(runLength) - 1;
+
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        labelBounds.Lower[dim] = std::min(labelBounds.Lower[dim], index[dim]);
+        labelBounds.Upper[dim] = std::max(labelBounds.Upper[dim], last[dim]);
+      }
+
+      info.NumberOfVoxels += runLength;
+      info.IndexSum[0] += runLength * static_cast<double>(index[0] + last[0]) / 2.0;
+      info.IndexSum[1] += static_cast<double>(runLength) * index[1];
+      info.IndexSum[2] += static_cast<double>(runLength) * index[2];
+    }
+  }
+
+  for (auto &info : infos)
+  {
+    info.second.Region.SetIndex(bounds[info.first].Lower);
+    info.second.Region.SetUpperIndex(bounds[info.first].Upper);
+  }
+
+  m_LabelRegionInfos.swap(infos);
+}
+
 bool mitk::Equal(const mitk::LabelSetImage &leftHandSide,
                  const mitk::LabelSetImage &rightHandSide,
                  ScalarType eps,
@@ -989,8 +1464,8 @@ bool mitk::Equal(const mitk::LabelSetImage &leftHandSide,
     else
     {
       // layer image data
-      returnValue =
-        mitk::Equal(*leftHandSide.GetLayerImage(layerIndex), *rightHandSide.GetLayerImage(layerIndex), eps, verbose);
+      returnValue = mitk::Equal(
+        *leftHandSide.GetDenseLayerImage(layerIndex), *rightHandSide.GetDenseLayerImage(layerIndex), eps, verbose);
       if (!returnValue)
       {
         MITK_INFO(verbose) << "Layer image data not equal.";
@@ -15,9 +15,16 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 #include <mitkLabelSet.h>
+#include <mitkSparseLabelVolume.h>
 
 #include <MitkMultilabelExports.h>
 
+#include <itkImageRegion.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
   //##Documentation
@@ -34,6 +41,33 @@ namespace mitk
 
       typedef mitk::Label::PixelType PixelType;
 
+    /**
+    * \brief Number of voxels, bounding region and centroid of a label in the active layer.
+    *
+    * For 4D images the region and the centroid refer to the spatial dimensions and cover all time steps.
+    */
+    struct LabelRegionInfo
+    {
+      /** Number of voxels of the label */
+      std::size_t NumberOfVoxels;
+
+      /** Region containing all voxels of the label. This is the bounding box of the label, unless voxels of
+       * the label have been overwritten by MaskStamp() since the image was scanned. Then it may be larger. */
+      itk::ImageRegion<3> Region;
+
+      /** Sum of the indices of all voxels of the label */
+      Vector3D IndexSum;
+
+      /** Mean index of all voxels of the label */
+      Point3D GetCentroidIndex() const
+      {
+        Point3D centroid;
+        for (unsigned int i = 0; i < 3; ++i)
+          centroid[i] = 0 != NumberOfVoxels ? IndexSum[i] / NumberOfVoxels : 0.0;
+        return centroid;
+      }
+    };
+
     /**
     * \brief BeforeChangeLayerEvent (e.g. used for GUI integration)
     * As soon as active labelset should be changed, the signal emits.
@@ -83,9 +117,36 @@ namespace mitk
     void MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer = 0);
 
     /**
-      * \brief  */
+      * \brief Sets the center of mass of the label to the voxel in the middle of its voxels (in memory order).
+      *
+      * Only the region of the label is processed, see GetLabelRegionInfo(). */
     void UpdateCenterOfMass(PixelType pixelValue, unsigned int layer = 0);
 
+    /**
+     * @brief Gets the number of voxels, the bounding region and the centroid of a label in the active layer.
+     *
+     * The information of all labels is determined in a single pass over the image, when it is requested for the
+     * first time after it was invalidated by Modified() or InvalidateLabelRegionInfos(). EraseLabel(), MergeLabel(),
+     * MergeLabels(), MaskStamp() and ClearBuffer() update it along with their changes of the image. Thus these methods,
+     * CreateLabelMask() and UpdateCenterOfMass() only process the region of the label in question.
+     *
+     * @param pixelValue the value of the label
+     * @param info the information of the label, unchanged if the label has no voxels
+     * @return false if the label has no voxels in the active layer or is the exterior label (0)
+     */
+    bool GetLabelRegionInfo(PixelType pixelValue, LabelRegionInfo &info) const;
+
+    /**
+     * @brief Marks the information of GetLabelRegionInfo() as outdated, so the next request scans the image again.
+     *
+     * Modified() does this as well. Code that writes voxels of the active layer must call one of them before the
+     * next call of EraseLabel(), MergeLabel() or GetLabelRegionInfo(), otherwise these methods miss the new voxels.
+     */
+    void InvalidateLabelRegionInfos();
+
+    /** Also invalidates the information of GetLabelRegionInfo(). */
+    void Modified() const override;
+
     /**
      * @brief Removes labels from the mitk::LabelSet of given layer.
      *        Calls mitk::LabelSetImage::EraseLabels() which also removes the labels from within the image.
@@ -244,11 +305,55 @@ namespace mitk
     void RemoveLayer();
 
     /**
-      * \brief  */
+      * \brief Image of a layer. In sparse mode a dense image of the layer is created on demand.
+      *
+      * The dense image replaces the sparse storage of the layer until the next CompactLayers().
+      * The image of the active layer is a copy from the time the layer was activated, the labels of the active
+      * layer are in the LabelSetImage itself. */
     mitk::Image *GetLayerImage(unsigned int layer);
 
+    /**
+      * \brief Image of a layer, nullptr if the layer is stored sparsely (see GetSparseLayer() and
+      * GetDenseLayerImage()). */
     const mitk::Image *GetLayerImage(unsigned int layer) const;
 
+    /**
+      * \brief Image of a layer, or a dense copy of a sparsely stored layer. The storage of the layer is unchanged.
+      */
+    mitk::Image::ConstPointer GetDenseLayerImage(unsigned int layer) const;
+
+    /**
+     * @brief Sparse storage of a layer, nullptr if the layer is stored as a dense image (see GetLayerImage()).
+     *
+     * Allows reading the labels of a layer without creating a dense image.
+     */
+    std::shared_ptr<const SparseLabelVolume> GetSparseLayer(unsigned int layer) const;
+
+    /**
+     * @brief Stores the layers in tiles that are only allocated where labels exist (see SparseLabelVolume).
+     *
+     * The labels of the active layer stay in the (dense) LabelSetImage itself. A layer that is deactivated is
+     * stored sparsely, unless a dense image of it was created by GetLayerImage(). Such images are only converted
+     * by CompactLayers(). Disabling the sparse storage creates dense images of all layers.
+     */
+    void SetSparseLayerStorage(bool sparse);
+
+    bool GetSparseLayerStorage() const;
+
+    /**
+     * @brief Converts the dense images of the layers into sparse storage.
+     *
+     * Images returned by GetLayerImage() before are no longer the storage of their layers, so call this when
+     * nobody writes to or renders them anymore. Enabling the sparse storage calls it, too. Does nothing unless
+     * the sparse storage is enabled.
+     */
+    void CompactLayers();
+
+    /**
+     * @brief Number of bytes of the label data of all layers, including the LabelSetImage itself.
+     */
+    std::size_t GetLayerMemorySize() const;
+
     void OnLabelSetModified();
 
     /**
@@ -281,6 +386,20 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
 
+    /// adds the storage of a new layer, either a dense image or a sparse volume, and activates it
+    unsigned int AddLayerStorage(mitk::Image::Pointer layerImage,
+                                 std::shared_ptr<const SparseLabelVolume> sparseLayer,
+                                 mitk::LabelSet::Pointer lset);
+
+    /// creates an empty dense image with the layout of the LabelSetImage
+    mitk::Image::Pointer CreateLayerImage() const;
+
+    /// copies the labels of the LabelSetImage into the storage of the active layer
+    void StoreActiveLayer();
+
+    /// copies the labels of the active layer from its storage into the LabelSetImage
+    void LoadActiveLayer();
+
     template <typename ImageType>
     void CalculateCenterOfMassProcessing(ImageType *input, PixelType index, unsigned int layer);
 
@@ -288,13 +407,26 @@ namespace mitk
     void ClearBufferProcessing(ImageType *input);
 
     template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index, unsigned int layer);
+    void EraseLabelProcessing(ImageType *input, PixelType index, const itk::ImageRegion<3> &region);
 
     //  template < typename ImageType >
     //  void ReorderLabelProcessing( ImageType* input, int index, int layer);
 
     template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
+    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index, const itk::ImageRegion<3> &region);
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void ScanLabelRegionsProcessing(const itk::Image<TPixel, VImageDimension> *input) const;
+
+    /// merges a label into another one in the active layer
+    void MergeLabelInActiveLayer(PixelType pixelValue, PixelType sourcePixelValue);
+
+    /// scans the active layer for the regions of all labels, unless m_LabelRegionInfos are valid
+    void UpdateLabelRegionInfos() const;
+
+    /// calls Modified() after a change of the image that was applied to m_LabelRegionInfos as well,
+    /// the infos stay valid if they were valid before the change
+    void ModifiedWithLabelRegionInfos(bool infosWereValid);
 
     template <typename ImageType>
     void ConcatenateProcessing(ImageType *input, mitk::LabelSetImage *other);
@@ -306,13 +438,30 @@ namespace mitk
     void InitializeByLabeledImageProcessing(LabelSetImageType *input, ImageType *other);
 
     std::vector<LabelSet::Pointer> m_LabelSetContainer;
+    /// dense images of the layers, nullptr for layers in m_SparseLayerContainer
     std::vector<Image::Pointer> m_LayerContainer;
 
+    /// sparse storage of the layers, nullptr for layers in m_LayerContainer
+    std::vector<std::shared_ptr<const SparseLabelVolume>> m_SparseLayerContainer;
+
+    bool m_SparseLayerStorage;
+
     int m_ActiveLayer;
 
     bool m_activeLayerInvalid;
 
     mitk::Label::Pointer m_ExteriorLabel;
+
+    typedef std::map<PixelType, LabelRegionInfo> LabelRegionInfoMapType;
+
+    /// regions of the labels (except the exterior label) in the active layer
+    mutable LabelRegionInfoMapType m_LabelRegionInfos;
+
+    /// true if m_LabelRegionInfos match the content of the active layer, cleared by Modified()
+    mutable bool m_LabelRegionInfosValid;
+
+    /// serializes the scan of m_LabelRegionInfos by concurrent const getters
+    mutable std::mutex m_LabelRegionInfosMutex;
   };
 
   /**
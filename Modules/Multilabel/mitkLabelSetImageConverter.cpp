@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include <itkImageDuplicator.h>
 #include <itkVectorIndexSelectionCastImageFilter.h>
 
+#include <vector>
+
 template <typename TPixel, unsigned int VDimension>
 static void ConvertLabelSetImageToImage(const itk::Image<TPixel, VDimension> *,
                                         mitk::LabelSetImage::ConstPointer labelSetImage,
@@ -36,10 +38,14 @@ static void ConvertLabelSetImageToImage(const itk::Image<TPixel, VDimension> *,
     auto vectorImageComposer = ComposeFilterType::New();
     auto activeLayer = labelSetImage->GetActiveLayer();
 
+    // dense copies of sparse layers have to live until the composer is updated
+    std::vector<mitk::Image::ConstPointer> layerImages;
+
     for (decltype(numberOfLayers) layer = 0; layer < numberOfLayers; ++layer)
     {
-      auto layerImage = mitk::ImageToItkImage<TPixel, VDimension>(
-        layer != activeLayer ? labelSetImage->GetLayerImage(layer) : labelSetImage);
+      layerImages.push_back(layer != activeLayer ? labelSetImage->GetDenseLayerImage(layer)
+                                                 : mitk::Image::ConstPointer(labelSetImage.GetPointer()));
+      auto layerImage = mitk::ImageToItkImage<TPixel, VDimension>(layerImages.back());
 
       vectorImageComposer->SetInput(layer, layerImage);
     }
@@ -75,7 +81,7 @@ mitk::Image::Pointer mitk::ConvertLabelSetImageToImage(LabelSetImage::ConstPoint
     }
     else
     {
-      AccessByItk_2(labelSetImage->GetLayerImage(0), ::ConvertLabelSetImageToImage, labelSetImage, image);
+      AccessByItk_2(labelSetImage, ::ConvertLabelSetImageToImage, labelSetImage, image);
     }
 
     image->SetTimeGeometry(labelSetImage->GetTimeGeometry()->Clone());
@@ -13,29 +13,36 @@ found in the LICENSE file.
 #include <mitkLabelSetImageToSurfaceFilter.h>
 
 #include <mitkImageAccessByItk.h>
-#include <mitkImageCast.h>
+#include <mitkParallelFor.h>
 
 // itk
 #include <itkAntiAliasBinaryImageFilter.h>
-#include <itkAutoCropLabelMapFilter.h>
-#include <itkBinaryThresholdImageFilter.h>
-#include <itkLabelImageToLabelMapFilter.h>
-#include <itkLabelMap.h>
-#include <itkLabelMapToLabelImageFilter.h>
-#include <itkLabelObject.h>
+#include <itkImageLinearConstIteratorWithIndex.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
 #include <itkNumericTraits.h>
 #include <itkSmoothingRecursiveGaussianImageFilter.h>
 
 // vtk
 #include <vtkCleanPolyData.h>
-#include <vtkImageChangeInformation.h>
+#include <vtkDecimatePro.h>
+#include <vtkFloatArray.h>
 #include <vtkImageData.h>
-#include <vtkLinearTransform.h>
 #include <vtkMarchingCubes.h>
+#include <vtkPointData.h>
+#include <vtkQuadricDecimation.h>
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
+
 mitk::LabelSetImageToSurfaceFilter::LabelSetImageToSurfaceFilter()
-  : m_GenerateAllLabels(false), m_RequestedLabel(1), m_BackgroundLabel(0), m_UseSmoothing(0), m_Sigma(0.1)
+  : m_GenerateAllLabels(false),
+    m_RequestedLabel(1),
+    m_BackgroundLabel(0),
+    m_UseSmoothing(0),
+    m_Sigma(0.1),
+    m_Decimate(ImageToSurfaceFilter::NoDecimation),
+    m_TargetReduction(0.5f)
 {
 }
 
@@ -64,6 +71,17 @@ const mitk::Image *mitk::LabelSetImageToSurfaceFilter::GetInput(void)
   return static_cast<const mitk::Image *>(this->ProcessObject::GetInput(0));
 }
 
+mitk::LabelSetImageToSurfaceFilter::LabelType mitk::LabelSetImageToSurfaceFilter::GetLabelForNthOutput(
+  const unsigned int &i)
+{
+  auto iter = m_IndexToLabels.find(i);
+
+  if (iter == m_IndexToLabels.end())
+    return itk::NumericTraits<LabelType>::max();
+
+  return iter->second;
+}
+
 void mitk::LabelSetImageToSurfaceFilter::GenerateOutputInformation()
 {
   itkDebugMacro(<< "GenerateOutputInformation()");
@@ -75,6 +93,34 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   if (inputImage.IsNull())
     return;
 
+  // the labels present in the image are only known after a full scan, which is part of the update
+  AccessFixedDimensionByItk(inputImage, ScanLabels, 3);
+
+  m_IndexToLabels.clear();
+
+  if (m_GenerateAllLabels)
+  {
+    unsigned int index = 0;
+
+    for (const auto &labelRegion : m_LabelRegions)
+      m_IndexToLabels[index++] = labelRegion.first;
+  }
+  else
+  {
+    m_IndexToLabels[0] = static_cast<LabelType>(m_RequestedLabel);
+  }
+
+  // one output per label, but at least one
+  const auto numberOfOutputs = static_cast<unsigned int>(std::max<std::size_t>(1, m_IndexToLabels.size()));
+
+  this->SetNumberOfIndexedOutputs(numberOfOutputs);
+
+  for (unsigned int i = 0; i < numberOfOutputs; ++i)
+  {
+    if (!this->GetOutput(i))
+      this->SetNthOutput(i, this->MakeOutput(i).GetPointer());
+  }
+
   mitk::Surface *outputSurface = this->GetOutput();
   if (!outputSurface)
     return;
@@ -82,58 +128,152 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
 }
 
+template <typename TPixel, unsigned int VDimension>
+void mitk::LabelSetImageToSurfaceFilter::ScanLabels(const itk::Image<TPixel, VDimension> *input)
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef typename ImageType::IndexType IndexType;
+  typedef std::map<LabelType, std::pair<IndexType, IndexType>> BoundsMapType;
+
+  m_AvailableLabels.clear();
+  m_LabelRegions.clear();
+
+  BoundsMapType bounds;
+  auto currentBounds = bounds.end();
+  auto currentCount = m_AvailableLabels.end();
+
+  itk::ImageLinearConstIteratorWithIndex<ImageType> iter(input, input->GetLargestPossibleRegion());
+  iter.SetDirection(0);
+
+  for (iter.GoToBegin(); !iter.IsAtEnd(); iter.NextLine())
+  {
+    IndexType index = iter.GetIndex();
+
+    for (; !iter.IsAtEndOfLine(); ++iter, ++index[0])
+    {
+      const TPixel value = iter.Get();
+
+      if (static_cast<int>(value) == m_BackgroundLabel)
+        continue;
+
+      const auto label = static_cast<LabelType>(value);
+
+      // neighboring voxels mostly belong to the same label
+      if (currentBounds == bounds.end() || currentBounds->first != label)
+      {
+        currentBounds = bounds.insert(std::make_pair(label, std::make_pair(index, index))).first;
+        currentCount = m_AvailableLabels.insert(std::make_pair(label, 0)).first;
+      }
+
+      auto &minIndex = currentBounds->second.first;
+      auto &maxIndex = currentBounds->second.second;
+
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        minIndex[dim] = std::min(minIndex[dim], index[dim]);
+        maxIndex[dim] = std::max(maxIndex[dim], index[dim]);
+      }
+
+      ++currentCount->second;
+    }
+  }
+
+  for (const auto &labelBounds : bounds)
+  {
+    RegionType region;
+
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      region.SetIndex(dim, labelBounds.second.first[dim]);
+      region.SetSize(dim, labelBounds.second.second[dim] - labelBounds.second.first[dim] + 1);
+    }
+
+    m_LabelRegions[labelBounds.first] = region;
+  }
+}
+
 template <typename TPixel, unsigned int VDimension>
 void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPixel, VDimension> *input,
                                                             mitk::Surface * /*surface*/)
 {
-  typedef itk::Image<TPixel, VDimension> ImageType;
+  const BaseGeometry *geometry = this->GetInput()->GetGeometry();
+
+  if (!m_GenerateAllLabels)
+  {
+    vtkSmartPointer<vtkPolyData> polydata;
+
+    auto iter = m_LabelRegions.find(static_cast<LabelType>(m_RequestedLabel));
+    if (iter != m_LabelRegions.end())
+      polydata = this->ExtractLabelSurface(input, iter->first, iter->second, geometry, 0);
+
+    if ((!polydata) || (!polydata->GetNumberOfPoints()))
+      throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+
+    this->GetOutput(0)->SetVtkPolyData(polydata, 0);
+    return;
+  }
 
-  typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
-  typedef itk::LabelObject<TPixel, VDimension> LabelObjectType;
-  typedef itk::LabelMap<LabelObjectType> LabelMapType;
-  typedef itk::LabelImageToLabelMapFilter<ImageType, LabelMapType> Image2LabelMapType;
-  typedef itk::AutoCropLabelMapFilter<LabelMapType> AutoCropType;
-  typedef itk::LabelMapToLabelImageFilter<LabelMapType, ImageType> LabelMap2ImageType;
+  if (m_IndexToLabels.empty())
+  {
+    this->GetOutput(0)->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New(), 0);
+    return;
+  }
+
+  std::vector<vtkSmartPointer<vtkPolyData>> polydatas(m_IndexToLabels.size());
+
+  // the labels are processed in parallel, so each label is processed in a single thread
+  const unsigned int numberOfThreadsPerLabel = polydatas.size() > 1 ? 1 : 0;
 
+  mitk::ParallelFor(polydatas.size(), [&](std::size_t i) {
+    const auto label = m_IndexToLabels.at(static_cast<unsigned int>(i));
+    polydatas[i] =
+      this->ExtractLabelSurface(input, label, m_LabelRegions.at(label), geometry, numberOfThreadsPerLabel);
+  });
+
+  for (std::size_t i = 0; i < polydatas.size(); ++i)
+    this->GetOutput(i)->SetVtkPolyData(polydatas[i], 0);
+}
+
+template <typename TPixel, unsigned int VDimension>
+vtkSmartPointer<vtkPolyData> mitk::LabelSetImageToSurfaceFilter::ExtractLabelSurface(
+  const itk::Image<TPixel, VDimension> *input,
+  LabelType label,
+  const RegionType &labelRegion,
+  const BaseGeometry *geometry,
+  unsigned int numberOfThreads) const
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
   typedef itk::Image<float, VDimension> RealImageType;
 
   typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
   typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
 
-  typename BinaryThresholdFilterType::Pointer thresholdFilter = BinaryThresholdFilterType::New();
-  thresholdFilter->SetInput(input);
-  thresholdFilter->SetLowerThreshold(m_RequestedLabel);
-  thresholdFilter->SetUpperThreshold(m_RequestedLabel);
-  thresholdFilter->SetOutsideValue(0);
-  thresholdFilter->SetInsideValue(1);
-  //  thresholdFilter->ReleaseDataFlagOn();
-  thresholdFilter->Update();
-
-  typename Image2LabelMapType::Pointer image2label = Image2LabelMapType::New();
-  image2label->SetInput(thresholdFilter->GetOutput());
-
-  typename AutoCropType::SizeType border;
-  border[0] = 3;
-  border[1] = 3;
-  border[2] = 3;
+  // the bounding box of the label with a border of 3 voxels
+  typename ImageType::RegionType cropRegion = labelRegion;
+  cropRegion.PadByRadius(3);
+  cropRegion.Crop(input->GetLargestPossibleRegion());
 
-  typename AutoCropType::Pointer autoCropFilter = AutoCropType::New();
-  autoCropFilter->SetInput(image2label->GetOutput());
-  autoCropFilter->SetCropBorder(border);
-  autoCropFilter->InPlaceOn();
+  typename ImageType::Pointer binaryImage = ImageType::New();
+  binaryImage->CopyInformation(input);
+  binaryImage->SetRegions(cropRegion);
+  binaryImage->Allocate();
 
-  typename LabelMap2ImageType::Pointer label2image = LabelMap2ImageType::New();
-  label2image->SetInput(autoCropFilter->GetOutput());
+  itk::ImageRegionConstIterator<ImageType> inputIter(input, cropRegion);
+  itk::ImageRegionIterator<ImageType> binaryIter(binaryImage, cropRegion);
 
-  label2image->Update();
+  for (; !inputIter.IsAtEnd(); ++inputIter, ++binaryIter)
+    binaryIter.Set(static_cast<LabelType>(inputIter.Get()) == label ? 1 : 0);
 
   typename AntiAliasFilterType::Pointer antiAliasFilter = AntiAliasFilterType::New();
-  antiAliasFilter->SetInput(label2image->GetOutput());
+  antiAliasFilter->SetInput(binaryImage);
   antiAliasFilter->SetMaximumRMSError(0.001);
   antiAliasFilter->SetNumberOfLayers(3);
   antiAliasFilter->SetUseImageSpacing(false);
   antiAliasFilter->SetNumberOfIterations(40);
 
+  if (0 != numberOfThreads)
+    antiAliasFilter->SetNumberOfThreads(numberOfThreads);
+
   antiAliasFilter->Update();
 
   typename RealImageType::Pointer result;
@@ -143,6 +283,10 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
     typename GaussianFilterType::Pointer gaussianFilter = GaussianFilterType::New();
     gaussianFilter->SetSigma(m_Sigma);
     gaussianFilter->SetInput(antiAliasFilter->GetOutput());
+
+    if (0 != numberOfThreads)
+      gaussianFilter->SetNumberOfThreads(numberOfThreads);
+
     gaussianFilter->Update();
     result = gaussianFilter->GetOutput();
   }
@@ -153,32 +297,25 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
 
   result->DisconnectPipeline();
 
-  typename ImageType::RegionType cropRegion;
-  cropRegion = autoCropFilter->GetOutput()->GetLargestPossibleRegion();
-
-  const typename ImageType::IndexType &cropIndex = cropRegion.GetIndex();
-
-  m_ResultImage = mitk::Image::New();
-  mitk::CastToMitkImage(result, m_ResultImage);
+  // marching cubes on the cropped region, with the spacing of the image but without its origin and direction
+  const auto &cropSize = cropRegion.GetSize();
+  const auto &spacing = input->GetSpacing();
 
-  mitk::BaseGeometry *newGeometry = m_ResultImage->GetSlicedGeometry();
-  mitk::Point3D origin;
-  vtk2itk(cropIndex, origin);
-  this->GetInput()->GetGeometry()->IndexToWorld(origin, origin);
-  newGeometry->SetOrigin(origin);
+  vtkSmartPointer<vtkFloatArray> scalars = vtkSmartPointer<vtkFloatArray>::New();
+  scalars->SetArray(result->GetBufferPointer(), cropRegion.GetNumberOfPixels(), 1);
 
-  auto *vtkimage = m_ResultImage->GetVtkImageData(0);
-
-  vtkSmartPointer<vtkImageChangeInformation> indexCoordinatesImageFilter =
-    vtkSmartPointer<vtkImageChangeInformation>::New();
-  indexCoordinatesImageFilter->SetInputData(vtkimage);
-  indexCoordinatesImageFilter->SetOutputOrigin(0.0, 0.0, 0.0);
+  vtkSmartPointer<vtkImageData> vtkimage = vtkSmartPointer<vtkImageData>::New();
+  vtkimage->SetDimensions(
+    static_cast<int>(cropSize[0]), static_cast<int>(cropSize[1]), static_cast<int>(cropSize[2]));
+  vtkimage->SetSpacing(spacing[0], spacing[1], spacing[2]);
+  vtkimage->SetOrigin(0.0, 0.0, 0.0);
+  vtkimage->GetPointData()->SetScalars(scalars);
 
   vtkSmartPointer<vtkMarchingCubes> marching = vtkSmartPointer<vtkMarchingCubes>::New();
   marching->ComputeScalarsOff();
   marching->ComputeNormalsOn();
   marching->ComputeGradientsOn();
-  marching->SetInputConnection(indexCoordinatesImageFilter->GetOutputPort());
+  marching->SetInputData(vtkimage);
   marching->SetValue(0, 0.0);
 
   marching->Update();
@@ -186,29 +323,27 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   vtkPolyData *polydata = marching->GetOutput();
 
   if ((!polydata) || (!polydata->GetNumberOfPoints()))
-    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+    return vtkSmartPointer<vtkPolyData>::New();
 
-  mitk::Vector3D spacing = newGeometry->GetSpacing();
+  // transform the points into world coordinates
+  const auto &cropIndex = cropRegion.GetIndex();
 
   vtkPoints *points = polydata->GetPoints();
-  vtkMatrix4x4 *vtkmatrix = vtkMatrix4x4::New();
-  newGeometry->GetVtkTransform()->GetMatrix(vtkmatrix);
-  double(*matrix)[4] = vtkmatrix->Element;
-
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      matrix[i][j] /= spacing[j];
-
-  unsigned int n = points->GetNumberOfPoints();
+  const vtkIdType n = points->GetNumberOfPoints();
   double point[3];
+  mitk::Point3D index;
+  mitk::Point3D world;
 
-  for (unsigned int i = 0; i < n; i++)
+  for (vtkIdType i = 0; i < n; ++i)
   {
     points->GetPoint(i, point);
-    mitkVtkLinearTransformPoint(matrix, point, point);
-    points->SetPoint(i, point);
+
+    for (unsigned int j = 0; j < 3; ++j)
+      index[j] = point[j] / spacing[j] + cropIndex[j];
+
+    geometry->IndexToWorld(index, world);
+    points->SetPoint(i, world[0], world[1], world[2]);
   }
-  vtkmatrix->Delete();
 
   vtkSmartPointer<vtkCleanPolyData> cleanPolyDataFilter = vtkSmartPointer<vtkCleanPolyData>::New();
   cleanPolyDataFilter->SetInputData(polydata);
@@ -219,6 +354,34 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   cleanPolyDataFilter->PointMergingOn();
   cleanPolyDataFilter->Update();
 
-  mitk::Surface::Pointer output = this->GetOutput(0);
-  output->SetVtkPolyData(cleanPolyDataFilter->GetOutput(), 0);
+  vtkSmartPointer<vtkPolyData> surface = cleanPolyDataFilter->GetOutput();
+
+  // decimate = to reduce number of polygons, with the settings of mitk::ImageToSurfaceFilter
+  if (m_Decimate == ImageToSurfaceFilter::DecimatePro)
+  {
+    vtkSmartPointer<vtkDecimatePro> decimate = vtkSmartPointer<vtkDecimatePro>::New();
+    decimate->SplittingOff();
+    decimate->SetErrorIsAbsolute(5);
+    decimate->SetFeatureAngle(30);
+    decimate->PreserveTopologyOn();
+    decimate->BoundaryVertexDeletionOff();
+    decimate->SetDegree(10);
+
+    decimate->SetInputData(surface);
+    decimate->SetTargetReduction(m_TargetReduction);
+    decimate->SetMaximumError(0.002);
+    decimate->Update();
+    surface = decimate->GetOutput();
+  }
+  else if (m_Decimate == ImageToSurfaceFilter::QuadricDecimation)
+  {
+    vtkSmartPointer<vtkQuadricDecimation> decimate = vtkSmartPointer<vtkQuadricDecimation>::New();
+    decimate->SetTargetReduction(m_TargetReduction);
+
+    decimate->SetInputData(surface);
+    decimate->Update();
+    surface = decimate->GetOutput();
+  }
+
+  return surface;
 }
@@ -16,9 +16,11 @@ found in the LICENSE file.
 #include "MitkMultilabelExports.h"
 #include "mitkLabelSetImage.h"
 #include "mitkSurface.h"
+#include <mitkImageToSurfaceFilter.h>
 #include <mitkSurfaceSource.h>
 
 #include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
 
 #include <itkImage.h>
 
@@ -29,7 +31,12 @@ namespace mitk
   /**
    * Generates surface meshes from a labelset image.
    * If you want to calculate a surface representation for all available labels,
-   * you may call GenerateAllLabelsOn().
+   * you may call GenerateAllLabelsOn(). Then one output is generated per label (except the
+   * background label) and you can query the label of an output using GetLabelForNthOutput().
+   *
+   * The bounding boxes of all labels are determined in a single pass over the image, so
+   * each label is only processed within its bounding box (plus a border of a few voxels).
+   * When all labels are generated, the labels are processed in parallel.
    */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceFilter : public SurfaceSource
   {
@@ -105,6 +112,24 @@ namespace mitk
      */
     itkSetMacro(Sigma, float);
 
+    /**
+     * Sets the decimation of the surfaces, by default NoDecimation.
+     */
+    itkSetMacro(Decimate, ImageToSurfaceFilter::DecimationType);
+    itkGetConstMacro(Decimate, ImageToSurfaceFilter::DecimationType);
+
+    /**
+     * Sets the desired reduction of triangles in the range from 0.0 to 1.0 used by the decimation, by default 0.5.
+     */
+    itkSetMacro(TargetReduction, float);
+    itkGetConstMacro(TargetReduction, float);
+
+    /**
+     * Returns the label of the ith output, after the filter has been updated.
+     * @returns itk::NumericTraits<LabelType>::max() if i is out of range.
+     */
+    LabelType GetLabelForNthOutput(const unsigned int &i);
+
   protected:
     LabelSetImageToSurfaceFilter();
 
@@ -124,11 +149,30 @@ namespace mitk
       out[2] = z;
     }
 
-    mitk::Image::Pointer m_ResultImage;
+    typedef itk::ImageRegion<3> RegionType;
+
+    typedef std::map<LabelType, RegionType> LabelRegionMapType;
+
+    /**
+    * Determines the voxel counts and bounding boxes of all labels in a single pass
+    */
+    template <typename TPixel, unsigned int VImageDimension>
+    void ScanLabels(const itk::Image<TPixel, VImageDimension> *input);
 
     template <typename TPixel, unsigned int VImageDimension>
     void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input, mitk::Surface *surface);
 
+    /**
+    * Generates the surface of a label within its bounding box
+    * @param numberOfThreads number of threads of the ITK filters, 0 for the default
+    */
+    template <typename TPixel, unsigned int VImageDimension>
+    vtkSmartPointer<vtkPolyData> ExtractLabelSurface(const itk::Image<TPixel, VImageDimension> *input,
+                                                     LabelType label,
+                                                     const RegionType &labelRegion,
+                                                     const BaseGeometry *geometry,
+                                                     unsigned int numberOfThreads) const;
+
     bool m_GenerateAllLabels;
 
     int m_RequestedLabel;
@@ -139,8 +183,14 @@ namespace mitk
 
     float m_Sigma;
 
+    ImageToSurfaceFilter::DecimationType m_Decimate;
+
+    float m_TargetReduction;
+
     LabelMapType m_AvailableLabels;
 
+    LabelRegionMapType m_LabelRegions;
+
     IndexToLabelMapType m_IndexToLabels;
 
     mitk::Vector3D m_InputImageSpacing;
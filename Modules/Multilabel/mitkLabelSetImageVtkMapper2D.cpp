@@ -15,6 +15,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLevelWindowProperty.h>
@@ -52,6 +53,11 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
 mitk::LabelSetImageVtkMapper2D::LabelSetImageVtkMapper2D()
 {
 }
@@ -92,9 +98,20 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
   float opacity = 1.0f;
   node->GetOpacity(opacity, renderer, "opacity");
 
-  if (numberOfLayers != localStorage->m_NumberOfLayers)
+  // sparse layers are sampled without densifying them only when compositing, so it is forced for them. Curved
+  // planes are resliced with the transform of each layer, so they cannot be composited.
+  bool compositeLayers = true;
+  node->GetBoolProperty("labelset.layers.composite", compositeLayers, renderer);
+  compositeLayers = (compositeLayers || image->GetSparseLayerStorage()) &&
+                    nullptr == dynamic_cast<const AbstractTransformGeometry *>(worldGeometry);
+
+  // number of textured planes
+  const int numberOfSlices = compositeLayers ? 1 : numberOfLayers;
+
+  if (numberOfLayers != localStorage->m_NumberOfLayers || compositeLayers != localStorage->m_CompositeLayers)
   {
     localStorage->m_NumberOfLayers = numberOfLayers;
+    localStorage->m_CompositeLayers = compositeLayers;
     localStorage->m_ReslicedImageVector.clear();
     localStorage->m_ReslicerVector.clear();
     localStorage->m_LayerTextureVector.clear();
@@ -104,7 +121,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
     localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
 
-    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+    for (int lidx = 0; lidx < numberOfSlices; ++lidx)
     {
       localStorage->m_ReslicedImageVector.push_back(vtkSmartPointer<vtkImageData>::New());
       localStorage->m_ReslicerVector.push_back(mitk::ExtractSliceFilter::New());
@@ -133,7 +150,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     // set image to nullptr, to clear the texture in 3D, because
     // the latest image is used there if the plane is out of the geometry
     // see bug-13275
-    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+    for (int lidx = 0; lidx < numberOfSlices; ++lidx)
     {
       localStorage->m_ReslicedImageVector[lidx] = nullptr;
       localStorage->m_LayerMapperVector[lidx]->SetInputData(localStorage->m_EmptyPolyData);
@@ -143,15 +160,19 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     return;
   }
 
-  for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+  for (int lidx = 0; lidx < numberOfSlices; ++lidx)
   {
-    mitk::Image *layerImage = nullptr;
+    mitk::Image::ConstPointer layerImage;
+    const mitk::LabelSetImage *constImage = image;
 
-    // set main input for ExtractSliceFilter
-    if (lidx == activeLayer)
+    // set main input for ExtractSliceFilter, the composited slice is resliced like the active layer. A temporary
+    // dense copy of a sparse layer is resliced, so rendering does not change the storage of the layer.
+    if (compositeLayers || lidx == activeLayer)
       layerImage = image;
+    else if (nullptr != image->GetSparseLayer(lidx))
+      layerImage = image->GetDenseLayerImage(lidx);
     else
-      layerImage = image->GetLayerImage(lidx);
+      layerImage = constImage->GetLayerImage(lidx);
 
     localStorage->m_ReslicerVector[lidx]->SetInput(layerImage);
     localStorage->m_ReslicerVector[lidx]->SetWorldGeometry(worldGeometry);
@@ -195,46 +216,55 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     localStorage->m_ReslicerVector[lidx]->UpdateLargestPossibleRegion();
     localStorage->m_ReslicedImageVector[lidx] = localStorage->m_ReslicerVector[lidx]->GetVtkOutput();
 
-    const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
+    // do not use a VTK lookup table (we do that ourselves in m_LevelWindowFilter or CompositeLayers())
+    localStorage->m_LayerTextureVector[lidx]->SetColorModeToDirectScalars();
 
-    double textureClippingBounds[6];
-    for (auto &textureClippingBound : textureClippingBounds)
-    {
-      textureClippingBound = 0.0;
-    }
+    // check for texture interpolation property
+    bool textureInterpolation = false;
+    node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
 
-    // Calculate the actual bounds of the transformed plane clipped by the
-    // dataset bounding box; this is required for drawing the texture at the
-    // correct position during 3D mapping.
-    mitk::PlaneClipping::CalculateClippedPlaneBounds(layerImage->GetGeometry(), planeGeometry, textureClippingBounds);
+    // set the interpolation modus according to the property
+    localStorage->m_LayerTextureVector[lidx]->SetInterpolate(textureInterpolation);
 
-    textureClippingBounds[0] = static_cast<int>(textureClippingBounds[0] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[1] = static_cast<int>(textureClippingBounds[1] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[2] = static_cast<int>(textureClippingBounds[2] / localStorage->m_mmPerPixel[1] + 0.5);
-    textureClippingBounds[3] = static_cast<int>(textureClippingBounds[3] / localStorage->m_mmPerPixel[1] + 0.5);
+    if (compositeLayers)
+    {
+      // the opacity is applied to each layer while compositing
+      this->CompositeLayers(renderer, image, opacity);
+      localStorage->m_LayerTextureVector[lidx]->SetInputData(localStorage->m_CompositedImage);
+    }
+    else
+    {
+      const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
-    // clipping bounds for cutting the imageLayer
-    localStorage->m_LevelWindowFilterVector[lidx]->SetClippingBounds(textureClippingBounds);
+      double textureClippingBounds[6];
+      for (auto &textureClippingBound : textureClippingBounds)
+      {
+        textureClippingBound = 0.0;
+      }
 
-    localStorage->m_LevelWindowFilterVector[lidx]->SetLookupTable(
-      image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable());
+      // Calculate the actual bounds of the transformed plane clipped by the
+      // dataset bounding box; this is required for drawing the texture at the
+      // correct position during 3D mapping.
+      mitk::PlaneClipping::CalculateClippedPlaneBounds(layerImage->GetGeometry(), planeGeometry, textureClippingBounds);
 
-    // do not use a VTK lookup table (we do that ourselves in m_LevelWindowFilter)
-    localStorage->m_LayerTextureVector[lidx]->SetColorModeToDirectScalars();
+      textureClippingBounds[0] = static_cast<int>(textureClippingBounds[0] / localStorage->m_mmPerPixel[0] + 0.5);
+      textureClippingBounds[1] = static_cast<int>(textureClippingBounds[1] / localStorage->m_mmPerPixel[0] + 0.5);
+      textureClippingBounds[2] = static_cast<int>(textureClippingBounds[2] / localStorage->m_mmPerPixel[1] + 0.5);
+      textureClippingBounds[3] = static_cast<int>(textureClippingBounds[3] / localStorage->m_mmPerPixel[1] + 0.5);
 
-    // connect the imageLayer with the levelwindow filter
-    localStorage->m_LevelWindowFilterVector[lidx]->SetInputData(localStorage->m_ReslicedImageVector[lidx]);
-    // connect the texture with the output of the levelwindow filter
+      // clipping bounds for cutting the imageLayer
+      localStorage->m_LevelWindowFilterVector[lidx]->SetClippingBounds(textureClippingBounds);
 
-    // check for texture interpolation property
-    bool textureInterpolation = false;
-    node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+      localStorage->m_LevelWindowFilterVector[lidx]->SetLookupTable(
+        image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable());
 
-    // set the interpolation modus according to the property
-    localStorage->m_LayerTextureVector[lidx]->SetInterpolate(textureInterpolation);
+      // connect the imageLayer with the levelwindow filter
+      localStorage->m_LevelWindowFilterVector[lidx]->SetInputData(localStorage->m_ReslicedImageVector[lidx]);
 
-    localStorage->m_LayerTextureVector[lidx]->SetInputConnection(
-      localStorage->m_LevelWindowFilterVector[lidx]->GetOutputPort());
+      // connect the texture with the output of the levelwindow filter
+      localStorage->m_LayerTextureVector[lidx]->SetInputConnection(
+        localStorage->m_LevelWindowFilterVector[lidx]->GetOutputPort());
+    }
 
     this->TransformActor(renderer);
 
@@ -243,7 +273,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
     // set the texture for the actor
     localStorage->m_LayerActorVector[lidx]->SetTexture(localStorage->m_LayerTextureVector[lidx]);
-    localStorage->m_LayerActorVector[lidx]->GetProperty()->SetOpacity(opacity);
+    localStorage->m_LayerActorVector[lidx]->GetProperty()->SetOpacity(compositeLayers ? 1.0 : opacity);
   }
 
   mitk::Label* activeLabel = image->GetActiveLabel(activeLayer);
@@ -253,9 +283,12 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     node->GetBoolProperty("labelset.contour.active", contourActive, renderer);
     if (contourActive && activeLabel->GetVisible()) //contour rendering
     {
+      vtkImageData *activeLayerSlice = compositeLayers ? localStorage->m_ActiveLayerSlice.GetPointer()
+                                                       : localStorage->m_ReslicedImageVector[activeLayer].GetPointer();
+
       //generate contours/outlines
       localStorage->m_OutlinePolyData =
-        this->CreateOutlinePolyData(renderer, localStorage->m_ReslicedImageVector[activeLayer], activeLabel->GetValue());
+        this->CreateOutlinePolyData(renderer, activeLayerSlice, activeLabel->GetValue());
       localStorage->m_OutlineActor->SetVisibility(true);
       localStorage->m_OutlineShadowActor->SetVisibility(true);
       const mitk::Color& color = activeLabel->GetColor();
@@ -278,6 +311,160 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
   localStorage->m_OutlineShadowActor->SetVisibility(false);
 }
 
+void mitk::LabelSetImageVtkMapper2D::CompositeLayers(mitk::BaseRenderer *renderer,
+                                                     mitk::LabelSetImage *image,
+                                                     float opacity)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  vtkImageData *slice = localStorage->m_ReslicedImageVector[0];
+
+  int extent[6];
+  slice->GetExtent(extent);
+
+  vtkImageData *composited = localStorage->m_CompositedImage;
+  composited->SetExtent(extent);
+  composited->SetSpacing(slice->GetSpacing());
+  composited->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+
+  vtkImageData *activeLayerSlice = localStorage->m_ActiveLayerSlice;
+  activeLayerSlice->SetExtent(extent);
+  activeLayerSlice->SetSpacing(slice->GetSpacing());
+  activeLayerSlice->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+
+  const unsigned int timeStep = this->GetTimestep();
+  const BaseGeometry *geometry = image->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+
+  // the reslice axes map the slice to world coordinates. The continuous index of the layers is affine in the
+  // slice coordinates, so it is determined for the origin of the slice and one step in x and y.
+  vtkMatrix4x4 *resliceAxes = localStorage->m_ReslicerVector[0]->GetResliceAxes();
+  const double *spacing = slice->GetSpacing();
+
+  auto sliceToIndex = [&](double x, double y) {
+    const double slicePoint[4] = {x, y, 0.0, 1.0};
+    double worldPoint[4];
+    resliceAxes->MultiplyPoint(slicePoint, worldPoint);
+
+    Point3D world;
+    world[0] = worldPoint[0];
+    world[1] = worldPoint[1];
+    world[2] = worldPoint[2];
+
+    Point3D index;
+    geometry->WorldToIndex(world, index);
+    return index;
+  };
+
+  const Point3D originIndex = sliceToIndex(0.0, 0.0);
+  const Vector3D stepX = sliceToIndex(spacing[0], 0.0) - originIndex;
+  const Vector3D stepY = sliceToIndex(0.0, spacing[1]) - originIndex;
+
+  const int dimensions[3] = {static_cast<int>(image->GetDimension(0)),
+                             static_cast<int>(image->GetDimension(1)),
+                             static_cast<int>(image->GetDimension(2))};
+
+  const unsigned int numberOfLayers = image->GetNumberOfLayers();
+  const unsigned int activeLayer = image->GetActiveLayer();
+
+  const mitk::LabelSetImage *constImage = image;
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const Label::PixelType *> layerData;
+  std::vector<std::shared_ptr<const SparseLabelVolume>> sparseLayers;
+  std::vector<vtkLookupTable *> lookupTables;
+
+  for (unsigned int lidx = 0; lidx < numberOfLayers; ++lidx)
+  {
+    // sparse layers are sampled directly instead of being materialized for every render
+    sparseLayers.push_back(lidx == activeLayer ? nullptr : image->GetSparseLayer(lidx));
+
+    if (nullptr != sparseLayers.back())
+    {
+      layerData.push_back(nullptr);
+    }
+    else
+    {
+      const mitk::Image *layerImage = lidx == activeLayer ? image : constImage->GetLayerImage(lidx);
+      accessors.emplace_back(new ImageReadAccessor(layerImage, layerImage->GetVolumeData(timeStep)));
+      layerData.push_back(static_cast<const Label::PixelType *>(accessors.back()->GetData()));
+    }
+
+    lookupTables.push_back(image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable());
+    lookupTables.back()->Build();
+  }
+
+  // labels come in long runs, so the color of the last label of each layer is kept
+  std::vector<Label::PixelType> lastLabels(numberOfLayers, 0);
+  std::vector<std::array<unsigned char, 4>> lastColors(numberOfLayers);
+  for (unsigned int lidx = 0; lidx < numberOfLayers; ++lidx)
+    std::copy(lookupTables[lidx]->MapValue(0), lookupTables[lidx]->MapValue(0) + 4, lastColors[lidx].begin());
+
+  auto *rgba = static_cast<unsigned char *>(composited->GetScalarPointer());
+  auto *activeLabels = static_cast<Label::PixelType *>(activeLayerSlice->GetScalarPointer());
+
+  for (int y = extent[2]; y <= extent[3]; ++y)
+  {
+    for (int x = extent[0]; x <= extent[1]; ++x, rgba += 4, ++activeLabels)
+    {
+      // nearest neighbor like the reslicer
+      int index[3];
+      bool inside = true;
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        index[dim] = static_cast<int>(std::floor(originIndex[dim] + x * stepX[dim] + y * stepY[dim] + 0.5));
+        inside = inside && index[dim] >= 0 && index[dim] < dimensions[dim];
+      }
+
+      *activeLabels = 0;
+      std::fill(rgba, rgba + 4, 0);
+
+      if (!inside)
+        continue;
+
+      const std::size_t offset =
+        (static_cast<std::size_t>(index[2]) * dimensions[1] + index[1]) * dimensions[0] + index[0];
+
+      // "over" compositing of the (not premultiplied) label colors, higher layers on top
+      double color[3] = {0.0, 0.0, 0.0};
+      double alpha = 0.0;
+
+      for (unsigned int lidx = 0; lidx < numberOfLayers; ++lidx)
+      {
+        const Label::PixelType label =
+          nullptr != layerData[lidx] ? layerData[lidx][offset]
+                                     : sparseLayers[lidx]->GetPixel(index[0], index[1], index[2], timeStep);
+
+        if (lidx == activeLayer)
+          *activeLabels = label;
+
+        if (label != lastLabels[lidx])
+        {
+          const unsigned char *labelColor = lookupTables[lidx]->MapValue(label);
+          std::copy(labelColor, labelColor + 4, lastColors[lidx].begin());
+          lastLabels[lidx] = label;
+        }
+
+        const auto &labelColor = lastColors[lidx];
+        const double labelAlpha = labelColor[3] / 255.0 * opacity;
+
+        if (labelAlpha <= 0.0)
+          continue;
+
+        const double compositedAlpha = labelAlpha + alpha * (1.0 - labelAlpha);
+        for (unsigned int i = 0; i < 3; ++i)
+          color[i] = (labelColor[i] * labelAlpha + color[i] * alpha * (1.0 - labelAlpha)) / compositedAlpha;
+        alpha = compositedAlpha;
+      }
+
+      for (unsigned int i = 0; i < 3; ++i)
+        rgba[i] = static_cast<unsigned char>(color[i] + 0.5);
+      rgba[3] = static_cast<unsigned char>(alpha * 255.0 + 0.5);
+    }
+  }
+
+  composited->Modified();
+  activeLayerSlice->Modified();
+}
+
 bool mitk::LabelSetImageVtkMapper2D::RenderingGeometryIntersectsImage(const PlaneGeometry *renderingGeometry,
                                                                       SlicedGeometry3D *imageGeometry)
 {
@@ -582,7 +769,7 @@ void mitk::LabelSetImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer
   vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ReslicerVector[0]->GetResliceAxes(); // same for all layers
   trans->SetMatrix(matrix);
 
-  for (int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
+  for (std::size_t lidx = 0; lidx < localStorage->m_LayerActorVector.size(); ++lidx)
   {
     // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
     localStorage->m_LayerActorVector[lidx]->SetUserTransform(trans);
@@ -620,6 +807,7 @@ void mitk::LabelSetImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node,
 
   node->SetProperty("labelset.contour.active", BoolProperty::New(true), renderer);
   node->SetProperty("labelset.contour.width", FloatProperty::New(2.0), renderer);
+  node->SetProperty("labelset.layers.composite", BoolProperty::New(true), renderer);
 
   Superclass::SetDefaultProperties(node, renderer, overwrite);
 }
@@ -640,6 +828,9 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
   m_OutlineShadowActor = vtkSmartPointer<vtkActor>::New();
 
   m_NumberOfLayers = 0;
+  m_CompositeLayers = false;
+  m_CompositedImage = vtkSmartPointer<vtkImageData>::New();
+  m_ActiveLayerSlice = vtkSmartPointer<vtkImageData>::New();
   m_mmPerPixel = nullptr;
 
   m_OutlineActor->SetMapper(m_OutlineMapper);
@@ -47,11 +47,14 @@ namespace mitk
    *
    *   - \b "labelset.contour.active": (BoolProperty) whether to show only the active label as a contour or not
    *   - \b "labelset.contour.width": (FloatProperty) line width of the contour
+   *   - \b "labelset.layers.composite": (BoolProperty) whether to sample all layers in one traversal of the slice and
+   *     composite their label colors into a single texture, instead of reslicing and texturing each layer on its own
 
    * The default properties are:
 
    *   - \b "labelset.contour.active", mitk::BoolProperty::New( true ), renderer, overwrite )
    *   - \b "labelset.contour.width", mitk::FloatProperty::New( 2.0 ), renderer, overwrite )
+   *   - \b "labelset.layers.composite", mitk::BoolProperty::New( true ), renderer, overwrite )
 
    * \ingroup Mapper
    */
@@ -116,6 +119,15 @@ namespace mitk
 
       int m_NumberOfLayers;
 
+      /** \brief Whether all layers are composited into the first (and only) texture. */
+      bool m_CompositeLayers;
+
+      /** \brief Composited label colors of all layers (RGBA), used in composite mode. */
+      vtkSmartPointer<vtkImageData> m_CompositedImage;
+
+      /** \brief Labels of the active layer sampled along with the composited image, used for the outline. */
+      vtkSmartPointer<vtkImageData> m_ActiveLayerSlice;
+
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       // vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
       std::vector<vtkSmartPointer<vtkMitkLevelWindowFilter>> m_LevelWindowFilterVector;
@@ -190,6 +202,12 @@ namespace mitk
       */
     void GenerateDataForRenderer(mitk::BaseRenderer *renderer) override;
 
+    /** \brief Samples all layers in one traversal of the slice that was resliced from the active layer (the first
+      * reslicer of the local storage) and composites their label colors into m_CompositedImage. The labels of the
+      * active layer are stored in m_ActiveLayerSlice, so the outline matches the composited slice.
+      */
+    void CompositeLayers(mitk::BaseRenderer *renderer, mitk::LabelSetImage *image, float opacity);
+
     /** \brief This method uses the vtkCamera clipping range and the layer property
       * to calcualte the depth of the object (e.g. image or contour). The depth is used
       * to keep the correct order for the final VTK rendering.*/
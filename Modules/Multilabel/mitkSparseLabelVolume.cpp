@@ -0,0 +1,178 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseLabelVolume.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+
+const unsigned int mitk::SparseLabelVolume::TileSize;
+
+mitk::SparseLabelVolume::SparseLabelVolume(const SizeType &size) : m_Size(size)
+{
+  for (unsigned int i = 0; i < 3; ++i)
+    m_NumberOfTiles[i] = (m_Size[i] + TileSize - 1) / TileSize;
+
+  m_Tiles.resize(static_cast<std::size_t>(m_NumberOfTiles[0]) * m_NumberOfTiles[1] * m_NumberOfTiles[2] * m_Size[3]);
+}
+
+bool mitk::SparseLabelVolume::GetLayout(const Image *image, SizeType &size)
+{
+  if (nullptr == image || !image->IsInitialized() || image->GetDimension() < 3 || image->GetDimension() > 4)
+    return false;
+
+  if (!(image->GetPixelType() == MakeScalarPixelType<PixelType>()))
+    return false;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    size[i] = image->GetDimension(i);
+
+  size[3] = 4 == image->GetDimension() ? image->GetDimension(3) : 1;
+
+  return true;
+}
+
+std::shared_ptr<mitk::SparseLabelVolume> mitk::SparseLabelVolume::New(const SizeType &size)
+{
+  return std::shared_ptr<SparseLabelVolume>(new SparseLabelVolume(size));
+}
+
+std::shared_ptr<mitk::SparseLabelVolume> mitk::SparseLabelVolume::New(const Image *image)
+{
+  SizeType size;
+
+  if (!GetLayout(image, size))
+    mitkThrow() << "Cannot create sparse label volume. Image is not a 3D or 4D image of label pixel type.";
+
+  std::shared_ptr<SparseLabelVolume> volume(new SparseLabelVolume(size));
+
+  ImageReadAccessor accessor(image);
+  const auto *data = static_cast<const PixelType *>(accessor.GetData());
+
+  std::size_t tileIndex = 0;
+
+  for (unsigned int t = 0; t < size[3]; ++t)
+  {
+    for (unsigned int z0 = 0; z0 < size[2]; z0 += TileSize)
+    {
+      const unsigned int z1 = std::min(z0 + TileSize, size[2]);
+
+      for (unsigned int y0 = 0; y0 < size[1]; y0 += TileSize)
+      {
+        const unsigned int y1 = std::min(y0 + TileSize, size[1]);
+
+        for (unsigned int x0 = 0; x0 < size[0]; x0 += TileSize, ++tileIndex)
+        {
+          const unsigned int x1 = std::min(x0 + TileSize, size[0]);
+
+          auto row = [&](unsigned int y, unsigned int z) {
+            return data + ((static_cast<std::size_t>(t) * size[2] + z) * size[1] + y) * size[0];
+          };
+
+          bool hasLabels = false;
+
+          for (unsigned int z = z0; z < z1 && !hasLabels; ++z)
+          {
+            for (unsigned int y = y0; y < y1 && !hasLabels; ++y)
+              hasLabels = std::any_of(row(y, z) + x0, row(y, z) + x1, [](PixelType value) { return 0 != value; });
+          }
+
+          if (!hasLabels)
+            continue;
+
+          // value-initialized, so the padding at the upper border is exterior
+          auto &tile = volume->m_Tiles[tileIndex];
+          tile.reset(new PixelType[TileSize * TileSize * TileSize]());
+
+          for (unsigned int z = z0; z < z1; ++z)
+          {
+            for (unsigned int y = y0; y < y1; ++y)
+              std::copy(row(y, z) + x0, row(y, z) + x1, tile.get() + ((z - z0) * TileSize + (y - y0)) * TileSize);
+          }
+        }
+      }
+    }
+  }
+
+  return volume;
+}
+
+bool mitk::SparseLabelVolume::IsCompatible(const Image *image) const
+{
+  SizeType size;
+  return GetLayout(image, size) && size == m_Size;
+}
+
+void mitk::SparseLabelVolume::WriteToImage(Image *image) const
+{
+  if (!this->IsCompatible(image))
+    mitkThrow() << "Cannot write sparse label volume. Image differs in size or pixel type.";
+
+  ImageWriteAccessor accessor(image);
+  auto *data = static_cast<PixelType *>(accessor.GetData());
+
+  std::size_t tileIndex = 0;
+
+  for (unsigned int t = 0; t < m_Size[3]; ++t)
+  {
+    for (unsigned int z0 = 0; z0 < m_Size[2]; z0 += TileSize)
+    {
+      const unsigned int z1 = std::min(z0 + TileSize, m_Size[2]);
+
+      for (unsigned int y0 = 0; y0 < m_Size[1]; y0 += TileSize)
+      {
+        const unsigned int y1 = std::min(y0 + TileSize, m_Size[1]);
+
+        for (unsigned int x0 = 0; x0 < m_Size[0]; x0 += TileSize, ++tileIndex)
+        {
+          const unsigned int x1 = std::min(x0 + TileSize, m_Size[0]);
+          const PixelType *tile = m_Tiles[tileIndex].get();
+
+          for (unsigned int z = z0; z < z1; ++z)
+          {
+            for (unsigned int y = y0; y < y1; ++y)
+            {
+              auto *row = data + ((static_cast<std::size_t>(t) * m_Size[2] + z) * m_Size[1] + y) * m_Size[0];
+
+              if (nullptr != tile)
+              {
+                const PixelType *tileRow = tile + ((z - z0) * TileSize + (y - y0)) * TileSize;
+                std::copy(tileRow, tileRow + (x1 - x0), row + x0);
+              }
+              else
+              {
+                std::fill(row + x0, row + x1, 0);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+std::size_t mitk::SparseLabelVolume::GetNumberOfAllocatedTiles() const
+{
+  return std::count_if(m_Tiles.begin(), m_Tiles.end(), [](const std::unique_ptr<PixelType[]> &tile) {
+    return nullptr != tile;
+  });
+}
+
+std::size_t mitk::SparseLabelVolume::GetMemorySize() const
+{
+  return sizeof(*this) + m_Tiles.capacity() * sizeof(std::unique_ptr<PixelType[]>) +
+         this->GetNumberOfAllocatedTiles() * TileSize * TileSize * TileSize * sizeof(PixelType);
+}
@@ -0,0 +1,104 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSparseLabelVolume_h_Included
+#define mitkSparseLabelVolume_h_Included
+
+#include <MitkMultilabelExports.h>
+#include <mitkLabel.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /** \brief Block-tiled storage of a (time resolved) label volume.
+
+    The volume is divided into tiles of TileSize x TileSize x TileSize voxels per time step. Only tiles that contain
+    at least one label other than the exterior (0) are allocated, so a layer with a small lesion needs a few tiles
+    instead of a full dense volume.
+
+    The storage is immutable. It is created from a dense image and written back into a dense image of the same size,
+    which is how LabelSetImage stores its inactive layers in sparse mode (see LabelSetImage::SetSparseLayerStorage()).
+    Thus it can be shared between copies of a LabelSetImage.
+  */
+  class MITKMULTILABEL_EXPORT SparseLabelVolume
+  {
+  public:
+    typedef Label::PixelType PixelType;
+    typedef std::array<unsigned int, 4> SizeType;
+
+    /** \brief Edge length of the tiles in voxels.*/
+    static const unsigned int TileSize = 32;
+
+    /** \brief Creates an empty (all exterior) volume of the given size (x, y, z, time steps).*/
+    static std::shared_ptr<SparseLabelVolume> New(const SizeType &size);
+
+    /** \brief Copies the labels of a 3D or 4D image of pixel type Label::PixelType.
+
+      \exception mitk::Exception if the image is not such an image.
+    */
+    static std::shared_ptr<SparseLabelVolume> New(const Image *image);
+
+    /** \brief Checks if the volume can be written into the given image.*/
+    bool IsCompatible(const Image *image) const;
+
+    /** \brief Writes all labels (including the exterior of unallocated tiles) into the given image.
+
+      \exception mitk::Exception if the image is not compatible.
+    */
+    void WriteToImage(Image *image) const;
+
+    /** \brief Label of a voxel. The index must be within the volume.*/
+    PixelType GetPixel(unsigned int x, unsigned int y, unsigned int z, unsigned int timeStep = 0) const
+    {
+      const auto &tile = m_Tiles[((timeStep * m_NumberOfTiles[2] + z / TileSize) * m_NumberOfTiles[1] + y / TileSize) *
+                                   m_NumberOfTiles[0] +
+                                 x / TileSize];
+
+      return nullptr != tile ? tile[((z % TileSize) * TileSize + y % TileSize) * TileSize + x % TileSize] : 0;
+    }
+
+    /** \brief Size of the volume (x, y, z, time steps).*/
+    const SizeType &GetSize() const { return m_Size; }
+
+    /** \brief Number of tiles of all time steps.*/
+    std::size_t GetNumberOfTiles() const { return m_Tiles.size(); }
+
+    /** \brief Number of tiles that contain labels.*/
+    std::size_t GetNumberOfAllocatedTiles() const;
+
+    /** \brief Number of bytes held by the volume.*/
+    std::size_t GetMemorySize() const;
+
+  private:
+    explicit SparseLabelVolume(const SizeType &size);
+
+    SparseLabelVolume(const SparseLabelVolume &) = delete;
+    SparseLabelVolume &operator=(const SparseLabelVolume &) = delete;
+
+    static bool GetLayout(const Image *image, SizeType &size);
+
+    SizeType m_Size;
+    std::array<unsigned int, 3> m_NumberOfTiles;
+
+    /** Tiles in x-fastest order per time step, nullptr for tiles without labels. Voxels of a tile are stored
+     * x-fastest as well. Tiles at the upper border of the volume are padded with exterior voxels.*/
+    std::vector<std::unique_ptr<PixelType[]>> m_Tiles;
+  };
+}
+
+#endif
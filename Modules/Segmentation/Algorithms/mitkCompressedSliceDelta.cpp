@@ -0,0 +1,262 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompressedSliceDelta.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  void AppendRun(std::vector<unsigned char> &runs, std::size_t runLength, const std::vector<unsigned char> &value)
+  {
+    while (runLength >= 0x80)
+    {
+      runs.push_back(static_cast<unsigned char>((runLength & 0x7F) | 0x80));
+      runLength >>= 7;
+    }
+
+    runs.push_back(static_cast<unsigned char>(runLength));
+    runs.insert(runs.end(), value.begin(), value.end());
+  }
+
+  std::size_t ReadRunLength(const std::vector<unsigned char> &runs, std::size_t &position)
+  {
+    std::size_t runLength = 0;
+    unsigned int shift = 0;
+
+    while (runs[position] & 0x80)
+    {
+      runLength |= static_cast<std::size_t>(runs[position++] & 0x7F) << shift;
+      shift += 7;
+    }
+
+    runLength |= static_cast<std::size_t>(runs[position++]) << shift;
+    return runLength;
+  }
+}
+
+mitk::CompressedSliceDelta::CompressedSliceDelta()
+  : m_SliceSize({{0, 0}}),
+    m_BytesPerPixel(0),
+    m_RegionIndex({{0, 0}}),
+    m_RegionSize({{0, 0}}),
+    m_BeforeChecksum(0),
+    m_AfterChecksum(0)
+{
+}
+
+bool mitk::CompressedSliceDelta::GetSliceLayout(const Image *slice, SizeType &size, std::size_t &bytesPerPixel)
+{
+  if (nullptr == slice || slice->GetDimension() < 2 || !slice->IsInitialized())
+    return false;
+
+  for (unsigned int i = 2; i < slice->GetDimension(); ++i)
+  {
+    if (1 != slice->GetDimension(i))
+      return false;
+  }
+
+  size[0] = slice->GetDimension(0);
+  size[1] = slice->GetDimension(1);
+  bytesPerPixel = slice->GetPixelType().GetSize();
+
+  return 0 != bytesPerPixel;
+}
+
+std::shared_ptr<mitk::CompressedSliceDelta> mitk::CompressedSliceDelta::New(const Image *before, const Image *after)
+{
+  SizeType size;
+  SizeType afterSize;
+  std::size_t bytesPerPixel = 0;
+  std::size_t afterBytesPerPixel = 0;
+
+  if (!GetSliceLayout(before, size, bytesPerPixel) || !GetSliceLayout(after, afterSize, afterBytesPerPixel) ||
+      size != afterSize || bytesPerPixel != afterBytesPerPixel)
+    return nullptr;
+
+  std::shared_ptr<CompressedSliceDelta> delta(new CompressedSliceDelta);
+  delta->m_SliceSize = size;
+  delta->m_BytesPerPixel = bytesPerPixel;
+
+  ImageReadAccessor beforeAccess(before);
+  ImageReadAccessor afterAccess(after);
+  const auto *beforeData = static_cast<const unsigned char *>(beforeAccess.GetData());
+  const auto *afterData = static_cast<const unsigned char *>(afterAccess.GetData());
+
+  const std::size_t bytesPerRow = size[0] * bytesPerPixel;
+
+  // bounding box of the changed pixels
+  unsigned int minX = size[0];
+  unsigned int maxX = 0;
+  unsigned int minY = size[1];
+  unsigned int maxY = 0;
+
+  for (unsigned int y = 0; y < size[1]; ++y)
+  {
+    const auto *beforeRow = beforeData + y * bytesPerRow;
+    const auto *afterRow = afterData + y * bytesPerRow;
+
+    if (0 == std::memcmp(beforeRow, afterRow, bytesPerRow))
+      continue;
+
+    unsigned int first = 0;
+    while (0 == std::memcmp(beforeRow + first * bytesPerPixel, afterRow + first * bytesPerPixel, bytesPerPixel))
+      ++first;
+
+    unsigned int last = size[0] - 1;
+    while (0 == std::memcmp(beforeRow + last * bytesPerPixel, afterRow + last * bytesPerPixel, bytesPerPixel))
+      --last;
+
+    minX = std::min(minX, first);
+    maxX = std::max(maxX, last);
+    minY = std::min(minY, y);
+    maxY = y;
+  }
+
+  if (minY > maxY)
+    return delta;
+
+  delta->m_RegionIndex = {{minX, minY}};
+  delta->m_RegionSize = {{maxX - minX + 1, maxY - minY + 1}};
+  delta->m_BeforeChecksum = delta->ComputeRegionChecksum(beforeData);
+  delta->m_AfterChecksum = delta->ComputeRegionChecksum(afterData);
+
+  // run-length encode the XOR values of the region in row-major order
+  std::vector<unsigned char> runValue(bytesPerPixel);
+  std::vector<unsigned char> value(bytesPerPixel);
+  std::size_t runLength = 0;
+
+  for (unsigned int y = minY; y <= maxY; ++y)
+  {
+    const std::size_t rowOffset = y * bytesPerRow;
+
+    for (unsigned int x = minX; x <= maxX; ++x)
+    {
+      const std::size_t offset = rowOffset + x * bytesPerPixel;
+
+      for (std::size_t i = 0; i < bytesPerPixel; ++i)
+        value[i] = beforeData[offset + i] ^ afterData[offset + i];
+
+      if (0 != runLength && value == runValue)
+      {
+        ++runLength;
+      }
+      else
+      {
+        if (0 != runLength)
+          AppendRun(delta->m_Runs, runLength, runValue);
+
+        runValue.swap(value);
+        runLength = 1;
+      }
+    }
+  }
+
+  AppendRun(delta->m_Runs, runLength, runValue);
+  delta->m_Runs.shrink_to_fit();
+
+  return delta;
+}
+
+bool mitk::CompressedSliceDelta::IsCompatible(const Image *slice) const
+{
+  SizeType size;
+  std::size_t bytesPerPixel = 0;
+
+  if (!GetSliceLayout(slice, size, bytesPerPixel) || size != m_SliceSize || bytesPerPixel != m_BytesPerPixel)
+    return false;
+
+  if (this->IsEmpty())
+    return true;
+
+  // the XOR is only meaningful for one of the two versions the delta was computed from
+  ImageReadAccessor access(slice);
+  const auto checksum = this->ComputeRegionChecksum(static_cast<const unsigned char *>(access.GetData()));
+
+  return checksum == m_BeforeChecksum || checksum == m_AfterChecksum;
+}
+
+std::uint64_t mitk::CompressedSliceDelta::ComputeRegionChecksum(const unsigned char *data) const
+{
+  const std::size_t bytesPerRow = m_SliceSize[0] * m_BytesPerPixel;
+  const std::size_t bytesPerRegionRow = m_RegionSize[0] * m_BytesPerPixel;
+  std::uint64_t checksum = 14695981039346656037ull;
+
+  for (unsigned int y = m_RegionIndex[1]; y < m_RegionIndex[1] + m_RegionSize[1]; ++y)
+  {
+    const auto *row = data + y * bytesPerRow + m_RegionIndex[0] * m_BytesPerPixel;
+
+    for (std::size_t i = 0; i < bytesPerRegionRow; ++i)
+    {
+      checksum ^= row[i];
+      checksum *= 1099511628211ull;
+    }
+  }
+
+  return checksum;
+}
+
+void mitk::CompressedSliceDelta::Apply(Image *slice) const
+{
+  if (!this->IsCompatible(slice))
+    mitkThrow() << "Cannot apply slice delta. Slice differs in size, pixel type or content from the slices of the delta.";
+
+  if (this->IsEmpty())
+    return;
+
+  ImageWriteAccessor access(slice);
+  auto *data = static_cast<unsigned char *>(access.GetData());
+
+  const std::size_t bytesPerRow = m_SliceSize[0] * m_BytesPerPixel;
+  std::size_t pixel = 0;
+  std::size_t position = 0;
+
+  while (position < m_Runs.size())
+  {
+    const std::size_t runLength = ReadRunLength(m_Runs, position);
+    const unsigned char *value = m_Runs.data() + position;
+    position += m_BytesPerPixel;
+
+    // unchanged pixels between the edits of a row are the most frequent runs
+    if (std::all_of(value, value + m_BytesPerPixel, [](unsigned char byte) { return 0 == byte; }))
+    {
+      pixel += runLength;
+      continue;
+    }
+
+    for (std::size_t i = 0; i < runLength; ++i, ++pixel)
+    {
+      const std::size_t x = m_RegionIndex[0] + pixel % m_RegionSize[0];
+      const std::size_t y = m_RegionIndex[1] + pixel / m_RegionSize[0];
+      auto *target = data + y * bytesPerRow + x * m_BytesPerPixel;
+
+      for (std::size_t j = 0; j < m_BytesPerPixel; ++j)
+        target[j] ^= value[j];
+    }
+  }
+}
+
+bool mitk::CompressedSliceDelta::IsEmpty() const
+{
+  return m_Runs.empty();
+}
+
+std::size_t mitk::CompressedSliceDelta::GetMemorySize() const
+{
+  return sizeof(*this) + m_Runs.capacity();
+}
@@ -0,0 +1,103 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkCompressedSliceDelta_h_Included
+#define mitkCompressedSliceDelta_h_Included
+
+#include <MitkSegmentationExports.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /** \brief Run-length encoded XOR difference of two versions of a 2D slice.
+
+    Only the bounding box of the changed pixels is stored. Within the bounding box the bitwise XOR of
+    the old and the new pixel values is stored as runs of identical values, so typical segmentation
+    edits (a brush stroke or a filled contour) need a few bytes per row of the bounding box instead of
+    two full slices.
+
+    Since XOR is its own inverse, applying the delta to the new slice restores the old slice and
+    applying it to the old slice restores the new one. Thus the do and the undo operation of an edit
+    can share one delta (see DiffSliceOperation).
+
+    Applied to any other slice, the XOR would produce garbage. Therefore checksums of the region in
+    both versions are stored as well, and the delta is only applied to a slice whose region matches
+    one of them.
+
+    \sa DiffSliceOperation
+  */
+  class MITKSEGMENTATION_EXPORT CompressedSliceDelta
+  {
+  public:
+    typedef std::array<unsigned int, 2> IndexType;
+    typedef std::array<unsigned int, 2> SizeType;
+
+    /** \brief Computes the delta between two slices.
+
+      \return nullptr if the slices differ in size or pixel type and thus cannot be compared.
+    */
+    static std::shared_ptr<CompressedSliceDelta> New(const Image *before, const Image *after);
+
+    /** \brief Checks if the delta can be applied to the given slice.
+
+      The slice must match the slices of the delta in size and pixel type, and its changed region
+      must equal the region of either the old or the new slice.
+    */
+    bool IsCompatible(const Image *slice) const;
+
+    /** \brief XORs the delta into the given slice.
+
+      \exception mitk::Exception if the slice is not compatible. The slice is left unchanged then.
+    */
+    void Apply(Image *slice) const;
+
+    /** \brief True if both slices were equal.*/
+    bool IsEmpty() const;
+
+    /** \brief Bounding box of the changed pixels.*/
+    const IndexType &GetRegionIndex() const { return m_RegionIndex; }
+    const SizeType &GetRegionSize() const { return m_RegionSize; }
+
+    /** \brief Number of bytes held by the delta.*/
+    std::size_t GetMemorySize() const;
+
+  private:
+    CompressedSliceDelta();
+
+    static bool GetSliceLayout(const Image *slice, SizeType &size, std::size_t &bytesPerPixel);
+
+    /** FNV-1a hash of the pixels of the region of the given slice data.*/
+    std::uint64_t ComputeRegionChecksum(const unsigned char *data) const;
+
+    SizeType m_SliceSize;
+    std::size_t m_BytesPerPixel;
+
+    IndexType m_RegionIndex;
+    SizeType m_RegionSize;
+
+    std::uint64_t m_BeforeChecksum;
+    std::uint64_t m_AfterChecksum;
+
+    /** Sequence of runs of the region in row-major order. Each run is a variable-length encoded
+     * run length followed by the XOR value of one pixel (m_BytesPerPixel bytes).*/
+    std::vector<unsigned char> m_Runs;
+  };
+}
+
+#endif
@@ -34,6 +34,27 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
                                              const BaseGeometry *currentWorldGeometry)
   : Operation(1)
 
+{
+  m_SliceGeometry = sliceGeometry->Clone();
+
+  m_zlibSliceContainer = CompressedImageContainer::New();
+  m_zlibSliceContainer->SetImage(slice);
+
+  this->Initialize(imageVolume, timestep, currentWorldGeometry);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             std::shared_ptr<const CompressedSliceDelta> delta,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : Operation(1), m_zlibSliceContainer(nullptr), m_Delta(delta), m_SliceGeometry(nullptr)
+{
+  this->Initialize(imageVolume, timestep, currentWorldGeometry);
+}
+
+void mitk::DiffSliceOperation::Initialize(Image *imageVolume,
+                                          TimeStepType timestep,
+                                          const BaseGeometry *currentWorldGeometry)
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
 
@@ -44,13 +65,8 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
   m_GuardReferenceGeometry = dynamic_cast<const PlaneGeometry *>(m_WorldGeometry.GetPointer())->GetReferenceGeometry();
   /*---------------------------------------------------------------------------------------------------*/
 
-  m_SliceGeometry = sliceGeometry->Clone();
-
   m_TimeStep = timestep;
 
-  m_zlibSliceContainer = CompressedImageContainer::New();
-  m_zlibSliceContainer->SetImage(slice);
-
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
 
@@ -73,6 +89,7 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 {
   m_WorldGeometry = nullptr;
   m_zlibSliceContainer = nullptr;
+  m_Delta = nullptr;
 
   if (m_ImageIsValid)
   {
@@ -84,13 +101,28 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
+  if (m_zlibSliceContainer.IsNull())
+    return nullptr;
+
   Image::Pointer image = m_zlibSliceContainer->GetImage();
   return image;
 }
 
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  if (nullptr != m_Delta)
+    return m_Delta->GetMemorySize() / 2;
+
+  if (m_zlibSliceContainer.IsNotNull())
+    return m_zlibSliceContainer->GetMemorySize();
+
+  return 0;
+}
+
 bool mitk::DiffSliceOperation::IsValid()
 {
-  return m_ImageIsValid && m_zlibSliceContainer.IsNotNull() && (m_WorldGeometry.IsNotNull()); // TODO improve
+  return m_ImageIsValid && (m_zlibSliceContainer.IsNotNull() || nullptr != m_Delta) &&
+         (m_WorldGeometry.IsNotNull()); // TODO improve
 }
 
 void mitk::DiffSliceOperation::OnImageDeleted()
@@ -14,11 +14,14 @@ found in the LICENSE file.
 #define mitkDiffSliceOperation_h_Included
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkCompressedSliceDelta.h"
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
 #include <vtkSmartPointer.h>
 
+#include <memory>
+
 namespace mitk
 {
   class Image;
@@ -33,6 +36,10 @@ namespace mitk
      timestep               the timestep in an 4D image.
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
+    Instead of a slice, the operation can hold a CompressedSliceDelta. Then the current slice is extracted
+    from the volume, the delta is XORed into it and the result is written back. The do and the undo
+    operation of an edit can share one delta, which only covers the changed pixels.
+
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
@@ -57,6 +64,12 @@ namespace mitk
                        const TimeStepType timestep,
                        const BaseGeometry *currentWorldGeometry);
 
+    /** \brief Creates an operation that applies a delta to the slice of the volume.*/
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       std::shared_ptr<const CompressedSliceDelta> delta,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -64,9 +77,16 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     const mitk::Image* GetImage() const { return this->m_Image; }
 
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation. nullptr if the operation holds a delta.*/
     Image::Pointer GetSlice();
 
+    /** \brief Get the delta that is applied in the operation. nullptr if the operation holds a slice.*/
+    std::shared_ptr<const CompressedSliceDelta> GetDelta() const { return this->m_Delta; }
+
+    /** \brief Size of the compressed slice or, as a delta is shared by the do and the undo operation
+      of an edit, half of the size of the delta.*/
+    std::size_t GetMemorySize() const override;
+
     /** \brief Set timeStep*/
     TimeStepType GetTimeStep() const { return this->m_TimeStep; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
@@ -79,8 +99,13 @@ namespace mitk
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
+    /** \brief Stores the volume and geometries and observes the volume.*/
+    void Initialize(Image *imageVolume, TimeStepType timestep, const BaseGeometry *currentWorldGeometry);
+
     CompressedImageContainer::Pointer m_zlibSliceContainer;
 
+    std::shared_ptr<const CompressedSliceDelta> m_Delta;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
@@ -44,6 +44,27 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
     mitk::Image::Pointer slice = imageOperation->GetSlice();
+
+    if (slice.IsNull())
+    {
+      // the operation holds a delta: restore the slice from the current content of the volume
+      auto delta = imageOperation->GetDelta();
+      if (nullptr == delta || delta->IsEmpty())
+        return;
+
+      const auto *plane = dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry());
+      slice = SegTool2D::GetAffectedImageSliceAs2DImage(plane, imageOperation->GetImage(), imageOperation->GetTimeStep());
+
+      if (slice.IsNull() || !delta->IsCompatible(slice))
+      {
+        // the slice was changed by something that bypassed the undo stack, applying the delta would corrupt it
+        MITK_ERROR << "Cannot undo/redo segmentation edit. The slice of the volume does not match the stored delta.";
+        return;
+      }
+
+      delta->Apply(slice);
+    }
+
     // Set the slice as 'input'
     reslice->SetInputSlice(slice->GetVtkImageData());
 
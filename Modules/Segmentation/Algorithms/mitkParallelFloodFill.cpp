@@ -0,0 +1,198 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelFloodFill.h"
+
+#include <mitkParallelFor.h>
+
+#include <itkMultiThreader.h>
+
+namespace
+{
+  std::size_t FindRoot(std::vector<std::size_t> &parents, std::size_t i)
+  {
+    // path halving
+    while (parents[i] != i)
+    {
+      parents[i] = parents[parents[i]];
+      i = parents[i];
+    }
+
+    return i;
+  }
+
+  /// links the root with the higher index to the one with the lower index, so parents never point forward
+  void Union(std::vector<std::size_t> &parents, std::size_t i, std::size_t j)
+  {
+    i = FindRoot(parents, i);
+    j = FindRoot(parents, j);
+
+    if (i < j)
+      parents[j] = i;
+    else if (j < i)
+      parents[i] = j;
+  }
+}
+
+mitk::ParallelFloodFill::ParallelFloodFill(const SizeType &size, const RowPredicateType &isInside)
+  : m_Size(size), m_NumberOfRows(static_cast<std::size_t>(size[1]) * size[2]), m_NumberOfComponents(0)
+{
+  // several blocks per thread balance the load of unevenly distributed regions
+  const std::size_t numberOfBlocks = 4 * itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  m_RowsPerBlock = std::max<std::size_t>(1, (m_NumberOfRows + numberOfBlocks - 1) / numberOfBlocks);
+
+  // 1. collect the runs of each block of rows
+  std::vector<std::vector<Run>> blockRuns((m_NumberOfRows + m_RowsPerBlock - 1) / m_RowsPerBlock);
+  m_RowOffsets.assign(m_NumberOfRows + 1, 0);
+
+  this->ParallelForRows([&](std::size_t beginRow, std::size_t endRow) {
+    auto &runs = blockRuns[beginRow / m_RowsPerBlock];
+    std::vector<unsigned char> inside(m_Size[0]);
+
+    for (std::size_t row = beginRow; row < endRow; ++row)
+    {
+      isInside(static_cast<unsigned int>(row % m_Size[1]), static_cast<unsigned int>(row / m_Size[1]), inside.data());
+
+      const std::size_t numberOfRuns = runs.size();
+
+      for (unsigned int x = 0; x < m_Size[0];)
+      {
+        if (0 == inside[x])
+        {
+          ++x;
+          continue;
+        }
+
+        Run run;
+        run.Begin = x;
+        while (x < m_Size[0] && 0 != inside[x])
+          ++x;
+        run.End = x;
+
+        runs.push_back(run);
+      }
+
+      m_RowOffsets[row + 1] = runs.size() - numberOfRuns;
+    }
+  });
+
+  for (std::size_t row = 0; row < m_NumberOfRows; ++row)
+    m_RowOffsets[row + 1] += m_RowOffsets[row];
+
+  m_Runs.resize(m_RowOffsets.back());
+
+  this->ParallelForRows([&](std::size_t beginRow, std::size_t) {
+    auto &runs = blockRuns[beginRow / m_RowsPerBlock];
+    std::copy(runs.begin(), runs.end(), m_Runs.begin() + m_RowOffsets[beginRow]);
+    std::vector<Run>().swap(runs);
+  });
+
+  // 2. join the runs within the blocks in parallel. Each block only touches the parents of its own runs.
+  std::vector<std::size_t> parents(m_Runs.size());
+  for (std::size_t i = 0; i < parents.size(); ++i)
+    parents[i] = i;
+
+  this->ParallelForRows([&](std::size_t beginRow, std::size_t endRow) {
+    for (std::size_t row = beginRow; row < endRow; ++row)
+    {
+      if (0 != row % m_Size[1] && row - 1 >= beginRow)
+        this->JoinRows(row, row - 1, parents);
+
+      if (row >= m_Size[1] && row - m_Size[1] >= beginRow)
+        this->JoinRows(row, row - m_Size[1], parents);
+    }
+  });
+
+  // 3. join the runs across the block borders
+  for (std::size_t beginRow = m_RowsPerBlock; beginRow < m_NumberOfRows; beginRow += m_RowsPerBlock)
+  {
+    const std::size_t endRow = std::min(m_NumberOfRows, beginRow + m_RowsPerBlock);
+
+    for (std::size_t row = beginRow; row < std::min(endRow, beginRow + m_Size[1]); ++row)
+    {
+      if (0 != row % m_Size[1] && row - 1 < beginRow)
+        this->JoinRows(row, row - 1, parents);
+
+      if (row >= m_Size[1] && row - m_Size[1] < beginRow)
+        this->JoinRows(row, row - m_Size[1], parents);
+    }
+  }
+
+  // 4. number the components in memory order. Parents never point forward, so they are numbered before.
+  m_Components.resize(m_Runs.size());
+
+  for (std::size_t i = 0; i < m_Runs.size(); ++i)
+    m_Components[i] = parents[i] == i ? ++m_NumberOfComponents : m_Components[parents[i]];
+}
+
+void mitk::ParallelFloodFill::JoinRows(std::size_t row, std::size_t neighborRow, std::vector<std::size_t> &parents) const
+{
+  std::size_t i = m_RowOffsets[row];
+  std::size_t j = m_RowOffsets[neighborRow];
+  const std::size_t endI = m_RowOffsets[row + 1];
+  const std::size_t endJ = m_RowOffsets[neighborRow + 1];
+
+  // both rows are sorted, so the overlapping runs are found like in a merge
+  while (i < endI && j < endJ)
+  {
+    if (m_Runs[i].Begin < m_Runs[j].End && m_Runs[j].Begin < m_Runs[i].End)
+      Union(parents, i, j);
+
+    if (m_Runs[i].End < m_Runs[j].End)
+      ++i;
+    else
+      ++j;
+  }
+}
+
+void mitk::ParallelFloodFill::ParallelForRows(
+  const std::function<void(std::size_t beginRow, std::size_t endRow)> &function) const
+{
+  mitk::ParallelFor((m_NumberOfRows + m_RowsPerBlock - 1) / m_RowsPerBlock, [&](std::size_t block) {
+    const std::size_t beginRow = block * m_RowsPerBlock;
+    function(beginRow, std::min(m_NumberOfRows, beginRow + m_RowsPerBlock));
+  });
+}
+
+unsigned int mitk::ParallelFloodFill::GetComponent(const IndexType &index) const
+{
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (index[dim] >= m_Size[dim])
+      return 0;
+  }
+
+  const std::size_t row = static_cast<std::size_t>(index[2]) * m_Size[1] + index[1];
+  const auto begin = m_Runs.begin() + m_RowOffsets[row];
+  const auto end = m_Runs.begin() + m_RowOffsets[row + 1];
+
+  // first run that begins behind the voxel, so the voxel can only be in the run before
+  const auto run = std::upper_bound(begin, end, index[0], [](unsigned int x, const Run &run) { return x < run.Begin; });
+
+  if (run == begin || index[0] >= (run - 1)->End)
+    return 0;
+
+  return m_Components[run - 1 - m_Runs.begin()];
+}
+
+std::size_t mitk::ParallelFloodFill::GetNumberOfVoxels(unsigned int component) const
+{
+  std::size_t numberOfVoxels = 0;
+
+  for (std::size_t i = 0; i < m_Runs.size(); ++i)
+  {
+    if (m_Components[i] == component)
+      numberOfVoxels += m_Runs[i].End - m_Runs[i].Begin;
+  }
+
+  return numberOfVoxels;
+}
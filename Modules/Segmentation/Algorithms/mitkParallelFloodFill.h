@@ -0,0 +1,192 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelFloodFill_h_Included
+#define mitkParallelFloodFill_h_Included
+
+#include <MitkSegmentationExports.h>
+
+#include <itkImage.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Parallel flood fill and connected component labeling of 2D and 3D images.
+
+    The voxels of a region (e.g. all voxels within a threshold interval) are collected as runs along x.
+    The runs are grouped into blocks of consecutive rows, and the face connected runs within each block are
+    joined by a union-find in parallel. Only the runs at the borders of the blocks are joined sequentially.
+
+    This replaces the single-threaded, queue-based flood fill of itk::ConnectedThresholdImageFilter and the
+    labeling of itk::ConnectedComponentImageFilter (both with face connectivity): a flood fill from a seed is
+    the component that contains the seed.
+
+    \code
+    auto fill = mitk::ParallelFloodFill::FromThreshold(itkImage, lower, upper);
+    fill.WriteComponent(fill.GetComponent(itkImage, seedIndex), OutputPixelType(1), outputImage.GetPointer());
+    \endcode
+  */
+  class MITKSEGMENTATION_EXPORT ParallelFloodFill
+  {
+  public:
+    /** \brief Size and index (x, y, z). z is 0 and the size in z is 1 for 2D images.*/
+    typedef std::array<unsigned int, 3> SizeType;
+    typedef std::array<unsigned int, 3> IndexType;
+
+    /** \brief Sets inside[x] to a nonzero value for all voxels of row (y, z) that belong to the region.
+      It is called in parallel for different rows.*/
+    typedef std::function<void(unsigned int y, unsigned int z, unsigned char *inside)> RowPredicateType;
+
+    /** \brief Labels the connected components of the region given by the predicate.*/
+    ParallelFloodFill(const SizeType &size, const RowPredicateType &isInside);
+
+    /** \brief Labels the connected components of all voxels with lower <= value <= upper.
+
+      The thresholds are cast to the pixel type, like in itk::ConnectedThresholdImageFilter.
+    */
+    template <typename TPixel, unsigned int VDimension>
+    static ParallelFloodFill FromThreshold(const itk::Image<TPixel, VDimension> *image, double lower, double upper)
+    {
+      const TPixel lowerValue = static_cast<TPixel>(lower);
+      const TPixel upperValue = static_cast<TPixel>(upper);
+      const SizeType size = GetSize(image);
+      const TPixel *buffer = image->GetBufferPointer();
+
+      return ParallelFloodFill(size, [=](unsigned int y, unsigned int z, unsigned char *inside) {
+        const TPixel *row = buffer + (static_cast<std::size_t>(z) * size[1] + y) * size[0];
+        for (unsigned int x = 0; x < size[0]; ++x)
+          inside[x] = lowerValue <= row[x] && row[x] <= upperValue;
+      });
+    }
+
+    /** \brief Number of connected components.*/
+    unsigned int GetNumberOfComponents() const { return m_NumberOfComponents; }
+
+    /** \brief Component of a voxel, 0 for voxels outside of the region.
+
+      The components are numbered from 1 in the order of their first voxel in memory, like the labels of
+      itk::ConnectedComponentImageFilter.
+    */
+    unsigned int GetComponent(const IndexType &index) const;
+
+    /** \brief Component of a voxel given by an index of the buffered region of an image.*/
+    template <typename TPixel, unsigned int VDimension>
+    unsigned int GetComponent(const itk::Image<TPixel, VDimension> *image,
+                              const itk::Index<VDimension> &imageIndex) const
+    {
+      if (!image->GetBufferedRegion().IsInside(imageIndex))
+        return 0;
+
+      IndexType index = {{0, 0, 0}};
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+        index[dim] = static_cast<unsigned int>(imageIndex[dim] - image->GetBufferedRegion().GetIndex(dim));
+
+      return this->GetComponent(index);
+    }
+
+    /** \brief Number of voxels of a component.*/
+    std::size_t GetNumberOfVoxels(unsigned int component) const;
+
+    /** \brief Sets the voxels of a component to value and all other voxels to 0.
+
+      All voxels are set to 0 for component 0. The buffer has the size of the image and is x-fastest.
+    */
+    template <typename TPixel>
+    void WriteComponent(unsigned int component, TPixel value, TPixel *buffer) const
+    {
+      this->ParallelForRows([&](std::size_t beginRow, std::size_t endRow) {
+        std::fill(buffer + beginRow * m_Size[0], buffer + endRow * m_Size[0], TPixel(0));
+
+        for (std::size_t row = beginRow; row < endRow; ++row)
+        {
+          TPixel *rowBuffer = buffer + row * m_Size[0];
+
+          for (std::size_t i = m_RowOffsets[row]; i < m_RowOffsets[row + 1]; ++i)
+          {
+            if (m_Components[i] == component)
+              std::fill(rowBuffer + m_Runs[i].Begin, rowBuffer + m_Runs[i].End, value);
+          }
+        }
+      });
+    }
+
+    /** \brief Sets the voxels of a component of an image with the same size to value and all others to 0.*/
+    template <typename TPixel, unsigned int VDimension>
+    void WriteComponent(unsigned int component, TPixel value, itk::Image<TPixel, VDimension> *image) const
+    {
+      this->WriteComponent(component, value, image->GetBufferPointer());
+    }
+
+    /** \brief Sets each voxel to its component, like itk::ConnectedComponentImageFilter.
+
+      The pixel type has to hold GetNumberOfComponents().
+    */
+    template <typename TPixel>
+    void WriteComponents(TPixel *buffer) const
+    {
+      this->ParallelForRows([&](std::size_t beginRow, std::size_t endRow) {
+        std::fill(buffer + beginRow * m_Size[0], buffer + endRow * m_Size[0], TPixel(0));
+
+        for (std::size_t row = beginRow; row < endRow; ++row)
+        {
+          TPixel *rowBuffer = buffer + row * m_Size[0];
+
+          for (std::size_t i = m_RowOffsets[row]; i < m_RowOffsets[row + 1]; ++i)
+            std::fill(rowBuffer + m_Runs[i].Begin, rowBuffer + m_Runs[i].End, static_cast<TPixel>(m_Components[i]));
+        }
+      });
+    }
+
+    template <typename TPixel, unsigned int VDimension>
+    static SizeType GetSize(const itk::Image<TPixel, VDimension> *image)
+    {
+      static_assert(2 == VDimension || 3 == VDimension, "Only 2D and 3D images are supported.");
+
+      SizeType size = {{1, 1, 1}};
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+        size[dim] = image->GetBufferedRegion().GetSize(dim);
+
+      return size;
+    }
+
+  private:
+    /** Run of region voxels [Begin, End) within a row.*/
+    struct Run
+    {
+      unsigned int Begin;
+      unsigned int End;
+    };
+
+    /** Calls function for blocks of consecutive rows [beginRow, endRow) in parallel.*/
+    void ParallelForRows(const std::function<void(std::size_t beginRow, std::size_t endRow)> &function) const;
+
+    void JoinRows(std::size_t row, std::size_t neighborRow, std::vector<std::size_t> &parents) const;
+
+    SizeType m_Size;
+    std::size_t m_NumberOfRows;
+    std::size_t m_RowsPerBlock;
+
+    /** Runs of all rows, the runs of row r are [m_RowOffsets[r], m_RowOffsets[r + 1]).*/
+    std::vector<Run> m_Runs;
+    std::vector<std::size_t> m_RowOffsets;
+
+    std::vector<unsigned int> m_Components;
+    unsigned int m_NumberOfComponents;
+  };
+}
+
+#endif
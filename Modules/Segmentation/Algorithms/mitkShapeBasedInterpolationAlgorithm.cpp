@@ -12,10 +12,10 @@ found in the LICENSE file.
 
 #include "mitkShapeBasedInterpolationAlgorithm.h"
 #include "mitkImageAccessByItk.h"
-#include "mitkImageCast.h"
-#include <mitkITKImageImport.h>
 
 #include <itkFastChamferDistanceImageFilter.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
 #include <itkInvertIntensityImageFilter.h>
 #include <itkIsoContourDistanceImageFilter.h>
 #include <itkSubtractImageFilter.h>
@@ -31,30 +31,46 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   unsigned int /*timeStep*/,
   Image::ConstPointer /*referenceImage*/)
 {
-  mitk::Image::Pointer lowerDistanceImage = mitk::Image::New();
-  AccessFixedDimensionByItk_1(lowerSlice, ComputeDistanceMap, 2, lowerDistanceImage);
-
-  mitk::Image::Pointer upperDistanceImage = mitk::Image::New();
-  AccessFixedDimensionByItk_1(upperSlice, ComputeDistanceMap, 2, upperDistanceImage);
+  DistanceImageType::Pointer lowerDistanceImage = this->ComputeSignedDistanceMap(lowerSlice);
+  DistanceImageType::Pointer upperDistanceImage = this->ComputeSignedDistanceMap(upperSlice);
 
   // calculate where the current slice is in comparison to the lower and upper neighboring slices
   float ratio = (float)(requestedIndex - lowerSliceIndex) / (float)(upperSliceIndex - lowerSliceIndex);
-  AccessFixedDimensionByItk_3(
-    resultImage, InterpolateIntermediateSlice, 2, upperDistanceImage, lowerDistanceImage, ratio);
+  this->InterpolateFromDistanceMaps(lowerDistanceImage, upperDistanceImage, ratio, resultImage);
 
   return resultImage;
 }
 
+mitk::ShapeBasedInterpolationAlgorithm::DistanceImageType::Pointer
+  mitk::ShapeBasedInterpolationAlgorithm::ComputeSignedDistanceMap(const Image *binarySlice,
+                                                                   unsigned int numberOfThreads) const
+{
+  DistanceImageType::Pointer distanceImage;
+  AccessFixedDimensionByItk_2(binarySlice, ComputeDistanceMap, 2, distanceImage, numberOfThreads);
+
+  return distanceImage;
+}
+
+void mitk::ShapeBasedInterpolationAlgorithm::InterpolateFromDistanceMaps(const DistanceImageType *lowerDistanceMap,
+                                                                         const DistanceImageType *upperDistanceMap,
+                                                                         float ratio,
+                                                                         Image *resultImage) const
+{
+  AccessFixedDimensionByItk_3(
+    resultImage, InterpolateIntermediateSlice, 2, lowerDistanceMap, upperDistanceMap, ratio);
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *binaryImage,
-                                                                mitk::Image::Pointer &result)
+                                                                DistanceImageType::Pointer &result,
+                                                                unsigned int numberOfThreads) const
 {
   typedef itk::Image<TPixel, VImageDimension> DistanceFilterInputImageType;
 
-  typedef itk::FastChamferDistanceImageFilter<DistanceFilterImageType, DistanceFilterImageType> DistanceFilterType;
-  typedef itk::IsoContourDistanceImageFilter<DistanceFilterInputImageType, DistanceFilterImageType> IsoContourType;
+  typedef itk::FastChamferDistanceImageFilter<DistanceImageType, DistanceImageType> DistanceFilterType;
+  typedef itk::IsoContourDistanceImageFilter<DistanceFilterInputImageType, DistanceImageType> IsoContourType;
   typedef itk::InvertIntensityImageFilter<DistanceFilterInputImageType> InvertIntensityImageFilterType;
-  typedef itk::SubtractImageFilter<DistanceFilterImageType, DistanceFilterImageType> SubtractImageFilterType;
+  typedef itk::SubtractImageFilter<DistanceImageType, DistanceImageType> SubtractImageFilterType;
 
   typename DistanceFilterType::Pointer distanceFilter = DistanceFilterType::New();
   typename DistanceFilterType::Pointer distanceFilterInverted = DistanceFilterType::New();
@@ -63,6 +79,16 @@ void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image
   typename InvertIntensityImageFilterType::Pointer invertFilter = InvertIntensityImageFilterType::New();
   typename SubtractImageFilterType::Pointer subtractImageFilter = SubtractImageFilterType::New();
 
+  if (0 != numberOfThreads)
+  {
+    distanceFilter->SetNumberOfThreads(numberOfThreads);
+    distanceFilterInverted->SetNumberOfThreads(numberOfThreads);
+    isoContourFilter->SetNumberOfThreads(numberOfThreads);
+    isoContourFilterInverted->SetNumberOfThreads(numberOfThreads);
+    invertFilter->SetNumberOfThreads(numberOfThreads);
+    subtractImageFilter->SetNumberOfThreads(numberOfThreads);
+  }
+
   // arbitrary maximum distance
   int maximumDistance = 100;
 
@@ -90,46 +116,37 @@ void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image
   subtractImageFilter->SetInput1(distanceFilterInverted->GetOutput());
   subtractImageFilter->Update();
 
-  result = mitk::GrabItkImageMemory(subtractImageFilter->GetOutput());
+  result = subtractImageFilter->GetOutput();
+  result->DisconnectPipeline();
 }
 
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::ShapeBasedInterpolationAlgorithm::InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                                                          const mitk::Image::Pointer &lower,
-                                                                          const mitk::Image::Pointer &upper,
-                                                                          float ratio)
+                                                                          const DistanceImageType *lowerDistanceMap,
+                                                                          const DistanceImageType *upperDistanceMap,
+                                                                          float ratio) const
 {
-  typename DistanceFilterImageType::Pointer lowerITK = DistanceFilterImageType::New();
-  typename DistanceFilterImageType::Pointer upperITK = DistanceFilterImageType::New();
-
-  CastToItkImage(lower, lowerITK);
-  CastToItkImage(upper, upperITK);
-
-  itk::ImageRegionConstIteratorWithIndex<DistanceFilterImageType> lowerIter(lowerITK,
-                                                                            lowerITK->GetLargestPossibleRegion());
+  const auto region = lowerDistanceMap->GetLargestPossibleRegion();
 
-  lowerIter.GoToBegin();
-
-  if (!lowerITK->GetLargestPossibleRegion().IsInside(upperITK->GetLargestPossibleRegion()) ||
-      !lowerITK->GetLargestPossibleRegion().IsInside(result->GetLargestPossibleRegion()))
+  if (!region.IsInside(upperDistanceMap->GetLargestPossibleRegion()) ||
+      !region.IsInside(result->GetLargestPossibleRegion()))
   {
     // TODO Exception etc.
     MITK_ERROR << "The regions of the slices for the 2D interpolation are not equally sized!";
     return;
   }
 
+  itk::ImageRegionConstIterator<DistanceImageType> lowerIter(lowerDistanceMap, region);
+  itk::ImageRegionConstIterator<DistanceImageType> upperIter(upperDistanceMap, region);
+  itk::ImageRegionIterator<itk::Image<TPixel, VImageDimension>> resultIter(result, region);
+
   float weight[2] = {1.0f - ratio, ratio};
 
-  while (!lowerIter.IsAtEnd())
+  for (; !lowerIter.IsAtEnd(); ++lowerIter, ++upperIter, ++resultIter)
   {
-    typename DistanceFilterImageType::PixelType lowerPixelVal = lowerIter.Get();
-    typename DistanceFilterImageType::PixelType upperPixelVal = upperITK->GetPixel(lowerIter.GetIndex());
-
-    typename DistanceFilterImageType::PixelType intermediatePixelVal =
-      (weight[0] * upperPixelVal + weight[1] * lowerPixelVal > 0 ? 0 : 1);
-
-    result->SetPixel(lowerIter.GetIndex(), static_cast<TPixel>(intermediatePixelVal));
+    typename DistanceImageType::PixelType intermediatePixelVal =
+      (weight[0] * lowerIter.Get() + weight[1] * upperIter.Get() > 0 ? 0 : 1);
 
-    ++lowerIter;
+    resultIter.Set(static_cast<TPixel>(intermediatePixelVal));
   }
 }
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkSegmentationInterpolationAlgorithm.h"
 #include <MitkSegmentationExports.h>
 
+#include <itkImage.h>
+
 namespace mitk
 {
   /**
@@ -47,17 +49,41 @@ namespace mitk
                                  unsigned int timeStep,
                                  Image::ConstPointer referenceImage) override;
 
-  private:
-    typedef itk::Image<mitk::ScalarType, 2> DistanceFilterImageType;
+    typedef itk::Image<mitk::ScalarType, 2> DistanceImageType;
+
+    /**
+     * \brief Computes the signed distance map of a binary slice (negative inside, positive outside).
+     *
+     * Interpolate() computes the distance maps of both neighboring slices for every requested slice. When
+     * many slices are interpolated between the same segmented slices, their distance maps can be computed once
+     * with this method and passed to InterpolateFromDistanceMaps() for each requested slice.
+     *
+     * \param numberOfThreads Number of threads of the distance filters, 0 for the ITK default. Use 1 when
+     *        several slices are processed in parallel.
+     */
+    DistanceImageType::Pointer ComputeSignedDistanceMap(const Image *binarySlice, unsigned int numberOfThreads = 0) const;
 
+    /**
+     * \brief Fills resultImage with the interpolation between the distance maps of two segmented slices.
+     *
+     * \param ratio Position of the requested slice between the lower (0) and the upper (1) slice.
+     */
+    void InterpolateFromDistanceMaps(const DistanceImageType *lowerDistanceMap,
+                                     const DistanceImageType *upperDistanceMap,
+                                     float ratio,
+                                     Image *resultImage) const;
+
+  private:
     template <typename TPixel, unsigned int VImageDimension>
-    void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *, mitk::Image::Pointer &result);
+    void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *,
+                            DistanceImageType::Pointer &result,
+                            unsigned int numberOfThreads) const;
 
     template <typename TPixel, unsigned int VImageDimension>
     void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                      const mitk::Image::Pointer &lowerDistanceImage,
-                                      const mitk::Image::Pointer &upperDistanceImage,
-                                      float ratio);
+                                      const DistanceImageType *lowerDistanceMap,
+                                      const DistanceImageType *upperDistanceMap,
+                                      float ratio) const;
   };
 
 } // namespace
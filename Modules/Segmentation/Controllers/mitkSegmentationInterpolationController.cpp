@@ -17,7 +17,9 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
-//#include <mitkPlaneGeometry.h>
+#include <mitkParallelFor.h>
+#include <mitkPixelTypeMultiplex.h>
+#include <mitkPlaneGeometry.h>
 
 #include "mitkShapeBasedInterpolationAlgorithm.h"
 
@@ -25,9 +27,81 @@ found in the LICENSE file.
 #include <itkImage.h>
 #include <itkImageSliceConstIteratorWithIndex.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace
+{
+  /// number of axial slices that are scanned as one work item and whose counts are kept together
+  const unsigned int SlabDepth = 16;
+
+  struct ScanData
+  {
+    std::vector<const void *> Volumes; // raw data of each time step
+    unsigned int Dimensions[3];
+    const std::vector<std::pair<unsigned int, unsigned int>> *Slabs;
+    std::vector<std::vector<std::vector<unsigned int>>> *CountInSlice;
+    std::vector<std::vector<std::array<std::vector<unsigned int>, 2>>> *CountInSlab;
+  };
+
+  template <typename TPixel>
+  void ScanSlab(ScanData &data, unsigned int timeStep, unsigned int slab)
+  {
+    const std::size_t sliceSize = static_cast<std::size_t>(data.Dimensions[0]) * data.Dimensions[1];
+    const unsigned int firstSlice = slab * SlabDepth;
+    const unsigned int endSlice = std::min(firstSlice + SlabDepth, data.Dimensions[2]);
+
+    auto &countInX = (*data.CountInSlab)[timeStep][slab][0];
+    auto &countInY = (*data.CountInSlab)[timeStep][slab][1];
+    auto &countInZ = (*data.CountInSlice)[timeStep][2];
+
+    std::fill(countInX.begin(), countInX.end(), 0);
+    std::fill(countInY.begin(), countInY.end(), 0);
+
+    const auto *pixel = static_cast<const TPixel *>(data.Volumes[timeStep]) + firstSlice * sliceSize;
+
+    for (unsigned int z = firstSlice; z < endSlice; ++z)
+    {
+      unsigned int countInSlice = 0;
+
+      for (unsigned int y = 0; y < data.Dimensions[1]; ++y)
+      {
+        unsigned int countInRow = 0;
+
+        for (unsigned int x = 0; x < data.Dimensions[0]; ++x, ++pixel)
+        {
+          if (0 == *pixel)
+            continue;
+
+          const auto value = static_cast<unsigned int>(*pixel);
+          countInX[x] += value;
+          countInRow += value;
+        }
+
+        countInY[y] += countInRow;
+        countInSlice += countInRow;
+      }
+
+      countInZ[z] = countInSlice;
+    }
+  }
+
+  template <typename TPixel>
+  void ScanSlabsOfPixelType(const mitk::PixelType &, ScanData &data)
+  {
+    mitk::ParallelFor(data.Slabs->size(), [&data](std::size_t i) {
+      ScanSlab<TPixel>(data, (*data.Slabs)[i].first, (*data.Slabs)[i].second);
+    });
+  }
+}
+
 mitk::SegmentationInterpolationController::InterpolatorMapType
   mitk::SegmentationInterpolationController::s_InterpolatorForImage; // static member initialization
 
+mitk::SegmentationInterpolationController::CountCacheType mitk::SegmentationInterpolationController::s_CountCache;
+
 mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationController::InterpolatorForImage(
   const Image *image)
 {
@@ -43,7 +117,11 @@ mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationContro
 }
 
 mitk::SegmentationInterpolationController::SegmentationInterpolationController()
-  : m_BlockModified(false), m_2DInterpolationActivated(false)
+  : m_BlockModified(false),
+    m_2DInterpolationActivated(false),
+    m_ModifiedObserverTag(0),
+    m_CountsMTime(0),
+    m_ReportedChangeOnValidCounts(false)
 {
 }
 
@@ -65,6 +143,12 @@ mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationContro
 
 mitk::SegmentationInterpolationController::~SegmentationInterpolationController()
 {
+  if (m_Segmentation.IsNotNull())
+  {
+    this->StoreCounts();
+    const_cast<Image *>(m_Segmentation.GetPointer())->RemoveObserver(m_ModifiedObserverTag);
+  }
+
   // remove this from the list of interpolators
   for (auto iter = s_InterpolatorForImage.begin(); iter != s_InterpolatorForImage.end(); ++iter)
   {
@@ -78,7 +162,19 @@ mitk::SegmentationInterpolationController::~SegmentationInterpolationController(
 
 void mitk::SegmentationInterpolationController::OnImageModified(const itk::EventObject &)
 {
-  if (!m_BlockModified && m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
+  if (m_BlockModified)
+  {
+    // the change was reported to us by one of the SetChanged...() methods
+    if (m_ReportedChangeOnValidCounts && m_Segmentation.IsNotNull())
+      m_CountsMTime = m_Segmentation->GetMTime();
+
+    m_ReportedChangeOnValidCounts = false;
+    return;
+  }
+
+  m_ReportedChangeOnValidCounts = false;
+
+  if (m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
   {
     SetSegmentationVolume(m_Segmentation);
   }
@@ -91,8 +187,13 @@ void mitk::SegmentationInterpolationController::BlockModified(bool block)
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
 {
+  // keep the counts of the current segmentation, so that setting it again does not need a new scan
+  if (m_Segmentation.IsNotNull())
+    this->StoreCounts();
+
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
+  m_SegmentationCountInSlab.clear();
 
   // delete this from the list of interpolators
   auto iter = s_InterpolatorForImage.find(segmentation);
@@ -110,39 +211,51 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   if (m_Segmentation != segmentation)
   {
+    // stop observing the previous segmentation
+    if (m_Segmentation.IsNotNull())
+      const_cast<Image *>(m_Segmentation.GetPointer())->RemoveObserver(m_ModifiedObserverTag);
+
     // observe Modified() event of image
     itk::ReceptorMemberCommand<SegmentationInterpolationController>::Pointer command =
       itk::ReceptorMemberCommand<SegmentationInterpolationController>::New();
     command->SetCallbackFunction(this, &SegmentationInterpolationController::OnImageModified);
-    segmentation->AddObserver(itk::ModifiedEvent(), command);
+    m_ModifiedObserverTag = segmentation->AddObserver(itk::ModifiedEvent(), command);
   }
 
   m_Segmentation = segmentation;
+  m_ReportedChangeOnValidCounts = false;
+
+  s_InterpolatorForImage.insert(std::make_pair(m_Segmentation, this));
 
-  m_SegmentationCountInSlice.resize(m_Segmentation->GetTimeSteps());
-  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
+  if (!this->RestoreCounts())
   {
-    m_SegmentationCountInSlice[timeStep].resize(3);
-    for (unsigned int dim = 0; dim < 3; ++dim)
+    const unsigned int numberOfSlabs = (m_Segmentation->GetDimension(2) + SlabDepth - 1) / SlabDepth;
+
+    m_SegmentationCountInSlice.resize(m_Segmentation->GetTimeSteps());
+    m_SegmentationCountInSlab.resize(m_Segmentation->GetTimeSteps());
+    SlabListType slabs;
+
+    for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
     {
-      m_SegmentationCountInSlice[timeStep][dim].clear();
-      m_SegmentationCountInSlice[timeStep][dim].resize(m_Segmentation->GetDimension(dim));
-      m_SegmentationCountInSlice[timeStep][dim].assign(m_Segmentation->GetDimension(dim), 0);
-    }
-  }
+      m_SegmentationCountInSlice[timeStep].resize(3);
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        m_SegmentationCountInSlice[timeStep][dim].assign(m_Segmentation->GetDimension(dim), 0);
+      }
 
-  s_InterpolatorForImage.insert(std::make_pair(m_Segmentation, this));
+      m_SegmentationCountInSlab[timeStep].resize(numberOfSlabs);
+      for (unsigned int slab = 0; slab < numberOfSlabs; ++slab)
+      {
+        m_SegmentationCountInSlab[timeStep][slab][0].assign(m_Segmentation->GetDimension(0), 0);
+        m_SegmentationCountInSlab[timeStep][slab][1].assign(m_Segmentation->GetDimension(1), 0);
+        slabs.emplace_back(timeStep, slab);
+      }
+    }
 
-  // for all timesteps
-  // scan whole image
-  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
-  {
-    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-    timeSelector->SetInput(m_Segmentation);
-    timeSelector->SetTimeNr(timeStep);
-    timeSelector->UpdateLargestPossibleRegion();
-    Image::Pointer segmentation3D = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
+    // for all timesteps
+    // scan whole image
+    this->ScanSlabs(slabs);
+    m_CountsMTime = m_Segmentation->GetMTime();
   }
 
   // PrintStatus();
@@ -152,6 +265,106 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
   Modified();
 }
 
+void mitk::SegmentationInterpolationController::ScanSlabs(const SlabListType &slabs)
+{
+  if (slabs.empty())
+    return;
+
+  ScanData data;
+  data.Slabs = &slabs;
+  data.CountInSlice = &m_SegmentationCountInSlice;
+  data.CountInSlab = &m_SegmentationCountInSlab;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    data.Dimensions[dim] = m_Segmentation->GetDimension(dim);
+
+  // keep the data of all time steps accessible (and locked) while the threads scan them
+  std::vector<std::unique_ptr<ImageReadAccessor>> readAccessors(m_Segmentation->GetTimeSteps());
+  data.Volumes.resize(m_Segmentation->GetTimeSteps(), nullptr);
+
+  for (const auto &slab : slabs)
+  {
+    if (nullptr == readAccessors[slab.first])
+    {
+      readAccessors[slab.first].reset(
+        new ImageReadAccessor(m_Segmentation, m_Segmentation->GetVolumeData(slab.first)));
+      data.Volumes[slab.first] = readAccessors[slab.first]->GetData();
+    }
+  }
+
+  const auto pixelType = m_Segmentation->GetPixelType();
+  mitkPixelTypeMultiplex1(ScanSlabsOfPixelType, pixelType, data);
+
+  // sum up the slabs of each scanned time step
+  for (unsigned int timeStep = 0; timeStep < readAccessors.size(); ++timeStep)
+  {
+    if (nullptr == readAccessors[timeStep])
+      continue;
+
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      auto &countInSlice = m_SegmentationCountInSlice[timeStep][dim];
+      std::fill(countInSlice.begin(), countInSlice.end(), 0);
+
+      for (const auto &countInSlab : m_SegmentationCountInSlab[timeStep])
+      {
+        for (std::size_t index = 0; index < countInSlice.size(); ++index)
+          countInSlice[index] += countInSlab[dim][index];
+      }
+    }
+  }
+}
+
+void mitk::SegmentationInterpolationController::OnChangeReported()
+{
+  if (m_Segmentation.IsNotNull() && m_Segmentation->GetMTime() == m_CountsMTime)
+    m_ReportedChangeOnValidCounts = true;
+}
+
+void mitk::SegmentationInterpolationController::StoreCounts()
+{
+  if (m_Segmentation.IsNull() || m_SegmentationCountInSlice.empty() || m_Segmentation->GetMTime() != m_CountsMTime)
+    return;
+
+  auto iter = s_CountCache.find(m_Segmentation);
+
+  if (iter == s_CountCache.end())
+  {
+    // forget the counts when the image is deleted
+    auto command = itk::CStyleCommand::New();
+    command->SetCallback(&SegmentationInterpolationController::OnCachedImageDeleted);
+    m_Segmentation->AddObserver(itk::DeleteEvent(), command);
+
+    iter = s_CountCache.insert(std::make_pair(m_Segmentation.GetPointer(), CachedCounts())).first;
+  }
+
+  iter->second.CountInSlice = m_SegmentationCountInSlice;
+  iter->second.CountInSlab = m_SegmentationCountInSlab;
+  iter->second.MTime = m_CountsMTime;
+}
+
+bool mitk::SegmentationInterpolationController::RestoreCounts()
+{
+  auto iter = s_CountCache.find(m_Segmentation);
+
+  if (iter == s_CountCache.end() || iter->second.MTime != m_Segmentation->GetMTime() ||
+      iter->second.CountInSlice.size() != m_Segmentation->GetTimeSteps())
+    return false;
+
+  m_SegmentationCountInSlice = iter->second.CountInSlice;
+  m_SegmentationCountInSlab = iter->second.CountInSlab;
+  m_CountsMTime = iter->second.MTime;
+
+  return true;
+}
+
+void mitk::SegmentationInterpolationController::OnCachedImageDeleted(itk::Object *caller,
+                                                                     const itk::EventObject &,
+                                                                     void *)
+{
+  s_CountCache.erase(dynamic_cast<const Image *>(caller));
+}
+
 void mitk::SegmentationInterpolationController::SetReferenceVolume(const Image *referenceImage)
 {
   m_ReferenceImage = referenceImage;
@@ -187,7 +400,10 @@ void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sl
     return;
   if (sliceDiff->GetDimension() != 3)
     return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
 
+  this->OnChangeReported();
   AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
 
   // PrintStatus();
@@ -234,12 +450,68 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
   if (!rawSlice)
     return;
 
+  this->OnChangeReported();
   AccessFixedDimensionByItk_1(
     sliceDiff, ScanChangedSlice, 2, SetChangedSliceOptions(sliceDimension, sliceIndex, dim0, dim1, timeStep, rawSlice));
 
   Modified();
 }
 
+void mitk::SegmentationInterpolationController::SetChangedSlices(unsigned int firstSlice,
+                                                                 unsigned int lastSlice,
+                                                                 unsigned int timeStep)
+{
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
+
+  lastSlice = std::min(lastSlice, m_Segmentation->GetDimension(2) - 1);
+  if (firstSlice > lastSlice)
+    return;
+
+  this->OnChangeReported();
+
+  SlabListType slabs;
+  for (unsigned int slab = firstSlice / SlabDepth; slab <= lastSlice / SlabDepth; ++slab)
+    slabs.emplace_back(timeStep, slab);
+
+  this->ScanSlabs(slabs);
+
+  Modified();
+}
+
+void mitk::SegmentationInterpolationController::SetChangedPlane(const PlaneGeometry *plane, unsigned int timeStep)
+{
+  if (!plane)
+    return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
+
+  const auto *geometry = m_Segmentation->GetGeometry(timeStep);
+  if (!geometry)
+    return;
+
+  // range of axial slices covered by the corners of the plane
+  ScalarType minZ = std::numeric_limits<ScalarType>::max();
+  ScalarType maxZ = std::numeric_limits<ScalarType>::lowest();
+
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point3D index;
+    geometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+    minZ = std::min(minZ, index[2]);
+    maxZ = std::max(maxZ, index[2]);
+  }
+
+  const auto maxSlice = static_cast<ScalarType>(m_Segmentation->GetDimension(2) - 1);
+  if (maxZ < 0 || minZ > maxSlice)
+    return;
+
+  const auto firstSlice = static_cast<unsigned int>(std::floor(std::max<ScalarType>(minZ, 0)));
+  const auto lastSlice = static_cast<unsigned int>(std::ceil(std::min(maxZ, maxSlice)));
+
+  this->SetChangedSlices(firstSlice, lastSlice, timeStep);
+}
+
 template <typename DATATYPE>
 void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Image<DATATYPE, 2> *,
                                                                  const SetChangedSliceOptions &options)
@@ -264,14 +536,25 @@ void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Imag
   unsigned int dim0max = m_SegmentationCountInSlice[timeStep][dim0].size();
   unsigned int dim1max = m_SegmentationCountInSlice[timeStep][dim1].size();
 
+  // index of the current pixel in the volume, needed to find its slab
+  unsigned int index[3];
+  index[sliceDimension] = sliceIndex;
+
   // scan the slice from two directions
   // and set the flags for the two dimensions of the slice
   for (unsigned int v = 0; v < dim1max; ++v)
   {
+    index[dim1] = v;
+
     for (unsigned int u = 0; u < dim0max; ++u)
     {
       DATATYPE value = *(pixelData + u + v * dim0max);
 
+      if (0 == value)
+        continue;
+
+      index[dim0] = u;
+
       assert((signed)m_SegmentationCountInSlice[timeStep][dim0][u] + (signed)value >=
              0); // just for debugging. This must always be true, otherwise some counting is going wrong
       assert((signed)m_SegmentationCountInSlice[timeStep][dim1][v] + (signed)value >= 0);
@@ -281,6 +564,10 @@ void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Imag
       m_SegmentationCountInSlice[timeStep][dim1][v] =
         static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][dim1][v] + value);
       numberOfPixels += static_cast<int>(value);
+
+      auto &countInSlab = m_SegmentationCountInSlab[timeStep][index[2] / SlabDepth];
+      countInSlab[0][index[0]] = static_cast<unsigned int>(countInSlab[0][index[0]] + value);
+      countInSlab[1][index[1]] = static_cast<unsigned int>(countInSlab[1][index[1]] + value);
     }
   }
 
@@ -334,6 +621,10 @@ void mitk::SegmentationInterpolationController::ScanChangedVolume(const itk::Ima
         m_SegmentationCountInSlice[timeStep][1][y] =
           static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][1][y] + value);
 
+        auto &countInSlab = m_SegmentationCountInSlab[timeStep][z / SlabDepth];
+        countInSlab[0][x] = static_cast<unsigned int>(countInSlab[0][x] + value);
+        countInSlab[1][y] = static_cast<unsigned int>(countInSlab[1][y] + value);
+
         numberOfPixels += static_cast<int>(value);
 
         ++iter;
@@ -348,28 +639,6 @@ void mitk::SegmentationInterpolationController::ScanChangedVolume(const itk::Ima
   }
 }
 
-template <typename DATATYPE>
-void mitk::SegmentationInterpolationController::ScanWholeVolume(const itk::Image<DATATYPE, 3> *,
-                                                                const Image *volume,
-                                                                unsigned int timeStep)
-{
-  if (!volume)
-    return;
-  if (timeStep >= m_SegmentationCountInSlice.size())
-    return;
-
-  ImageReadAccessor readAccess(volume, volume->GetVolumeData(timeStep));
-
-  for (unsigned int slice = 0; slice < volume->GetDimension(2); ++slice)
-  {
-    const auto *rawVolume =
-      static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
-    const DATATYPE *rawSlice = rawVolume + (volume->GetDimension(0) * volume->GetDimension(1) * slice);
-
-    ScanChangedSlice<DATATYPE>(nullptr, SetChangedSliceOptions(2, slice, 0, 1, timeStep, rawSlice));
-  }
-}
-
 void mitk::SegmentationInterpolationController::PrintStatus()
 {
   unsigned int timeStep(0); // if needed, put a loop over time steps around everyting, but beware, output will be long
@@ -512,47 +781,8 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
     resultImage = extractor->GetOutput();
     resultImage->DisconnectPipeline();
 
-    // Creating PlaneGeometry for lower slice
-    mitk::PlaneGeometry::Pointer reslicePlane = currentPlane->Clone();
-
-    // Transforming the current origin so that it matches the lower slice
-    mitk::Point3D origin = currentPlane->GetOrigin();
-    m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
-    origin[sliceDimension] = lowerBound;
-    m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
-    reslicePlane->SetOrigin(origin);
-
-    // Extract the lower slice
-    extractor = ExtractSliceFilter::New();
-    extractor->SetInput(m_Segmentation);
-    extractor->SetTimeStep(timeStep);
-    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
-    extractor->SetVtkOutputRequest(false);
-
-    extractor->SetWorldGeometry(reslicePlane);
-    extractor->Modified();
-    extractor->Update();
-    lowerMITKSlice = extractor->GetOutput();
-    lowerMITKSlice->DisconnectPipeline();
-
-    // Transforming the current origin so that it matches the upper slice
-    m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
-    origin[sliceDimension] = upperBound;
-    m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
-    reslicePlane->SetOrigin(origin);
-
-    // Extract the upper slice
-    extractor = ExtractSliceFilter::New();
-    extractor->SetInput(m_Segmentation);
-    extractor->SetTimeStep(timeStep);
-    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
-    extractor->SetVtkOutputRequest(false);
-
-    extractor->SetWorldGeometry(reslicePlane);
-    extractor->Modified();
-    extractor->Update();
-    upperMITKSlice = extractor->GetOutput();
-    upperMITKSlice->DisconnectPipeline();
+    lowerMITKSlice = this->ExtractSlice(currentPlane, sliceDimension, lowerBound, timeStep);
+    upperMITKSlice = this->ExtractSlice(currentPlane, sliceDimension, upperBound, timeStep);
 
     if (lowerMITKSlice.IsNull() || upperMITKSlice.IsNull())
       return nullptr;
@@ -584,3 +814,138 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
                                 timeStep,
                                 m_ReferenceImage);
 }
+
+std::map<unsigned int, mitk::Image::Pointer> mitk::SegmentationInterpolationController::InterpolateAll(
+  unsigned int sliceDimension, const mitk::PlaneGeometry *currentPlane, unsigned int timeStep)
+{
+  std::map<unsigned int, Image::Pointer> interpolations;
+
+  if (m_Segmentation.IsNull() || !currentPlane)
+    return interpolations;
+
+  if (timeStep >= m_SegmentationCountInSlice.size() || sliceDimension > 2)
+    return interpolations;
+
+  const DirtyVectorType &countInSlice = m_SegmentationCountInSlice[timeStep][sliceDimension];
+
+  // segmented slices that bound at least one empty slice, and the empty slices with the positions of their bounds
+  struct IntermediateSlice
+  {
+    unsigned int SliceIndex;
+    std::size_t LowerBound;
+    std::size_t UpperBound;
+    Image::Pointer Slice;
+  };
+
+  std::vector<unsigned int> boundIndices;
+  std::vector<IntermediateSlice> intermediateSlices;
+
+  bool hasLowerBound = false;
+  unsigned int lowerBound = 0;
+
+  for (unsigned int sliceIndex = 0; sliceIndex < countInSlice.size(); ++sliceIndex)
+  {
+    if (0 == countInSlice[sliceIndex])
+      continue;
+
+    if (hasLowerBound && sliceIndex - lowerBound > 1)
+    {
+      if (boundIndices.empty() || boundIndices.back() != lowerBound)
+        boundIndices.push_back(lowerBound);
+
+      boundIndices.push_back(sliceIndex);
+
+      for (unsigned int index = lowerBound + 1; index < sliceIndex; ++index)
+        intermediateSlices.push_back({index, boundIndices.size() - 2, boundIndices.size() - 1, nullptr});
+    }
+
+    hasLowerBound = true;
+    lowerBound = sliceIndex;
+  }
+
+  if (intermediateSlices.empty())
+    return interpolations;
+
+  // the extraction accesses the segmentation through VTK and is done sequentially
+  std::vector<Image::Pointer> boundSlices;
+
+  try
+  {
+    for (auto boundIndex : boundIndices)
+      boundSlices.push_back(this->ExtractSlice(currentPlane, sliceDimension, boundIndex, timeStep));
+
+    for (auto &intermediateSlice : intermediateSlices)
+      intermediateSlice.Slice = this->ExtractSlice(currentPlane, sliceDimension, intermediateSlice.SliceIndex, timeStep);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error in 2D interpolation: " << e.what();
+    return interpolations;
+  }
+
+  auto algorithm = ShapeBasedInterpolationAlgorithm::New();
+  std::vector<ShapeBasedInterpolationAlgorithm::DistanceImageType::Pointer> distanceMaps(boundSlices.size());
+
+  try
+  {
+    // the slices are processed in parallel, so each distance filter runs in a single thread
+    mitk::ParallelFor(boundSlices.size(), [&](std::size_t i) {
+      distanceMaps[i] = algorithm->ComputeSignedDistanceMap(boundSlices[i], 1);
+    });
+
+    mitk::ParallelFor(intermediateSlices.size(), [&](std::size_t i) {
+      const auto &intermediateSlice = intermediateSlices[i];
+      const auto lowerIndex = boundIndices[intermediateSlice.LowerBound];
+      const auto upperIndex = boundIndices[intermediateSlice.UpperBound];
+
+      // calculate where the slice is in comparison to the lower and upper neighboring slices
+      const float ratio =
+        static_cast<float>(intermediateSlice.SliceIndex - lowerIndex) / static_cast<float>(upperIndex - lowerIndex);
+
+      algorithm->InterpolateFromDistanceMaps(distanceMaps[intermediateSlice.LowerBound],
+                                             distanceMaps[intermediateSlice.UpperBound],
+                                             ratio,
+                                             intermediateSlice.Slice);
+    });
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error in 2D interpolation: " << e.what();
+    return interpolations;
+  }
+
+  for (const auto &intermediateSlice : intermediateSlices)
+    interpolations[intermediateSlice.SliceIndex] = intermediateSlice.Slice;
+
+  return interpolations;
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(const PlaneGeometry *plane,
+                                                                           unsigned int sliceDimension,
+                                                                           unsigned int sliceIndex,
+                                                                           unsigned int timeStep) const
+{
+  mitk::PlaneGeometry::Pointer reslicePlane = plane->Clone();
+
+  // Transforming the origin so that it matches the requested slice
+  mitk::Point3D origin = plane->GetOrigin();
+  m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
+  origin[sliceDimension] = sliceIndex;
+  m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
+  reslicePlane->SetOrigin(origin);
+
+  mitk::ExtractSliceFilter::Pointer extractor = ExtractSliceFilter::New();
+  extractor->SetInput(m_Segmentation);
+  extractor->SetTimeStep(timeStep);
+  extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
+  extractor->SetVtkOutputRequest(false);
+
+  extractor->SetWorldGeometry(reslicePlane);
+  extractor->Modified();
+  extractor->Update();
+
+  mitk::Image::Pointer slice = extractor->GetOutput();
+  slice->DisconnectPipeline();
+
+  return slice;
+}
@@ -20,12 +20,15 @@ found in the LICENSE file.
 #include <itkImage.h>
 #include <itkObjectFactory.h>
 
+#include <array>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace mitk
 {
   class Image;
+  class PlaneGeometry;
 
   /**
     \brief Generates interpolations of 2D slices.
@@ -57,6 +60,15 @@ namespace mitk
     each dimension).
     Each item describes one image dimension, each vector item holds the count of pixels in "its" slice.
 
+    The whole image is scanned in parallel, split into slabs of a few axial slices per time step. The counts of each
+    slab are kept, so that a change of some axial slices only requires a new scan of the slabs containing them
+    (see SetChangedSlices() and SetChangedPlane()).
+
+    The counts of a segmentation are kept when another segmentation is set or the controller is destroyed. As long as
+    the segmentation is not modified, setting it again (e.g. when switching back to it) reuses these counts
+    instead of scanning the whole image. Code that writes pixels through an ImageWriteAccessor has to call Modified()
+    on the image (or report the change using one of the SetChanged...() methods), which is common practice anyway.
+
     $Author$
   */
   class MITKSEGMENTATION_EXPORT SegmentationInterpolationController : public itk::Object
@@ -123,6 +135,20 @@ namespace mitk
                          unsigned int timeStep);
     void SetChangedVolume(const Image *sliceDiff, unsigned int timeStep);
 
+    /**
+      \brief Update after the pixels of some axial slices were written directly, e.g. through an ImageWriteAccessor.
+
+      Only the slabs containing the slices firstSlice to lastSlice (both included) are scanned again.
+    */
+    void SetChangedSlices(unsigned int firstSlice, unsigned int lastSlice, unsigned int timeStep);
+
+    /**
+      \brief Update after a (possibly oblique) slice was written to the segmentation.
+
+      Scans again all slabs that intersect the given plane, see SetChangedSlices().
+    */
+    void SetChangedPlane(const PlaneGeometry *plane, unsigned int timeStep);
+
     /**
       \brief Generates an interpolated image for the given slice.
 
@@ -139,6 +165,25 @@ namespace mitk
                                const mitk::PlaneGeometry *currentPlane,
                                unsigned int timeStep);
 
+    /**
+      \brief Generates the interpolations of all slices of one orientation at once.
+
+      Every slice without segmentation between two slices with segmentation is interpolated, i.e. the same slices
+      for which Interpolate() returns a result. In contrast to calling Interpolate() for each slice, the distance map
+      of every segmented slice is computed only once and the slices are interpolated in parallel.
+
+      \param sliceDimension Number of the dimension which is constant for all pixels of the meant slices.
+
+      \param currentPlane Any plane of the meant orientation, e.g. the currently selected one.
+
+      \param timeStep Which time step to use
+
+      \return The interpolated slices by their slice index.
+    */
+    std::map<unsigned int, Image::Pointer> InterpolateAll(unsigned int sliceDimension,
+                                                          const mitk::PlaneGeometry *currentPlane,
+                                                          unsigned int timeStep);
+
     void OnImageModified(const itk::EventObject &);
 
     /**
@@ -178,6 +223,22 @@ namespace mitk
     typedef std::vector<std::vector<DirtyVectorType>> TimeResolvedDirtyVectorType;
     typedef std::map<const Image *, SegmentationInterpolationController *> InterpolatorMapType;
 
+    /// pixel counts of the slices in x and y direction within one slab of axial slices
+    typedef std::array<DirtyVectorType, 2> SlabCountType;
+    typedef std::vector<std::vector<SlabCountType>> TimeResolvedSlabCountType;
+
+    /// slabs to scan, given as pairs of time step and slab number
+    typedef std::vector<std::pair<unsigned int, unsigned int>> SlabListType;
+
+    /// counts of a segmentation that was set before, valid as long as the image has the given modification time
+    struct CachedCounts
+    {
+      TimeResolvedDirtyVectorType CountInSlice;
+      TimeResolvedSlabCountType CountInSlab;
+      unsigned long MTime;
+    };
+    typedef std::map<const Image *, CachedCounts> CountCacheType;
+
     SegmentationInterpolationController(); // purposely hidden
     ~SegmentationInterpolationController() override;
 
@@ -188,8 +249,25 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *, unsigned int timeStep);
 
-    template <typename DATATYPE>
-    void ScanWholeVolume(const itk::Image<DATATYPE, 3> *, const Image *volume, unsigned int timeStep);
+    /// extracts the slice with the given index that is parallel to plane
+    Image::Pointer ExtractSlice(const PlaneGeometry *plane,
+                                unsigned int sliceDimension,
+                                unsigned int sliceIndex,
+                                unsigned int timeStep) const;
+
+    /// scans the given slabs of m_Segmentation in parallel and updates the counts of the slices
+    void ScanSlabs(const SlabListType &slabs);
+
+    /// remembers if the counts are still in sync with the image when a change is reported
+    void OnChangeReported();
+
+    /// stores the counts of m_Segmentation in s_CountCache if they are in sync with the image
+    void StoreCounts();
+
+    /// \return true if valid counts of m_Segmentation were found in s_CountCache
+    bool RestoreCounts();
+
+    static void OnCachedImageDeleted(itk::Object *caller, const itk::EventObject &, void *);
 
     void PrintStatus();
 
@@ -204,12 +282,25 @@ namespace mitk
     */
     TimeResolvedDirtyVectorType m_SegmentationCountInSlice;
 
+    /**
+      The same counts for x and y direction, but restricted to the slabs of axial slices, indexed by
+      m_SegmentationCountInSlab[timeStep][slab][0 or 1][index]. m_SegmentationCountInSlice holds their sums.
+    */
+    TimeResolvedSlabCountType m_SegmentationCountInSlab;
+
     static InterpolatorMapType s_InterpolatorForImage;
+    static CountCacheType s_CountCache;
 
     Image::ConstPointer m_Segmentation;
     Image::ConstPointer m_ReferenceImage;
     bool m_BlockModified;
     bool m_2DInterpolationActivated;
+
+    unsigned long m_ModifiedObserverTag;
+
+    /// modification time of m_Segmentation when the counts were known to be in sync with it
+    unsigned long m_CountsMTime;
+    bool m_ReportedChangeOnValidCounts;
   };
 
 } // namespace
@@ -26,8 +26,7 @@ found in the LICENSE file.
 // ITK
 #include "mitkITKImageImport.h"
 #include "mitkImageAccessByItk.h"
-#include <itkConnectedComponentImageFilter.h>
-#include <itkConnectedThresholdImageFilter.h>
+#include "mitkParallelFloodFill.h"
 #include <itkNeighborhoodIterator.h>
 
 #include <itkImageDuplicator.h>
@@ -189,26 +188,17 @@ void mitk::RegionGrowingTool::StartRegionGrowing(const itk::Image<TPixel, imageD
   typedef itk::Image<TPixel, imageDimension> InputImageType;
   typedef itk::Image<DefaultSegmentationDataType, imageDimension> OutputImageType;
 
-  typedef itk::ConnectedThresholdImageFilter<InputImageType, OutputImageType> RegionGrowingFilterType;
-  typename RegionGrowingFilterType::Pointer regionGrower = RegionGrowingFilterType::New();
-
   // perform region growing in desired segmented region
-  regionGrower->SetInput(inputImage);
-  regionGrower->SetSeed(seedIndex);
-
-  regionGrower->SetLower(thresholds[0]);
-  regionGrower->SetUpper(thresholds[1]);
+  auto regionGrower = ParallelFloodFill::FromThreshold(inputImage, thresholds[0], thresholds[1]);
 
-  try
-  {
-    regionGrower->Update();
-  }
-  catch (...)
-  {
-    return; // Should we do something?
-  }
+  typename OutputImageType::Pointer resultImage = OutputImageType::New();
+  resultImage->CopyInformation(inputImage);
+  resultImage->SetRegions(inputImage->GetBufferedRegion());
+  resultImage->Allocate();
 
-  typename OutputImageType::Pointer resultImage = regionGrower->GetOutput();
+  regionGrower.WriteComponent(regionGrower.GetComponent(inputImage, seedIndex),
+                              DefaultSegmentationDataType(1),
+                              resultImage->GetBufferPointer());
 
   // Smooth result: Every pixel is replaced by the majority of the neighborhood
   typedef itk::NeighborhoodIterator<OutputImageType> NeighborhoodIteratorType;
@@ -260,16 +250,12 @@ void mitk::RegionGrowingTool::StartRegionGrowing(const itk::Image<TPixel, imageD
     MITK_DEBUG << "Region growing result is empty.";
   }
 
-  // Can potentially have multiple regions, use connected component image filter to label disjunct regions
-  typedef itk::ConnectedComponentImageFilter<OutputImageType, OutputImageType> ConnectedComponentImageFilterType;
-  typename ConnectedComponentImageFilterType::Pointer connectedComponentFilter =
-    ConnectedComponentImageFilterType::New();
-  connectedComponentFilter->SetInput(resultImage);
-  connectedComponentFilter->Update();
-  typename OutputImageType::Pointer resultImageCC = connectedComponentFilter->GetOutput();
-  m_ConnectedComponentValue = resultImageCC->GetPixel(seedIndex);
+  // Can potentially have multiple regions, label the disjunct regions
+  auto connectedComponents = ParallelFloodFill::FromThreshold(resultImage.GetPointer(), 1, 1);
+  connectedComponents.WriteComponents(resultImage->GetBufferPointer());
+  m_ConnectedComponentValue = resultImage->GetPixel(seedIndex);
 
-  outputImage = mitk::GrabItkImageMemory(resultImageCC);
+  outputImage = mitk::GrabItkImageMemory(resultImage);
 }
 
 template <typename TPixel, unsigned int imageDimension>
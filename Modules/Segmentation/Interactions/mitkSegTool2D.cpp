@@ -27,6 +27,7 @@ found in the LICENSE file.
 // Includes for 3DSurfaceInterpolation
 #include "mitkImageTimeSelector.h"
 #include "mitkImageToContourFilter.h"
+#include "mitkSegmentationInterpolationController.h"
 #include "mitkSurfaceInterpolationController.h"
 
 // includes for resling and overwriting
@@ -556,19 +557,13 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  DiffSliceOperation* undoOperation = nullptr;
+  mitk::Image::Pointer originalSlice;
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    // Cache the not yet modified slice to create the undo operation
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
     /*============= END undo/redo feature block ========================*/
   }
 
@@ -598,20 +593,56 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   extractor->Modified();
   extractor->Update();
 
+  // let the slice interpolation rescan only the slabs touched by the slice instead of the whole volume
+  auto interpolator = SegmentationInterpolationController::InterpolatorForImage(workingImage);
+  if (nullptr != interpolator)
+  {
+    interpolator->SetChangedPlane(sliceInfo.plane, sliceInfo.timestep);
+    interpolator->BlockModified(true);
+  }
+
   // the image was modified within the pipeline, but not marked so
   workingImage->Modified();
   workingImage->GetVtkImageData()->Modified();
 
+  if (nullptr != interpolator)
+  {
+    interpolator->BlockModified(false);
+  }
+
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
-    auto* doOperation =
-      new DiffSliceOperation(workingImage,
-        extractor->GetOutput(),
-        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    // Store only the XOR difference of the changed region. It is shared by the undo and the redo
+    // operation and is much smaller than the two full slices stored otherwise.
+    mitk::Image::Pointer editedSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
+    auto delta = CompressedSliceDelta::New(originalSlice, editedSlice);
+
+    DiffSliceOperation* undoOperation = nullptr;
+    DiffSliceOperation* doOperation = nullptr;
+
+    if (nullptr != delta)
+    {
+      undoOperation = new DiffSliceOperation(workingImage, delta, sliceInfo.timestep, sliceInfo.plane);
+      doOperation = new DiffSliceOperation(workingImage, delta, sliceInfo.timestep, sliceInfo.plane);
+    }
+    else
+    {
+      undoOperation =
+        new DiffSliceOperation(workingImage,
+          originalSlice,
+          dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+          sliceInfo.timestep,
+          sliceInfo.plane);
+
+      // specify the redo operation with the edited slice
+      doOperation =
+        new DiffSliceOperation(workingImage,
+          extractor->GetOutput(),
+          dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+          sliceInfo.timestep,
+          sliceInfo.plane);
+    }
 
     // create an operation event for the undo stack
     OperationEvent* undoStackItem =
@@ -18,9 +18,9 @@ found in the LICENSE file.
 
 #include <mitkITKImageImport.h>
 #include <mitkImageToContourModelFilter.h>
+#include <mitkParallelFloodFill.h>
 
 #include <itkBinaryFillholeImageFilter.h>
-#include <itkConnectedThresholdImageFilter.h>
 
 mitk::SetRegionTool::SetRegionTool(int paintingPixelValue)
   : FeedbackContourTool("PressMoveRelease"), m_PaintingPixelValue(paintingPixelValue)
@@ -74,8 +74,6 @@ void mitk::SetRegionTool::OnMousePressed(StateMachineAction *, InteractionEvent
 
   typedef itk::Image<DefaultSegmentationDataType, 2> InputImageType;
   typedef InputImageType::IndexType IndexType;
-  typedef itk::ConnectedThresholdImageFilter<InputImageType, InputImageType> RegionGrowingFilterType;
-  RegionGrowingFilterType::Pointer regionGrower = RegionGrowingFilterType::New();
 
   // convert world coordinates to image indices
   IndexType seedIndex;
@@ -84,19 +82,23 @@ void mitk::SetRegionTool::OnMousePressed(StateMachineAction *, InteractionEvent
   // perform region growing in desired segmented region
   InputImageType::Pointer itkImage = InputImageType::New();
   CastToItkImage(workingSlice, itkImage);
-  regionGrower->SetInput(itkImage);
-  regionGrower->AddSeed(seedIndex);
 
   InputImageType::PixelType bound = itkImage->GetPixel(seedIndex);
 
-  regionGrower->SetLower(bound);
-  regionGrower->SetUpper(bound);
-  regionGrower->SetReplaceValue(1);
+  auto regionGrower = ParallelFloodFill::FromThreshold(itkImage.GetPointer(), bound, bound);
+
+  InputImageType::Pointer regionImage = InputImageType::New();
+  regionImage->CopyInformation(itkImage);
+  regionImage->SetRegions(itkImage->GetBufferedRegion());
+  regionImage->Allocate();
+  regionGrower.WriteComponent(regionGrower.GetComponent(itkImage.GetPointer(), seedIndex),
+                              InputImageType::PixelType(1),
+                              regionImage->GetBufferPointer());
 
   itk::BinaryFillholeImageFilter<InputImageType>::Pointer fillHolesFilter =
     itk::BinaryFillholeImageFilter<InputImageType>::New();
 
-  fillHolesFilter->SetInput(regionGrower->GetOutput());
+  fillHolesFilter->SetInput(regionImage);
   fillHolesFilter->SetForegroundValue(1);
 
   // Store result and preview
@@ -0,0 +1,168 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkParallelFloodFill.h>
+
+#include <itkBinaryThresholdImageFilter.h>
+#include <itkConnectedComponentImageFilter.h>
+#include <itkConnectedThresholdImageFilter.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  typedef itk::Image<short, 3> ImageType;
+  typedef itk::Image<unsigned char, 3> MaskImageType;
+  typedef itk::Image<unsigned int, 3> LabelImageType;
+
+  /** CT like volume: a large "organ" (100) with a tubular structure, small "lesions" and a noisy background. */
+  ImageType::Pointer CreateImage(unsigned int size)
+  {
+    auto image = ImageType::New();
+    ImageType::RegionType region;
+    region.SetSize(0, size);
+    region.SetSize(1, size);
+    region.SetSize(2, size);
+    image->SetRegions(region);
+    image->Allocate();
+
+    const double center = 0.5 * size;
+    const double radius = 0.35 * size;
+
+    for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      const auto &index = it.GetIndex();
+      const double dx = index[0] - center;
+      const double dy = index[1] - center;
+      const double dz = index[2] - center;
+
+      short value = static_cast<short>((index[0] * 7 + index[1] * 13 + index[2] * 17) % 50 - 200);
+
+      if (dx * dx + dy * dy + dz * dz < radius * radius)
+        value = 100;
+      else if (dx * dx + dy * dy < 0.01 * size * size)
+        value = 100;
+      else if ((index[0] / 16 + index[1] / 16 + index[2] / 16) % 7 == 0 && index[0] % 16 > 8 && index[1] % 16 > 8)
+        value = 100;
+
+      it.Set(value);
+    }
+
+    return image;
+  }
+
+  template <typename TImage>
+  std::size_t CountForeground(const TImage *image)
+  {
+    std::size_t count = 0;
+    for (itk::ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+      count += 0 != it.Get();
+    return count;
+  }
+
+  double Seconds(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Flood Fill Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Compares the flood fill and the connected component labeling of mitk::ParallelFloodFill "
+                        "with itk::ConnectedThresholdImageFilter and itk::ConnectedComponentImageFilter.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("size", "s", mitkCommandLineParser::Int, "Size:", "Edge length of the cubic image (default: 512)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int size = parsedArgs.count("size") ? us::any_cast<int>(parsedArgs["size"]) : 512;
+
+  auto image = CreateImage(size);
+  ImageType::IndexType seed;
+  seed.Fill(size / 2);
+
+  std::cout << std::fixed << std::setprecision(3);
+
+  // flood fill from the seed
+  auto start = std::chrono::steady_clock::now();
+  auto connectedThreshold = itk::ConnectedThresholdImageFilter<ImageType, MaskImageType>::New();
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->SetLower(50);
+  connectedThreshold->SetUpper(150);
+  connectedThreshold->Update();
+  const double itkFillTime = Seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  auto fillImage = MaskImageType::New();
+  fillImage->CopyInformation(image);
+  fillImage->SetRegions(image->GetBufferedRegion());
+  fillImage->Allocate();
+  auto floodFill = mitk::ParallelFloodFill::FromThreshold(image.GetPointer(), 50, 150);
+  floodFill.WriteComponent(
+    floodFill.GetComponent(image.GetPointer(), seed), MaskImageType::PixelType(1), fillImage.GetPointer());
+  const double parallelFillTime = Seconds(start);
+
+  std::cout << "flood fill [s]:         itk " << itkFillTime << ", parallel " << parallelFillTime << " ("
+            << CountForeground(connectedThreshold->GetOutput()) << " / " << CountForeground(fillImage.GetPointer())
+            << " voxels)" << std::endl;
+
+  // labeling of all components
+  auto threshold = itk::BinaryThresholdImageFilter<ImageType, MaskImageType>::New();
+  threshold->SetInput(image);
+  threshold->SetLowerThreshold(50);
+  threshold->SetUpperThreshold(150);
+  threshold->Update();
+
+  start = std::chrono::steady_clock::now();
+  auto connectedComponents = itk::ConnectedComponentImageFilter<MaskImageType, LabelImageType>::New();
+  connectedComponents->SetInput(threshold->GetOutput());
+  connectedComponents->Update();
+  const double itkLabelTime = Seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  auto labelImage = LabelImageType::New();
+  labelImage->CopyInformation(image);
+  labelImage->SetRegions(image->GetBufferedRegion());
+  labelImage->Allocate();
+  auto labeling = mitk::ParallelFloodFill::FromThreshold(threshold->GetOutput(), 1, 1);
+  labeling.WriteComponents(labelImage->GetBufferPointer());
+  const double parallelLabelTime = Seconds(start);
+
+  std::cout << "component labeling [s]: itk " << itkLabelTime << ", parallel " << parallelLabelTime << " ("
+            << connectedComponents->GetObjectCount() << " / " << labeling.GetNumberOfComponents() << " components)"
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
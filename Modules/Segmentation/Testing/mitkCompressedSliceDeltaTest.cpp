@@ -0,0 +1,204 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkCompressedSliceDelta.h>
+#include <mitkDiffSliceOperation.h>
+#include <mitkException.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkOperationEvent.h>
+#include <mitkPlaneGeometry.h>
+
+#include <cstring>
+
+class mitkCompressedSliceDeltaTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedSliceDeltaTestSuite);
+  MITK_TEST(New_BrushStroke_StoresChangedRegionOnly);
+  MITK_TEST(Apply_BrushStroke_RestoresBothSlices);
+  MITK_TEST(New_EqualSlices_IsEmpty);
+  MITK_TEST(New_DifferentSizes_ReturnsNull);
+  MITK_TEST(Apply_IncompatibleSlice_Throws);
+  MITK_TEST(Apply_SliceChangedInRegion_Throws);
+  MITK_TEST(SetUndoMemoryLimit_SliceEdits_DropsOldestItems);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int SliceSize = 1024;
+
+  mitk::Image::Pointer m_Before;
+  mitk::Image::Pointer m_After;
+
+  static mitk::Image::Pointer CreateSlice(unsigned int width, unsigned int height)
+  {
+    auto slice = mitk::Image::New();
+    unsigned int dimensions[2] = {width, height};
+    slice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+
+    mitk::ImageWriteAccessor writeAccess(slice);
+    std::memset(writeAccess.GetData(), 0, static_cast<std::size_t>(width) * height * sizeof(unsigned short));
+
+    return slice;
+  }
+
+  /** Paints a filled disc like a paintbrush stroke. */
+  static void PaintDisc(mitk::Image *slice, int centerX, int centerY, int radius, unsigned short value)
+  {
+    mitk::ImageWriteAccessor writeAccess(slice);
+    auto *data = static_cast<unsigned short *>(writeAccess.GetData());
+    const int width = slice->GetDimension(0);
+
+    for (int y = centerY - radius; y <= centerY + radius; ++y)
+      for (int x = centerX - radius; x <= centerX + radius; ++x)
+        if ((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY) <= radius * radius)
+          data[y * width + x] = value;
+  }
+
+  static bool Equal(const mitk::Image *slice1, const mitk::Image *slice2)
+  {
+    mitk::ImageReadAccessor access1(slice1);
+    mitk::ImageReadAccessor access2(slice2);
+    const std::size_t numberOfBytes =
+      static_cast<std::size_t>(slice1->GetDimension(0)) * slice1->GetDimension(1) * sizeof(unsigned short);
+
+    return 0 == std::memcmp(access1.GetData(), access2.GetData(), numberOfBytes);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Before = CreateSlice(SliceSize, SliceSize);
+    PaintDisc(m_Before, 300, 300, 100, 1);
+
+    m_After = m_Before->Clone();
+    PaintDisc(m_After, 600, 500, 20, 2);
+  }
+
+  void tearDown() override
+  {
+    m_Before = nullptr;
+    m_After = nullptr;
+  }
+
+  void New_BrushStroke_StoresChangedRegionOnly()
+  {
+    auto delta = mitk::CompressedSliceDelta::New(m_Before, m_After);
+    CPPUNIT_ASSERT(nullptr != delta);
+    CPPUNIT_ASSERT(!delta->IsEmpty());
+
+    CPPUNIT_ASSERT_EQUAL(580u, delta->GetRegionIndex()[0]);
+    CPPUNIT_ASSERT_EQUAL(480u, delta->GetRegionIndex()[1]);
+    CPPUNIT_ASSERT_EQUAL(41u, delta->GetRegionSize()[0]);
+    CPPUNIT_ASSERT_EQUAL(41u, delta->GetRegionSize()[1]);
+
+    // two full slices were stored per undo step before
+    const std::size_t fullSlicesMemory = 2 * SliceSize * SliceSize * sizeof(unsigned short);
+    MITK_INFO << "Memory per undo step: " << delta->GetMemorySize() << " bytes (full slices: " << fullSlicesMemory
+              << " bytes)";
+
+    CPPUNIT_ASSERT(delta->GetMemorySize() < 4096);
+  }
+
+  void Apply_BrushStroke_RestoresBothSlices()
+  {
+    auto delta = mitk::CompressedSliceDelta::New(m_Before, m_After);
+
+    mitk::Image::Pointer slice = m_After->Clone();
+    delta->Apply(slice);
+    CPPUNIT_ASSERT(Equal(slice, m_Before));
+
+    delta->Apply(slice);
+    CPPUNIT_ASSERT(Equal(slice, m_After));
+  }
+
+  void New_EqualSlices_IsEmpty()
+  {
+    auto delta = mitk::CompressedSliceDelta::New(m_Before, m_Before);
+    CPPUNIT_ASSERT(nullptr != delta);
+    CPPUNIT_ASSERT(delta->IsEmpty());
+
+    mitk::Image::Pointer slice = m_After->Clone();
+    delta->Apply(slice);
+    CPPUNIT_ASSERT(Equal(slice, m_After));
+  }
+
+  void New_DifferentSizes_ReturnsNull()
+  {
+    auto smallSlice = CreateSlice(SliceSize, SliceSize / 2);
+    CPPUNIT_ASSERT(nullptr == mitk::CompressedSliceDelta::New(m_Before, smallSlice));
+    CPPUNIT_ASSERT(nullptr == mitk::CompressedSliceDelta::New(m_Before, nullptr));
+  }
+
+  void Apply_IncompatibleSlice_Throws()
+  {
+    auto delta = mitk::CompressedSliceDelta::New(m_Before, m_After);
+    auto smallSlice = CreateSlice(SliceSize, SliceSize / 2);
+
+    CPPUNIT_ASSERT(!delta->IsCompatible(smallSlice));
+    CPPUNIT_ASSERT_THROW(delta->Apply(smallSlice), mitk::Exception);
+  }
+
+  void Apply_SliceChangedInRegion_Throws()
+  {
+    auto delta = mitk::CompressedSliceDelta::New(m_Before, m_After);
+
+    // another edit of the region that is not known to the delta
+    mitk::Image::Pointer slice = m_After->Clone();
+    PaintDisc(slice, 600, 500, 10, 3);
+    mitk::Image::Pointer changedSlice = slice->Clone();
+
+    CPPUNIT_ASSERT(!delta->IsCompatible(slice));
+    CPPUNIT_ASSERT_THROW(delta->Apply(slice), mitk::Exception);
+    CPPUNIT_ASSERT(Equal(slice, changedSlice));
+
+    // edits outside of the region do not affect the delta
+    slice = m_After->Clone();
+    PaintDisc(slice, 100, 100, 10, 3);
+    CPPUNIT_ASSERT(delta->IsCompatible(slice));
+  }
+
+  void SetUndoMemoryLimit_SliceEdits_DropsOldestItems()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    auto plane = mitk::PlaneGeometry::New();
+
+    auto delta = mitk::CompressedSliceDelta::New(m_Before, m_After);
+    // the do and the undo operation account for one half of the shared delta each
+    const std::size_t memoryPerStep = 2 * (delta->GetMemorySize() / 2);
+
+    undoModel->SetUndoMemoryLimit(10 * memoryPerStep);
+
+    for (int i = 0; i < 50; ++i)
+    {
+      auto doOperation = new mitk::DiffSliceOperation(nullptr, delta, 0, plane);
+      auto undoOperation = new mitk::DiffSliceOperation(nullptr, delta, 0, plane);
+      undoModel->SetOperationEvent(new mitk::OperationEvent(nullptr, doOperation, undoOperation, "Segmentation"));
+      mitk::UndoStackItem::IncCurrObjectEventId();
+    }
+
+    CPPUNIT_ASSERT(undoModel->GetUndoMemorySize() <= 10 * memoryPerStep);
+    CPPUNIT_ASSERT(undoModel->GetUndoMemorySize() > 9 * memoryPerStep);
+
+    // the most recent item is always kept
+    undoModel->SetUndoMemoryLimit(1);
+    CPPUNIT_ASSERT_EQUAL(memoryPerStep, undoModel->GetUndoMemorySize());
+
+    undoModel->Clear();
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedSliceDelta)
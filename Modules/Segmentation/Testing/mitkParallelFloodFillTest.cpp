@@ -0,0 +1,214 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkParallelFloodFill.h>
+
+#include <itkConnectedComponentImageFilter.h>
+#include <itkConnectedThresholdImageFilter.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+
+#include <algorithm>
+
+class mitkParallelFloodFillTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelFloodFillTestSuite);
+  MITK_TEST(FromThreshold_3DImage_EqualsConnectedThresholdFilter);
+  MITK_TEST(FromThreshold_2DImage_EqualsConnectedThresholdFilter);
+  MITK_TEST(WriteComponents_3DImage_EqualsConnectedComponentFilter);
+  MITK_TEST(GetComponent_SeedOutsideRegion_IsZero);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 3> ImageType;
+  typedef itk::Image<short, 2> Image2DType;
+  typedef itk::Image<unsigned char, 3> MaskImageType;
+  typedef itk::Image<unsigned char, 2> Mask2DImageType;
+  typedef itk::Image<unsigned int, 3> LabelImageType;
+
+  ImageType::Pointer m_Image;
+
+  /** Pseudo random values in [0, 100), so the region consists of many winding components. */
+  template <typename TImage>
+  static typename TImage::Pointer CreateImage(const typename TImage::SizeType &size)
+  {
+    auto image = TImage::New();
+    typename TImage::IndexType index;
+    index.Fill(5); // the buffered region does not start at 0
+    image->SetRegions(typename TImage::RegionType(index, size));
+    image->Allocate();
+
+    unsigned int state = 12345;
+    for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      state = state * 1103515245 + 12345;
+      it.Set(static_cast<short>((state >> 16) % 100));
+    }
+
+    return image;
+  }
+
+  template <typename TImage1, typename TImage2>
+  static bool Equal(const TImage1 *image1, const TImage2 *image2)
+  {
+    itk::ImageRegionConstIterator<TImage1> it1(image1, image1->GetBufferedRegion());
+    itk::ImageRegionConstIterator<TImage2> it2(image2, image2->GetBufferedRegion());
+
+    for (; !it1.IsAtEnd(); ++it1, ++it2)
+    {
+      if (it1.Get() != it2.Get())
+        return false;
+    }
+
+    return true;
+  }
+
+  template <typename TImage, typename TOutputImage>
+  static typename TOutputImage::Pointer FloodFill(const TImage *image,
+                                                  const typename TImage::IndexType &seed,
+                                                  double lower,
+                                                  double upper)
+  {
+    auto output = TOutputImage::New();
+    output->CopyInformation(image);
+    output->SetRegions(image->GetBufferedRegion());
+    output->Allocate();
+
+    auto fill = mitk::ParallelFloodFill::FromThreshold(image, lower, upper);
+    fill.WriteComponent(fill.GetComponent(image, seed), typename TOutputImage::PixelType(1), output.GetPointer());
+
+    return output;
+  }
+
+public:
+  void setUp() override
+  {
+    ImageType::SizeType size;
+    size[0] = 61;
+    size[1] = 47;
+    size[2] = 53;
+    m_Image = CreateImage<ImageType>(size);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void FromThreshold_3DImage_EqualsConnectedThresholdFilter()
+  {
+    ImageType::IndexType seed;
+    seed[0] = 30;
+    seed[1] = 20;
+    seed[2] = 25;
+
+    // the thresholds are cast to the pixel type
+    const double lower = std::max(0, m_Image->GetPixel(seed) - 40) + 0.5;
+    const double upper = lower + 65;
+
+    auto filter = itk::ConnectedThresholdImageFilter<ImageType, MaskImageType>::New();
+    filter->SetInput(m_Image);
+    filter->SetSeed(seed);
+    filter->SetLower(lower);
+    filter->SetUpper(upper);
+    filter->Update();
+
+    auto result = FloodFill<ImageType, MaskImageType>(m_Image, seed, lower, upper);
+    CPPUNIT_ASSERT(Equal(filter->GetOutput(), result.GetPointer()));
+  }
+
+  void FromThreshold_2DImage_EqualsConnectedThresholdFilter()
+  {
+    Image2DType::SizeType size;
+    size[0] = 200;
+    size[1] = 150;
+    auto image = CreateImage<Image2DType>(size);
+
+    Image2DType::IndexType seed;
+    seed[0] = 100;
+    seed[1] = 60;
+
+    const double lower = std::max(0, image->GetPixel(seed) - 30);
+    const double upper = lower + 60;
+
+    auto filter = itk::ConnectedThresholdImageFilter<Image2DType, Mask2DImageType>::New();
+    filter->SetInput(image);
+    filter->SetSeed(seed);
+    filter->SetLower(lower);
+    filter->SetUpper(upper);
+    filter->Update();
+
+    auto result = FloodFill<Image2DType, Mask2DImageType>(image, seed, lower, upper);
+    CPPUNIT_ASSERT(Equal(filter->GetOutput(), result.GetPointer()));
+  }
+
+  void WriteComponents_3DImage_EqualsConnectedComponentFilter()
+  {
+    auto mask = MaskImageType::New();
+    mask->SetRegions(m_Image->GetBufferedRegion());
+    mask->Allocate();
+
+    itk::ImageRegionConstIterator<ImageType> imageIt(m_Image, m_Image->GetBufferedRegion());
+    itk::ImageRegionIterator<MaskImageType> maskIt(mask, mask->GetBufferedRegion());
+    for (; !imageIt.IsAtEnd(); ++imageIt, ++maskIt)
+      maskIt.Set(imageIt.Get() < 45 ? 1 : 0);
+
+    auto filter = itk::ConnectedComponentImageFilter<MaskImageType, LabelImageType>::New();
+    filter->SetInput(mask);
+    filter->Update();
+
+    auto labeling = mitk::ParallelFloodFill::FromThreshold(mask.GetPointer(), 1, 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(filter->GetObjectCount()), labeling.GetNumberOfComponents());
+
+    auto result = LabelImageType::New();
+    result->SetRegions(mask->GetBufferedRegion());
+    result->Allocate();
+    labeling.WriteComponents(result->GetBufferPointer());
+
+    CPPUNIT_ASSERT(Equal(filter->GetOutput(), result.GetPointer()));
+
+    std::size_t numberOfVoxels = 0;
+    for (unsigned int component = 1; component <= labeling.GetNumberOfComponents(); ++component)
+      numberOfVoxels += labeling.GetNumberOfVoxels(component);
+
+    std::size_t numberOfMaskVoxels = 0;
+    for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt)
+      numberOfMaskVoxels += maskIt.Get();
+
+    CPPUNIT_ASSERT_EQUAL(numberOfMaskVoxels, numberOfVoxels);
+  }
+
+  void GetComponent_SeedOutsideRegion_IsZero()
+  {
+    ImageType::IndexType seed;
+    seed[0] = 10;
+    seed[1] = 10;
+    seed[2] = 10;
+
+    const short value = m_Image->GetPixel(seed);
+    auto fill = mitk::ParallelFloodFill::FromThreshold(m_Image.GetPointer(), value + 1, 200);
+    CPPUNIT_ASSERT_EQUAL(0u, fill.GetComponent(m_Image.GetPointer(), seed));
+
+    // indices outside of the buffered region
+    seed.Fill(0);
+    CPPUNIT_ASSERT_EQUAL(0u, fill.GetComponent(m_Image.GetPointer(), seed));
+
+    auto result = FloodFill<ImageType, MaskImageType>(m_Image, seed, value + 1, 200);
+    std::size_t numberOfVoxels = 0;
+    for (itk::ImageRegionConstIterator<MaskImageType> it(result, result->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+      numberOfVoxels += it.Get();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), numberOfVoxels);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelFloodFill)
@@ -0,0 +1,208 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkSegmentationInterpolationController.h>
+
+#include <vector>
+
+namespace
+{
+  /** Gives access to the slice counts of the controller. */
+  class TestSegmentationInterpolationController : public mitk::SegmentationInterpolationController
+  {
+  public:
+    mitkClassMacro(TestSegmentationInterpolationController, mitk::SegmentationInterpolationController);
+    itkFactorylessNewMacro(Self);
+
+    const TimeResolvedDirtyVectorType &GetCountInSlice() const { return m_SegmentationCountInSlice; }
+  };
+
+  typedef std::vector<std::vector<std::vector<unsigned int>>> CountType;
+}
+
+class mitkSegmentationInterpolationControllerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSegmentationInterpolationControllerTestSuite);
+  MITK_TEST(SetSegmentationVolume_4DImage_CountsAllSlices);
+  MITK_TEST(SetChangedSlices_WrittenSlices_UpdatesCounts);
+  MITK_TEST(SetChangedSlice_Difference_KeepsSlabsConsistent);
+  MITK_TEST(SetSegmentationVolume_UnmodifiedImage_ReusesCounts);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int Width = 23;
+  static const unsigned int Height = 17;
+  static const unsigned int Depth = 41;
+  static const unsigned int TimeSteps = 3;
+
+  mitk::Image::Pointer m_Segmentation;
+  TestSegmentationInterpolationController::Pointer m_Controller;
+
+  static mitk::Image::Pointer CreateSegmentation()
+  {
+    auto segmentation = mitk::Image::New();
+    unsigned int dimensions[4] = {Width, Height, Depth, TimeSteps};
+    segmentation->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 4, dimensions);
+
+    for (unsigned int timeStep = 0; timeStep < TimeSteps; ++timeStep)
+    {
+      mitk::ImageWriteAccessor writeAccess(segmentation, segmentation->GetVolumeData(timeStep));
+      auto *data = static_cast<unsigned char *>(writeAccess.GetData());
+
+      for (unsigned int z = 0; z < Depth; ++z)
+        for (unsigned int y = 0; y < Height; ++y)
+          for (unsigned int x = 0; x < Width; ++x)
+            data[(z * Height + y) * Width + x] = (x + 2 * y + 3 * z + timeStep) % 7 == 0 ? 1 : 0;
+    }
+
+    return segmentation;
+  }
+
+  static void SetPixel(mitk::Image *segmentation, unsigned int x, unsigned int y, unsigned int z, unsigned char value)
+  {
+    mitk::ImageWriteAccessor writeAccess(segmentation, segmentation->GetVolumeData(1));
+    static_cast<unsigned char *>(writeAccess.GetData())[(z * Height + y) * Width + x] = value;
+  }
+
+  /** Counts the pixels of every slice the straightforward way. */
+  static CountType CountPixels(mitk::Image *segmentation)
+  {
+    CountType counts(TimeSteps);
+
+    for (unsigned int timeStep = 0; timeStep < TimeSteps; ++timeStep)
+    {
+      counts[timeStep] = {std::vector<unsigned int>(Width, 0),
+                          std::vector<unsigned int>(Height, 0),
+                          std::vector<unsigned int>(Depth, 0)};
+
+      mitk::ImageReadAccessor readAccess(segmentation, segmentation->GetVolumeData(timeStep));
+      const auto *data = static_cast<const unsigned char *>(readAccess.GetData());
+
+      for (unsigned int z = 0; z < Depth; ++z)
+        for (unsigned int y = 0; y < Height; ++y)
+          for (unsigned int x = 0; x < Width; ++x)
+          {
+            const unsigned char value = data[(z * Height + y) * Width + x];
+            counts[timeStep][0][x] += value;
+            counts[timeStep][1][y] += value;
+            counts[timeStep][2][z] += value;
+          }
+    }
+
+    return counts;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Segmentation = CreateSegmentation();
+    m_Controller = TestSegmentationInterpolationController::New();
+  }
+
+  void tearDown() override
+  {
+    m_Controller = nullptr;
+    m_Segmentation = nullptr;
+  }
+
+  void SetSegmentationVolume_4DImage_CountsAllSlices()
+  {
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+
+    CPPUNIT_ASSERT(CountPixels(m_Segmentation) == m_Controller->GetCountInSlice());
+    CPPUNIT_ASSERT(m_Controller == mitk::SegmentationInterpolationController::InterpolatorForImage(m_Segmentation));
+  }
+
+  void SetChangedSlices_WrittenSlices_UpdatesCounts()
+  {
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+
+    SetPixel(m_Segmentation, 3, 4, 20, 1);
+    SetPixel(m_Segmentation, 5, 6, 21, 1);
+    SetPixel(m_Segmentation, 0, 0, 20, 0);
+    m_Controller->SetChangedSlices(20, 21, 1);
+
+    CPPUNIT_ASSERT(CountPixels(m_Segmentation) == m_Controller->GetCountInSlice());
+
+    // the slice range is clamped to the image
+    SetPixel(m_Segmentation, 22, 16, Depth - 1, 1);
+    m_Controller->SetChangedSlices(Depth - 1, Depth + 10, 1);
+
+    CPPUNIT_ASSERT(CountPixels(m_Segmentation) == m_Controller->GetCountInSlice());
+  }
+
+  void SetChangedSlice_Difference_KeepsSlabsConsistent()
+  {
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+
+    // set a whole sagittal slice (x = 2) of time step 1 and report the difference
+    auto difference = mitk::Image::New();
+    unsigned int dimensions[2] = {Height, Depth};
+    difference->Initialize(mitk::MakeScalarPixelType<short>(), 2, dimensions);
+    {
+      mitk::ImageWriteAccessor writeAccess(difference);
+      auto *diffData = static_cast<short *>(writeAccess.GetData());
+
+      mitk::ImageReadAccessor readAccess(m_Segmentation, m_Segmentation->GetVolumeData(1));
+      const auto *data = static_cast<const unsigned char *>(readAccess.GetData());
+
+      for (unsigned int z = 0; z < Depth; ++z)
+        for (unsigned int y = 0; y < Height; ++y)
+          diffData[z * Height + y] = 1 - data[(z * Height + y) * Width + 2];
+    }
+
+    for (unsigned int z = 0; z < Depth; ++z)
+      for (unsigned int y = 0; y < Height; ++y)
+        SetPixel(m_Segmentation, 2, y, z, 1);
+
+    m_Controller->SetChangedSlice(difference, 0, 2, 1);
+    CPPUNIT_ASSERT(CountPixels(m_Segmentation) == m_Controller->GetCountInSlice());
+
+    // rescanning a slab must not lose the difference reported before
+    SetPixel(m_Segmentation, 7, 7, 33, 1);
+    m_Controller->SetChangedSlices(33, 33, 1);
+    CPPUNIT_ASSERT(CountPixels(m_Segmentation) == m_Controller->GetCountInSlice());
+  }
+
+  void SetSegmentationVolume_UnmodifiedImage_ReusesCounts()
+  {
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+    const auto counts = m_Controller->GetCountInSlice();
+
+    auto otherSegmentation = CreateSegmentation();
+    m_Controller->SetSegmentationVolume(otherSegmentation);
+
+    // not reported and not marked as modified, so switching back must not scan the image again
+    SetPixel(m_Segmentation, 1, 1, 2, 1);
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+    CPPUNIT_ASSERT(counts == m_Controller->GetCountInSlice());
+
+    // a new controller for the same image reuses the counts, too
+    m_Controller = TestSegmentationInterpolationController::New();
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+    CPPUNIT_ASSERT(counts == m_Controller->GetCountInSlice());
+
+    m_Controller->SetSegmentationVolume(otherSegmentation);
+    m_Segmentation->Modified();
+    m_Controller->SetSegmentationVolume(m_Segmentation);
+    CPPUNIT_ASSERT(CountPixels(m_Segmentation) == m_Controller->GetCountInSlice());
+    CPPUNIT_ASSERT(counts != m_Controller->GetCountInSlice());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolationController)
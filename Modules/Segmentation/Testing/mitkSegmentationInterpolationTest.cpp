@@ -19,18 +19,22 @@ found in the LICENSE file.
 #include <mitkIOUtil.h>
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
 #include <mitkSegmentationInterpolationController.h>
 #include <mitkSliceNavigationController.h>
 #include <mitkTool.h>
 #include <mitkVtkImageOverwrite.h>
 
+#include <cstring>
+
 class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkSegmentationInterpolationTestSuite);
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Frontal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(InterpolateAll_Axial_EqualsInterpolationOfEachSlice);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -144,6 +148,34 @@ private:
     }
   }
 
+  void fillSquare(unsigned int slice, int minOffset, int maxOffset)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+    itk::Index<3> currentPoint = m_CenterPoint;
+    currentPoint[2] = slice;
+
+    for (int i = minOffset; i <= maxOffset; ++i)
+    {
+      for (int j = minOffset; j <= maxOffset; ++j)
+      {
+        currentPoint[0] = m_CenterPoint[0] + i;
+        currentPoint[1] = m_CenterPoint[1] + j;
+        writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+      }
+    }
+  }
+
+  static bool equalPixels(mitk::Image *slice1, mitk::Image *slice2)
+  {
+    mitk::ImageReadAccessor access1(slice1);
+    mitk::ImageReadAccessor access2(slice2);
+    const std::size_t numberOfBytes = static_cast<std::size_t>(slice1->GetDimension(0)) * slice1->GetDimension(1) *
+                                      sizeof(mitk::Tool::DefaultSegmentationDataType);
+
+    return slice1->GetDimension(0) == slice2->GetDimension(0) && slice1->GetDimension(1) == slice2->GetDimension(1) &&
+           0 == std::memcmp(access1.GetData(), access2.GetData(), numberOfBytes);
+  }
+
   mitk::Image::Pointer m_ReferenceImage;
   mitk::Image::Pointer m_SegmentationImage;
   itk::Index<3> m_CenterPoint;
@@ -199,6 +231,55 @@ public:
     mitk::SliceNavigationController::ViewDirection viewDirection = mitk::SliceNavigationController::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void InterpolateAll_Axial_EqualsInterpolationOfEachSlice()
+  {
+    // two gaps, the slice in between bounds both of them
+    const unsigned int firstSlice = m_CenterPoint[2] - 6;
+    const unsigned int middleSlice = m_CenterPoint[2];
+    const unsigned int lastSlice = m_CenterPoint[2] + 3;
+
+    fillSquare(firstSlice, -5, 5);
+    fillSquare(middleSlice, 0, 1);
+    fillSquare(lastSlice, -3, 3);
+
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::SliceNavigationController::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    mitk::PlaneGeometry::Pointer plane = navigationController->GetCurrentPlaneGeometry()->Clone();
+
+    const auto interpolations = m_InterpolationController->InterpolateAll(2, plane, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(lastSlice - firstSlice - 2), interpolations.size());
+
+    mitk::Point3D origin = plane->GetOrigin();
+
+    for (unsigned int slice = firstSlice - 1; slice <= lastSlice + 1; ++slice)
+    {
+      m_SegmentationImage->GetSlicedGeometry()->WorldToIndex(origin, origin);
+      origin[2] = slice;
+      m_SegmentationImage->GetSlicedGeometry()->IndexToWorld(origin, origin);
+      plane->SetOrigin(origin);
+
+      mitk::Image::Pointer interpolation = m_InterpolationController->Interpolate(2, slice, plane, 0);
+      auto iter = interpolations.find(slice);
+
+      if (interpolation.IsNull())
+      {
+        CPPUNIT_ASSERT_MESSAGE("Interpolated a segmented or unbounded slice.", iter == interpolations.end());
+      }
+      else
+      {
+        CPPUNIT_ASSERT_MESSAGE("Missed an interpolated slice.", iter != interpolations.end());
+        CPPUNIT_ASSERT_MESSAGE("Interpolation differs from the interpolation of the single slice.",
+                               equalPixels(interpolation, iter->second));
+      }
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
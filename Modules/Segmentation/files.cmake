@@ -1,5 +1,6 @@
 set(CPP_FILES
   Algorithms/mitkCalculateSegmentationVolume.cpp
+  Algorithms/mitkCompressedSliceDelta.cpp
   Algorithms/mitkContourModelSetToImageFilter.cpp
   Algorithms/mitkContourSetToPointSetFilter.cpp
   Algorithms/mitkContourUtils.cpp
@@ -16,6 +17,7 @@ set(CPP_FILES
   Algorithms/mitkOtsuSegmentationFilter.cpp
   Algorithms/mitkOverwriteDirectedPlaneImageFilter.cpp
   Algorithms/mitkOverwriteSliceImageFilter.cpp
+  Algorithms/mitkParallelFloodFill.cpp
   Algorithms/mitkSegmentationObjectFactory.cpp
   Algorithms/mitkShapeBasedInterpolationAlgorithm.cpp
   Algorithms/mitkShowSegmentationAsSmoothedSurface.cpp
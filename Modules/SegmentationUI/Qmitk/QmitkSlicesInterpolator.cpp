@@ -150,6 +150,12 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
   command2->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged);
   SurfaceInterpolationInfoChangedObserverTag = m_SurfaceInterpolator->AddObserver(itk::ModifiedEvent(), command2);
 
+  itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::Pointer command3 =
+    itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::New();
+  command3->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationFinishedEvent);
+  SurfaceInterpolationFinishedObserverTag =
+    m_SurfaceInterpolator->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command3);
+
   // feedback node and its visualization properties
   m_FeedbackNode = mitk::DataNode::New();
   mitk::CoreObjectFactory::GetInstance()->SetDefaultProperties(m_FeedbackNode);
@@ -196,12 +202,7 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
     QWidget::layout()->setContentsMargins(0, 0, 0, 0);
   }
 
-  // For running 3D Interpolation in background
-  // create a QFuture and a QFutureWatcher
-
-  connect(&m_Watcher, SIGNAL(started()), this, SLOT(StartUpdateInterpolationTimer()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(OnSurfaceInterpolationFinished()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(StopUpdateInterpolationTimer()));
+  // The 3D interpolation runs in the background (see Start3DInterpolation())
   m_Timer = new QTimer(this);
   connect(m_Timer, SIGNAL(timeout()), this, SLOT(ChangeSurfaceColor()));
 }
@@ -346,6 +347,7 @@ QmitkSlicesInterpolator::~QmitkSlicesInterpolator()
   // remove observer
   m_Interpolator->RemoveObserver(InterpolationInfoChangedObserverTag);
   m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationInfoChangedObserverTag);
+  m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationFinishedObserverTag);
 
   delete m_Timer;
 }
@@ -613,6 +615,9 @@ void QmitkSlicesInterpolator::Interpolate(mitk::PlaneGeometry *plane,
 
 void QmitkSlicesInterpolator::OnSurfaceInterpolationFinished()
 {
+  if (!m_SurfaceInterpolator->IsBackgroundInterpolationRunning())
+    this->StopUpdateInterpolationTimer();
+
   mitk::Surface::Pointer interpolatedSurface = m_SurfaceInterpolator->GetInterpolationResult();
   mitk::DataNode *workingNode = m_ToolManager->GetWorkingData(0);
 
@@ -762,46 +767,47 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     int sliceIndex(-1);
     mitk::SegTool2D::DetermineAffectedImageSlice(m_Segmentation, reslicePlane, sliceDimension, sliceIndex);
 
-    unsigned int zslices = m_Segmentation->GetDimension(sliceDimension);
-    mitk::ProgressBar::GetInstance()->AddStepsToDo(zslices);
+    // the distance maps of the segmented slices are computed once for all interpolated slices
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(1);
+    const auto interpolations = m_Interpolator->InterpolateAll(sliceDimension, reslicePlane, timeStep);
+    mitk::ProgressBar::GetInstance()->Progress();
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(interpolations.size());
 
     mitk::Point3D origin = reslicePlane->GetOrigin();
     unsigned int totalChangedSlices(0);
 
-    for (unsigned int sliceIndex = 0; sliceIndex < zslices; ++sliceIndex)
+    for (const auto &sliceInterpolation : interpolations)
     {
+      const auto sliceIndex = sliceInterpolation.first;
+      const mitk::Image::Pointer &interpolation = sliceInterpolation.second;
+
       // Transforming the current origin of the reslice plane
       // so that it matches the one of the next slice
       m_Segmentation->GetSlicedGeometry()->WorldToIndex(origin, origin);
       origin[sliceDimension] = sliceIndex;
       m_Segmentation->GetSlicedGeometry()->IndexToWorld(origin, origin);
       reslicePlane->SetOrigin(origin);
-      // Set the slice as 'input'
-      mitk::Image::Pointer interpolation =
-        m_Interpolator->Interpolate(sliceDimension, sliceIndex, reslicePlane, timeStep);
 
-      if (interpolation.IsNotNull()) // we don't check if interpolation is necessary/sensible - but m_Interpolator does
-      {
-        // Setting up the reslicing pipeline which allows us to write the interpolation results back into
-        // the image volume
-        vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-        // set overwrite mode to true to write back to the image volume
-        reslice->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
-        reslice->SetOverwriteMode(true);
-        reslice->Modified();
-
-        mitk::ExtractSliceFilter::Pointer diffslicewriter = mitk::ExtractSliceFilter::New(reslice);
-        diffslicewriter->SetInput(diffImage);
-        diffslicewriter->SetTimeStep(0);
-        diffslicewriter->SetWorldGeometry(reslicePlane);
-        diffslicewriter->SetVtkOutputRequest(true);
-        diffslicewriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-
-        diffslicewriter->Modified();
-        diffslicewriter->Update();
-        ++totalChangedSlices;
-      }
+      // Setting up the reslicing pipeline which allows us to write the interpolation results back into
+      // the image volume
+      vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+      // set overwrite mode to true to write back to the image volume
+      reslice->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
+      reslice->SetOverwriteMode(true);
+      reslice->Modified();
+
+      mitk::ExtractSliceFilter::Pointer diffslicewriter = mitk::ExtractSliceFilter::New(reslice);
+      diffslicewriter->SetInput(diffImage);
+      diffslicewriter->SetTimeStep(0);
+      diffslicewriter->SetWorldGeometry(reslicePlane);
+      diffslicewriter->SetVtkOutputRequest(true);
+      diffslicewriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
+
+      diffslicewriter->Modified();
+      diffslicewriter->Update();
+      ++totalChangedSlices;
+
       mitk::ProgressBar::GetInstance()->Progress();
     }
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
@@ -1142,9 +1148,12 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
   UpdateVisibleSuggestion();
 }
 
-void QmitkSlicesInterpolator::Run3DInterpolation()
+void QmitkSlicesInterpolator::Start3DInterpolation()
 {
-  m_SurfaceInterpolator->Interpolate();
+  m_SurfaceInterpolator->StartBackgroundInterpolation();
+
+  if (m_SurfaceInterpolator->IsBackgroundInterpolationRunning())
+    this->StartUpdateInterpolationTimer();
 }
 
 void QmitkSlicesInterpolator::StartUpdateInterpolationTimer()
@@ -1204,13 +1213,9 @@ void QmitkSlicesInterpolator::On3DInterpolationActivated(bool on)
             ret = msgBox.exec();
           }
 
-          if (m_Watcher.isRunning())
-            m_Watcher.waitForFinished();
-
           if (ret == QMessageBox::Yes)
           {
-            m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-            m_Watcher.setFuture(m_Future);
+            this->Start3DInterpolation();
           }
           else
           {
@@ -1269,13 +1274,17 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::Event
 {
   if (m_3DInterpolationEnabled)
   {
-    if (m_Watcher.isRunning())
-      m_Watcher.waitForFinished();
-    m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-    m_Watcher.setFuture(m_Future);
+    // cancels an outdated interpolation instead of waiting for it
+    this->Start3DInterpolation();
   }
 }
 
+void QmitkSlicesInterpolator::OnSurfaceInterpolationFinishedEvent(const itk::EventObject & /*e*/)
+{
+  // invoked on the worker thread of the interpolation
+  QMetaObject::invokeMethod(this, "OnSurfaceInterpolationFinished", Qt::QueuedConnection);
+}
+
 void QmitkSlicesInterpolator::SetCurrentContourListID()
 {
   // New ContourList = hide current interpolation
@@ -1325,10 +1334,7 @@ void QmitkSlicesInterpolator::SetCurrentContourListID()
 
       if (m_3DInterpolationEnabled)
       {
-        if (m_Watcher.isRunning())
-          m_Watcher.waitForFinished();
-        m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-        m_Watcher.setFuture(m_Future);
+        this->Start3DInterpolation();
       }
     }
     else
@@ -1382,10 +1388,7 @@ void QmitkSlicesInterpolator::OnSliceNavigationControllerDeleted(const itk::Obje
 
 void QmitkSlicesInterpolator::WaitForFutures()
 {
-  if (m_Watcher.isRunning())
-  {
-    m_Watcher.waitForFinished();
-  }
+  m_SurfaceInterpolator->StopBackgroundInterpolation();
 
   if (m_PlaneWatcher.isRunning())
   {
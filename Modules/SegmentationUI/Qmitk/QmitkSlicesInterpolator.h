@@ -114,6 +114,11 @@ public:
   */
   void OnSurfaceInterpolationInfoChanged(const itk::EventObject &);
 
+  /**
+    Just public because it is called by itk::Commands. You should not need to call this.
+  */
+  void OnSurfaceInterpolationFinishedEvent(const itk::EventObject &);
+
   /**
    * @brief Set the visibility of the 3d interpolation
    */
@@ -181,8 +186,6 @@ protected slots:
   void OnInterpolationDisabled(bool);
   void OnShowMarkers(bool);
 
-  void Run3DInterpolation();
-
   void RunPlaneSuggestion();
 
   void OnSurfaceInterpolationFinished();
@@ -232,6 +235,7 @@ private:
   void Show3DInterpolationControls(bool show);
   void CheckSupportedImageDimension();
   void WaitForFutures();
+  void Start3DInterpolation();
   void NodeRemoved(const mitk::DataNode* node);
 
   mitk::SegmentationInterpolationController::Pointer m_Interpolator;
@@ -249,6 +253,7 @@ private:
 
   unsigned int InterpolationInfoChangedObserverTag;
   unsigned int SurfaceInterpolationInfoChangedObserverTag;
+  unsigned int SurfaceInterpolationFinishedObserverTag;
 
   QGroupBox *m_GroupBoxEnableExclusiveInterpolationMode;
   QComboBox *m_CmbInterpolation;
@@ -279,8 +284,6 @@ private:
 
   mitk::DataStorage::Pointer m_DataStorage;
 
-  QFuture<void> m_Future;
-  QFutureWatcher<void> m_Watcher;
   QTimer *m_Timer;
 
   QFuture<void> m_PlaneFuture;
@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkCreateDistanceImageFromSurfaceFilter.h>
+#include <mitkSurface.h>
+
+#include <itkImage.h>
+#include <itkMath.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  /** Circular contour in the plane z with normals pointing outwards, as created by ComputeContourSetNormalsFilter. */
+  mitk::Surface::Pointer CreateCircularContour(double z, double radius, unsigned int numberOfPoints)
+  {
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+
+    polys->InsertNextCell(numberOfPoints);
+
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfPoints;
+      points->InsertNextPoint(radius * std::cos(angle), radius * std::sin(angle), z);
+      normals->InsertNextTuple3(std::cos(angle), std::sin(angle), 0.0);
+      polys->InsertCellPoint(i);
+    }
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    auto contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
+  /** Interpolates a sphere of radius 50 mm from the given number of axial contours and returns the time in seconds. */
+  double Measure(unsigned int numberOfContours, unsigned int pointsPerContour, unsigned int maxNumberOfCenters)
+  {
+    const double radius = 50.0;
+
+    auto referenceImage = itk::Image<unsigned char, 3>::New();
+    itk::Image<unsigned char, 3>::RegionType region;
+    region.SetSize(0, 121);
+    region.SetSize(1, 121);
+    region.SetSize(2, 121);
+    referenceImage->SetRegions(region);
+    itk::Image<unsigned char, 3>::PointType origin;
+    origin.Fill(-60.0);
+    referenceImage->SetOrigin(origin);
+
+    auto filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(referenceImage.GetPointer());
+    filter->SetMaxNumberOfCenters(maxNumberOfCenters);
+
+    std::vector<mitk::Surface::Pointer> contours;
+
+    for (unsigned int i = 0; i < numberOfContours; ++i)
+    {
+      const double z = -0.9 * radius + 1.8 * radius * (i + 0.5) / numberOfContours;
+      contours.push_back(CreateCircularContour(z, std::sqrt(radius * radius - z * z), pointsPerContour));
+      filter->SetInput(i, contours.back());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    filter->Update();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Surface Interpolation Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Measures the time of the 3D surface interpolation (CreateDistanceImageFromSurfaceFilter) of a "
+                        "sphere with an increasing number of contours, using all centers of the radial basis "
+                        "function interpolation and a limited number of selected centers.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("points", "p", mitkCommandLineParser::Int, "Points:", "Number of points per contour (default: 100)", us::Any(), true);
+  parser.addArgument("contours", "c", mitkCommandLineParser::Int, "Contours:", "Maximum number of contours (default: 80)", us::Any(), true);
+  parser.addArgument("centers", "m", mitkCommandLineParser::Int, "Centers:", "Maximum number of selected centers (default: 2000)", us::Any(), true);
+  parser.addArgument("direct", "d", mitkCommandLineParser::Int, "Direct:", "Maximum number of centers for which all centers are used as well (default: 6000)", us::Any(), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0 && argc > 1)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const unsigned int pointsPerContour = parsedArgs.count("points") ? us::any_cast<int>(parsedArgs["points"]) : 100;
+  const unsigned int maxContours = parsedArgs.count("contours") ? us::any_cast<int>(parsedArgs["contours"]) : 80;
+  const unsigned int maxNumberOfCenters = parsedArgs.count("centers") ? us::any_cast<int>(parsedArgs["centers"]) : 2000;
+  const unsigned int maxDirectCenters = parsedArgs.count("direct") ? us::any_cast<int>(parsedArgs["direct"]) : 6000;
+
+  std::cout << std::left << std::setw(10) << "contours" << std::right << std::setw(10) << "centers" << std::setw(14)
+            << "all [s]" << std::setw(14) << "selected [s]" << std::endl;
+
+  for (unsigned int contours = 5; contours <= maxContours; contours *= 2)
+  {
+    const unsigned int numberOfCenters = 3 * contours * pointsPerContour;
+
+    std::cout << std::left << std::setw(10) << contours << std::right << std::setw(10) << numberOfCenters
+              << std::fixed << std::setprecision(3) << std::setw(14);
+
+    // the dense system of all centers needs numberOfCenters^2 doubles, so skip it for large numbers
+    if (numberOfCenters <= maxDirectCenters)
+      std::cout << Measure(contours, pointsPerContour, numberOfCenters);
+    else
+      std::cout << "-";
+
+    std::cout << std::setw(14) << Measure(contours, pointsPerContour, maxNumberOfCenters) << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -14,10 +14,21 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImagePixelReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <itkMath.h>
+
+#include <cmath>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,11 +37,40 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestCreateDistanceImageForSphereWithSelectedCenters);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   std::vector<mitk::Surface::Pointer> contourList;
 
+  /** Creates a circular contour in the plane z with normals pointing outwards, like ComputeContourSetNormalsFilter. */
+  static mitk::Surface::Pointer CreateCircularContour(double z, double radius, unsigned int numberOfPoints)
+  {
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+
+    polys->InsertNextCell(numberOfPoints);
+
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfPoints;
+      points->InsertNextPoint(radius * std::cos(angle), radius * std::sin(angle), z);
+      normals->InsertNextTuple3(std::cos(angle), std::sin(angle), 0.0);
+      polys->InsertCellPoint(i);
+    }
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    auto contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
 public:
   void setUp() override {}
   template <typename TPixel, unsigned int VImageDimension>
@@ -128,6 +168,74 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  // Interpolate a sphere from more contour points than centers are allowed
+  void TestCreateDistanceImageForSphereWithSelectedCenters()
+  {
+    const double radius = 20.0;
+
+    auto referenceImage = itk::Image<unsigned char, 3>::New();
+    itk::Image<unsigned char, 3>::RegionType region;
+    region.SetSize(0, 61);
+    region.SetSize(1, 61);
+    region.SetSize(2, 61);
+    referenceImage->SetRegions(region);
+    itk::Image<unsigned char, 3>::PointType origin;
+    origin.Fill(-30.0);
+    referenceImage->SetOrigin(origin);
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter =
+      mitk::CreateDistanceImageFromSurfaceFilter::New();
+    interpolateSurfaceFilter->SetReferenceImage(referenceImage.GetPointer());
+    interpolateSurfaceFilter->SetMaxNumberOfCenters(300);
+
+    // 9 contours with 60 points each result in 1620 centers
+    unsigned int index = 0;
+    for (double z = -16.0; z <= 16.0; z += 4.0)
+    {
+      contourList.push_back(CreateCircularContour(z, std::sqrt(radius * radius - z * z), 60));
+      interpolateSurfaceFilter->SetInput(index++, contourList.back());
+    }
+
+    interpolateSurfaceFilter->Update();
+
+    mitk::Image::Pointer distanceImage = interpolateSurfaceFilter->GetOutput();
+    CPPUNIT_ASSERT(distanceImage.IsNotNull());
+
+    const double spacing = interpolateSurfaceFilter->GetDistanceImageSpacing();
+    mitk::ImagePixelReadAccessor<double, 3> readAccess(distanceImage);
+    auto geometry = distanceImage->GetGeometry();
+
+    unsigned int numberOfSurfacePixels = 0;
+    itk::Index<3> pixel;
+    itk::Index<3> end;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      end[dim] = distanceImage->GetDimension(dim);
+
+    for (pixel[2] = 0; pixel[2] < end[2]; ++pixel[2])
+      for (pixel[1] = 0; pixel[1] < end[1]; ++pixel[1])
+        for (pixel[0] = 0; pixel[0] < end[0]; ++pixel[0])
+        {
+          const double value = readAccess.GetPixelByIndex(pixel);
+          mitk::Point3D point;
+          geometry->IndexToWorld(pixel, point);
+
+          // the caps of the sphere are not covered by contours
+          if (std::fabs(value) > 2 * spacing || std::fabs(point[2]) > 16.0)
+            continue;
+
+          const double distanceToSphere = point.GetVectorFromOrigin().GetNorm() - radius;
+          CPPUNIT_ASSERT_MESSAGE("Interpolated surface deviates from sphere.", std::fabs(distanceToSphere) < 4 * spacing);
+          ++numberOfSurfacePixels;
+        }
+
+    CPPUNIT_ASSERT(numberOfSurfacePixels > 0);
+
+    mitk::Point3D center;
+    center.Fill(0.0);
+    geometry->WorldToIndex(center, pixel);
+    CPPUNIT_ASSERT_MESSAGE("Center of sphere is not inside.", readAccess.GetPixelByIndex(pixel) < 0);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
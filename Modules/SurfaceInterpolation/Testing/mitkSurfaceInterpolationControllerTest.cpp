@@ -19,6 +19,30 @@ found in the LICENSE file.
 
 #include "mitkImagePixelWriteAccessor.h"
 #include "mitkImageTimeSelector.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+  /** Gives access to the preprocessed contours of the controller. */
+  class TestSurfaceInterpolationController : public mitk::SurfaceInterpolationController
+  {
+  public:
+    mitkClassMacro(TestSurfaceInterpolationController, mitk::SurfaceInterpolationController);
+    itkFactorylessNewMacro(Self);
+
+    const PreprocessedContourMap &GetPreprocessedContours() const { return m_PreprocessedContours; }
+  };
+
+  void CountEvent(itk::Object *, const itk::EventObject &, void *clientData)
+  {
+    ++(*static_cast<std::atomic<int> *>(clientData));
+  }
+}
 
 class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 {
@@ -41,6 +65,10 @@ class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestAddNewContour);
   MITK_TEST(TestRemoveContour);
+
+  MITK_TEST(TestStartBackgroundInterpolation);
+  MITK_TEST(TestStartBackgroundInterpolationWithNewContours);
+  MITK_TEST(TestStopBackgroundInterpolation);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -63,6 +91,59 @@ public:
     return newImage;
   }
 
+  /** Empty segmentation of 50x50x50 voxels with a spacing of 1 mm. */
+  mitk::Image::Pointer createEmptySegmentation()
+  {
+    unsigned int dimensions[] = {50, 50, 50};
+    mitk::Image::Pointer segmentation = createImage(dimensions);
+
+    mitk::ImageWriteAccessor writeAccess(segmentation);
+    std::memset(writeAccess.GetData(), 0, 50 * 50 * 50);
+
+    return segmentation;
+  }
+
+  /** Axial circular contour around the center of the segmentation. */
+  mitk::Surface::Pointer createCircularContour(double z, double radius)
+  {
+    double center[3] = {25.0, 25.0, z};
+    double normal[3] = {0.0, 0.0, 1.0};
+    vtkSmartPointer<vtkRegularPolygonSource> polygonSource = vtkSmartPointer<vtkRegularPolygonSource>::New();
+    polygonSource->SetNumberOfSides(60);
+    polygonSource->SetCenter(center);
+    polygonSource->SetRadius(radius);
+    polygonSource->SetNormal(normal);
+    polygonSource->Update();
+
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polygonSource->GetOutput());
+    return contour;
+  }
+
+  TestSurfaceInterpolationController::Pointer createBackgroundController(mitk::Image *segmentation)
+  {
+    TestSurfaceInterpolationController::Pointer controller = TestSurfaceInterpolationController::New();
+    controller->SetMinSpacing(1.0);
+    controller->SetMaxSpacing(1.0);
+    controller->SetCurrentInterpolationSession(segmentation);
+    return controller;
+  }
+
+  static bool waitForBackgroundInterpolation(mitk::SurfaceInterpolationController *controller)
+  {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+
+    while (controller->IsBackgroundInterpolationRunning())
+    {
+      if (std::chrono::steady_clock::now() > timeout)
+        return false;
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return true;
+  }
+
   void setUp() override
   {
     m_Controller = mitk::SurfaceInterpolationController::GetInstance();
@@ -808,6 +889,96 @@ public:
                            m_Controller->GetCurrentSegmentation().IsNull());
   }
 
+  void TestStartBackgroundInterpolation()
+  {
+    mitk::Image::Pointer segmentation = createEmptySegmentation();
+    TestSurfaceInterpolationController::Pointer controller = createBackgroundController(segmentation);
+
+    controller->AddNewContours(
+      {createCircularContour(15.0, 8.0), createCircularContour(25.0, 12.0), createCircularContour(35.0, 8.0)});
+
+    controller->Interpolate();
+    mitk::Surface::Pointer expectedResult = controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("No interpolation result", expectedResult.IsNotNull());
+
+    std::atomic<int> numberOfFinishedEvents(0);
+    itk::CStyleCommand::Pointer command = itk::CStyleCommand::New();
+    command->SetClientData(&numberOfFinishedEvents);
+    command->SetCallback(CountEvent);
+    controller->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command);
+
+    controller->StartBackgroundInterpolation();
+    CPPUNIT_ASSERT_MESSAGE("Background interpolation did not finish", waitForBackgroundInterpolation(controller));
+
+    mitk::Surface::Pointer result = controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_EQUAL(1, numberOfFinishedEvents.load());
+    CPPUNIT_ASSERT_MESSAGE("No new interpolation result", result.IsNotNull() && result != expectedResult);
+    CPPUNIT_ASSERT_MESSAGE(
+      "Background interpolation differs from interpolation",
+      mitk::Equal(*(expectedResult->GetVtkPolyData()), *(result->GetVtkPolyData()), 0.000001, true));
+  }
+
+  void TestStartBackgroundInterpolationWithNewContours()
+  {
+    mitk::Image::Pointer segmentation = createEmptySegmentation();
+    TestSurfaceInterpolationController::Pointer controller = createBackgroundController(segmentation);
+
+    controller->AddNewContours({createCircularContour(10.0, 6.0), createCircularContour(20.0, 10.0)});
+    controller->StartBackgroundInterpolation();
+    CPPUNIT_ASSERT_MESSAGE("Background interpolation did not finish", waitForBackgroundInterpolation(controller));
+
+    const auto preprocessedContours = controller->GetPreprocessedContours();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), preprocessedContours.size());
+
+    // the first of these runs is outdated by the second one
+    controller->AddNewContour(createCircularContour(30.0, 10.0));
+    controller->StartBackgroundInterpolation();
+    controller->AddNewContour(createCircularContour(40.0, 6.0));
+    controller->StartBackgroundInterpolation();
+    CPPUNIT_ASSERT_MESSAGE("Background interpolation did not finish", waitForBackgroundInterpolation(controller));
+
+    // contours which have been preprocessed before are reused
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), controller->GetPreprocessedContours().size());
+
+    for (const auto &preprocessedContour : preprocessedContours)
+    {
+      CPPUNIT_ASSERT(preprocessedContour.second.reducedContour.IsNotNull());
+      CPPUNIT_ASSERT(preprocessedContour.second.reducedContour ==
+                     controller->GetPreprocessedContours().at(preprocessedContour.first).reducedContour);
+    }
+
+    // the published result belongs to all four contours
+    mitk::Surface::Pointer result = controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("No interpolation result", result.IsNotNull());
+
+    controller->Interpolate();
+    CPPUNIT_ASSERT_MESSAGE("Background interpolation differs from interpolation of all contours",
+                           mitk::Equal(*(controller->GetInterpolationResult()->GetVtkPolyData()),
+                                       *(result->GetVtkPolyData()),
+                                       0.000001,
+                                       true));
+  }
+
+  void TestStopBackgroundInterpolation()
+  {
+    mitk::Image::Pointer segmentation = createEmptySegmentation();
+    TestSurfaceInterpolationController::Pointer controller = createBackgroundController(segmentation);
+
+    controller->AddNewContours(
+      {createCircularContour(10.0, 6.0), createCircularContour(25.0, 12.0), createCircularContour(40.0, 6.0)});
+    controller->StartBackgroundInterpolation();
+    controller->StopBackgroundInterpolation();
+
+    CPPUNIT_ASSERT(!controller->IsBackgroundInterpolationRunning());
+
+    // an interpolation without a selected segmentation does not start a run
+    controller->SetCurrentInterpolationSession(nullptr);
+    controller->StartBackgroundInterpolation();
+
+    CPPUNIT_ASSERT(!controller->IsBackgroundInterpolationRunning());
+    CPPUNIT_ASSERT(controller->GetInterpolationResult().IsNull());
+  }
+
   void TestOnSegmentationDeleted4D()
   {
     {
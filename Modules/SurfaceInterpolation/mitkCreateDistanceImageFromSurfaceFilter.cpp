@@ -22,7 +22,11 @@ found in the LICENSE file.
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNeighborhoodIterator.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <queue>
+#include <set>
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -108,6 +112,7 @@ mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter
   : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
 {
   m_DistanceImageVolume = 50000;
+  m_MaxNumberOfCenters = 2000;
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 5;
 
@@ -130,11 +135,22 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  this->UpdateProgressAndCheckAbort(0.2f);
+
+  if (m_Centers.size() <= m_MaxNumberOfCenters)
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  }
+  else
+  {
+    this->SelectCentersAndSolve();
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
 
+  this->UpdateProgressAndCheckAbort(0.7f);
+
   // The last step is to create the distance map with the interpolated distance function
   this->FillDistanceImage();
 
@@ -168,6 +184,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  // points that are already contained in m_Centers
+  std::set<std::array<double, 3>> existingCenters;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -199,9 +218,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (existingCenters.insert({{p[0], p[1], p[2]}}).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -261,29 +278,132 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
     m_FunctionValues[numberOfCenters * 2 + i] = m_DistanceImageSpacing;
   }
 
-  // Now we have created all centers and all function values. Next step is to create the solution matrix
-  numberOfCenters = m_Centers.size();
+  // Now we have created all centers and all function values. Next step is to create the solution matrix.
+  // If there are too many centers, SelectCentersAndSolve() creates it for a subset of them.
+  if (m_Centers.size() <= m_MaxNumberOfCenters)
+  {
+    CreateSolutionMatrix(m_Centers, m_SolutionMatrix);
+  }
+}
 
-  m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrix(const CenterList &centers,
+                                                                      Eigen::MatrixXd &solutionMatrix)
+{
+  const auto numberOfCenters = static_cast<Eigen::Index>(centers.size());
+  solutionMatrix.resize(numberOfCenters, numberOfCenters);
 
-  m_Weights.resize(numberOfCenters);
+  for (Eigen::Index i = 0; i < numberOfCenters; i++)
+  {
+    solutionMatrix(i, i) = 0.0;
 
-  PointType p1;
-  PointType p2;
-  double norm;
+    for (Eigen::Index j = 0; j < i; j++)
+    {
+      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
+      const double norm = (centers[i] - centers[j]).two_norm();
+      solutionMatrix(i, j) = norm;
+      solutionMatrix(j, i) = norm;
+    }
+  }
+}
 
-  for (unsigned int i = 0; i < numberOfCenters; i++)
+void mitk::CreateDistanceImageFromSurfaceFilter::SelectCentersAndSolve()
+{
+  // m_Centers contains all contour points, followed by their inner points and their outer points
+  const auto numberOfCenters = static_cast<unsigned int>(m_Centers.size());
+  const unsigned int numberOfContourPoints = numberOfCenters / 3;
+  const unsigned int maxNumberOfCenters = std::max(3u, m_MaxNumberOfCenters);
+  const unsigned int numberOfCentersPerIteration = std::max(1u, maxNumberOfCenters / 8);
+  const double tolerance = 0.1 * m_DistanceImageSpacing;
+
+  std::vector<bool> isSelected(numberOfCenters, false);
+  std::vector<unsigned int> selectedCenters;
+
+  // Start with a uniform subsample of the contour points together with their inner and outer points
+  const unsigned int numberOfInitialPoints = std::max(1u, maxNumberOfCenters / 6);
+
+  for (unsigned int i = 0; i < numberOfInitialPoints; i++)
   {
-    for (unsigned int j = 0; j < numberOfCenters; j++)
+    const auto point =
+      static_cast<unsigned int>(static_cast<std::size_t>(i) * numberOfContourPoints / numberOfInitialPoints);
+
+    for (unsigned int j = 0; j < 3; j++)
     {
-      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
-      m_SolutionMatrix(i, j) = norm;
+      isSelected[point + j * numberOfContourPoints] = true;
+      selectedCenters.push_back(point + j * numberOfContourPoints);
     }
   }
+
+  CenterList centers;
+  Eigen::VectorXd functionValues;
+  std::vector<std::pair<double, unsigned int>> residuals;
+
+  while (true)
+  {
+    centers.resize(selectedCenters.size());
+    functionValues.resize(selectedCenters.size());
+
+    for (std::size_t i = 0; i < selectedCenters.size(); i++)
+    {
+      centers[i] = m_Centers[selectedCenters[i]];
+      functionValues[i] = m_FunctionValues[selectedCenters[i]];
+    }
+
+    CreateSolutionMatrix(centers, m_SolutionMatrix);
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(functionValues);
+
+    this->UpdateProgressAndCheckAbort(0.2f + 0.5f * selectedCenters.size() / maxNumberOfCenters);
+
+    if (selectedCenters.size() >= maxNumberOfCenters)
+      break;
+
+    // Add the centers that are approximated worst
+    residuals.clear();
+
+    for (unsigned int i = 0; i < numberOfCenters; i++)
+    {
+      if (isSelected[i])
+        continue;
+
+      const double residual = std::fabs(EvaluateInterpolant(centers, m_Weights, m_Centers[i]) - m_FunctionValues[i]);
+
+      if (residual > tolerance)
+        residuals.emplace_back(residual, i);
+    }
+
+    if (residuals.empty())
+      break;
+
+    const auto numberOfNewCenters = std::min<std::size_t>(
+      residuals.size(), std::min<std::size_t>(numberOfCentersPerIteration, maxNumberOfCenters - selectedCenters.size()));
+
+    std::partial_sort(residuals.begin(),
+                      residuals.begin() + numberOfNewCenters,
+                      residuals.end(),
+                      std::greater<std::pair<double, unsigned int>>());
+
+    for (std::size_t i = 0; i < numberOfNewCenters; i++)
+    {
+      isSelected[residuals[i].second] = true;
+      selectedCenters.push_back(residuals[i].second);
+    }
+  }
+
+  MITK_DEBUG << "Interpolating with " << centers.size() << " of " << numberOfCenters << " centers";
+
+  m_Centers.swap(centers);
+  m_FunctionValues = functionValues;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::UpdateProgressAndCheckAbort(float progress)
+{
+  this->UpdateProgress(progress);
+
+  if (this->GetAbortGenerateData())
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+  }
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
@@ -421,22 +541,24 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
 
 double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
 {
-  double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
+  return EvaluateInterpolant(m_Centers, m_Weights, p);
+}
 
-  CenterList::iterator centerIter;
+double mitk::CreateDistanceImageFromSurfaceFilter::EvaluateInterpolant(const CenterList &centers,
+                                                                       const Eigen::VectorXd &weights,
+                                                                       const PointType &p)
+{
+  double distanceValue(0);
 
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  for (std::size_t i = 0; i < centers.size(); ++i)
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    const double dx = p[0] - centers[i][0];
+    const double dy = p[1] - centers[i][1];
+    const double dz = p[2] - centers[i][2];
+
+    distanceValue += std::sqrt(dx * dx + dy * dy + dz * dz) * weights[i];
   }
+
   return distanceValue;
 }
 
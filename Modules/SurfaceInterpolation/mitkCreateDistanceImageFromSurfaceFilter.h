@@ -99,6 +99,19 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the maximum number of centers of the radial basis function interpolation.
+           Each contour point contributes three centers (the point itself and an inner and an outer point along its
+           normal). The interpolation solves a dense equation system whose size grows quadratically and whose
+           solution time grows cubically with the number of centers.
+           If there are more centers, only a subset of them is used: starting with a uniform subsample of the contour
+           points, the centers that are approximated worst are added until all centers are approximated within a
+           tenth of the distance image spacing or the maximum number of centers is reached.
+           If non is set, the maximum is 2000.
+    */
+    itkSetMacro(MaxNumberOfCenters, unsigned int);
+    itkGetMacro(MaxNumberOfCenters, unsigned int);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -130,8 +143,25 @@ namespace mitk
     void CreateSolutionMatrixAndFunctionValues();
     double CalculateDistanceValue(PointType p);
 
+    /**
+    * \brief Selects a subset of at most m_MaxNumberOfCenters centers and solves the equation system for them.
+    *
+    * Afterwards m_Centers, m_FunctionValues and m_SolutionMatrix only contain the selected centers.
+    */
+    void SelectCentersAndSolve();
+
+    static void CreateSolutionMatrix(const CenterList &centers, Eigen::MatrixXd &solutionMatrix);
+    static double EvaluateInterpolant(const CenterList &centers, const Eigen::VectorXd &weights, const PointType &p);
+
     void FillDistanceImage();
 
+    /**
+    * \brief Reports the progress and throws itk::ProcessAborted if AbortGenerateData has been set.
+    *
+    * Observers of the ProgressEvent can abort the filter this way, e.g. because its inputs are outdated.
+    */
+    void UpdateProgressAndCheckAbort(float progress);
+
     /**
     * \brief This method fills the given variables with the minimum and
     * maximum coordinates that contain all input-points in index- and
@@ -168,6 +198,7 @@ namespace mitk
     double m_DistanceImageSpacing;
     double m_DistanceImageDefaultBufferValue;
     unsigned int m_DistanceImageVolume;
+    unsigned int m_MaxNumberOfCenters;
 
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
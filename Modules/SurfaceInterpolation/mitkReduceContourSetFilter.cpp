@@ -375,116 +375,129 @@ bool mitk::ReduceContourSetFilter::CheckForIntersection(
       continue;
 
     // Get the next polydata to check for intersection
-    vtkSmartPointer<vtkPolyData> poly = this->GetInput(i)->GetVtkPolyData();
-    vtkSmartPointer<vtkCellArray> polygonArray = poly->GetPolys();
-    polygonArray->InitTraversal();
-    vtkIdType anotherInputPolygonSize(0);
-    const vtkIdType *anotherInputPolygonIDs(nullptr);
+    vtkPolyData *poly = this->GetInput(i)->GetVtkPolyData();
 
-    /*
-    The procedure is:
-    - Create the equation of the plane, defined by the points of next input
-    - Calculate the distance of each point of the current polygon to the plane
-    - If the maximum distance is not bigger than 1.5 of the maximum spacing AND the minimal distance is not bigger
-    than 0.5 of the minimum spacing then the current contour is an intersection contour
-    */
+    if (IsIntersectionPolygon(currentCell, currentCellSize, currentPoints, poly, m_MinSpacing, m_MaxSpacing))
+      return false;
+  } // for (to iterate through all inputs)
 
-    for (polygonArray->InitTraversal(); polygonArray->GetNextCell(anotherInputPolygonSize, anotherInputPolygonIDs);)
-    {
-      // Choosing three plane points to calculate the plane vectors
-      double p1[3];
-      double p2[3];
-      double p3[3];
+  return true;
+}
 
-      // The plane vectors
-      double v1[3];
-      double v2[3] = {0};
-      // The plane normal
-      double normal[3];
+bool mitk::ReduceContourSetFilter::IsIntersectionPolygon(const vtkIdType *currentCell,
+                                                        vtkIdType currentCellSize,
+                                                        vtkPoints *currentPoints,
+                                                        vtkPolyData *poly,
+                                                        double minSpacing,
+                                                        double maxSpacing)
+{
+  vtkSmartPointer<vtkCellArray> polygonArray = poly->GetPolys();
+  polygonArray->InitTraversal();
+  vtkIdType anotherInputPolygonSize(0);
+  const vtkIdType *anotherInputPolygonIDs(nullptr);
 
-      // Create first Vector
-      poly->GetPoint(anotherInputPolygonIDs[0], p1);
-      poly->GetPoint(anotherInputPolygonIDs[1], p2);
+  /*
+  The procedure is:
+  - Create the equation of the plane, defined by the points of next input
+  - Calculate the distance of each point of the current polygon to the plane
+  - If the maximum distance is not bigger than 1.5 of the maximum spacing AND the minimal distance is not bigger
+  than 0.5 of the minimum spacing then the current contour is an intersection contour
+  */
 
-      v1[0] = p2[0] - p1[0];
-      v1[1] = p2[1] - p1[1];
-      v1[2] = p2[2] - p1[2];
+  for (polygonArray->InitTraversal(); polygonArray->GetNextCell(anotherInputPolygonSize, anotherInputPolygonIDs);)
+  {
+    // Choosing three plane points to calculate the plane vectors
+    double p1[3];
+    double p2[3];
+    double p3[3];
 
-      // Find 3rd point for 2nd vector (The angle between the two plane vectors should be bigger than 30 degrees)
+    // The plane vectors
+    double v1[3];
+    double v2[3] = {0};
+    // The plane normal
+    double normal[3];
 
-      double maxDistance(0);
-      double minDistance(10000);
+    // Create first Vector
+    poly->GetPoint(anotherInputPolygonIDs[0], p1);
+    poly->GetPoint(anotherInputPolygonIDs[1], p2);
 
-      for (vtkIdType j = 2; j < anotherInputPolygonSize; j++)
-      {
-        poly->GetPoint(anotherInputPolygonIDs[j], p3);
+    v1[0] = p2[0] - p1[0];
+    v1[1] = p2[1] - p1[1];
+    v1[2] = p2[2] - p1[2];
 
-        v2[0] = p3[0] - p1[0];
-        v2[1] = p3[1] - p1[1];
-        v2[2] = p3[2] - p1[2];
+    // Find 3rd point for 2nd vector (The angle between the two plane vectors should be bigger than 30 degrees)
 
-        // Calculate the angle between the two vector for the current point
-        double dotV1V2 = vtkMath::Dot(v1, v2);
-        double absV1 = sqrt(vtkMath::Dot(v1, v1));
-        double absV2 = sqrt(vtkMath::Dot(v2, v2));
-        double cosV1V2 = dotV1V2 / (absV1 * absV2);
+    double maxDistance(0);
+    double minDistance(10000);
 
-        double arccos = acos(cosV1V2);
-        double degree = vtkMath::DegreesFromRadians(arccos);
+    for (vtkIdType j = 2; j < anotherInputPolygonSize; j++)
+    {
+      poly->GetPoint(anotherInputPolygonIDs[j], p3);
 
-        // If angle is bigger than 30 degrees break
-        if (degree > 30)
-          break;
+      v2[0] = p3[0] - p1[0];
+      v2[1] = p3[1] - p1[1];
+      v2[2] = p3[2] - p1[2];
 
-      } // for (to find 3rd point)
+      // Calculate the angle between the two vector for the current point
+      double dotV1V2 = vtkMath::Dot(v1, v2);
+      double absV1 = sqrt(vtkMath::Dot(v1, v1));
+      double absV2 = sqrt(vtkMath::Dot(v2, v2));
+      double cosV1V2 = dotV1V2 / (absV1 * absV2);
 
-      // Calculate normal of the plane by taking the cross product of the two vectors
-      vtkMath::Cross(v1, v2, normal);
-      vtkMath::Normalize(normal);
+      double arccos = acos(cosV1V2);
+      double degree = vtkMath::DegreesFromRadians(arccos);
 
-      // Determine position of the plane
-      double lambda = vtkMath::Dot(normal, p1);
+      // If angle is bigger than 30 degrees break
+      if (degree > 30)
+        break;
 
-      /*
-      Calculate the distance to the plane for each point of the current polygon
-      If the distance is zero then save the currentPoint as intersection point
-      */
-      for (vtkIdType k = 0; k < currentCellSize; k++)
-      {
-        double currentPoint[3];
-        currentPoints->GetPoint(currentCell[k], currentPoint);
+    } // for (to find 3rd point)
 
-        double tempPoint[3];
-        tempPoint[0] = normal[0] * currentPoint[0];
-        tempPoint[1] = normal[1] * currentPoint[1];
-        tempPoint[2] = normal[2] * currentPoint[2];
+    // Calculate normal of the plane by taking the cross product of the two vectors
+    vtkMath::Cross(v1, v2, normal);
+    vtkMath::Normalize(normal);
 
-        double temp = tempPoint[0] + tempPoint[1] + tempPoint[2] - lambda;
-        double distance = fabs(temp);
+    // Determine position of the plane
+    double lambda = vtkMath::Dot(normal, p1);
 
-        if (distance > maxDistance)
-        {
-          maxDistance = distance;
-        }
-        if (distance < minDistance)
-        {
-          minDistance = distance;
-        }
-      } // for (to calculate distance and intersections with currentPolygon)
+    /*
+    Calculate the distance to the plane for each point of the current polygon
+    If the distance is zero then save the currentPoint as intersection point
+    */
+    for (vtkIdType k = 0; k < currentCellSize; k++)
+    {
+      double currentPoint[3];
+      currentPoints->GetPoint(currentCell[k], currentPoint);
+
+      double tempPoint[3];
+      tempPoint[0] = normal[0] * currentPoint[0];
+      tempPoint[1] = normal[1] * currentPoint[1];
+      tempPoint[2] = normal[2] * currentPoint[2];
 
-      if (maxDistance < 1.5 * m_MaxSpacing && minDistance < 0.5 * m_MinSpacing)
+      double temp = tempPoint[0] + tempPoint[1] + tempPoint[2] - lambda;
+      double distance = fabs(temp);
+
+      if (distance > maxDistance)
+      {
+        maxDistance = distance;
+      }
+      if (distance < minDistance)
       {
-        return false;
+        minDistance = distance;
       }
+    } // for (to calculate distance and intersections with currentPolygon)
 
-      // Because we are considering the plane defined by the acual input polygon only one iteration is sufficient
-      // We do not need to consider each cell of the plane
-      break;
-    } // for (to traverse through all cells of actualInputPolyData)
+    if (maxDistance < 1.5 * maxSpacing && minDistance < 0.5 * minSpacing)
+    {
+      return true;
+    }
 
-  } // for (to iterate through all inputs)
+    // Because we are considering the plane defined by the acual input polygon only one iteration is sufficient
+    // We do not need to consider each cell of the plane
+    break;
+  } // for (to traverse through all cells of actualInputPolyData)
 
-  return true;
+  return false;
 }
 
 void mitk::ReduceContourSetFilter::GenerateOutputInformation()
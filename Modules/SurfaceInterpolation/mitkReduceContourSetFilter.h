@@ -96,6 +96,19 @@ namespace mitk
     */
     void SetProgressStepSize(unsigned int stepSize);
 
+    /**
+      \brief Checks whether a polygon just exists because of an intersection with the plane of another contour
+
+      This is the case if all points of the polygon lie close to the plane of the first polygon of \a poly
+      and at least one point lies in this plane. Such polygons are eliminated by the filter.
+    */
+    static bool IsIntersectionPolygon(const vtkIdType *currentCell,
+                                      vtkIdType currentCellSize,
+                                      vtkPoints *currentPoints,
+                                      vtkPolyData *poly,
+                                      double minSpacing,
+                                      double maxSpacing);
+
   protected:
     ReduceContourSetFilter();
     ~ReduceContourSetFilter() override;
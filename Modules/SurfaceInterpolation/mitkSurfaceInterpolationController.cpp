@@ -19,6 +19,91 @@ found in the LICENSE file.
 //#include "vtkXMLPolyDataWriter.h"
 #include "vtkPolyDataWriter.h"
 
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <set>
+
+namespace
+{
+  struct AbortData
+  {
+    const std::atomic<unsigned long> *currentGeneration;
+    unsigned long generation;
+  };
+
+  // Aborts the distance image computation of an outdated background interpolation
+  void AbortIfOutdated(itk::Object *caller, const itk::EventObject &, void *clientData)
+  {
+    const auto *abortData = static_cast<AbortData *>(clientData);
+
+    if (*abortData->currentGeneration != abortData->generation)
+      static_cast<itk::ProcessObject *>(caller)->AbortGenerateDataOn();
+  }
+
+  // Reduces the points of the kept polygons of a contour and computes their normals.
+  // Returns nullptr if no polygon remains.
+  mitk::Surface::Pointer ReduceContour(mitk::Surface *contour,
+                                       const std::vector<bool> &keptPolygons,
+                                       mitk::Image *segmentation,
+                                       double minSpacing,
+                                       double maxSpacing)
+  {
+    mitk::Surface::Pointer input = contour;
+
+    if (std::find(keptPolygons.begin(), keptPolygons.end(), false) != keptPolygons.end())
+    {
+      vtkPolyData *polyData = contour->GetVtkPolyData();
+      vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+
+      const vtkIdType *cell(nullptr);
+      vtkIdType cellSize(0);
+      std::size_t polygon = 0;
+
+      for (polyData->GetPolys()->InitTraversal(); polyData->GetPolys()->GetNextCell(cellSize, cell); ++polygon)
+      {
+        if (keptPolygons[polygon])
+          polys->InsertNextCell(cellSize, cell);
+      }
+
+      if (0 == polys->GetNumberOfCells())
+        return nullptr;
+
+      vtkSmartPointer<vtkPolyData> keptPolyData = vtkSmartPointer<vtkPolyData>::New();
+      keptPolyData->SetPoints(polyData->GetPoints());
+      keptPolyData->SetPolys(polys);
+
+      input = mitk::Surface::New();
+      input->SetVtkPolyData(keptPolyData);
+    }
+
+    mitk::ReduceContourSetFilter::Pointer reduceFilter = mitk::ReduceContourSetFilter::New();
+    reduceFilter->SetMinSpacing(minSpacing);
+    reduceFilter->SetMaxSpacing(maxSpacing);
+    reduceFilter->SetInput(0, input);
+    reduceFilter->Update();
+
+    mitk::Surface::Pointer reducedContour = reduceFilter->GetOutput(0);
+    if (nullptr == reducedContour->GetVtkPolyData() || 0 == reducedContour->GetVtkPolyData()->GetNumberOfCells())
+      return nullptr;
+
+    reducedContour->DisconnectPipeline();
+
+    mitk::ComputeContourSetNormalsFilter::Pointer normalsFilter = mitk::ComputeContourSetNormalsFilter::New();
+    // a negative spacing has not been set, so the filter keeps its default
+    if (maxSpacing > 0)
+      normalsFilter->SetMaxSpacing(maxSpacing);
+    normalsFilter->SetSegmentationBinaryImage(segmentation);
+    normalsFilter->SetInput(0, reducedContour);
+    normalsFilter->Update();
+
+    mitk::Surface::Pointer contourWithNormals = normalsFilter->GetOutput(0);
+    contourWithNormals->DisconnectPipeline();
+
+    return contourWithNormals;
+  }
+}
+
 // Check whether the given contours are coplanar
 bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
                       mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
@@ -74,20 +159,15 @@ mitk::SurfaceInterpolationController::ContourPositionInformation CreateContourPo
 }
 
 mitk::SurfaceInterpolationController::SurfaceInterpolationController()
-  : m_SelectedSegmentation(nullptr), m_CurrentTimePoint(0.)
+  : m_MinSpacing(-1.0),
+    m_MaxSpacing(-1.0),
+    m_DistanceImageVolume(50000),
+    m_SelectedSegmentation(nullptr),
+    m_CurrentTimePoint(0.),
+    m_BackgroundInterpolationRunning(false),
+    m_Generation(0)
 {
   m_DistanceImageSpacing = 0.0;
-  m_ReduceFilter = ReduceContourSetFilter::New();
-  m_NormalsFilter = ComputeContourSetNormalsFilter::New();
-  m_InterpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
-  // m_TimeSelector = ImageTimeSelector::New();
-
-  m_ReduceFilter->SetUseProgressBar(false);
-  //  m_ReduceFilter->SetProgressStepSize(1);
-  m_NormalsFilter->SetUseProgressBar(true);
-  m_NormalsFilter->SetProgressStepSize(1);
-  m_InterpolateSurfaceFilter->SetUseProgressBar(true);
-  m_InterpolateSurfaceFilter->SetProgressStepSize(7);
 
   m_Contours = Surface::New();
 
@@ -96,11 +176,13 @@ mitk::SurfaceInterpolationController::SurfaceInterpolationController()
   m_PolyData->SetPoints(points);
 
   m_InterpolationResult = nullptr;
-  m_CurrentNumberOfReducedContours = 0;
+  m_NumberOfPointsAfterReduction = 0;
 }
 
 mitk::SurfaceInterpolationController::~SurfaceInterpolationController()
 {
+  this->StopBackgroundInterpolation();
+
   // Removing all observers
   auto dataIter = m_SegmentationObserverTags.begin();
   for (; dataIter != m_SegmentationObserverTags.end(); ++dataIter)
@@ -177,14 +259,11 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
   // Don't save a new empty contour
   if (pos == -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
-    m_ReduceFilter->SetInput(m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size(),
-                             newContour);
     m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].push_back(contourInfo);
   }
   else if (pos != -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
     m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].at(pos) = contourInfo;
-    m_ReduceFilter->SetInput(pos, newContour);
   }
   else if (newContour->GetVtkPolyData()->GetNumberOfPoints() == 0)
   {
@@ -262,100 +341,376 @@ unsigned int mitk::SurfaceInterpolationController::GetNumberOfContours()
 
 void mitk::SurfaceInterpolationController::Interpolate()
 {
-  if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
+  InterpolationInput input;
+
+  if (!this->CreateInterpolationInput(input))
   {
-    MITK_WARN << "No interpolation possible, currently selected timepoint is not in the time bounds of currently selected segmentation. Time point: " << m_CurrentTimePoint;
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
     m_InterpolationResult = nullptr;
     return;
   }
-  const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
 
-  m_ReduceFilter->Update();
+  mitk::ProgressBar::GetInstance()->AddStepsToDo(1);
+
+  InterpolationOutput output;
+  this->ComputeInterpolation(input, output);
+  this->PublishInterpolation(output, input.generation);
+
+  mitk::ProgressBar::GetInstance()->Progress();
+}
+
+void mitk::SurfaceInterpolationController::StartBackgroundInterpolation()
+{
+  std::unique_ptr<InterpolationInput> input(new InterpolationInput);
+  const bool validInput = this->CreateInterpolationInput(*input);
+
+  std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+
+  // a run in progress is outdated now
+  input->generation = ++m_Generation;
+
+  if (!validInput)
+  {
+    m_PendingInput.reset();
+
+    std::lock_guard<std::mutex> resultLock(m_ResultMutex);
+    m_InterpolationResult = nullptr;
+    return;
+  }
+
+  m_PendingInput = std::move(input);
+
+  // the worker continues with the pending input
+  if (m_BackgroundInterpolationRunning)
+    return;
+
+  // a previous worker has finished already
+  if (m_BackgroundThread.joinable())
+    m_BackgroundThread.join();
+
+  m_BackgroundInterpolationRunning = true;
+  m_BackgroundThread = std::thread(&SurfaceInterpolationController::RunBackgroundInterpolation, this);
+}
+
+void mitk::SurfaceInterpolationController::StopBackgroundInterpolation()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+    ++m_Generation;
+    m_PendingInput.reset();
+  }
+
+  if (m_BackgroundThread.joinable())
+    m_BackgroundThread.join();
+}
 
-  m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-  if (m_CurrentNumberOfReducedContours == 1)
+bool mitk::SurfaceInterpolationController::IsBackgroundInterpolationRunning() const
+{
+  std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+  return m_BackgroundInterpolationRunning;
+}
+
+void mitk::SurfaceInterpolationController::RunBackgroundInterpolation()
+{
+  while (true)
   {
-    vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-    if (tmp == nullptr)
+    std::unique_ptr<InterpolationInput> input;
+
     {
-      m_CurrentNumberOfReducedContours = 0;
+      std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+      input = std::move(m_PendingInput);
+
+      if (!input)
+      {
+        m_BackgroundInterpolationRunning = false;
+        return;
+      }
+    }
+
+    bool published = false;
+
+    try
+    {
+      InterpolationOutput output;
+      this->ComputeInterpolation(*input, output);
+      published = this->PublishInterpolation(output, input->generation);
+    }
+    catch (const itk::ProcessAborted &)
+    {
+      // outdated by newer contours, continue with the pending input
     }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "3D surface interpolation failed: " << e.what();
+    }
+
+    if (!published)
+      continue;
+
+    // the run is finished before its observers learn about it, unless there are newer contours already
+    bool finished = false;
+
+    {
+      std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+
+      if (!m_PendingInput)
+      {
+        m_BackgroundInterpolationRunning = false;
+        finished = true;
+      }
+    }
+
+    this->InvokeEvent(SurfaceInterpolationFinishedEvent());
+
+    if (finished)
+      return;
+  }
+}
+
+bool mitk::SurfaceInterpolationController::CreateInterpolationInput(InterpolationInput &input)
+{
+  if (!m_SelectedSegmentation)
+  {
+    return false;
+  }
+
+  if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
+  {
+    MITK_WARN << "No interpolation possible, currently selected timepoint is not in the time bounds of currently selected segmentation. Time point: " << m_CurrentTimePoint;
+    return false;
   }
 
+  input.timeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
+
   mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
   timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(currentTimeStep);
+  timeSelector->SetTimeNr(input.timeStep);
   timeSelector->SetChannelNr(0);
   timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
 
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-  for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
+  // the time selector references the memory of the segmentation, which the user keeps editing while the
+  // worker thread reads it, so the worker gets a copy of its own
+  input.segmentation = timeSelector->GetOutput()->Clone();
+
+  input.timeGeometry = m_SelectedSegmentation->GetTimeGeometry()->Clone();
+
+  const ContourPositionInformationVec2D &contours = m_ListOfInterpolationSessions[m_SelectedSegmentation];
+
+  input.contours.clear();
+
+  if (input.timeStep < contours.size())
   {
-    mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(i);
-    reducedContour->DisconnectPipeline();
-    m_NormalsFilter->SetInput(i, reducedContour);
-    m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
+    for (const auto &contourInfo : contours[input.timeStep])
+      input.contours.push_back(contourInfo.contour);
   }
 
-  if (m_CurrentNumberOfReducedContours < 2)
+  input.minSpacing = m_MinSpacing;
+  input.maxSpacing = m_MaxSpacing;
+  input.distanceImageVolume = m_DistanceImageVolume;
+  input.generation = 0;
+
+  return true;
+}
+
+std::vector<mitk::Surface::Pointer> mitk::SurfaceInterpolationController::PreprocessContours(
+  const InterpolationInput &input)
+{
+  std::lock_guard<std::mutex> lock(m_PreprocessingMutex);
+
+  std::vector<Surface::Pointer> reducedContours;
+  std::set<const Surface *> usedContours;
+  unsigned int numberOfPointsAfterReduction = 0;
+
+  for (const auto &contour : input.contours)
+  {
+    this->ThrowIfCanceled(input.generation);
+
+    // Polygons which just exist because the plane of another contour intersects the segmentation are
+    // eliminated (see ReduceContourSetFilter). This depends on all contours, so it is checked every time.
+    vtkPolyData *polyData = contour->GetVtkPolyData();
+    std::vector<bool> keptPolygons;
+    const vtkIdType *cell(nullptr);
+    vtkIdType cellSize(0);
+
+    for (polyData->GetPolys()->InitTraversal(); polyData->GetPolys()->GetNextCell(cellSize, cell);)
+    {
+      bool kept = true;
+
+      for (const auto &otherContour : input.contours)
+      {
+        if (otherContour != contour &&
+            ReduceContourSetFilter::IsIntersectionPolygon(
+              cell, cellSize, polyData->GetPoints(), otherContour->GetVtkPolyData(), input.minSpacing, input.maxSpacing))
+        {
+          kept = false;
+          break;
+        }
+      }
+
+      keptPolygons.push_back(kept);
+    }
+
+    auto &preprocessedContour = m_PreprocessedContours[contour.GetPointer()];
+
+    if (preprocessedContour.contour != contour || preprocessedContour.contourMTime != contour->GetMTime() ||
+        preprocessedContour.minSpacing != input.minSpacing || preprocessedContour.maxSpacing != input.maxSpacing ||
+        preprocessedContour.keptPolygons != keptPolygons)
+    {
+      preprocessedContour.contour = contour;
+      preprocessedContour.contourMTime = contour->GetMTime();
+      preprocessedContour.minSpacing = input.minSpacing;
+      preprocessedContour.maxSpacing = input.maxSpacing;
+      preprocessedContour.keptPolygons = keptPolygons;
+      preprocessedContour.reducedContour =
+        ReduceContour(contour, keptPolygons, input.segmentation, input.minSpacing, input.maxSpacing);
+    }
+
+    usedContours.insert(contour.GetPointer());
+
+    if (preprocessedContour.reducedContour.IsNotNull())
+    {
+      reducedContours.push_back(preprocessedContour.reducedContour);
+      numberOfPointsAfterReduction += preprocessedContour.reducedContour->GetVtkPolyData()->GetNumberOfPoints();
+    }
+  }
+
+  // contours which have been removed or replaced are not needed anymore
+  for (auto it = m_PreprocessedContours.begin(); it != m_PreprocessedContours.end();)
+  {
+    if (usedContours.count(it->first) == 0)
+      it = m_PreprocessedContours.erase(it);
+    else
+      ++it;
+  }
+
+  m_NumberOfPointsAfterReduction = numberOfPointsAfterReduction;
+
+  return reducedContours;
+}
+
+void mitk::SurfaceInterpolationController::ComputeInterpolation(const InterpolationInput &input,
+                                                                InterpolationOutput &output)
+{
+  std::vector<Surface::Pointer> reducedContours = this->PreprocessContours(input);
+
+  auto geometry = input.timeGeometry->Clone();
+  geometry->ReplaceTimeStepGeometries(mitk::Geometry3D::New());
+
+  output.contours = Surface::New();
+
+  if (!input.contours.empty())
+  {
+    vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
+    for (const auto &contour : input.contours)
+    {
+      polyDataAppender->AddInputData(contour->GetVtkPolyData());
+    }
+    polyDataAppender->Update();
+    output.contours->SetVtkPolyData(polyDataAppender->GetOutput());
+  }
+
+  auto *contoursGeometry = static_cast<mitk::ProportionalTimeGeometry *>(output.contours->GetTimeGeometry());
+  auto timeBounds = geometry->GetTimeBounds(input.timeStep);
+  contoursGeometry->SetFirstTimePoint(timeBounds[0]);
+  contoursGeometry->SetStepDuration(timeBounds[1] - timeBounds[0]);
+
+  if (reducedContours.size() < 2)
   {
     // If no interpolation is possible reset the interpolation result
-    m_InterpolationResult = nullptr;
+    output.interpolationResult = nullptr;
     return;
   }
 
-  // Setting up progress bar
-  mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
+  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+  AccessFixedDimensionByItk_1(input.segmentation, GetImageBase, 3, itkImage);
+
+  CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
+  interpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
+  interpolateSurfaceFilter->SetDistanceImageVolume(input.distanceImageVolume);
+
+  for (unsigned int i = 0; i < reducedContours.size(); i++)
+  {
+    interpolateSurfaceFilter->SetInput(i, reducedContours[i]);
+  }
+
+  AbortData abortData = {&m_Generation, input.generation};
+
+  if (0 != input.generation)
+  {
+    itk::CStyleCommand::Pointer abortCommand = itk::CStyleCommand::New();
+    abortCommand->SetClientData(&abortData);
+    abortCommand->SetCallback(AbortIfOutdated);
+    interpolateSurfaceFilter->AddObserver(itk::ProgressEvent(), abortCommand);
+  }
+
+  interpolateSurfaceFilter->Update();
+
+  this->ThrowIfCanceled(input.generation);
 
   // create a surface from the distance-image
   mitk::ImageToSurfaceFilter::Pointer imageToSurfaceFilter = mitk::ImageToSurfaceFilter::New();
-  imageToSurfaceFilter->SetInput(m_InterpolateSurfaceFilter->GetOutput());
+  imageToSurfaceFilter->SetInput(interpolateSurfaceFilter->GetOutput());
   imageToSurfaceFilter->SetThreshold(0);
   imageToSurfaceFilter->SetSmooth(true);
   imageToSurfaceFilter->SetSmoothIteration(20);
   imageToSurfaceFilter->Update();
 
-  mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
-  interpolationResult->Expand(m_SelectedSegmentation->GetTimeSteps());
+  output.interpolationResult = mitk::Surface::New();
+  output.interpolationResult->Expand(input.timeGeometry->CountTimeSteps());
+  output.interpolationResult->SetTimeGeometry(geometry);
+  output.interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), input.timeStep);
+  output.interpolationResult->DisconnectPipeline();
 
-  auto geometry = m_SelectedSegmentation->GetTimeGeometry()->Clone();
-  geometry->ReplaceTimeStepGeometries(mitk::Geometry3D::New());
-  interpolationResult->SetTimeGeometry(geometry);
+  output.distanceImage = interpolateSurfaceFilter->GetOutput();
+  output.distanceImage->DisconnectPipeline();
+  output.distanceImageSpacing = interpolateSurfaceFilter->GetDistanceImageSpacing();
+}
 
-  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), currentTimeStep);
+bool mitk::SurfaceInterpolationController::PublishInterpolation(const InterpolationOutput &output,
+                                                                unsigned long generation)
+{
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
 
-  m_InterpolationResult = interpolationResult;
+  if (0 != generation && generation != m_Generation)
+    return false;
 
-  m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
+  m_InterpolationResult = output.interpolationResult;
+  m_Contours = output.contours;
 
-  vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
-  for (unsigned int i = 0; i < m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size(); i++)
+  if (output.distanceImage.IsNotNull())
   {
-    polyDataAppender->AddInputData(
-      m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].at(i).contour->GetVtkPolyData());
+    m_DistanceImage = output.distanceImage;
+    m_DistanceImageSpacing = output.distanceImageSpacing;
   }
-  polyDataAppender->Update();
-  m_Contours->SetVtkPolyData(polyDataAppender->GetOutput());
-
-  auto* contoursGeometry = static_cast<mitk::ProportionalTimeGeometry*>(m_Contours->GetTimeGeometry());
-  auto timeBounds = geometry->GetTimeBounds(currentTimeStep);
-  contoursGeometry->SetFirstTimePoint(timeBounds[0]);
-  contoursGeometry->SetStepDuration(timeBounds[1] - timeBounds[0]);
 
-  // Last progress step
-  mitk::ProgressBar::GetInstance()->Progress(20);
+  return true;
+}
 
-  m_InterpolationResult->DisconnectPipeline();
+void mitk::SurfaceInterpolationController::ThrowIfCanceled(unsigned long generation) const
+{
+  if (0 != generation && generation != m_Generation)
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+  }
 }
 
 mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetInterpolationResult()
 {
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
   return m_InterpolationResult;
 }
 
-mitk::Surface *mitk::SurfaceInterpolationController::GetContoursAsSurface()
+double mitk::SurfaceInterpolationController::GetDistanceImageSpacing() const
 {
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  return m_DistanceImageSpacing;
+}
+
+mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetContoursAsSurface()
+{
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
   return m_Contours;
 }
 
@@ -366,18 +721,17 @@ void mitk::SurfaceInterpolationController::SetDataStorage(DataStorage::Pointer d
 
 void mitk::SurfaceInterpolationController::SetMinSpacing(double minSpacing)
 {
-  m_ReduceFilter->SetMinSpacing(minSpacing);
+  m_MinSpacing = minSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetMaxSpacing(double maxSpacing)
 {
-  m_ReduceFilter->SetMaxSpacing(maxSpacing);
-  m_NormalsFilter->SetMaxSpacing(maxSpacing);
+  m_MaxSpacing = maxSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int distImgVolume)
 {
-  m_InterpolateSurfaceFilter->SetDistanceImageVolume(distImgVolume);
+  m_DistanceImageVolume = distImgVolume;
 }
 
 mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentation()
@@ -385,14 +739,23 @@ mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentatio
   return m_SelectedSegmentation;
 }
 
-mitk::Image *mitk::SurfaceInterpolationController::GetImage()
+mitk::Image::Pointer mitk::SurfaceInterpolationController::GetImage()
 {
-  return m_InterpolateSurfaceFilter->GetOutput();
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  return m_DistanceImage;
 }
 
 double mitk::SurfaceInterpolationController::EstimatePortionOfNeededMemory()
 {
-  double numberOfPointsAfterReduction = m_ReduceFilter->GetNumberOfPointsAfterReduction() * 3;
+  // the preprocessed contours are reused by the following interpolation
+  InterpolationInput input;
+  if (this->CreateInterpolationInput(input))
+    this->PreprocessContours(input);
+
+  std::unique_lock<std::mutex> lock(m_PreprocessingMutex);
+  double numberOfPointsAfterReduction = m_NumberOfPointsAfterReduction * 3;
+  lock.unlock();
+
   double sizeOfPoints = pow(numberOfPointsAfterReduction, 2) * sizeof(double);
   double totalMem = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
   double percentage = sizeOfPoints / totalMem;
@@ -437,8 +800,11 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
     ContourPositionInformationVec2D newList;
     m_ListOfInterpolationSessions.insert(
       std::pair<mitk::Image *, ContourPositionInformationVec2D>(m_SelectedSegmentation, newList));
-    m_InterpolationResult = nullptr;
-    m_CurrentNumberOfReducedContours = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(m_ResultMutex);
+      m_InterpolationResult = nullptr;
+    }
 
     itk::MemberCommand<SurfaceInterpolationController>::Pointer command =
       itk::MemberCommand<SurfaceInterpolationController>::New();
@@ -485,16 +851,6 @@ bool mitk::SurfaceInterpolationController::ReplaceInterpolationSession(mitk::Ima
   if (m_SelectedSegmentation == oldSession)
     m_SelectedSegmentation = newSession;
 
-  const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
-
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(currentTimeStep);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-
   this->RemoveInterpolationSession(oldSession);
   return true;
 }
@@ -510,7 +866,6 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
   {
     if (m_SelectedSegmentation == segmentationImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
       m_SelectedSegmentation = nullptr;
     }
     m_ListOfInterpolationSessions.erase(segmentationImage);
@@ -656,7 +1011,6 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
   {
     if (m_SelectedSegmentation == tempImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
       m_SelectedSegmentation = nullptr;
     }
     m_SegmentationObserverTags.erase(tempImage);
@@ -666,13 +1020,6 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
 
 void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
 {
-  // If session has changed reset the pipeline
-  m_ReduceFilter->Reset();
-  m_NormalsFilter->Reset();
-  m_InterpolateSurfaceFilter->Reset();
-
-  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
-
   if (m_SelectedSegmentation)
   {
     if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
@@ -680,17 +1027,8 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       MITK_WARN << "Interpolation cannot be reinitialized. Currently selected timepoint is not in the time bounds of the currently selected segmentation. Time point: " << m_CurrentTimePoint;
       return;
     }
-    const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
-
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(m_SelectedSegmentation);
-    timeSelector->SetTimeNr(currentTimeStep);
-    timeSelector->SetChannelNr(0);
-    timeSelector->Update();
-    mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_1(refSegImage, GetImageBase, 3, itkImage);
-    m_InterpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
 
+    // The contours are reduced and their normals are computed by the next interpolation
     unsigned int numTimeSteps = m_SelectedSegmentation->GetTimeSteps();
     unsigned int size = m_ListOfInterpolationSessions[m_SelectedSegmentation].size();
     if (size != numTimeSteps)
@@ -698,34 +1036,6 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       m_ListOfInterpolationSessions[m_SelectedSegmentation].resize(numTimeSteps);
     }
 
-    if (currentTimeStep < numTimeSteps)
-    {
-      unsigned int numContours = m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size();
-      for (unsigned int c = 0; c < numContours; ++c)
-      {
-        m_ReduceFilter->SetInput(c,
-                                 m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep][c].contour);
-      }
-
-      m_ReduceFilter->Update();
-
-      m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-      if (m_CurrentNumberOfReducedContours == 1)
-      {
-        vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-        if (tmp == nullptr)
-        {
-          m_CurrentNumberOfReducedContours = 0;
-        }
-      }
-
-      for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-      {
-        m_NormalsFilter->SetInput(i, m_ReduceFilter->GetOutput(i));
-        m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-      }
-    }
-
     Modified();
   }
 }
@@ -43,15 +43,27 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
+  /**
+   * \brief Invoked by SurfaceInterpolationController when a background interpolation has published its result.
+   *
+   * The event is invoked on the worker thread of the interpolation.
+   */
+  itkEventMacro(SurfaceInterpolationFinishedEvent, itk::AnyEvent);
+
   class MITKSURFACEINTERPOLATION_EXPORT SurfaceInterpolationController : public itk::Object
   {
   public:
     mitkClassMacroItkParent(SurfaceInterpolationController, itk::Object);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
-    itkGetMacro(DistanceImageSpacing, double);
 
     struct ContourPositionInformation
     {
@@ -120,8 +132,33 @@ namespace mitk
      */
     void Interpolate();
 
+    /**
+     * @brief Interpolates the 3D surface from the given extracted contours on a worker thread
+     *
+     * Returns immediately. A run that is still in progress is canceled since its contours are outdated.
+     * When a run completes, its result is published (see GetInterpolationResult()) and a
+     * SurfaceInterpolationFinishedEvent is invoked on the worker thread. Observers must not block
+     * and must not stop the background interpolation from within the event.
+     *
+     * The reduced contours and their normals are kept across runs, so only added or changed contours
+     * are preprocessed again.
+     */
+    void StartBackgroundInterpolation();
+
+    /**
+     * @brief Cancels the background interpolation and waits for the worker thread to finish
+     */
+    void StopBackgroundInterpolation();
+
+    /**
+     * @brief Returns true while the background interpolation has runs to complete
+     */
+    bool IsBackgroundInterpolationRunning() const;
+
     mitk::Surface::Pointer GetInterpolationResult();
 
+    double GetDistanceImageSpacing() const;
+
     /**
      * Sets the minimum spacing of the current selected segmentation
      * This is needed since the contour points we reduced before they are used to interpolate the surface
@@ -146,7 +183,7 @@ namespace mitk
      */
     mitk::Image::Pointer GetCurrentSegmentation();
 
-    Surface *GetContoursAsSurface();
+    Surface::Pointer GetContoursAsSurface();
 
     void SetDataStorage(DataStorage::Pointer ds);
 
@@ -197,7 +234,7 @@ namespace mitk
      */
     void ReinitializeInterpolation(mitk::Surface::Pointer contours);
 
-    mitk::Image *GetImage();
+    mitk::Image::Pointer GetImage();
 
     /**
      * Estimates the memory which is needed to build up the equationsystem for the interpolation.
@@ -208,6 +245,21 @@ namespace mitk
     unsigned int GetNumberOfInterpolationSessions();
 
   protected:
+    /** A contour after the reduction of its points and the computation of its normals */
+    struct PreprocessedContour
+    {
+      Surface::Pointer contour;
+      itk::ModifiedTimeType contourMTime;
+      double minSpacing;
+      double maxSpacing;
+      /** Polygons of the contour which are not just intersections with the plane of another contour */
+      std::vector<bool> keptPolygons;
+      /** nullptr if no polygon remains after the reduction */
+      Surface::Pointer reducedContour;
+    };
+
+    typedef std::map<const Surface *, PreprocessedContour> PreprocessedContourMap;
+
     SurfaceInterpolationController();
 
     ~SurfaceInterpolationController() override;
@@ -215,21 +267,64 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void GetImageBase(itk::Image<TPixel, VImageDimension> *input, itk::ImageBase<3>::Pointer &result);
 
+    /** Preprocessed contours of the last interpolation, keyed by the contours of the sessions */
+    PreprocessedContourMap m_PreprocessedContours;
+
   private:
+    /** Everything an interpolation needs, copied from the current session so that it can run on another thread */
+    struct InterpolationInput
+    {
+      std::vector<Surface::Pointer> contours;
+      /** Copy of the current time step of the selected segmentation, owned by the interpolation */
+      Image::Pointer segmentation;
+      TimeGeometry::Pointer timeGeometry;
+      TimeStepType timeStep;
+      double minSpacing;
+      double maxSpacing;
+      unsigned int distanceImageVolume;
+      /** 0 for interpolations that cannot be canceled */
+      unsigned long generation;
+    };
+
+    struct InterpolationOutput
+    {
+      Surface::Pointer interpolationResult;
+      Surface::Pointer contours;
+      Image::Pointer distanceImage;
+      double distanceImageSpacing;
+    };
+
     void ReinitializeInterpolation();
 
     void OnSegmentationDeleted(const itk::Object *caller, const itk::EventObject &event);
 
     void AddToInterpolationPipeline(ContourPositionInformation contourInfo);
 
-    ReduceContourSetFilter::Pointer m_ReduceFilter;
-    ComputeContourSetNormalsFilter::Pointer m_NormalsFilter;
-    CreateDistanceImageFromSurfaceFilter::Pointer m_InterpolateSurfaceFilter;
+    bool CreateInterpolationInput(InterpolationInput &input);
+
+    /** Returns the reduced contours with normals. Reuses the results of previous calls for unchanged contours. */
+    std::vector<Surface::Pointer> PreprocessContours(const InterpolationInput &input);
+
+    void ComputeInterpolation(const InterpolationInput &input, InterpolationOutput &output);
+
+    /** Publishes the output unless a newer background interpolation has been requested meanwhile */
+    bool PublishInterpolation(const InterpolationOutput &output, unsigned long generation);
+
+    void RunBackgroundInterpolation();
+
+    /** Throws itk::ProcessAborted if a newer background interpolation has been requested */
+    void ThrowIfCanceled(unsigned long generation) const;
+
+    double m_MinSpacing;
+    double m_MaxSpacing;
+    unsigned int m_DistanceImageVolume;
 
     Surface::Pointer m_Contours;
 
     double m_DistanceImageSpacing;
 
+    Image::Pointer m_DistanceImage;
+
     vtkSmartPointer<vtkPolyData> m_PolyData;
 
     mitk::DataStorage::Pointer m_DataStorage;
@@ -238,13 +333,26 @@ namespace mitk
 
     mitk::Surface::Pointer m_InterpolationResult;
 
-    unsigned int m_CurrentNumberOfReducedContours;
+    unsigned int m_NumberOfPointsAfterReduction;
 
     mitk::Image *m_SelectedSegmentation;
 
     std::map<mitk::Image *, unsigned long> m_SegmentationObserverTags;
 
     mitk::TimePointType m_CurrentTimePoint;
+
+    /** Guards the published results */
+    mutable std::mutex m_ResultMutex;
+
+    /** Guards m_PreprocessedContours and m_NumberOfPointsAfterReduction */
+    std::mutex m_PreprocessingMutex;
+
+    /** Guards the pending input and the state of the worker thread */
+    mutable std::mutex m_BackgroundMutex;
+    std::unique_ptr<InterpolationInput> m_PendingInput;
+    bool m_BackgroundInterpolationRunning;
+    std::atomic<unsigned long> m_Generation;
+    std::thread m_BackgroundThread;
   };
 }
 #endif
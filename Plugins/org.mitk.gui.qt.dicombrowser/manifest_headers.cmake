@@ -3,3 +3,4 @@ set(Plugin-Version "0.1")
 set(Plugin-Vendor "German Cancer Research Center (DKFZ)")
 set(Plugin-ContactAddress "")
 set(Require-Plugin org.mitk.gui.qt.common)
+set(Plugin-ActivationPolicy "eager")
@@ -71,6 +71,11 @@ void QmitkDicomPreferencePage::CreateQtControl(QWidget* parent)
   displayOptionsLayout->addWidget(m_PathDefault);
 
   formLayout->addRow("Local database path:",displayOptionsLayout);
+
+  m_PersistentTagCacheCheckBox = new QCheckBox("Remember the tags of scanned files across sessions", m_MainControl);
+  m_PersistentTagCacheCheckBox->setToolTip("Speeds up repeated imports of unchanged DICOM files.");
+  formLayout->addRow("Tag cache:", m_PersistentTagCacheCheckBox);
+
   m_MainControl->setLayout(formLayout);
 
   connect(m_PathDefault, SIGNAL(clicked()), this, SLOT(DefaultButtonPushed()));
@@ -91,6 +96,8 @@ void QmitkDicomPreferencePage::PerformCancel()
 bool QmitkDicomPreferencePage::PerformOk()
 {
   m_DicomPreferencesNode->Put("default dicom path",m_PathEdit->text());
+  m_DicomPreferencesNode->PutBool("persistent tag cache", m_PersistentTagCacheCheckBox->isChecked());
+  mitk::PluginActivator::SetPersistentTagCacheEnabled(m_PersistentTagCacheCheckBox->isChecked());
   return true;
 }
 
@@ -98,6 +105,7 @@ void QmitkDicomPreferencePage::Update()
 {
   QString path = m_DicomPreferencesNode->Get("default dicom path", CreateDefaultPath());
   m_PathEdit->setText(path);
+  m_PersistentTagCacheCheckBox->setChecked(m_DicomPreferencesNode->GetBool("persistent tag cache", true));
 }
 
 void QmitkDicomPreferencePage::DefaultButtonPushed()
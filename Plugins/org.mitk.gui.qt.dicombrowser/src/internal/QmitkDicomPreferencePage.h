@@ -63,6 +63,7 @@ protected:
     QLineEdit* m_PathEdit;
     QPushButton* m_PathSelect;
     QPushButton* m_PathDefault;
+    QCheckBox* m_PersistentTagCacheCheckBox;
 
 protected slots:
     void DefaultButtonPushed();
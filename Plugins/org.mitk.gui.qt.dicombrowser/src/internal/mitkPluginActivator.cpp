@@ -13,27 +13,61 @@ found in the LICENSE file.
 #include "mitkPluginActivator.h"
 #include "QmitkDicomBrowser.h"
 #include "QmitkDicomPreferencePage.h"
+
+#include <berryIPreferencesService.h>
+#include <berryPlatform.h>
 #include <usModuleInitialization.h>
 
 US_INITIALIZE_MODULE
 
 namespace mitk {
 ctkPluginContext* PluginActivator::pluginContext = nullptr;
+DICOMPersistentTagCache::Pointer PluginActivator::persistentTagCache;
 
 void PluginActivator::start(ctkPluginContext* context)
 {
   BERRY_REGISTER_EXTENSION_CLASS(QmitkDicomBrowser, context)
   BERRY_REGISTER_EXTENSION_CLASS(QmitkDicomPreferencePage, context)
   pluginContext = context;
+
+  // the tag values of scanned files are reused by all DICOM readers, also in later sessions
+  berry::IPreferencesService* prefService = berry::Platform::GetPreferencesService();
+  auto dicomPreferencesNode = prefService->GetSystemPreferences()->Node("/org.mitk.views.dicomreader");
+  SetPersistentTagCacheEnabled(dicomPreferencesNode->GetBool("persistent tag cache", true));
 }
 
 void PluginActivator::stop(ctkPluginContext* context)
 {
   Q_UNUSED(context)
+  SetPersistentTagCacheEnabled(false);
   pluginContext = nullptr;
 }
 ctkPluginContext* PluginActivator::getContext()
 {
     return pluginContext;
 }
+
+void PluginActivator::SetPersistentTagCacheEnabled(bool enabled)
+{
+  if (enabled == persistentTagCache.IsNotNull())
+    return;
+
+  if (enabled)
+  {
+    persistentTagCache = DICOMPersistentTagCache::New();
+    persistentTagCache->SetFileName(pluginContext->getDataFile("DICOMTagCache.bin").absoluteFilePath().toStdString());
+    persistentTagCache->Load();
+    DICOMPersistentTagCache::SetDefault(persistentTagCache);
+  }
+  else
+  {
+    if (DICOMPersistentTagCache::GetDefault() == persistentTagCache)
+      DICOMPersistentTagCache::SetDefault(nullptr);
+
+    if (persistentTagCache->IsSaveRequired())
+      persistentTagCache->Save();
+
+    persistentTagCache = nullptr;
+  }
+}
 }
@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include <ctkPluginActivator.h>
 
+#include <mitkDICOMPersistentTagCache.h>
+
 namespace mitk {
 
 class PluginActivator :
@@ -29,8 +31,13 @@ public:
   void start(ctkPluginContext* context) override;
   void stop(ctkPluginContext* context) override;
   static ctkPluginContext* getContext();
+
+  /** Creates the persistent tag cache of the DICOM readers from its file in the plugin data directory, or saves and
+      releases it. */
+  static void SetPersistentTagCacheEnabled(bool enabled);
 private:
     static ctkPluginContext* pluginContext;
+    static DICOMPersistentTagCache::Pointer persistentTagCache;
 }; // PluginActivator
 
 }
@@ -99,6 +99,8 @@ void QmitkImageStatisticsView::CreateConnections()
 {
   connect(m_Controls.checkBox_ignoreZero, &QCheckBox::stateChanged,
     this, &QmitkImageStatisticsView::OnCheckBoxIgnoreZeroStateChanged);
+  connect(m_Controls.checkBox_incrementalUpdates, &QCheckBox::stateChanged,
+    this, &QmitkImageStatisticsView::OnCheckBoxIncrementalUpdatesStateChanged);
   connect(m_Controls.buttonSelection, &QAbstractButton::clicked,
     this, &QmitkImageStatisticsView::OnButtonSelectionPressed);
 
@@ -301,6 +303,11 @@ void QmitkImageStatisticsView::OnCheckBoxIgnoreZeroStateChanged(int state)
   this->UpdateHistogramWidget();
 }
 
+void QmitkImageStatisticsView::OnCheckBoxIncrementalUpdatesStateChanged(int state)
+{
+  m_DataGenerator->SetIncrementalUpdates(state != Qt::Unchecked);
+}
+
 void QmitkImageStatisticsView::OnImageSelectionChanged(QmitkAbstractNodeSelectionWidget::NodeList /*nodes*/)
 {
   auto images = m_Controls.imageNodesSelector->GetSelectedNodesStdVector();